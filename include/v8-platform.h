@@ -448,6 +448,20 @@ class PageAllocator {
    */
   virtual bool DiscardSystemPages(void* address, size_t size) { return true; }
 
+  /**
+   * INTERNAL ONLY: This interface has not been stabilised and may change
+   * without notice from one release to another without being deprecated first.
+   *
+   * Makes pages in an allocated range inaccessible like SetPermissions with
+   * kNoAccess, but keeps their memory committed. This is for pages that are
+   * likely to be reused soon, e.g. because they share a transparent huge page
+   * with pages that are still in use. The default implementation does not
+   * keep the memory.
+   */
+  virtual bool SetNoAccessWithoutDiscarding(void* address, size_t length) {
+    return SetPermissions(address, length, kNoAccess);
+  }
+
   /**
    * INTERNAL ONLY: This interface has not been stabilised and may change
    * without notice from one release to another without being deprecated first.
@@ -127,6 +127,7 @@ template<typename T> class PropertyCallbackInfo;
 template<typename T> class ReturnValue;
 
 namespace internal {
+class BackgroundDeserializeTask;
 class BasicTracedReferenceExtractor;
 class ExternalString;
 class FunctionCallbackArguments;
@@ -134,6 +135,7 @@ class GlobalHandles;
 class Heap;
 class HeapObject;
 class Isolate;
+class JsonStreamingParser;
 class LocalEmbedderHeapTracer;
 class MicrotaskQueue;
 class PropertyCallbackArguments;
@@ -1837,16 +1839,21 @@ class V8_EXPORT ScriptCompiler {
     CachedData& operator=(const CachedData&) = delete;
   };
 
+  class ConsumeCodeCacheTask;
+
   /**
    * Source code which can be then compiled to a UnboundScript or Script.
    */
   class Source {
    public:
-    // Source takes ownership of CachedData.
+    // Source takes ownership of both CachedData and ConsumeCodeCacheTask.
     V8_INLINE Source(Local<String> source_string, const ScriptOrigin& origin,
-                     CachedData* cached_data = nullptr);
-    V8_INLINE explicit Source(Local<String> source_string,
-                              CachedData* cached_data = nullptr);
+                     CachedData* cached_data = nullptr,
+                     ConsumeCodeCacheTask* consume_cache_task = nullptr);
+    // Source takes ownership of both CachedData and ConsumeCodeCacheTask.
+    V8_INLINE explicit Source(
+        Local<String> source_string, CachedData* cached_data = nullptr,
+        ConsumeCodeCacheTask* consume_cache_task = nullptr);
     V8_INLINE ~Source();
 
     // Ownership of the CachedData or its buffers is *not* transferred to the
@@ -1877,6 +1884,7 @@ class V8_EXPORT ScriptCompiler {
     // set), or hold newly generated cache data (kProduce*Cache flags) are
     // set when calling a compile method.
     CachedData* cached_data;
+    std::unique_ptr<ConsumeCodeCacheTask> consume_cache_task;
   };
 
   /**
@@ -1973,6 +1981,26 @@ class V8_EXPORT ScriptCompiler {
     internal::ScriptStreamingData* data_;
   };
 
+  /**
+   * A task which the embedder must run on a background thread to
+   * consume a V8 code cache. Returned by
+   * ScriptCompiler::StartConsumingCodeCache.
+   */
+  class V8_EXPORT ConsumeCodeCacheTask final {
+   public:
+    ~ConsumeCodeCacheTask();
+
+    void Run();
+
+   private:
+    friend class ScriptCompiler;
+
+    explicit ConsumeCodeCacheTask(
+        std::unique_ptr<internal::BackgroundDeserializeTask> impl);
+
+    std::unique_ptr<internal::BackgroundDeserializeTask> impl_;
+  };
+
   enum CompileOptions {
     kNoCompileOptions = 0,
     kConsumeCodeCache,
@@ -2053,6 +2081,19 @@ class V8_EXPORT ScriptCompiler {
       Isolate* isolate, StreamedSource* source,
       ScriptType type = ScriptType::kClassic);
 
+  /**
+   * Returns a task which deserializes the code cache in |source|. The
+   * embedder is responsible for running the task on a background thread.
+   * When ConsumeCodeCacheTask::Run exits, the task is passed to Compile or
+   * CompileUnboundScript as part of a Source, together with
+   * kConsumeCodeCache; the Source takes ownership of it. The remaining work,
+   * such as checking the source and registering the script, is done on the
+   * main thread. The task owns |source|, whose rejected field is updated when
+   * the script is compiled.
+   */
+  static ConsumeCodeCacheTask* StartConsumingCodeCache(
+      Isolate* isolate, std::unique_ptr<CachedData> source);
+
   /**
    * Compiles a streamed script (bound to current context).
    *
@@ -2148,6 +2189,16 @@ class V8_EXPORT ScriptCompiler {
    */
   static CachedData* CreateCodeCacheForFunction(Local<Function> function);
 
+  /**
+   * Updates the entry of the specified unbound_script in the on-disk code
+   * cache configured by Isolate::CreateParams::code_cache_directory right
+   * away, instead of waiting for the scheduled update. Calling this after the
+   * script has run includes lazily compiled functions in the cache. Returns
+   * false if there is no on-disk code cache or the script cannot be
+   * serialized.
+   */
+  static bool UpdatePersistentCodeCache(Local<UnboundScript> unbound_script);
+
  private:
   static V8_WARN_UNUSED_RESULT MaybeLocal<UnboundScript> CompileUnboundInternal(
       Isolate* isolate, Source* source, CompileOptions options,
@@ -2467,6 +2518,79 @@ class V8_EXPORT JSON {
   static V8_WARN_UNUSED_RESULT MaybeLocal<String> Stringify(
       Local<Context> context, Local<Value> json_object,
       Local<String> gap = Local<String>());
+
+  /**
+   * Receives the UTF-8 encoded output of StringifyToUtf8 in chunks. The
+   * embedder decides how to grow its buffer, or may write the chunks out
+   * directly.
+   */
+  class V8_EXPORT Utf8Sink {
+   public:
+    virtual ~Utf8Sink() = default;
+
+    /**
+     * Appends |length| bytes of output. Chunks never end in the middle of a
+     * character.
+     */
+    virtual void Append(const char* data, size_t length) = 0;
+  };
+
+  /**
+   * Like Stringify, but writes the result as UTF-8 to |sink| while it is
+   * produced, instead of creating a string which the embedder would have to
+   * encode again, e.g. for sending large responses over the network.
+   *
+   * Returns false without writing anything if |json_object| has no JSON
+   * representation, e.g. if it is undefined. If an exception is thrown, a
+   * prefix of the output may have been written already.
+   */
+  static V8_WARN_UNUSED_RESULT Maybe<bool> StringifyToUtf8(
+      Local<Context> context, Local<Value> json_object, Utf8Sink* sink,
+      Local<String> gap = Local<String>());
+
+  /**
+   * Parses JSON text which is passed in chunks, e.g. as it is received over
+   * the network, without concatenating the chunks into a string first. The
+   * elements of a top-level array are parsed as soon as they have been
+   * received completely, so that only the elements which haven't been parsed
+   * yet need to be kept in memory. The result is the same as that of Parse on
+   * the whole text.
+   *
+   * After a call has failed, the parser must not be used anymore.
+   */
+  class V8_EXPORT StreamingParser {
+   public:
+    enum Encoding { ONE_BYTE, TWO_BYTE, UTF8 };
+
+    /**
+     * Creates a parser for text in the given encoding. ONE_BYTE is Latin-1,
+     * TWO_BYTE is UTF-16 in the native byte order.
+     */
+    StreamingParser(Isolate* isolate, Encoding encoding);
+    ~StreamingParser();
+
+    /**
+     * Appends |length| bytes of text. Characters may be split between
+     * chunks. Returns Nothing and throws a SyntaxError if the text so far
+     * can't be the start of a JSON text.
+     */
+    V8_WARN_UNUSED_RESULT Maybe<bool> AppendChunk(Local<Context> context,
+                                                  const uint8_t* data,
+                                                  size_t length);
+
+    /**
+     * Returns the parsed value, or throws a SyntaxError if the text isn't a
+     * complete JSON text. Must be called at most once.
+     */
+    V8_WARN_UNUSED_RESULT MaybeLocal<Value> Finish(Local<Context> context);
+
+    // Prevent copying.
+    StreamingParser(const StreamingParser&) = delete;
+    StreamingParser& operator=(const StreamingParser&) = delete;
+
+   private:
+    std::unique_ptr<internal::JsonStreamingParser> impl_;
+  };
 };
 
 /**
@@ -8217,6 +8341,13 @@ class V8_EXPORT MeasureMemoryDelegate {
       Local<Promise::Resolver> promise_resolver, MeasureMemoryMode mode);
 };
 
+/**
+ * This callback is invoked after a full GC in which the live bytes of a
+ * context tracked with Isolate::TrackContextMemory exceeded its limit.
+ */
+using ContextMemoryLimitCallback = void (*)(Local<Context> context,
+                                            size_t live_bytes, void* data);
+
 /**
  * Isolate represents an isolated instance of the V8 engine.  V8 isolates have
  * completely separate states.  Objects from one isolate must not be used in
@@ -8304,6 +8435,26 @@ class V8_EXPORT Isolate {
     int embedder_wrapper_type_index = -1;
     int embedder_wrapper_object_index = -1;
 
+    /**
+     * Optional path of an existing directory in which V8 persists the code
+     * caches of compiled scripts across process restarts. Scripts compiled
+     * with kNoCompileOptions or kEagerCompile are looked up in this cache
+     * before they are compiled. They are stored in it a few seconds after they
+     * were compiled or loaded, and when the isolate is disposed, so that the
+     * entries include the functions that were compiled while they ran.
+     * Entries are keyed by the script source and are only used by the same V8
+     * version with the same flags. The directory may be shared between
+     * isolates and processes.
+     */
+    const char* code_cache_directory = nullptr;
+
+    /**
+     * The maximum total size in bytes of the on-disk code cache configured by
+     * code_cache_directory. Least recently used entries are evicted when it is
+     * exceeded. If zero, a default of 64MB is used.
+     */
+    size_t code_cache_max_size = 0;
+
     V8_DEPRECATED(
         "Setting this has no effect. Embedders should ignore import assertions "
         "that they do not use.")
@@ -8807,6 +8958,37 @@ class V8_EXPORT Isolate {
   MaybeLocal<Promise> MeasureMemory(Local<Context> context,
                                     MeasureMemoryMode mode);
 
+  /**
+   * This API is experimental and may change significantly.
+   *
+   * Attributes the live bytes of the heap to the given context during every
+   * full GC, in the same way as MeasureMemory does, until the context dies or
+   * is untracked. Calling it again for the same context updates the limit.
+   *
+   * \param limit_in_bytes if not zero, the callback set with
+   *   SetContextMemoryLimitCallback is invoked after each full GC in which
+   *   the live bytes of the context exceeded this limit.
+   */
+  void TrackContextMemory(Local<Context> context, size_t limit_in_bytes = 0);
+
+  /**
+   * Stops the attribution of live bytes to the given context.
+   */
+  void UntrackContextMemory(Local<Context> context);
+
+  /**
+   * Returns the live bytes of a context tracked with TrackContextMemory as of
+   * the last full GC, or zero if no full GC has measured it yet.
+   */
+  size_t GetContextLiveBytes(Local<Context> context);
+
+  /**
+   * Sets the callback that is invoked when a tracked context exceeds its
+   * limit. The callback runs in a task after the GC.
+   */
+  void SetContextMemoryLimitCallback(ContextMemoryLimitCallback callback,
+                                     void* data);
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -11467,7 +11649,8 @@ int ScriptOrigin::ScriptId() const { return script_id_; }
 Local<Value> ScriptOrigin::SourceMapUrl() const { return source_map_url_; }
 
 ScriptCompiler::Source::Source(Local<String> string, const ScriptOrigin& origin,
-                               CachedData* data)
+                               CachedData* data,
+                               ConsumeCodeCacheTask* consume_cache_task)
     : source_string(string),
       resource_name(origin.ResourceName()),
       resource_line_offset(origin.LineOffset()),
@@ -11475,11 +11658,14 @@ ScriptCompiler::Source::Source(Local<String> string, const ScriptOrigin& origin,
       resource_options(origin.Options()),
       source_map_url(origin.SourceMapUrl()),
       host_defined_options(origin.HostDefinedOptions()),
-      cached_data(data) {}
+      cached_data(data),
+      consume_cache_task(consume_cache_task) {}
 
-ScriptCompiler::Source::Source(Local<String> string,
-                               CachedData* data)
-    : source_string(string), cached_data(data) {}
+ScriptCompiler::Source::Source(Local<String> string, CachedData* data,
+                               ConsumeCodeCacheTask* consume_cache_task)
+    : source_string(string),
+      cached_data(data),
+      consume_cache_task(consume_cache_task) {}
 
 
 ScriptCompiler::Source::~Source() {
@@ -50,11 +50,13 @@
 #include "src/handles/persistent-handles.h"
 #include "src/heap/embedder-tracing.h"
 #include "src/heap/heap-inl.h"
+#include "src/heap/memory-measurement.h"
 #include "src/init/bootstrapper.h"
 #include "src/init/icu_util.h"
 #include "src/init/startup-data-util.h"
 #include "src/init/v8.h"
 #include "src/json/json-parser.h"
+#include "src/json/json-streaming-parser.h"
 #include "src/json/json-stringifier.h"
 #include "src/logging/counters.h"
 #include "src/logging/metrics.h"
@@ -101,6 +103,7 @@
 #include "src/runtime/runtime.h"
 #include "src/snapshot/code-serializer.h"
 #include "src/snapshot/embedded/embedded-data.h"
+#include "src/snapshot/persistent-code-cache.h"
 #include "src/snapshot/snapshot.h"
 #include "src/snapshot/startup-serializer.h"  // For SerializedHandleChecker.
 #include "src/strings/char-predicates-inl.h"
@@ -2319,14 +2322,6 @@ MaybeLocal<UnboundScript> ScriptCompiler::CompileUnboundInternal(
                      CompileUnbound, MaybeLocal<UnboundScript>(),
                      InternalEscapableScope);
 
-  i::ScriptData* script_data = nullptr;
-  if (options == kConsumeCodeCache) {
-    DCHECK(source->cached_data);
-    // ScriptData takes care of pointer-aligning the data.
-    script_data = new i::ScriptData(source->cached_data->data,
-                                    source->cached_data->length);
-  }
-
   i::Handle<i::String> str = Utils::OpenHandle(*(source->source_string));
   i::Handle<i::SharedFunctionInfo> result;
   TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"), "V8.CompileScript");
@@ -2334,14 +2329,35 @@ MaybeLocal<UnboundScript> ScriptCompiler::CompileUnboundInternal(
       isolate, source->resource_name, source->resource_line_offset,
       source->resource_column_offset, source->source_map_url,
       source->host_defined_options);
-  i::MaybeHandle<i::SharedFunctionInfo> maybe_function_info =
-      i::Compiler::GetSharedFunctionInfoForScript(
-          isolate, str, script_details, source->resource_options, nullptr,
-          script_data, options, no_cache_reason, i::NOT_NATIVES_CODE);
-  if (options == kConsumeCodeCache) {
-    source->cached_data->rejected = script_data->rejected();
-  }
-  delete script_data;
+
+  i::MaybeHandle<i::SharedFunctionInfo> maybe_function_info;
+  if (options == kConsumeCodeCache && source->consume_cache_task) {
+    // The code cache was deserialized on a background thread already.
+    i::BackgroundDeserializeTask* deserialize_task =
+        source->consume_cache_task->impl_.get();
+    maybe_function_info =
+        i::Compiler::GetSharedFunctionInfoForScriptWithDeserializeTask(
+            isolate, str, script_details, source->resource_options,
+            deserialize_task, options, no_cache_reason, i::NOT_NATIVES_CODE);
+    if (source->cached_data) {
+      source->cached_data->rejected = deserialize_task->rejected();
+    }
+  } else {
+    i::ScriptData* script_data = nullptr;
+    if (options == kConsumeCodeCache) {
+      DCHECK(source->cached_data);
+      // ScriptData takes care of pointer-aligning the data.
+      script_data = new i::ScriptData(source->cached_data->data,
+                                      source->cached_data->length);
+    }
+    maybe_function_info = i::Compiler::GetSharedFunctionInfoForScript(
+        isolate, str, script_details, source->resource_options, nullptr,
+        script_data, options, no_cache_reason, i::NOT_NATIVES_CODE);
+    if (options == kConsumeCodeCache) {
+      source->cached_data->rejected = script_data->rejected();
+    }
+    delete script_data;
+  }
   has_pending_exception = !maybe_function_info.ToHandle(&result);
   RETURN_ON_FAILED_EXECUTION(UnboundScript);
   RETURN_ESCAPED(ToApiHandle<UnboundScript>(result));
@@ -2500,6 +2516,23 @@ MaybeLocal<Function> ScriptCompiler::CompileFunctionInContext(
 
 void ScriptCompiler::ScriptStreamingTask::Run() { data_->task->Run(); }
 
+ScriptCompiler::ConsumeCodeCacheTask::ConsumeCodeCacheTask(
+    std::unique_ptr<i::BackgroundDeserializeTask> impl)
+    : impl_(std::move(impl)) {}
+
+ScriptCompiler::ConsumeCodeCacheTask::~ConsumeCodeCacheTask() = default;
+
+void ScriptCompiler::ConsumeCodeCacheTask::Run() { impl_->Run(); }
+
+ScriptCompiler::ConsumeCodeCacheTask* ScriptCompiler::StartConsumingCodeCache(
+    Isolate* v8_isolate, std::unique_ptr<CachedData> cached_data) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  ASSERT_NO_SCRIPT_NO_EXCEPTION(isolate);
+  return new ScriptCompiler::ConsumeCodeCacheTask(
+      std::make_unique<i::BackgroundDeserializeTask>(isolate,
+                                                     std::move(cached_data)));
+}
+
 ScriptCompiler::ScriptStreamingTask* ScriptCompiler::StartStreamingScript(
     Isolate* v8_isolate, StreamedSource* source, CompileOptions options) {
   // We don't support other compile options on streaming background compiles.
@@ -2615,6 +2648,19 @@ ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCacheForFunction(
   return i::CodeSerializer::Serialize(shared);
 }
 
+bool ScriptCompiler::UpdatePersistentCodeCache(
+    Local<UnboundScript> unbound_script) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  ASSERT_NO_SCRIPT_NO_EXCEPTION(isolate);
+  DCHECK(shared->is_toplevel());
+  i::PersistentCodeCache* cache = isolate->persistent_code_cache();
+  if (cache == nullptr) return false;
+  return cache->StoreScript(isolate, shared);
+}
+
 MaybeLocal<Script> Script::Compile(Local<Context> context, Local<String> source,
                                    ScriptOrigin* origin) {
   if (origin) {
@@ -3056,6 +3102,49 @@ MaybeLocal<String> JSON::Stringify(Local<Context> context,
   RETURN_ESCAPED(result);
 }
 
+Maybe<bool> JSON::StringifyToUtf8(Local<Context> context,
+                                   Local<Value> json_object, Utf8Sink* sink,
+                                   Local<String> gap) {
+  auto isolate = reinterpret_cast<i::Isolate*>(context->GetIsolate());
+  ENTER_V8(isolate, context, JSON, StringifyToUtf8, Nothing<bool>(),
+           i::HandleScope);
+  i::Handle<i::Object> object = Utils::OpenHandle(*json_object);
+  i::Handle<i::String> gap_string = gap.IsEmpty()
+                                        ? isolate->factory()->empty_string()
+                                        : Utils::OpenHandle(*gap);
+  Maybe<bool> result =
+      i::JsonStringifyToUtf8(isolate, object, gap_string, sink);
+  has_pending_exception = result.IsNothing();
+  RETURN_ON_FAILED_EXECUTION_PRIMITIVE(bool);
+  return result;
+}
+
+JSON::StreamingParser::StreamingParser(Isolate* isolate, Encoding encoding)
+    : impl_(new i::JsonStreamingParser(reinterpret_cast<i::Isolate*>(isolate),
+                                       encoding)) {}
+
+JSON::StreamingParser::~StreamingParser() = default;
+
+Maybe<bool> JSON::StreamingParser::AppendChunk(Local<Context> context,
+                                               const uint8_t* data,
+                                               size_t length) {
+  auto isolate = reinterpret_cast<i::Isolate*>(context->GetIsolate());
+  ENTER_V8(isolate, context, JSON_StreamingParser, AppendChunk,
+           Nothing<bool>(), i::HandleScope);
+  Maybe<bool> result = impl_->AppendChunk(data, length);
+  has_pending_exception = result.IsNothing();
+  RETURN_ON_FAILED_EXECUTION_PRIMITIVE(bool);
+  return result;
+}
+
+MaybeLocal<Value> JSON::StreamingParser::Finish(Local<Context> context) {
+  PREPARE_FOR_EXECUTION(context, JSON_StreamingParser, Finish, Value);
+  Local<Value> result;
+  has_pending_exception = !ToLocal<Value>(impl_->Finish(), &result);
+  RETURN_ON_FAILED_EXECUTION(Value);
+  RETURN_ESCAPED(result);
+}
+
 // --- V a l u e   S e r i a l i z a t i o n ---
 
 Maybe<bool> ValueSerializer::Delegate::WriteHostObject(Isolate* v8_isolate,
@@ -8189,6 +8278,14 @@ void Isolate::Initialize(Isolate* isolate,
       params.embedder_wrapper_type_index);
   i_isolate->set_embedder_wrapper_object_index(
       params.embedder_wrapper_object_index);
+  if (params.code_cache_directory != nullptr) {
+    size_t max_size = params.code_cache_max_size != 0
+                          ? params.code_cache_max_size
+                          : i::PersistentCodeCache::kDefaultMaxSize;
+    i_isolate->set_persistent_code_cache(
+        std::make_unique<i::PersistentCodeCache>(params.code_cache_directory,
+                                                 max_size));
+  }
 
   if (!i::V8::GetCurrentPlatform()
            ->GetForegroundTaskRunner(isolate)
@@ -8511,6 +8608,37 @@ bool Isolate::MeasureMemory(std::unique_ptr<MeasureMemoryDelegate> delegate,
   return isolate->heap()->MeasureMemory(std::move(delegate), execution);
 }
 
+void Isolate::TrackContextMemory(Local<Context> context,
+                                 size_t limit_in_bytes) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Handle<i::NativeContext> native_context =
+      handle(Utils::OpenHandle(*context)->native_context(), isolate);
+  isolate->heap()->memory_measurement()->TrackContext(native_context,
+                                                      limit_in_bytes);
+}
+
+void Isolate::UntrackContextMemory(Local<Context> context) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Handle<i::NativeContext> native_context =
+      handle(Utils::OpenHandle(*context)->native_context(), isolate);
+  isolate->heap()->memory_measurement()->UntrackContext(native_context);
+}
+
+size_t Isolate::GetContextLiveBytes(Local<Context> context) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Handle<i::NativeContext> native_context =
+      handle(Utils::OpenHandle(*context)->native_context(), isolate);
+  return isolate->heap()->memory_measurement()->ContextLiveBytes(
+      native_context);
+}
+
+void Isolate::SetContextMemoryLimitCallback(
+    ContextMemoryLimitCallback callback, void* data) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->memory_measurement()->SetContextLimitCallback(callback,
+                                                                 data);
+}
+
 std::unique_ptr<MeasureMemoryDelegate> MeasureMemoryDelegate::Default(
     Isolate* isolate, Local<Context> context,
     Local<Promise::Resolver> promise_resolver, MeasureMemoryMode mode) {
@@ -4,19 +4,24 @@
 
 #include "src/base/bounded-page-allocator.h"
 
+#include <algorithm>
+
 namespace v8 {
 namespace base {
 
 BoundedPageAllocator::BoundedPageAllocator(v8::PageAllocator* page_allocator,
                                            Address start, size_t size,
-                                           size_t allocate_page_size)
+                                           size_t allocate_page_size,
+                                           size_t huge_page_size)
     : allocate_page_size_(allocate_page_size),
       commit_page_size_(page_allocator->CommitPageSize()),
+      huge_page_size_(huge_page_size),
       page_allocator_(page_allocator),
       region_allocator_(start, size, allocate_page_size_) {
   CHECK_NOT_NULL(page_allocator);
   CHECK(IsAligned(allocate_page_size, page_allocator->AllocatePageSize()));
   CHECK(IsAligned(allocate_page_size_, commit_page_size_));
+  CHECK(IsAligned(huge_page_size_, allocate_page_size_));
 }
 
 BoundedPageAllocator::Address BoundedPageAllocator::begin() const {
@@ -85,11 +90,32 @@ bool BoundedPageAllocator::FreePages(void* raw_address, size_t size) {
   Address address = reinterpret_cast<Address>(raw_address);
   size_t freed_size = region_allocator_.FreeRegion(address);
   if (freed_size != size) return false;
+  if (huge_page_size_ != 0) {
+    CHECK(page_allocator_->SetNoAccessWithoutDiscarding(raw_address, size));
+    DecommitFreeHugePages(address, size);
+    return true;
+  }
   CHECK(page_allocator_->SetPermissions(raw_address, size,
                                         PageAllocator::kNoAccess));
   return true;
 }
 
+void BoundedPageAllocator::DecommitFreeHugePages(Address address,
+                                                 size_t size) {
+  const Address start = RoundDown(address, huge_page_size_);
+  const Address end = RoundUp(address + size, huge_page_size_);
+  for (Address group = start; group < end; group += huge_page_size_) {
+    Address group_begin = std::max(group, region_allocator_.begin());
+    Address group_end =
+        std::min(group + huge_page_size_, region_allocator_.end());
+    size_t group_size = group_end - group_begin;
+    if (!region_allocator_.IsFree(group_begin, group_size)) continue;
+    CHECK(page_allocator_->SetPermissions(reinterpret_cast<void*>(group_begin),
+                                          group_size,
+                                          PageAllocator::kNoAccess));
+  }
+}
+
 bool BoundedPageAllocator::ReleasePages(void* raw_address, size_t size,
                                         size_t new_size) {
   Address address = reinterpret_cast<Address>(raw_address);
@@ -131,6 +157,14 @@ bool BoundedPageAllocator::SetPermissions(void* address, size_t size,
   return page_allocator_->SetPermissions(address, size, access);
 }
 
+bool BoundedPageAllocator::SetNoAccessWithoutDiscarding(void* address,
+                                                        size_t size) {
+  DCHECK(IsAligned(reinterpret_cast<Address>(address), commit_page_size_));
+  DCHECK(IsAligned(size, commit_page_size_));
+  DCHECK(region_allocator_.contains(reinterpret_cast<Address>(address), size));
+  return page_allocator_->SetNoAccessWithoutDiscarding(address, size);
+}
+
 bool BoundedPageAllocator::DiscardSystemPages(void* address, size_t size) {
   return page_allocator_->DiscardSystemPages(address, size);
 }
@@ -22,13 +22,18 @@ namespace base {
 //    displacement on certain 64-bit platforms.
 // Bounded page allocator uses other page allocator instance for doing actual
 // page allocations.
+// If |huge_page_size| is not zero, freed pages are only decommitted once all
+// pages of their |huge_page_size|-aligned group are free, so that freeing a
+// page does not split the transparent huge page backing the group. Until then,
+// freed pages are inaccessible but stay committed.
 // The implementation is thread-safe.
 class V8_BASE_EXPORT BoundedPageAllocator : public v8::PageAllocator {
  public:
   using Address = uintptr_t;
 
   BoundedPageAllocator(v8::PageAllocator* page_allocator, Address start,
-                       size_t size, size_t allocate_page_size);
+                       size_t size, size_t allocate_page_size,
+                       size_t huge_page_size = 0);
   BoundedPageAllocator(const BoundedPageAllocator&) = delete;
   BoundedPageAllocator& operator=(const BoundedPageAllocator&) = delete;
   ~BoundedPageAllocator() override = default;
@@ -69,12 +74,19 @@ class V8_BASE_EXPORT BoundedPageAllocator : public v8::PageAllocator {
 
   bool SetPermissions(void* address, size_t size, Permission access) override;
 
+  bool SetNoAccessWithoutDiscarding(void* address, size_t size) override;
+
   bool DiscardSystemPages(void* address, size_t size) override;
 
  private:
+  // Decommits the groups of huge pages overlapping the given region that have
+  // no allocated pages left.
+  void DecommitFreeHugePages(Address address, size_t size);
+
   v8::base::Mutex mutex_;
   const size_t allocate_page_size_;
   const size_t commit_page_size_;
+  const size_t huge_page_size_;
   v8::PageAllocator* const page_allocator_;
   v8::base::RegionAllocator region_allocator_;
 };
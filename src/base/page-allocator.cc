@@ -151,5 +151,9 @@ bool PageAllocator::DiscardSystemPages(void* address, size_t size) {
   return base::OS::DiscardSystemPages(address, size);
 }
 
+bool PageAllocator::SetNoAccessWithoutDiscarding(void* address, size_t size) {
+  return base::OS::SetNoAccessWithoutDiscarding(address, size);
+}
+
 }  // namespace base
 }  // namespace v8
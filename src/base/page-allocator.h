@@ -47,6 +47,8 @@ class V8_BASE_EXPORT PageAllocator
 
   bool DiscardSystemPages(void* address, size_t size) override;
 
+  bool SetNoAccessWithoutDiscarding(void* address, size_t size) override;
+
  private:
   friend class v8::base::SharedMemory;
 
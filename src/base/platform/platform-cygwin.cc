@@ -205,6 +205,14 @@ bool OS::HasLazyCommits() {
   return false;
 }
 
+// static
+bool OS::SetNoAccessWithoutDiscarding(void* address, size_t size) {
+  return SetPermissions(address, size, MemoryPermission::kNoAccess);
+}
+
+// static
+bool OS::AdviseHugePages(void* address, size_t size) { return false; }
+
 std::vector<OS::SharedLibraryAddress> OS::GetSharedLibraryAddresses() {
   std::vector<SharedLibraryAddresses> result;
   // This function assumes that the layout of the file is as follows:
@@ -137,6 +137,14 @@ bool OS::HasLazyCommits() {
   return false;
 }
 
+// static
+bool OS::SetNoAccessWithoutDiscarding(void* address, size_t size) {
+  return SetPermissions(address, size, MemoryPermission::kNoAccess);
+}
+
+// static
+bool OS::AdviseHugePages(void* address, size_t size) { return false; }
+
 std::vector<OS::SharedLibraryAddress> OS::GetSharedLibraryAddresses() {
   UNREACHABLE();  // TODO(scottmg): Port, https://crbug.com/731217.
 }
@@ -485,6 +485,26 @@ bool OS::HasLazyCommits() {
   return false;
 #endif
 }
+
+// static
+bool OS::SetNoAccessWithoutDiscarding(void* address, size_t size) {
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(address) % CommitPageSize());
+  DCHECK_EQ(0, size % CommitPageSize());
+  if (mprotect(address, size, PROT_NONE) == 0) return true;
+  // See SetPermissions for why this can fail on MacOS.
+  return SetPermissions(address, size, MemoryPermission::kNoAccess);
+}
+
+// static
+bool OS::AdviseHugePages(void* address, size_t size) {
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(address) % CommitPageSize());
+  DCHECK_EQ(0, size % CommitPageSize());
+#if V8_OS_LINUX && defined(MADV_HUGEPAGE)
+  return madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
 #endif  // !V8_OS_CYGWIN && !V8_OS_FUCHSIA
 
 const char* OS::GetGCFakeMMapFile() {
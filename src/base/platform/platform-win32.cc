@@ -913,6 +913,14 @@ bool OS::HasLazyCommits() {
   return false;
 }
 
+// static
+bool OS::SetNoAccessWithoutDiscarding(void* address, size_t size) {
+  return SetPermissions(address, size, MemoryPermission::kNoAccess);
+}
+
+// static
+bool OS::AdviseHugePages(void* address, size_t size) { return false; }
+
 void OS::Sleep(TimeDelta interval) {
   ::Sleep(static_cast<DWORD>(interval.InMilliseconds()));
 }
@@ -181,6 +181,10 @@ class V8_BASE_EXPORT OS {
 
   static bool HasLazyCommits();
 
+  // Asks the OS to back the given range with transparent huge pages where
+  // possible. This is advisory; returns false if it is not supported.
+  static bool AdviseHugePages(void* address, size_t size);
+
   // Sleep for a specified time interval.
   static void Sleep(TimeDelta interval);
 
@@ -300,6 +304,11 @@ class V8_BASE_EXPORT OS {
   V8_WARN_UNUSED_RESULT static bool DiscardSystemPages(void* address,
                                                        size_t size);
 
+  // Like SetPermissions with kNoAccess, but leaves the memory committed where
+  // the OS allows it.
+  V8_WARN_UNUSED_RESULT static bool SetNoAccessWithoutDiscarding(void* address,
+                                                                 size_t size);
+
   static const int msPerSecond = 1000;
 
 #if V8_OS_POSIX
@@ -18,7 +18,14 @@
 #include <sys/sysctl.h>
 #endif
 
+#if V8_OS_LINUX
+#include <stdio.h>
+#include <string.h>
+#endif
+
 #include <limits>
+#include <string>
+#include <vector>
 
 #include "src/base/logging.h"
 #include "src/base/macros.h"
@@ -29,6 +36,156 @@
 namespace v8 {
 namespace base {
 
+#if V8_OS_LINUX
+namespace {
+
+// The memory controller directory of the cgroup of the current process.
+struct CgroupDirectory {
+  std::string path;
+  bool v2;
+};
+
+// Splits |line| at spaces.
+std::vector<std::string> SplitFields(const char* line) {
+  std::vector<std::string> fields;
+  const char* field = line;
+  for (const char* c = line;; c++) {
+    if (*c == ' ' || *c == '\n' || *c == '\0') {
+      if (c > field) fields.emplace_back(field, c - field);
+      if (*c != ' ') break;
+      field = c + 1;
+    }
+  }
+  return fields;
+}
+
+bool HasOption(const std::string& options, const char* option) {
+  size_t begin = 0;
+  while (begin <= options.size()) {
+    size_t end = options.find(',', begin);
+    if (end == std::string::npos) end = options.size();
+    if (options.compare(begin, end - begin, option) == 0) return true;
+    begin = end + 1;
+  }
+  return false;
+}
+
+// Returns the path of |cgroup| below a mount of its hierarchy whose root is
+// |mount_root|, or fails if the mount does not contain the cgroup.
+bool RelativeCgroupPath(const std::string& cgroup,
+                        const std::string& mount_root, std::string* result) {
+  if (mount_root == "/") {
+    *result = cgroup;
+    return true;
+  }
+  if (cgroup.compare(0, mount_root.size(), mount_root) != 0) return false;
+  if (cgroup.size() > mount_root.size() && cgroup[mount_root.size()] != '/') {
+    return false;
+  }
+  *result = cgroup.substr(mount_root.size());
+  return true;
+}
+
+// Finds the directory of the process's cgroup from /proc/self/cgroup and
+// /proc/self/mountinfo. The cgroup is only visible at /sys/fs/cgroup if the
+// process has its own cgroup namespace, which is not the case e.g. for systemd
+// services. If the memory controller is mounted as a cgroup v1 hierarchy, it
+// is used over the unified cgroup v2 hierarchy.
+bool FindCgroupDirectory(const char* root, CgroupDirectory* result) {
+  const std::string prefix = root;
+  FILE* file = fopen((prefix + "/proc/self/cgroup").c_str(), "r");
+  if (file == nullptr) return false;
+  // Lines are "hierarchy-ID:controller-list:cgroup-path".
+  std::string v1_cgroup, v2_cgroup;
+  char line[4096];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    std::string entry = line;
+    if (!entry.empty() && entry.back() == '\n') entry.pop_back();
+    size_t first = entry.find(':');
+    size_t second = entry.find(':', first + 1);
+    if (first == std::string::npos || second == std::string::npos) continue;
+    std::string controllers = entry.substr(first + 1, second - first - 1);
+    std::string cgroup = entry.substr(second + 1);
+    if (entry.compare(0, first, "0") == 0 && controllers.empty()) {
+      v2_cgroup = cgroup;
+    } else if (HasOption(controllers, "memory")) {
+      v1_cgroup = cgroup;
+    }
+  }
+  fclose(file);
+  if (v1_cgroup.empty() && v2_cgroup.empty()) return false;
+
+  file = fopen((prefix + "/proc/self/mountinfo").c_str(), "r");
+  if (file == nullptr) return false;
+  // Lines are "ID parent-ID major:minor root mount-point mount-options
+  // [optional-fields...] - fs-type source super-options".
+  std::string v1_directory, v2_directory;
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    std::vector<std::string> fields = SplitFields(line);
+    size_t separator = 6;
+    while (separator < fields.size() && fields[separator] != "-") separator++;
+    if (separator + 3 >= fields.size()) continue;
+    const std::string& mount_root = fields[3];
+    const std::string& mount_point = fields[4];
+    const std::string& fs_type = fields[separator + 1];
+    const std::string& super_options = fields[separator + 3];
+    std::string relative;
+    if (fs_type == "cgroup" && !v1_cgroup.empty() &&
+        HasOption(super_options, "memory") &&
+        RelativeCgroupPath(v1_cgroup, mount_root, &relative)) {
+      v1_directory = prefix + mount_point + relative;
+    } else if (fs_type == "cgroup2" && !v2_cgroup.empty() &&
+               RelativeCgroupPath(v2_cgroup, mount_root, &relative)) {
+      v2_directory = prefix + mount_point + relative;
+    }
+  }
+  fclose(file);
+  if (!v1_directory.empty()) {
+    *result = {v1_directory, false};
+  } else if (!v2_directory.empty()) {
+    *result = {v2_directory, true};
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Reads the number at the start of the given cgroup file. Fails for files that
+// do not exist, and for values like "max" that are not numbers.
+bool ReadCgroupValue(const std::string& cgroup, const char* name,
+                     int64_t* value) {
+  FILE* file = fopen((cgroup + "/" + name).c_str(), "r");
+  if (file == nullptr) return false;
+  long long result;  // NOLINT(runtime/int)
+  bool success = fscanf(file, "%lld", &result) == 1;
+  fclose(file);
+  if (success) *value = static_cast<int64_t>(result);
+  return success;
+}
+
+// Reads the value of |key| from a cgroup file with "key value" lines, like
+// memory.stat.
+bool ReadCgroupStat(const std::string& cgroup, const char* name,
+                    const char* key, int64_t* value) {
+  FILE* file = fopen((cgroup + "/" + name).c_str(), "r");
+  if (file == nullptr) return false;
+  char entry[64];
+  long long result;  // NOLINT(runtime/int)
+  bool found = false;
+  while (fscanf(file, "%63s %lld", entry, &result) == 2) {
+    if (strcmp(entry, key) == 0) {
+      *value = static_cast<int64_t>(result);
+      found = true;
+      break;
+    }
+  }
+  fclose(file);
+  return found;
+}
+
+}  // namespace
+#endif  // V8_OS_LINUX
+
 // static
 int SysInfo::NumberOfProcessors() {
 #if V8_OS_OPENBSD
@@ -115,5 +272,86 @@ int64_t SysInfo::AmountOfVirtualMemory() {
 #endif
 }
 
+// static
+int64_t SysInfo::AmountOfCgroupMemory(const char* root) {
+  return CgroupMemory(root).Limit();
+}
+
+// static
+int64_t SysInfo::CgroupMemoryWorkingSet(const char* root) {
+  return CgroupMemory(root).WorkingSet();
+}
+
+// static
+double SysInfo::MemoryPressureStallPercentage(const char* root) {
+  return CgroupMemory(root).PressureStallPercentage();
+}
+
+CgroupMemory::CgroupMemory(const char* root) {
+#if V8_OS_LINUX
+  CgroupDirectory cgroup;
+  if (!FindCgroupDirectory(root, &cgroup)) return;
+  path_ = cgroup.path;
+  v2_ = cgroup.v2;
+  // The root cgroup has no memory.max, and its memory.pressure covers the
+  // whole system rather than the process.
+  struct stat stat_buf;
+  has_pressure_ = v2_ && stat((path_ + "/memory.max").c_str(), &stat_buf) == 0;
+#endif
+}
+
+int64_t CgroupMemory::Limit() const {
+#if V8_OS_LINUX
+  if (!IsAvailable()) return 0;
+  int64_t limit = 0;
+  // cgroup v2 reports "max" and cgroup v1 a huge number if there is no limit.
+  if (!ReadCgroupValue(path_, v2_ ? "memory.max" : "memory.limit_in_bytes",
+                       &limit)) {
+    return 0;
+  }
+  int64_t physical_memory = SysInfo::AmountOfPhysicalMemory();
+  if (limit <= 0 || (physical_memory > 0 && limit >= physical_memory)) {
+    return 0;
+  }
+  return limit;
+#else
+  return 0;
+#endif
+}
+
+int64_t CgroupMemory::WorkingSet() const {
+#if V8_OS_LINUX
+  if (!IsAvailable()) return 0;
+  int64_t usage = 0;
+  if (!ReadCgroupValue(path_, v2_ ? "memory.current" : "memory.usage_in_bytes",
+                       &usage)) {
+    return 0;
+  }
+  int64_t inactive_file = 0;
+  if (ReadCgroupStat(path_, "memory.stat",
+                     v2_ ? "inactive_file" : "total_inactive_file",
+                     &inactive_file) &&
+      inactive_file < usage) {
+    usage -= inactive_file;
+  }
+  return usage;
+#else
+  return 0;
+#endif
+}
+
+double CgroupMemory::PressureStallPercentage() const {
+#if V8_OS_LINUX
+  if (!has_pressure_) return -1;
+  FILE* file = fopen((path_ + "/memory.pressure").c_str(), "r");
+  if (file == nullptr) return -1;
+  double stall;
+  bool success = fscanf(file, "some avg10=%lf", &stall) == 1;
+  fclose(file);
+  if (success) return stall;
+#endif
+  return -1;
+}
+
 }  // namespace base
 }  // namespace v8
@@ -7,6 +7,8 @@
 
 #include <stdint.h>
 
+#include <string>
+
 #include "src/base/base-export.h"
 #include "src/base/compiler-specific.h"
 
@@ -24,6 +26,51 @@ class V8_BASE_EXPORT SysInfo final {
   // Returns the number of bytes of virtual memory of this process. A return
   // value of zero means that there is no limit on the available virtual memory.
   static int64_t AmountOfVirtualMemory();
+
+  // Shorthands for the values of a CgroupMemory (see below) that is only used
+  // once. Callers that sample the values periodically should keep their own
+  // CgroupMemory instead, which finds the cgroup only once.
+  static int64_t AmountOfCgroupMemory(const char* root = "");
+  static int64_t CgroupMemoryWorkingSet(const char* root = "");
+  static double MemoryPressureStallPercentage(const char* root = "");
+};
+
+// The memory controller of the cgroup (v1 or v2) of the current process. The
+// cgroup is found once, through /proc/self/cgroup and /proc/self/mountinfo,
+// when the instance is created; the values are then read from the files of
+// the cgroup on every call. All paths are prefixed with |root|, which tests
+// use for fixture files.
+class V8_BASE_EXPORT CgroupMemory final {
+ public:
+  explicit CgroupMemory(const char* root = "");
+
+  // Returns true if the cgroup was found. The values are unknown otherwise,
+  // e.g. on platforms that do not support cgroups.
+  bool IsAvailable() const { return !path_.empty(); }
+
+  // Returns the memory limit in bytes of the cgroup. A return value of zero
+  // means that there is no limit, or that it is unknown.
+  int64_t Limit() const;
+
+  // Returns the number of bytes of memory that the cgroup uses, not counting
+  // the inactive file cache that the kernel can reclaim before it runs out of
+  // memory. A return value of zero means that the usage is unknown.
+  int64_t WorkingSet() const;
+
+  // Returns the percentage of the last 10 seconds in which some tasks of the
+  // cgroup were stalled waiting for memory, as reported by the Linux pressure
+  // stall information (PSI) of cgroup v2. A negative return value means that
+  // the information is not available, which includes processes in the root
+  // cgroup, whose PSI covers the whole system.
+  double PressureStallPercentage() const;
+
+ private:
+  // The directory of the cgroup in the cgroup file system.
+  std::string path_;
+  bool v2_ = false;
+  // Whether the memory.pressure file of the cgroup is its own, i.e. the
+  // cgroup is a v2 cgroup other than the root.
+  bool has_pressure_ = false;
 };
 
 }  // namespace base
@@ -0,0 +1,449 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/baseline/baseline-batch-compiler.h"
+
+// TODO(v8:11421): Remove #if once baseline compiler is ported to other
+// architectures.
+#if V8_TARGET_ARCH_IA32 || V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_ARM64 || \
+    V8_TARGET_ARCH_ARM
+
+#include <algorithm>
+#include <vector>
+
+#include "include/v8-platform.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/elapsed-timer.h"
+#include "src/base/platform/mutex.h"
+#include "src/baseline/baseline-compiler.h"
+#include "src/baseline/baseline.h"
+#include "src/codegen/compiler.h"
+#include "src/diagnostics/code-tracer.h"
+#include "src/execution/isolate.h"
+#include "src/execution/local-isolate.h"
+#include "src/handles/global-handles.h"
+#include "src/handles/persistent-handles.h"
+#include "src/heap/factory-inl.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/local-heap-inl.h"
+#include "src/heap/parked-scope.h"
+#include "src/init/v8.h"
+#include "src/logging/counters.h"
+#include "src/objects/fixed-array-inl.h"
+#include "src/objects/js-function-inl.h"
+#include "src/objects/shared-function-info-inl.h"
+#include "src/utils/locked-queue-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace baseline {
+
+// A single function of a batch that is compiled on a background thread.
+class BaselineCompilerTask {
+ public:
+  BaselineCompilerTask(Isolate* isolate, PersistentHandles* handles,
+                       SharedFunctionInfo shared)
+      : shared_function_info_(handles->NewHandle(shared)),
+        bytecode_(handles->NewHandle(shared.GetBytecodeArray(isolate))) {}
+
+  BaselineCompilerTask(const BaselineCompilerTask&) = delete;
+  BaselineCompilerTask& operator=(const BaselineCompilerTask&) = delete;
+  BaselineCompilerTask(BaselineCompilerTask&&) V8_NOEXCEPT = default;
+
+  // Executed on the background thread.
+  void Compile(Isolate* isolate, LocalIsolate* local_isolate) {
+    base::ElapsedTimer timer;
+    timer.Start();
+    compiler_ = std::make_unique<BaselineCompiler>(
+        isolate, shared_function_info_, bytecode_, local_isolate);
+    compiler_->GenerateCode();
+    time_taken_ = timer.Elapsed();
+  }
+
+  // Executed on the main thread.
+  void Install(Isolate* isolate) {
+    // The function may have been compiled in the meantime, or may no longer
+    // be suitable for Sparkplug (e.g. the debugger set a breakpoint, or the
+    // bytecode was flushed or replaced).
+    if (shared_function_info_->HasBaselineData()) return;
+    if (!CanCompileWithBaseline(isolate, shared_function_info_)) return;
+    if (shared_function_info_->GetBytecodeArray(isolate) != *bytecode_) return;
+
+    base::ElapsedTimer timer;
+    timer.Start();
+    Handle<Code> code;
+    // This can only fail because of an OOM, in which case the function just
+    // stays interpreted.
+    if (!compiler_->Build(isolate).ToHandle(&code)) return;
+    time_taken_ += timer.Elapsed();
+    Compiler::InstallBaselineCode(isolate, shared_function_info_, code,
+                                  time_taken_.InMillisecondsF());
+  }
+
+ private:
+  Handle<SharedFunctionInfo> shared_function_info_;
+  Handle<BytecodeArray> bytecode_;
+  std::unique_ptr<BaselineCompiler> compiler_;
+  base::TimeDelta time_taken_;
+};
+
+// A batch of functions that is compiled on a background thread. The handles
+// of the batch are persistent, so that they can be passed between threads.
+class BaselineBatchCompilerJob {
+ public:
+  BaselineBatchCompilerJob(Isolate* isolate, Handle<WeakFixedArray> task_queue,
+                           int batch_size)
+      : isolate_(isolate), handles_(isolate->NewPersistentHandles()) {
+    tasks_.reserve(batch_size);
+    for (int i = 0; i < batch_size; i++) {
+      MaybeObject maybe_sfi = task_queue->Get(i);
+      // The queue is reused for the next batch.
+      task_queue->Set(i, HeapObjectReference::ClearedValue(isolate));
+      HeapObject obj;
+      // Skip functions where the weak reference is no longer valid.
+      if (!maybe_sfi.GetHeapObjectIfWeak(&obj)) continue;
+      SharedFunctionInfo shared = SharedFunctionInfo::cast(obj);
+      // Skip functions where the bytecode has been flushed, or which were
+      // compiled in the meantime.
+      if (!shared.HasBytecodeArray() || shared.HasBaselineData()) continue;
+      tasks_.emplace_back(isolate, handles_.get(), shared);
+    }
+  }
+
+  BaselineBatchCompilerJob(const BaselineBatchCompilerJob&) = delete;
+  BaselineBatchCompilerJob& operator=(const BaselineBatchCompilerJob&) =
+      delete;
+
+  // Executed on the background thread.
+  void Compile(LocalIsolate* local_isolate) {
+    local_isolate->heap()->AttachPersistentHandles(std::move(handles_));
+    for (auto& task : tasks_) {
+      LocalHandleScope handle_scope(local_isolate);
+      task.Compile(isolate_, local_isolate);
+      local_isolate->heap()->Safepoint();
+    }
+    // Take the handles back, they are needed to install the code.
+    handles_ = local_isolate->heap()->DetachPersistentHandles();
+  }
+
+  // Executed on the main thread.
+  void Install(Isolate* isolate) {
+    HandleScope scope(isolate);
+    // Since the whole batch is installed at once, this makes sure we only
+    // switch the code pages between writable and executable once.
+    CodePageCollectionMemoryModificationScope batch_allocation(
+        isolate->heap());
+    for (auto& task : tasks_) {
+      task.Install(isolate);
+    }
+  }
+
+  bool is_empty() const { return tasks_.empty(); }
+
+ private:
+  Isolate* isolate_;
+  std::unique_ptr<PersistentHandles> handles_;
+  std::vector<BaselineCompilerTask> tasks_;
+};
+
+class ConcurrentBaselineCompiler {
+ public:
+  class JobDispatcher final : public v8::JobTask {
+   public:
+    JobDispatcher(
+        Isolate* isolate, ConcurrentBaselineCompiler* compiler,
+        LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>>* incoming_queue,
+        LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>>* outgoing_queue)
+        : isolate_(isolate),
+          compiler_(compiler),
+          incoming_queue_(incoming_queue),
+          outgoing_queue_(outgoing_queue) {}
+
+    void Run(JobDelegate* delegate) override {
+      LocalIsolate local_isolate(isolate_, ThreadKind::kBackground);
+      UnparkedScope unparked_scope(&local_isolate);
+      while (!incoming_queue_->IsEmpty() && !delegate->ShouldYield()) {
+        std::unique_ptr<BaselineBatchCompilerJob> job;
+        if (!incoming_queue_->Dequeue(&job)) break;
+        DCHECK_NOT_NULL(job);
+        job->Compile(&local_isolate);
+        outgoing_queue_->Enqueue(std::move(job));
+        isolate_->stack_guard()->RequestInstallBaselineCode();
+        compiler_->JobCompiled();
+      }
+    }
+
+    size_t GetMaxConcurrency(size_t worker_count) const override {
+      return worker_count + (incoming_queue_->IsEmpty() ? 0 : 1);
+    }
+
+   private:
+    Isolate* isolate_;
+    ConcurrentBaselineCompiler* compiler_;
+    LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>>* incoming_queue_;
+    LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>>* outgoing_queue_;
+  };
+
+  explicit ConcurrentBaselineCompiler(Isolate* isolate) : isolate_(isolate) {
+    DCHECK(FLAG_concurrent_sparkplug);
+    job_handle_ = V8::GetCurrentPlatform()->PostJob(
+        TaskPriority::kUserVisible,
+        std::make_unique<JobDispatcher>(isolate_, this, &incoming_queue_,
+                                        &outgoing_queue_));
+  }
+
+  ~ConcurrentBaselineCompiler() {
+    if (job_handle_ && job_handle_->IsValid()) {
+      // Wait for the job handle to complete, so that we know the queue
+      // pointers are safe.
+      job_handle_->Cancel();
+    }
+  }
+
+  void CompileBatch(Handle<WeakFixedArray> task_queue, int batch_size) {
+    DCHECK(FLAG_concurrent_sparkplug);
+    RuntimeCallTimerScope runtime_timer(
+        isolate_, RuntimeCallCounterId::kCompileBaseline);
+    auto job = std::make_unique<BaselineBatchCompilerJob>(isolate_, task_queue,
+                                                          batch_size);
+    if (job->is_empty()) return;
+    {
+      base::MutexGuard guard(&pending_jobs_mutex_);
+      pending_jobs_++;
+    }
+    incoming_queue_.Enqueue(std::move(job));
+    job_handle_->NotifyConcurrencyIncrease();
+  }
+
+  // Executed on the background thread, once a job is in the outgoing queue.
+  void JobCompiled() {
+    base::MutexGuard guard(&pending_jobs_mutex_);
+    DCHECK_LT(0, pending_jobs_);
+    if (--pending_jobs_ == 0) pending_jobs_cv_.NotifyAll();
+  }
+
+  void AwaitJobs() {
+    // The background thread may need a safepoint while compiling.
+    ParkedScope parked(isolate_->main_thread_local_isolate());
+    base::MutexGuard guard(&pending_jobs_mutex_);
+    while (pending_jobs_ > 0) pending_jobs_cv_.Wait(&pending_jobs_mutex_);
+  }
+
+  void InstallBatch() {
+    while (!outgoing_queue_.IsEmpty()) {
+      std::unique_ptr<BaselineBatchCompilerJob> job;
+      if (!outgoing_queue_.Dequeue(&job)) break;
+      job->Install(isolate_);
+    }
+  }
+
+ private:
+  Isolate* isolate_;
+  std::unique_ptr<JobHandle> job_handle_;
+  LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>> incoming_queue_;
+  LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>> outgoing_queue_;
+  // Number of jobs in the incoming queue or being compiled.
+  base::Mutex pending_jobs_mutex_;
+  base::ConditionVariable pending_jobs_cv_;
+  int pending_jobs_ = 0;
+};
+
+BaselineBatchCompiler::BaselineBatchCompiler(Isolate* isolate)
+    : isolate_(isolate),
+      compilation_queue_(Handle<WeakFixedArray>::null()),
+      last_index_(0),
+      estimated_instruction_size_(0),
+      enabled_(FLAG_baseline_batch_compilation) {
+  if (FLAG_concurrent_sparkplug) {
+    concurrent_compiler_ =
+        std::make_unique<ConcurrentBaselineCompiler>(isolate_);
+  }
+}
+
+BaselineBatchCompiler::~BaselineBatchCompiler() {
+  // Stop the background compiler first, it may still hold handles.
+  concurrent_compiler_.reset();
+  if (!compilation_queue_.is_null()) {
+    GlobalHandles::Destroy(compilation_queue_.location());
+    compilation_queue_ = Handle<WeakFixedArray>::null();
+  }
+}
+
+void BaselineBatchCompiler::EnqueueFunction(Handle<JSFunction> function) {
+  Handle<SharedFunctionInfo> shared(function->shared(), isolate_);
+  // Early return if the function is compiled with baseline already or it is
+  // not suitable for baseline compilation.
+  if (shared->HasBaselineData()) return;
+  if (!CanCompileWithBaseline(isolate_, shared)) return;
+
+  // Immediately compile the function if batch compilation is disabled.
+  if (!is_enabled()) {
+    IsCompiledScope is_compiled_scope(
+        function->shared().is_compiled_scope(isolate_));
+    Compiler::CompileBaseline(isolate_, function, Compiler::CLEAR_EXCEPTION,
+                              &is_compiled_scope);
+    return;
+  }
+
+  int estimated_size;
+  {
+    DisallowGarbageCollection no_gc;
+    estimated_size = BaselineCompiler::EstimateInstructionSize(
+        shared->GetBytecodeArray(isolate_));
+  }
+  estimated_instruction_size_ += estimated_size;
+  if (FLAG_trace_baseline_batch_compilation) {
+    CodeTracer::Scope trace_scope(isolate_->GetCodeTracer());
+    PrintF(trace_scope.file(),
+           "[Baseline batch compilation] Enqueued function ");
+    function->PrintName(trace_scope.file());
+    PrintF(trace_scope.file(),
+           " with estimated size %d (current budget: %d/%d)\n", estimated_size,
+           estimated_instruction_size_,
+           FLAG_baseline_batch_compilation_threshold);
+  }
+  if (ShouldCompileBatch()) {
+    if (FLAG_trace_baseline_batch_compilation) {
+      CodeTracer::Scope trace_scope(isolate_->GetCodeTracer());
+      PrintF(trace_scope.file(),
+             "[Baseline batch compilation] Compiling current batch of %d "
+             "functions%s\n",
+             last_index_ + 1, concurrent_compiler_ ? " concurrently" : "");
+    }
+    if (concurrent_compiler_) {
+      Enqueue(shared);
+      concurrent_compiler_->CompileBatch(compilation_queue_, last_index_);
+      ClearBatch();
+    } else {
+      CompileBatch(function);
+    }
+  } else {
+    Enqueue(shared);
+  }
+}
+
+void BaselineBatchCompiler::Enqueue(Handle<SharedFunctionInfo> shared) {
+  if (compilation_queue_.is_null()) {
+    Handle<WeakFixedArray> queue = isolate_->factory()->NewWeakFixedArray(
+        kInitialQueueSize, AllocationType::kOld);
+    compilation_queue_ = isolate_->global_handles()->Create(*queue);
+  } else if (last_index_ >= compilation_queue_->length()) {
+    Handle<WeakFixedArray> new_queue =
+        isolate_->factory()->CopyWeakFixedArrayAndGrow(compilation_queue_,
+                                                       last_index_);
+    GlobalHandles::Destroy(compilation_queue_.location());
+    compilation_queue_ = isolate_->global_handles()->Create(*new_queue);
+  }
+  compilation_queue_->Set(last_index_++, HeapObjectReference::Weak(*shared));
+}
+
+void BaselineBatchCompiler::InstallBatch() {
+  if (concurrent_compiler_) concurrent_compiler_->InstallBatch();
+}
+
+void BaselineBatchCompiler::CompileBatch(Handle<JSFunction> function) {
+  RuntimeCallTimerScope runtime_timer(isolate_,
+                                      RuntimeCallCounterId::kCompileBaseline);
+  // Since the whole batch is compiled at once, this makes sure we only switch
+  // the code pages between writable and executable once.
+  CodePageCollectionMemoryModificationScope batch_allocation(isolate_->heap());
+  {
+    IsCompiledScope is_compiled_scope(
+        function->shared().is_compiled_scope(isolate_));
+    Compiler::CompileBaseline(isolate_, function, Compiler::CLEAR_EXCEPTION,
+                              &is_compiled_scope);
+  }
+  CompileQueuedFunctions();
+}
+
+void BaselineBatchCompiler::CompileQueuedFunctions() {
+  for (int i = 0; i < last_index_; i++) {
+    MaybeObject maybe_sfi = compilation_queue_->Get(i);
+    MaybeCompileFunction(maybe_sfi);
+    compilation_queue_->Set(i, HeapObjectReference::ClearedValue(isolate_));
+  }
+  ClearBatch();
+}
+
+void BaselineBatchCompiler::CompileBatchForTesting() {
+  if (last_index_ == 0) return;
+  if (concurrent_compiler_) {
+    concurrent_compiler_->CompileBatch(compilation_queue_, last_index_);
+    ClearBatch();
+    return;
+  }
+  RuntimeCallTimerScope runtime_timer(isolate_,
+                                      RuntimeCallCounterId::kCompileBaseline);
+  CodePageCollectionMemoryModificationScope batch_allocation(isolate_->heap());
+  CompileQueuedFunctions();
+}
+
+void BaselineBatchCompiler::AwaitAndInstallBatchesForTesting() {
+  if (!concurrent_compiler_) return;
+  concurrent_compiler_->AwaitJobs();
+  concurrent_compiler_->InstallBatch();
+}
+
+bool BaselineBatchCompiler::ShouldCompileBatch() const {
+  return estimated_instruction_size_ >=
+         FLAG_baseline_batch_compilation_threshold;
+}
+
+bool BaselineBatchCompiler::MaybeCompileFunction(MaybeObject maybe_sfi) {
+  HeapObject heapobj;
+  // Skip functions where the weak reference is no longer valid.
+  if (!maybe_sfi.GetHeapObjectIfWeak(&heapobj)) return false;
+  Handle<SharedFunctionInfo> shared =
+      handle(SharedFunctionInfo::cast(heapobj), isolate_);
+  // Skip functions where the bytecode has been flushed.
+  if (!shared->is_compiled()) return false;
+
+  IsCompiledScope is_compiled_scope(shared->is_compiled_scope(isolate_));
+  return Compiler::CompileSharedWithBaseline(
+      isolate_, shared, Compiler::CLEAR_EXCEPTION, &is_compiled_scope);
+}
+
+void BaselineBatchCompiler::ClearBatch() {
+  estimated_instruction_size_ = 0;
+  last_index_ = 0;
+}
+
+}  // namespace baseline
+}  // namespace internal
+}  // namespace v8
+
+#else
+
+namespace v8 {
+namespace internal {
+namespace baseline {
+
+class ConcurrentBaselineCompiler {};
+
+BaselineBatchCompiler::BaselineBatchCompiler(Isolate* isolate)
+    : isolate_(isolate),
+      compilation_queue_(Handle<WeakFixedArray>::null()),
+      last_index_(0),
+      estimated_instruction_size_(0),
+      enabled_(false) {}
+
+BaselineBatchCompiler::~BaselineBatchCompiler() = default;
+
+void BaselineBatchCompiler::EnqueueFunction(Handle<JSFunction> function) {
+  UNREACHABLE();
+}
+
+void BaselineBatchCompiler::InstallBatch() { UNREACHABLE(); }
+
+void BaselineBatchCompiler::CompileBatchForTesting() { UNREACHABLE(); }
+
+void BaselineBatchCompiler::AwaitAndInstallBatchesForTesting() {
+  UNREACHABLE();
+}
+
+}  // namespace baseline
+}  // namespace internal
+}  // namespace v8
+
+#endif
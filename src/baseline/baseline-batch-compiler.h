@@ -0,0 +1,104 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_BASELINE_BASELINE_BATCH_COMPILER_H_
+#define V8_BASELINE_BASELINE_BATCH_COMPILER_H_
+
+#include <memory>
+
+#include "src/handles/handles.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class JSFunction;
+class MaybeObject;
+class SharedFunctionInfo;
+class WeakFixedArray;
+
+namespace baseline {
+
+class ConcurrentBaselineCompiler;
+
+// Collects functions whose interrupt budget ran out and compiles them with
+// Sparkplug in batches, once the estimated size of the generated code
+// exceeds --baseline-batch-compilation-threshold. With --concurrent-sparkplug
+// the machine code of a batch is generated on a background thread, and only
+// the code objects are allocated and installed on the main thread.
+class BaselineBatchCompiler {
+ public:
+  static const int kInitialQueueSize = 32;
+
+  explicit BaselineBatchCompiler(Isolate* isolate);
+  ~BaselineBatchCompiler();
+
+  BaselineBatchCompiler(const BaselineBatchCompiler&) = delete;
+  BaselineBatchCompiler& operator=(const BaselineBatchCompiler&) = delete;
+
+  // Enqueues the SharedFunctionInfo of {function} for compilation.
+  void EnqueueFunction(Handle<JSFunction> function);
+
+  void set_enabled(bool enabled) { enabled_ = enabled; }
+  bool is_enabled() const { return enabled_; }
+
+  // Installs the code of batches that were compiled on a background thread.
+  // Called from the INSTALL_BASELINE_CODE interrupt.
+  void InstallBatch();
+
+  // Compiles the current batch regardless of its estimated size. With
+  // --concurrent-sparkplug the batch is handed to the background thread.
+  void CompileBatchForTesting();
+
+  // Waits until the batches handed to the background thread are compiled, and
+  // installs their code.
+  void AwaitAndInstallBatchesForTesting();
+
+ private:
+  // Adds {shared} to the current batch, growing the queue if necessary.
+  void Enqueue(Handle<SharedFunctionInfo> shared);
+
+  // Returns true if the current batch exceeds the threshold and should be
+  // compiled.
+  bool ShouldCompileBatch() const;
+
+  // Compiles the current batch on the main thread, together with {function}
+  // which triggered it.
+  void CompileBatch(Handle<JSFunction> function);
+
+  // Compiles the functions of the current batch on the main thread.
+  void CompileQueuedFunctions();
+
+  // Resets the current batch.
+  void ClearBatch();
+
+  // Tries to compile {maybe_sfi}. Returns false if compilation was not
+  // possible (e.g. the function was collected or its bytecode was flushed).
+  bool MaybeCompileFunction(MaybeObject maybe_sfi);
+
+  Isolate* isolate_;
+
+  // Global handle to the shared function infos enqueued in the current batch,
+  // held weakly.
+  Handle<WeakFixedArray> compilation_queue_;
+
+  // Number of entries used in {compilation_queue_}.
+  int last_index_;
+
+  // Estimated instruction size of the current batch.
+  int estimated_instruction_size_;
+
+  // Whether batch compilation is enabled. If not, functions are compiled
+  // right away when they are enqueued.
+  bool enabled_;
+
+  // Only present with --concurrent-sparkplug.
+  std::unique_ptr<ConcurrentBaselineCompiler> concurrent_compiler_;
+};
+
+}  // namespace baseline
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_BASELINE_BASELINE_BATCH_COMPILER_H_
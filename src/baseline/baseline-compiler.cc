@@ -24,6 +24,7 @@
 #include "src/codegen/macro-assembler-inl.h"
 #include "src/common/globals.h"
 #include "src/execution/frame-constants.h"
+#include "src/execution/local-isolate.h"
 #include "src/interpreter/bytecode-array-iterator.h"
 #include "src/interpreter/bytecode-flags.h"
 #include "src/objects/code.h"
@@ -227,14 +228,15 @@ void MoveArgumentsForDescriptor(BaselineAssembler* masm,
 
 BaselineCompiler::BaselineCompiler(
     Isolate* isolate, Handle<SharedFunctionInfo> shared_function_info,
-    Handle<BytecodeArray> bytecode)
+    Handle<BytecodeArray> bytecode, LocalIsolate* local_isolate)
     : isolate_(isolate),
-      stats_(isolate->counters()->runtime_call_stats()),
+      local_isolate_(local_isolate),
+      stats_(local_isolate ? local_isolate->runtime_call_stats()
+                           : isolate->counters()->runtime_call_stats()),
       shared_function_info_(shared_function_info),
       bytecode_(bytecode),
       masm_(isolate, CodeObjectRequired::kNo),
       basm_(&masm_),
-      iterator_(bytecode_),
       zone_(isolate->allocator(), ZONE_NAME),
       labels_(zone_.NewArray<BaselineLabels*>(bytecode_->length())),
       next_handler_offset_(nullptr) {
@@ -244,6 +246,7 @@ BaselineCompiler::BaselineCompiler(
 #define __ basm_.
 
 void BaselineCompiler::GenerateCode() {
+  iterator_.emplace(bytecode_);
   HandlerTable table(*bytecode_);
   {
     // Handler offsets are stored in a sorted array, terminated with kMaxInt.
@@ -265,10 +268,10 @@ void BaselineCompiler::GenerateCode() {
   {
     RuntimeCallTimerScope runtimeTimer(
         stats_, RuntimeCallCounterId::kCompileBaselinePreVisit);
-    for (; !iterator_.done(); iterator_.Advance()) {
+    for (; !iterator_->done(); iterator_->Advance()) {
       PreVisitSingleBytecode();
     }
-    iterator_.Reset();
+    iterator_->Reset();
   }
 
   // No code generated yet.
@@ -280,11 +283,12 @@ void BaselineCompiler::GenerateCode() {
         stats_, RuntimeCallCounterId::kCompileBaselineVisit);
     Prologue();
     AddPosition();
-    for (; !iterator_.done(); iterator_.Advance()) {
+    for (; !iterator_->done(); iterator_->Advance()) {
       VisitSingleBytecode();
       AddPosition();
     }
   }
+  iterator_.reset();
 }
 
 MaybeHandle<Code> BaselineCompiler::Build(Isolate* isolate) {
@@ -298,6 +302,11 @@ MaybeHandle<Code> BaselineCompiler::Build(Isolate* isolate) {
       .TryBuild();
 }
 
+// static
+int BaselineCompiler::EstimateInstructionSize(BytecodeArray bytecode) {
+  return bytecode.length() * kAverageBytecodeToInstructionRatio;
+}
+
 interpreter::Register BaselineCompiler::RegisterOperand(int operand_index) {
   return iterator().GetRegisterOperand(operand_index);
 }
@@ -319,6 +328,12 @@ void BaselineCompiler::StoreRegisterPair(int operand_index, Register val0,
 }
 template <typename Type>
 Handle<Type> BaselineCompiler::Constant(int operand_index) {
+  if (local_isolate_ != nullptr) {
+    // The generated code refers to its constants through handles, which have
+    // to stay valid until the code is built.
+    return Handle<Type>::cast(local_isolate_->heap()->NewPersistentHandle(
+        iterator().GetConstantForIndexOperand(operand_index, local_isolate_)));
+  }
   return Handle<Type>::cast(
       iterator().GetConstantForIndexOperand(operand_index, isolate_));
 }
@@ -11,6 +11,7 @@
     V8_TARGET_ARCH_ARM
 
 #include "src/base/logging.h"
+#include "src/base/optional.h"
 #include "src/base/threaded-list.h"
 #include "src/base/vlq.h"
 #include "src/baseline/baseline-assembler.h"
@@ -26,6 +27,7 @@ namespace v8 {
 namespace internal {
 
 class BytecodeArray;
+class LocalIsolate;
 
 namespace baseline {
 
@@ -49,14 +51,24 @@ class BytecodeOffsetTableBuilder {
 
 class BaselineCompiler {
  public:
+  // If {local_isolate} is given, GenerateCode() may run on that
+  // LocalIsolate's thread. The handles passed in must then be persistent, and
+  // constants are loaded into persistent handles so that Build() can run on
+  // the main thread afterwards.
   explicit BaselineCompiler(Isolate* isolate,
                             Handle<SharedFunctionInfo> shared_function_info,
-                            Handle<BytecodeArray> bytecode);
+                            Handle<BytecodeArray> bytecode,
+                            LocalIsolate* local_isolate = nullptr);
 
   void GenerateCode();
   MaybeHandle<Code> Build(Isolate* isolate);
+  static int EstimateInstructionSize(BytecodeArray bytecode);
 
  private:
+  // Rough number of bytes of machine code per byte of bytecode, used to
+  // estimate the size of the generated code before compiling.
+  static constexpr int kAverageBytecodeToInstructionRatio = 7;
+
   void Prologue();
   void PrologueFillFrame();
   void PrologueHandleOptimizationState(Register feedback_vector);
@@ -162,15 +174,18 @@ class BaselineCompiler {
   INTRINSICS_LIST(DECLARE_VISITOR)
 #undef DECLARE_VISITOR
 
-  const interpreter::BytecodeArrayIterator& iterator() { return iterator_; }
+  const interpreter::BytecodeArrayIterator& iterator() { return *iterator_; }
 
   Isolate* isolate_;
+  LocalIsolate* local_isolate_;
   RuntimeCallStats* stats_;
   Handle<SharedFunctionInfo> shared_function_info_;
   Handle<BytecodeArray> bytecode_;
   MacroAssembler masm_;
   BaselineAssembler basm_;
-  interpreter::BytecodeArrayIterator iterator_;
+  // Only alive during GenerateCode(), since it is tied to the current
+  // thread's LocalHeap.
+  base::Optional<interpreter::BytecodeArrayIterator> iterator_;
   BytecodeOffsetTableBuilder bytecode_offset_table_builder_;
   Zone zone_;
 
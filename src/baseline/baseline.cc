@@ -4,6 +4,37 @@
 
 #include "src/baseline/baseline.h"
 
+#include "src/debug/debug.h"
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
+#include "src/objects/shared-function-info-inl.h"
+
+namespace v8 {
+namespace internal {
+
+bool CanCompileWithBaseline(Isolate* isolate,
+                            Handle<SharedFunctionInfo> shared) {
+  // Check if we actually have bytecode.
+  if (!shared->HasBytecodeArray()) return false;
+
+  // Do not optimize when debugger needs to hook into every call.
+  if (isolate->debug()->needs_check_on_function_call()) return false;
+
+  // Functions with breakpoints have to stay interpreted.
+  if (shared->HasBreakInfo()) return false;
+
+  // Do not baseline compile if sparkplug is disabled or function doesn't pass
+  // sparkplug_filter.
+  if (!FLAG_sparkplug || !shared->PassesFilter(FLAG_sparkplug_filter)) {
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace internal
+}  // namespace v8
+
 // TODO(v8:11421): Remove #if once baseline compiler is ported to other
 // architectures.
 #if V8_TARGET_ARCH_IA32 || V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_ARM64 || \
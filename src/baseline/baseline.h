@@ -14,6 +14,9 @@ class Code;
 class SharedFunctionInfo;
 class MacroAssembler;
 
+bool CanCompileWithBaseline(Isolate* isolate,
+                            Handle<SharedFunctionInfo> shared);
+
 MaybeHandle<Code> GenerateBaselineCode(Isolate* isolate,
                                        Handle<SharedFunctionInfo> shared);
 
@@ -0,0 +1,171 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/bigint/bigint-internal.h"
+
+#include <utility>
+
+#include "src/bigint/div-helpers.h"
+#include "src/bigint/vector-arithmetic.h"
+
+namespace v8 {
+namespace bigint {
+
+ProcessorImpl::ProcessorImpl(Platform* platform) : platform_(platform) {}
+
+ProcessorImpl::~ProcessorImpl() { delete platform_; }
+
+Status ProcessorImpl::get_and_clear_status() {
+  Status result = status_;
+  status_ = Status::kOk;
+  return result;
+}
+
+Processor* Processor::New(Platform* platform) {
+  ProcessorImpl* impl = new ProcessorImpl(platform);
+  return static_cast<Processor*>(impl);
+}
+
+void Processor::Destroy() { delete static_cast<ProcessorImpl*>(this); }
+
+void ProcessorImpl::Multiply(RWDigits Z, Digits X, Digits Y) {
+  X.Normalize();
+  Y.Normalize();
+  if (X.len() == 0 || Y.len() == 0) return Z.Clear();
+  if (X.len() < Y.len()) std::swap(X, Y);
+  if (Y.len() == 1) return MultiplySingle(Z, X, Y[0]);
+  if (Y.len() < kKaratsubaThreshold) return MultiplySchoolbook(Z, X, Y);
+  if (Y.len() < kToomThreshold) return MultiplyKaratsuba(Z, X, Y);
+  if (Y.len() < kFftThreshold) return MultiplyToomCook(Z, X, Y);
+  return MultiplyFFT(Z, X, Y);
+}
+
+void ProcessorImpl::Divide(RWDigits Q, Digits A, Digits B) {
+  A.Normalize();
+  B.Normalize();
+  DCHECK(B.len() > 0);
+  int cmp = Compare(A, B);
+  if (cmp < 0) return Q.Clear();
+  if (cmp == 0) {
+    Q[0] = 1;
+    for (int i = 1; i < Q.len(); i++) Q[i] = 0;
+    return;
+  }
+  if (B.len() == 1) {
+    digit_t remainder;
+    return DivideSingle(Q, &remainder, A, B[0]);
+  }
+  if (B.len() < kBurnikelThreshold) {
+    return DivideSchoolbook(Q, RWDigits(nullptr, 0), A, B);
+  }
+  if (B.len() < kBarrettThreshold || A.len() == B.len()) {
+    return DivideBurnikelZiegler(Q, RWDigits(nullptr, 0), A, B);
+  }
+  return DivideBarrett(Q, RWDigits(nullptr, 0), A, B);
+}
+
+void ProcessorImpl::Modulo(RWDigits R, Digits A, Digits B) {
+  A.Normalize();
+  B.Normalize();
+  DCHECK(B.len() > 0);
+  int cmp = Compare(A, B);
+  if (cmp < 0) {
+    for (int i = 0; i < A.len(); i++) R[i] = A[i];
+    for (int i = A.len(); i < R.len(); i++) R[i] = 0;
+    return;
+  }
+  if (cmp == 0) return R.Clear();
+  if (B.len() == 1) {
+    digit_t remainder;
+    DivideSingle(RWDigits(nullptr, 0), &remainder, A, B[0]);
+    R[0] = remainder;
+    for (int i = 1; i < R.len(); i++) R[i] = 0;
+    return;
+  }
+  if (B.len() < kBurnikelThreshold) {
+    return DivideSchoolbook(RWDigits(nullptr, 0), R, A, B);
+  }
+  int q_len = DivideResultLength(A, B);
+  ScratchDigits Q(q_len);
+  if (B.len() < kBarrettThreshold || A.len() == B.len()) {
+    return DivideBurnikelZiegler(Q, R, A, B);
+  }
+  return DivideBarrett(Q, R, A, B);
+}
+
+RadixPowerCache::RadixPowerCache() = default;
+RadixPowerCache::~RadixPowerCache() = default;
+
+Digits RadixPowerCache::Get(ProcessorImpl* processor, digit_t base,
+                            int level) {
+  int index = last_used_;
+  if (entries_[index].base != base) {
+    index = 1 - index;
+    if (entries_[index].base != base) {
+      entries_[index].base = base;
+      entries_[index].powers.clear();
+    }
+  }
+  last_used_ = index;
+  std::vector<std::unique_ptr<ScratchDigits>>& powers = entries_[index].powers;
+  if (powers.empty()) {
+    std::unique_ptr<ScratchDigits> first(new ScratchDigits(1));
+    (*first)[0] = base;
+    powers.push_back(std::move(first));
+  }
+  while (static_cast<int>(powers.size()) <= level) {
+    Digits previous = *powers.back();
+    std::unique_ptr<ScratchDigits> next(new ScratchDigits(2 * previous.len()));
+    processor->Multiply(*next, previous, previous);
+    if (processor->should_terminate()) return Digits();
+    next->Normalize();
+    powers.push_back(std::move(next));
+  }
+  return *powers[level];
+}
+
+void RadixPowerCache::TrimLargeEntries() {
+  for (Entry& entry : entries_) {
+    while (!entry.powers.empty() &&
+           entry.powers.back()->len() > kMaxRetainedLength) {
+      entry.powers.pop_back();
+    }
+  }
+}
+
+Status Processor::Multiply(RWDigits Z, Digits X, Digits Y) {
+  ProcessorImpl* impl = static_cast<ProcessorImpl*>(this);
+  impl->Multiply(Z, X, Y);
+  return impl->get_and_clear_status();
+}
+
+Status Processor::Divide(RWDigits Q, Digits A, Digits B) {
+  ProcessorImpl* impl = static_cast<ProcessorImpl*>(this);
+  impl->Divide(Q, A, B);
+  return impl->get_and_clear_status();
+}
+
+Status Processor::Modulo(RWDigits R, Digits A, Digits B) {
+  ProcessorImpl* impl = static_cast<ProcessorImpl*>(this);
+  impl->Modulo(R, A, B);
+  return impl->get_and_clear_status();
+}
+
+Status Processor::ToString(char* out, int* out_length, Digits X, int radix,
+                           bool sign) {
+  ProcessorImpl* impl = static_cast<ProcessorImpl*>(this);
+  impl->ToString(out, out_length, X, radix, sign);
+  impl->TrimRadixPowers();
+  return impl->get_and_clear_status();
+}
+
+Status Processor::FromString(RWDigits Z, FromStringAccumulator* accumulator) {
+  ProcessorImpl* impl = static_cast<ProcessorImpl*>(this);
+  impl->FromString(Z, accumulator);
+  impl->TrimRadixPowers();
+  return impl->get_and_clear_status();
+}
+
+}  // namespace bigint
+}  // namespace v8
@@ -0,0 +1,173 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_BIGINT_BIGINT_INTERNAL_H_
+#define V8_BIGINT_BIGINT_INTERNAL_H_
+
+#include <memory>
+#include <vector>
+
+#include "src/bigint/bigint.h"
+
+namespace v8 {
+namespace bigint {
+
+// Algorithm selection thresholds, in digits. They have been determined
+// experimentally on x64; the algorithms are correct for any input size,
+// these values only affect performance.
+constexpr int kKaratsubaThreshold = 34;
+constexpr int kToomThreshold = 193;
+constexpr int kFftThreshold = 1500;
+constexpr int kBurnikelThreshold = 57;
+constexpr int kNewtonInversionThreshold = 50;
+constexpr int kBarrettThreshold = 13310;
+constexpr int kToStringFastThreshold = 43;
+constexpr int kFromStringLargeThreshold = 50;
+
+class ProcessorImpl;
+class ScratchDigits;
+
+// Caches the powers base^(2^i), i = 0, 1, 2, ..., for up to two different
+// bases, as needed by the divide-and-conquer string conversion algorithms.
+// Repeated conversions (typically all using radix 10) thereby only pay for
+// computing the powers once.
+class RadixPowerCache {
+ public:
+  RadixPowerCache();
+  ~RadixPowerCache();
+
+  // Returns base^(2^level). The result remains valid until the next call
+  // to {TrimLargeEntries}, or until powers of two other bases have been
+  // requested. If the computation was interrupted, the result is empty.
+  Digits Get(ProcessorImpl* processor, digit_t base, int level);
+
+  // Frees any powers longer than {kMaxRetainedLength} digits, so that
+  // conversions of huge numbers don't keep their memory alive indefinitely.
+  void TrimLargeEntries();
+
+ private:
+  static constexpr int kMaxRetainedLength = 1 << 14;
+
+  struct Entry {
+    digit_t base{0};
+    std::vector<std::unique_ptr<ScratchDigits>> powers;
+  };
+
+  Entry entries_[2];
+  // Index of the most recently used entry.
+  int last_used_{0};
+};
+
+class ProcessorImpl : public Processor {
+ public:
+  explicit ProcessorImpl(Platform* platform);
+  ~ProcessorImpl();
+
+  Status get_and_clear_status();
+
+  void Multiply(RWDigits Z, Digits X, Digits Y);
+  void MultiplySingle(RWDigits Z, Digits X, digit_t y);
+  void MultiplySchoolbook(RWDigits Z, Digits X, Digits Y);
+
+  void MultiplyKaratsuba(RWDigits Z, Digits X, Digits Y);
+  void KaratsubaMain(RWDigits Z, Digits X, Digits Y, RWDigits scratch, int n);
+
+  void MultiplyToomCook(RWDigits Z, Digits X, Digits Y);
+  void Toom3Main(RWDigits Z, Digits X, Digits Y);
+
+  void MultiplyFFT(RWDigits Z, Digits X, Digits Y);
+
+  void Divide(RWDigits Q, Digits A, Digits B);
+  void DivideSingle(RWDigits Q, digit_t* remainder, Digits A, digit_t b);
+  void DivideSchoolbook(RWDigits Q, RWDigits R, Digits A, Digits B);
+  void DivideBurnikelZiegler(RWDigits Q, RWDigits R, Digits A, Digits B);
+  void DivideBarrett(RWDigits Q, RWDigits R, Digits A, Digits B);
+
+  // Z := floor((beta^(2n) - 1) / V) or slightly less, for n = V.len().
+  // See {InvertNewton} in div-barrett.cc for details.
+  void Invert(RWDigits Z, Digits V);
+  void InvertBasecase(RWDigits Z, Digits V);
+  void InvertNewton(RWDigits Z, Digits V);
+
+  void Modulo(RWDigits R, Digits A, Digits B);
+
+  void ToString(char* out, int* out_length, Digits X, int radix, bool sign);
+
+  void FromString(RWDigits Z, FromStringAccumulator* accumulator);
+  void FromStringClassic(RWDigits Z, FromStringAccumulator* accumulator);
+  void FromStringLarge(RWDigits Z, FromStringAccumulator* accumulator);
+
+  // Returns base^(2^level), see {RadixPowerCache}.
+  Digits RadixPower(digit_t base, int level) {
+    return radix_powers_.Get(this, base, level);
+  }
+  void TrimRadixPowers() { radix_powers_.TrimLargeEntries(); }
+
+  bool should_terminate() { return status_ == Status::kInterrupted; }
+
+  // Each unit is supposed to represent approximately one CPU {mul}
+  // instruction. Doesn't need to be accurate; we just want to make sure
+  // to check for interrupt requests every now and then (roughly every
+  // 10-100 ms; often enough not to appear stuck, rarely enough not to
+  // cause noticeable overhead).
+  static const uintptr_t kWorkEstimateThreshold = 5000000;
+
+  void AddWorkEstimate(uintptr_t estimate) {
+    work_estimate_ += estimate;
+    if (work_estimate_ >= kWorkEstimateThreshold) {
+      work_estimate_ = 0;
+      if (platform_->InterruptRequested()) {
+        status_ = Status::kInterrupted;
+      }
+    }
+  }
+
+ private:
+  uintptr_t work_estimate_{0};
+  Status status_{Status::kOk};
+  Platform* platform_;
+  RadixPowerCache radix_powers_;
+};
+
+#define CHECK(cond)                                   \
+  if (!(cond)) {                                      \
+    std::cerr << __FILE__ << ":" << __LINE__ << ": "; \
+    std::cerr << "Assertion failed: " #cond "\n";     \
+    abort();                                          \
+  }
+
+#ifdef DEBUG
+#define DCHECK(cond) CHECK(cond)
+#else
+#define DCHECK(cond) (void(0))
+#endif
+
+#define USE(var) ((void)var)
+
+// RAII memory for a Digits array.
+class Storage {
+ public:
+  explicit Storage(int count) : ptr_(new digit_t[count]) {}
+
+  digit_t* get() { return ptr_.get(); }
+
+ private:
+  std::unique_ptr<digit_t[]> ptr_;
+};
+
+// A writable Digits array with attached storage.
+class ScratchDigits : public RWDigits {
+ public:
+  explicit ScratchDigits(int len) : RWDigits(nullptr, len), storage_(len) {
+    digits_ = storage_.get();
+  }
+
+ private:
+  Storage storage_;
+};
+
+}  // namespace bigint
+}  // namespace v8
+
+#endif  // V8_BIGINT_BIGINT_INTERNAL_H_
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <vector>
 
 namespace v8 {
 namespace bigint {
@@ -66,6 +67,7 @@ class Digits {
         len_(std::max(0, std::min(src.len_ - offset, len))) {
     BIGINT_H_DCHECK(offset >= 0);
   }
+  Digits() : Digits(static_cast<digit_t*>(nullptr), 0) {}
   // Alternative way to get a "slice" view into another Digits object.
   Digits operator+(int i) {
     BIGINT_H_DCHECK(i >= 0 && i <= len_);
@@ -101,7 +103,7 @@ class Digits {
   const digit_t* digits() const { return digits_; }
 
  protected:
-  friend class TemporaryLeftShift;
+  friend class ShiftedDigits;
   digit_t* digits_;
   int len_;
 
@@ -120,9 +122,182 @@ class Digits {
   }
 };
 
+// Writable version of a Digits array.
+// Does not own the memory it points at.
+class RWDigits : public Digits {
+ public:
+  RWDigits(digit_t* mem, int len) : Digits(mem, len) {}
+  RWDigits(RWDigits src, int offset, int len) : Digits(src, offset, len) {}
+  RWDigits operator+(int i) {
+    BIGINT_H_DCHECK(i >= 0 && i <= len_);
+    return RWDigits(digits_ + i, len_ - i);
+  }
+
+#if UINTPTR_MAX == 0xFFFFFFFF
+  digit_t& operator[](int i) {
+    BIGINT_H_DCHECK(i >= 0 && i < len_);
+    return digits_[i];
+  }
+#else
+  // 64-bit platform. We only require digits arrays to be 4-byte aligned,
+  // so we use a wrapper class to allow regular array syntax while
+  // performing unaligned memory accesses under the hood.
+  class WritableDigitReference {
+   public:
+    // Support "X[i] = x" notation.
+    void operator=(digit_t digit) { memcpy(ptr_, &digit, sizeof(digit)); }
+    // Support "X[i] = Y[j]" notation.
+    WritableDigitReference& operator=(const WritableDigitReference& src) {
+      memcpy(ptr_, src.ptr_, sizeof(digit_t));
+      return *this;
+    }
+    // Support "x = X[i]" notation.
+    operator digit_t() {
+      digit_t result;
+      memcpy(&result, ptr_, sizeof(result));
+      return result;
+    }
+
+   private:
+    // This class is not for public consumption.
+    friend class RWDigits;
+    // Primary constructor.
+    explicit WritableDigitReference(digit_t* ptr)
+        : ptr_(reinterpret_cast<uint32_t*>(ptr)) {}
+    // Required for returning WDR instances from "operator[]" below.
+    WritableDigitReference(const WritableDigitReference& src) = default;
+
+    uint32_t* ptr_;
+  };
+
+  WritableDigitReference operator[](int i) {
+    BIGINT_H_DCHECK(i >= 0 && i < len_);
+    return WritableDigitReference(digits_ + i);
+  }
+#endif
+
+  digit_t* digits() { return digits_; }
+  void set_len(int len) { len_ = len; }
+
+  void Clear() { memset(digits_, 0, len_ * sizeof(digit_t)); }
+};
+
+class Platform {
+ public:
+  virtual ~Platform() = default;
+
+  // If you want the ability to interrupt long-running operations, implement
+  // a Platform subclass that overrides this method. It will be queried
+  // every now and then by long-running operations.
+  virtual bool InterruptRequested() { return false; }
+};
+
+// These are the operations that this library supports.
+// The signatures follow the convention:
+//
+//   void Operation(RWDigits results, Digits inputs);
+//
+// You must preallocate the result; use the respective {OperationResultLength}
+// function to determine its minimum required length. The actual result may
+// be smaller, so you should call result.Normalize() on the result.
+//
+// The operations are divided into two groups: "fast" (O(n) with small
+// coefficient) operations are exposed directly as free functions, "slow"
+// operations are methods on a {Processor} object, which provides
+// support for interrupting execution via the {Platform}'s {InterruptRequested}
+// mechanism when it takes too long. These functions return a {Status} value.
+
 // Returns r such that r < 0 if A < B; r > 0 if A > B; r == 0 if A == B.
 int Compare(Digits A, Digits B);
 
+enum class Status { kOk, kInterrupted };
+
+class FromStringAccumulator;
+
+class Processor {
+ public:
+  // Takes ownership of {platform}.
+  static Processor* New(Platform* platform);
+
+  // Use this for any std::unique_ptr holding an instance of {Processor}.
+  class Destroyer {
+   public:
+    void operator()(Processor* proc) { proc->Destroy(); }
+  };
+  // When not using std::unique_ptr, call this to delete the instance.
+  void Destroy();
+
+  // Z := X * Y
+  Status Multiply(RWDigits Z, Digits X, Digits Y);
+  // Q := A / B
+  Status Divide(RWDigits Q, Digits A, Digits B);
+  // R := A % B
+  Status Modulo(RWDigits R, Digits A, Digits B);
+
+  // {out_length} initially contains the allocated capacity of {out}, and
+  // upon return will be set to the actual length of the result string.
+  Status ToString(char* out, int* out_length, Digits X, int radix, bool sign);
+
+  // Z := the contents of {accumulator}.
+  // Assume that this leaves {accumulator} in unusable state.
+  Status FromString(RWDigits Z, FromStringAccumulator* accumulator);
+};
+
+inline int MultiplyResultLength(Digits X, Digits Y) {
+  return X.len() + Y.len();
+}
+inline int DivideResultLength(Digits A, Digits B) {
+  return A.len() - B.len() + 1;
+}
+inline int ModuloResultLength(Digits B) { return B.len(); }
+
+int ToStringResultLength(Digits X, int radix, bool sign);
+
+// Collects the chunks of a string-to-BigInt conversion. The caller parses
+// the string and feeds the numeric values of consecutive groups of
+// characters (most significant first) into {AddPart}; {Processor::FromString}
+// then combines them into the final result. Doing that in a separate step
+// allows the combination to use a divide-and-conquer algorithm, which is
+// much faster than repeated multiply-adds for long inputs.
+class FromStringAccumulator {
+ public:
+  // Adds the next chunk of characters: {part} is their numeric value, and
+  // {multiplier} is the radix raised to the number of characters in the chunk.
+  // All calls except the last one must use the same {multiplier}.
+  void AddPart(digit_t multiplier, digit_t part) {
+    BIGINT_H_DCHECK(part < multiplier);
+    if (multiplier != incoming_multiplier_) {
+      incoming_multiplier_ = multiplier;
+      combine_limit_ = ~digit_t{0} / multiplier;
+    }
+    if (current_multiplier_ <= combine_limit_) {
+      current_multiplier_ *= multiplier;
+      current_part_ = current_part_ * multiplier + part;
+      return;
+    }
+    BIGINT_H_DCHECK(parts_.empty() || parts_multiplier_ == current_multiplier_);
+    parts_multiplier_ = current_multiplier_;
+    parts_.push_back(current_part_);
+    current_multiplier_ = multiplier;
+    current_part_ = part;
+  }
+
+ private:
+  friend class ProcessorImpl;
+
+  // Completed digit-sized parts, most significant first. They all have the
+  // same multiplier, {parts_multiplier_}.
+  std::vector<digit_t> parts_;
+  digit_t parts_multiplier_{0};
+  // The part that's currently being assembled; will be the least
+  // significant one when the input ends.
+  digit_t current_part_{0};
+  digit_t current_multiplier_{1};
+  // Cache for {AddPart}'s overflow check.
+  digit_t incoming_multiplier_{0};
+  digit_t combine_limit_{0};
+};
+
 }  // namespace bigint
 }  // namespace v8
 
@@ -0,0 +1,206 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Barrett division, finding the inverse with Newton's method.
+// Reference: "Fast Division of Large Integers" by Karl Hasselström,
+// found at https://treskal.com/s/masters-thesis.pdf
+
+// Many thanks to Karl Wiberg, k@w5.se, for both writing up an
+// understandable theoretical description of the algorithm and privately
+// providing a demo implementation, on which the implementation in this file is
+// based.
+
+#include <algorithm>
+
+#include "src/bigint/bigint-internal.h"
+#include "src/bigint/digit-arithmetic.h"
+#include "src/bigint/div-helpers.h"
+#include "src/bigint/vector-arithmetic.h"
+
+namespace v8 {
+namespace bigint {
+
+namespace {
+
+void SubtractOne(RWDigits Z) {
+  digit_t one = 1;
+  digit_t borrow = SubAndReturnBorrow(Z, Digits(&one, 1));
+  DCHECK(borrow == 0);  // NOLINT(readability/check)
+  USE(borrow);
+}
+
+void AddOne(RWDigits Z) {
+  digit_t one = 1;
+  digit_t carry = AddAndReturnOverflow(Z, Digits(&one, 1));
+  DCHECK(carry == 0);  // NOLINT(readability/check)
+  USE(carry);
+}
+
+}  // namespace
+
+// Z := floor((beta^(2n) - 1) / V), for n = V.len(), via naive division.
+void ProcessorImpl::InvertBasecase(RWDigits Z, Digits V) {
+  DCHECK(Z.len() > V.len());
+  DCHECK(V.len() > 0);
+  int n = V.len();
+  ScratchDigits X(2 * n);
+  for (int i = 0; i < 2 * n; i++) X[i] = ~digit_t{0};
+  RWDigits R(nullptr, 0);  // We don't need the remainder.
+  if (n < kBurnikelThreshold) {
+    DivideSchoolbook(Z, R, X, V);
+  } else {
+    DivideBurnikelZiegler(Z, R, X, V);
+  }
+}
+
+// This is Algorithm 3.5 "ApproximateReciprocal" from "Modern Computer
+// Arithmetic" by Richard Brent and Paul Zimmermann, found at
+// https://members.loria.fr/PZimmermann/mca/mca-cup-0.5.9.pdf
+// For a bit-normalized V with n digits, computes an X with n + 1 digits
+// (the top one of which is always 1) such that
+//   V * X < beta^(2n) <= V * (X + 2),
+// i.e. X is the truncated value of beta^(2n) / V, or at most 2 less.
+// Barrett's division algorithm can handle that, so we don't care.
+void ProcessorImpl::InvertNewton(RWDigits Z, Digits V) {
+  const int n = V.len();
+  DCHECK(Z.len() >= n + 1);
+  DCHECK(IsBitNormalized(V));
+  if (n < kNewtonInversionThreshold) return InvertBasecase(Z, V);
+  // Step 2: Split V into a low part of l digits and a high part of h digits.
+  const int l = (n - 1) / 2;
+  const int h = n - l;
+  // Steps 3 and 4: Compute the reciprocal of the high part, recursively.
+  Digits Vh(V, l, h);
+  ScratchDigits Xh(h + 1);
+  InvertNewton(Xh, Vh);
+  if (should_terminate()) return;
+  // Step 5: T := V * Xh.
+  ScratchDigits T(n + h + 1);
+  Multiply(T, V, Xh);
+  if (should_terminate()) return;
+  // Steps 6 and 7: As long as T >= beta^(n+h), decrement Xh and adjust T.
+  while (T[n + h] != 0) {
+    SubtractOne(Xh);
+    SubAndReturnBorrow(T, V);
+  }
+  // Step 8: T := beta^(n+h) - T. Since 0 < T < beta^(n+h), this is
+  // the two's complement of T's lower n+h digits.
+  digit_t carry = 1;
+  for (int i = 0; i < n + h; i++) {
+    T[i] = digit_add2(~T[i], carry, &carry);
+  }
+  // Step 9: Tm := T >> (l digits).
+  Digits Tm(T, l, n + h + 1 - l);
+  Tm.Normalize();
+  // Step 10: U := Tm * Xh.
+  ScratchDigits U(Tm.len() + Xh.len());
+  Multiply(U, Tm, Xh);
+  if (should_terminate()) return;
+  // Step 11: Z := Xh * beta^l + U >> ((2h - l) digits).
+  for (int i = 0; i < l; i++) Z[i] = 0;
+  PutAt(Z + l, Xh, Z.len() - l);
+  Digits U_part(U, 2 * h - l, U.len());
+  carry = AddAndReturnOverflow(Z, U_part);
+  DCHECK(carry == 0);  // NOLINT(readability/check)
+  USE(carry);
+}
+
+// Computes an approximation of the inverse of V, see {InvertNewton}.
+void ProcessorImpl::Invert(RWDigits Z, Digits V) {
+  V.Normalize();
+  DCHECK(V.len() > 0);
+  DCHECK(Z.len() > V.len());
+  if (V.len() < kNewtonInversionThreshold) return InvertBasecase(Z, V);
+  return InvertNewton(Z, V);
+}
+
+namespace {
+
+// Computes Q(uotient) and R(emainder) for A/B, where B is bit-normalized,
+// A < B * beta^n (for n = B.len()) so that Q fits into n digits, and I is
+// the approximate inverse of B as computed by {InvertNewton}.
+// Q and R must have n digits each.
+void DivideBarrettStep(ProcessorImpl* processor, RWDigits Q, RWDigits R,
+                       Digits A, Digits B, Digits I) {
+  const int n = B.len();
+  DCHECK(Q.len() == n);
+  DCHECK(R.len() == n);
+  DCHECK(A.len() <= 2 * n);
+  // Estimate the quotient: Q := ((A >> (n-1) digits) * I) >> (n+1) digits.
+  // This is never too large, and at most a small constant too small.
+  Digits A1(A, n - 1, n + 1);
+  ScratchDigits K(A1.len() + I.len());
+  processor->Multiply(K, A1, I);
+  if (processor->should_terminate()) return;
+  Digits K_part(K, n + 1, K.len());
+  K_part.Normalize();
+  DCHECK(K_part.len() <= n);
+  PutAt(Q, K_part, n);
+  // Compute the corresponding remainder: D := A - Q * B.
+  ScratchDigits P(2 * n);
+  processor->Multiply(P, Q, B);
+  if (processor->should_terminate()) return;
+  ScratchDigits D(std::max(A.len(), 1));
+  Subtract(D, A, P);
+  // Fix up the estimate as needed.
+  while (GreaterThanOrEqual(D, B)) {
+    digit_t borrow = SubAndReturnBorrow(D, B);
+    DCHECK(borrow == 0);  // NOLINT(readability/check)
+    USE(borrow);
+    AddOne(Q);
+  }
+  PutAt(R, D, n);
+}
+
+}  // namespace
+
+// Computes Q(uotient) and R(emainder) for A/B, using Barrett division
+// against a Newton-computed inverse of B. Asymptotically as fast as
+// multiplication, which makes this preferable over Burnikel-Ziegler for very
+// large inputs if multiplication is fast (i.e. FFT-based).
+// Q is required, R is optional.
+void ProcessorImpl::DivideBarrett(RWDigits Q, RWDigits R, Digits A, Digits B) {
+  DCHECK(Q.len() > A.len() - B.len());
+  DCHECK(R.len() == 0 || R.len() >= B.len());
+  A.Normalize();
+  B.Normalize();
+  const int n = B.len();
+  // Bit-normalize B and shift A accordingly.
+  ShiftedDigits b_normalized(B);
+  B = b_normalized;
+  ScratchDigits A_shifted(A.len() + 1);
+  LeftShift(A_shifted, A, b_normalized.shift());
+  A = A_shifted;
+  A.Normalize();
+  // Compute the inverse of B.
+  ScratchDigits I(n + 1);
+  Invert(I, B);
+  if (should_terminate()) return;
+  // Process A in chunks of n digits, starting with the most significant one,
+  // each time dividing [remainder_so_far, chunk] by B.
+  Q.Clear();
+  ScratchDigits Z(2 * n);
+  RWDigits Z_high(Z, n, n);
+  RWDigits Z_low(Z, 0, n);
+  Z_high.Clear();
+  ScratchDigits Qi(n);
+  ScratchDigits Ri(n);
+  for (int i = DIV_CEIL(A.len(), n) - 1; i >= 0; i--) {
+    PutAt(Z_low, Digits(A, i * n, n), n);
+    DivideBarrettStep(this, Qi, Ri, Z, B, I);
+    if (should_terminate()) return;
+    // Q might not have room for the full top chunk, but there will be enough
+    // space for any non-zero result digits.
+    RWDigits target(Q, i * n, n);
+    for (int j = 0; j < target.len(); j++) target[j] = Qi[j];
+    for (int j = target.len(); j < n; j++) DCHECK(Qi[j] == 0);
+    PutAt(Z_high, Ri, n);
+  }
+  if (R.len() != 0) {
+    RightShift(R, Z_high, b_normalized.shift());
+  }
+}
+
+}  // namespace bigint
+}  // namespace v8
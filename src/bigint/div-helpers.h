@@ -0,0 +1,67 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_BIGINT_DIV_HELPERS_H_
+#define V8_BIGINT_DIV_HELPERS_H_
+
+#include <memory>
+
+#include "src/bigint/bigint.h"
+#include "src/bigint/util.h"
+
+namespace v8 {
+namespace bigint {
+
+// Z := X << shift, for 0 <= shift < kDigitBits. Z must be long enough to
+// hold the result; excess digits will be zeroed.
+void LeftShift(RWDigits Z, Digits X, int shift);
+// Z := X >> shift, for 0 <= shift < kDigitBits. Excess digits of Z will be
+// zeroed.
+void RightShift(RWDigits Z, Digits X, int shift);
+
+// Copies {count} digits from {A} into {Z}, zero-padding as needed.
+inline void PutAt(RWDigits Z, Digits A, int count) {
+  int len = std::min(A.len(), count);
+  int i = 0;
+  for (; i < len; i++) Z[i] = A[i];
+  for (; i < count; i++) Z[i] = 0;
+}
+
+// Division algorithms typically need to left-shift their inputs into
+// "bit-normalized" form (i.e. top bit is set). The inputs are considered
+// read-only, and V8 relies on that by allowing concurrent reads from them,
+// so by default, {ShiftedDigits} allocate temporary storage for their
+// contents.
+class ShiftedDigits : public Digits {
+ public:
+  // Shifts {original} left by {shift} bits, or by the number of bits that
+  // bit-normalizes it if {shift} is negative. Adds an extra digit if the
+  // requested shift would otherwise lose bits.
+  explicit ShiftedDigits(Digits& original, int shift = -1)
+      : Digits(original.digits_, original.len_) {
+    int leading_zeros = CountLeadingZeros(original.msd());
+    if (shift < 0) {
+      shift = leading_zeros;
+    } else if (shift > leading_zeros) {
+      len_++;
+    }
+    shift_ = shift;
+    if (shift == 0 && len_ == original.len_) return;
+    storage_.reset(new digit_t[len_]);
+    digits_ = storage_.get();
+    RWDigits rw_view(digits_, len_);
+    LeftShift(rw_view, original, shift_);
+  }
+
+  int shift() { return shift_; }
+
+ private:
+  int shift_;
+  std::unique_ptr<digit_t[]> storage_;
+};
+
+}  // namespace bigint
+}  // namespace v8
+
+#endif  // V8_BIGINT_DIV_HELPERS_H_
@@ -0,0 +1,126 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <utility>
+
+#include "src/bigint/bigint-internal.h"
+#include "src/bigint/digit-arithmetic.h"
+#include "src/bigint/div-helpers.h"
+#include "src/bigint/vector-arithmetic.h"
+
+namespace v8 {
+namespace bigint {
+
+namespace {
+
+// Z[0..len) := Z[0..len) * multiplier + summand. Returns the carry, i.e.
+// the digit that would have to be written to Z[len].
+digit_t MultiplyAddInPlace(RWDigits Z, int len, digit_t multiplier,
+                           digit_t summand) {
+  digit_t carry = summand;
+  for (int i = 0; i < len; i++) {
+    digit_t high;
+    digit_t low = digit_mul(Z[i], multiplier, &high);
+    digit_t new_carry;
+    Z[i] = digit_add2(low, carry, &new_carry);
+    // Can't overflow: {high} is at most (2^kDigitBits - 2).
+    carry = high + new_carry;
+  }
+  return carry;
+}
+
+}  // namespace
+
+// The classic algorithm: for each part, multiply the accumulated result
+// by the multiplier and add the part. Quadratic in the number of parts.
+void ProcessorImpl::FromStringClassic(RWDigits Z,
+                                      FromStringAccumulator* accumulator) {
+  const digit_t multiplier = accumulator->parts_multiplier_;
+  int len = 0;
+  for (digit_t part : accumulator->parts_) {
+    digit_t carry = MultiplyAddInPlace(Z, len, multiplier, part);
+    if (carry != 0) Z[len++] = carry;
+    AddWorkEstimate(len);
+    if (should_terminate()) return;
+  }
+  for (int i = len; i < Z.len(); i++) Z[i] = 0;
+}
+
+// Divide-and-conquer conversion. All parts are digit_t-sized and share the
+// same multiplier M (i.e. each part represents the same number of
+// characters), so in the first round we can combine pairs of adjacent parts
+// as "high * M + low", in the second round pairs of those results as
+// "high * M^2 + low", then "high * M^4 + low", and so on. Each round
+// halves the number of (twice as long) intermediate values, so with
+// subquadratic multiplication the overall complexity is that of the
+// multiplication algorithm times a log(n) factor.
+// The powers M^(2^i) are cached by the processor, so repeated conversions
+// only need to compute them once.
+void ProcessorImpl::FromStringLarge(RWDigits Z,
+                                    FromStringAccumulator* accumulator) {
+  const int num_parts = static_cast<int>(accumulator->parts_.size());
+  const digit_t multiplier = accumulator->parts_multiplier_;
+  ScratchDigits buffer1(num_parts);
+  ScratchDigits buffer2(num_parts);
+  // Intermediate values are stored little-endian in the buffers, each of
+  // them taking up the slots of the parts it was made from.
+  for (int i = 0; i < num_parts; i++) {
+    buffer1[i] = accumulator->parts_[num_parts - 1 - i];
+  }
+  // The parts aren't needed any more, free their memory early.
+  std::vector<digit_t>().swap(accumulator->parts_);
+  RWDigits* input = &buffer1;
+  RWDigits* output = &buffer2;
+  for (int level = 0, group = 1; group < num_parts; level++, group *= 2) {
+    // {group} is the number of parts that each input value consists of.
+    // That many parts fit into {group} digits, as does {power}.
+    Digits power = RadixPower(multiplier, level);
+    if (should_terminate()) return;
+    for (int start = 0; start < num_parts; start += 2 * group) {
+      RWDigits low(*input, start, group);
+      RWDigits result(*output, start, 2 * group);
+      if (start + group >= num_parts) {
+        // Odd one out: there is no "high" value to combine this one with.
+        PutAt(result, low, result.len());
+        continue;
+      }
+      Digits high(*input, start + group, group);
+      Multiply(result, high, power);
+      if (should_terminate()) return;
+      digit_t carry = AddAndReturnOverflow(result, low);
+      DCHECK(carry == 0);  // NOLINT(readability/check)
+      USE(carry);
+    }
+    std::swap(input, output);
+  }
+  Digits result = *input;
+  result.Normalize();
+  DCHECK(result.len() <= Z.len());
+  PutAt(Z, result, Z.len());
+}
+
+void ProcessorImpl::FromString(RWDigits Z, FromStringAccumulator* accumulator) {
+  if (accumulator->parts_.empty()) {
+    Z.Clear();
+    if (accumulator->current_part_ != 0) Z[0] = accumulator->current_part_;
+    return;
+  }
+  if (static_cast<int>(accumulator->parts_.size()) <
+      kFromStringLargeThreshold) {
+    FromStringClassic(Z, accumulator);
+  } else {
+    FromStringLarge(Z, accumulator);
+  }
+  if (should_terminate()) return;
+  // Finally, account for the last (possibly incomplete) part.
+  digit_t carry = MultiplyAddInPlace(Z, Z.len(),
+                                     accumulator->current_multiplier_,
+                                     accumulator->current_part_);
+  DCHECK(carry == 0);  // NOLINT(readability/check)
+  USE(carry);
+}
+
+}  // namespace bigint
+}  // namespace v8
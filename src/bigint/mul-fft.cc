@@ -0,0 +1,380 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// FFT-based multiplication, due to Schönhage and Strassen.
+// This implementation mostly follows the description given in:
+// Christoph Lüders: Fast Multiplication of Large Integers,
+// http://arxiv.org/abs/1503.04955
+
+#include <algorithm>
+#include <cstdint>
+
+#include "src/bigint/bigint-internal.h"
+#include "src/bigint/digit-arithmetic.h"
+#include "src/bigint/util.h"
+#include "src/bigint/vector-arithmetic.h"
+
+namespace v8 {
+namespace bigint {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+// Part 1: Functions for "mod F_n" arithmetic.
+// F_n is of the shape 2^K + 1, where K = n * kDigitBits. Elements are stored
+// as arrays of n + 1 digits; in canonical form, their value is in the range
+// [0, 2^K], so the top digit is either 0, or it is 1 and all other digits
+// are 0.
+
+// Reduces {x} to canonical form, interpreting its top digit as an unsigned
+// multiple of 2^K (which is congruent to -1).
+void ModFn_Normalize(digit_t* x, int n) {
+  digit_t top = x[n];
+  if (top == 0) return;
+  x[n] = 0;
+  digit_t borrow = top;
+  for (int i = 0; i < n && borrow != 0; i++) {
+    x[i] = digit_sub(x[i], borrow, &borrow);
+  }
+  if (borrow == 0) return;
+  // The result was negative, and wrapping around the low n digits has
+  // effectively added 2^K to it. Add the missing 1 to complete adding F_n.
+  digit_t carry = 1;
+  for (int i = 0; i < n && carry != 0; i++) {
+    x[i] = digit_add2(x[i], carry, &carry);
+  }
+  x[n] = carry;
+}
+
+// z := x + y (mod F_n). {z} may alias {x} or {y}.
+void ModFn_Add(digit_t* z, const digit_t* x, const digit_t* y, int n) {
+  digit_t carry = 0;
+  for (int i = 0; i <= n; i++) {
+    z[i] = digit_add3(x[i], y[i], carry, &carry);
+  }
+  ModFn_Normalize(z, n);
+}
+
+// z := x - y (mod F_n). {z} may alias {x} or {y}.
+void ModFn_Sub(digit_t* z, const digit_t* x, const digit_t* y, int n) {
+  digit_t borrow = 0;
+  for (int i = 0; i <= n; i++) {
+    z[i] = digit_sub2(x[i], y[i], borrow, &borrow);
+  }
+  if (borrow != 0) {
+    // The result is negative; add F_n = 2^K + 1 to it. The overall result
+    // fits into n + 1 digits, so the final carry can be discarded.
+    digit_t carry = 1;
+    for (int i = 0; i < n && carry != 0; i++) {
+      z[i] = digit_add2(z[i], carry, &carry);
+    }
+    z[n] = z[n] + 1 + carry;
+  }
+  ModFn_Normalize(z, n);
+}
+
+// z := -x (mod F_n). {z} may alias {x}.
+void ModFn_Negate(digit_t* z, const digit_t* x, int n) {
+  if (x[n] != 0) {
+    // x == 2^K, so -x == 1.
+    z[0] = 1;
+    for (int i = 1; i <= n; i++) z[i] = 0;
+    return;
+  }
+  bool is_zero = true;
+  for (int i = 0; i < n; i++) {
+    if (x[i] != 0) {
+      is_zero = false;
+      break;
+    }
+  }
+  if (is_zero) {
+    for (int i = 0; i <= n; i++) z[i] = 0;
+    return;
+  }
+  // 2^K + 1 - x == (2^K - 1 - x) + 2 == ~x + 2.
+  digit_t carry = 2;
+  for (int i = 0; i < n; i++) {
+    z[i] = digit_add2(~x[i], carry, &carry);
+  }
+  z[n] = carry;
+}
+
+// Computes z := L - H (mod F_n), where L and H are the lower and upper
+// n digits of the 2n-digit value that {get_digit} describes. This is the
+// reduction step for values up to 2^(2K), since 2^K is congruent to -1.
+template <class GetDigit>
+void ModFn_ReduceDouble(digit_t* z, int n, GetDigit get_digit) {
+  digit_t borrow = 0;
+  for (int i = 0; i < n; i++) {
+    z[i] = digit_sub2(get_digit(i), get_digit(n + i), borrow, &borrow);
+  }
+  z[n] = 0;
+  if (borrow != 0) {
+    // Same as in {ModFn_Normalize}: 2^K has already been added, add 1.
+    digit_t carry = 1;
+    for (int i = 0; i < n && carry != 0; i++) {
+      z[i] = digit_add2(z[i], carry, &carry);
+    }
+    z[n] = carry;
+  }
+}
+
+// z := x * 2^shift (mod F_n), for 0 <= shift < K.
+// {z} must not alias {x}.
+void ModFn_ShiftLeft(digit_t* z, const digit_t* x, int shift, int n) {
+  if (x[n] != 0) {
+    // x == 2^K == -1, so the result is -(2^shift).
+    for (int i = 0; i <= n; i++) z[i] = 0;
+    z[shift / kDigitBits] = digit_t{1} << (shift % kDigitBits);
+    return ModFn_Negate(z, z, n);
+  }
+  const int digit_shift = shift / kDigitBits;
+  const int bits_shift = shift % kDigitBits;
+  // Conceptually, we compute the 2n-digit value x << shift, and then
+  // subtract its upper half from its lower half.
+  if (bits_shift == 0) {
+    ModFn_ReduceDouble(z, n, [=](int i) {
+      int j = i - digit_shift;
+      return (j >= 0 && j < n) ? x[j] : 0;
+    });
+  } else {
+    ModFn_ReduceDouble(z, n, [=](int i) {
+      int j = i - digit_shift;
+      digit_t high = (j >= 0 && j < n) ? x[j] << bits_shift : 0;
+      digit_t low =
+          (j >= 1 && j <= n) ? x[j - 1] >> (kDigitBits - bits_shift) : 0;
+      return high | low;
+    });
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Part 2: Parameter selection.
+
+struct Parameters {
+  int m;  // The FFT has length 2^m.
+  int s;  // Number of input digits per FFT element.
+  int n;  // Number of digits in K, i.e. F_n = 2^(n * kDigitBits) + 1.
+};
+
+// Very rough estimate of the cost of multiplying two n-digit numbers,
+// in units of digit multiplications.
+uint64_t MultiplicationCost(int n) {
+  if (n < kKaratsubaThreshold) return static_cast<uint64_t>(n) * n;
+  return 3 * MultiplicationCost(DIV_CEIL(n, 2)) + 4 * n;
+}
+
+void ComputeParameters(int x_len, int y_len, int m, Parameters* params) {
+  int N = 1 << m;
+  // Each element holds {s} digits, and the cyclic convolution of length N
+  // must not wrap around.
+  int s = DIV_CEIL(x_len + y_len, N);
+  while (DIV_CEIL(x_len, s) + DIV_CEIL(y_len, s) - 1 > N) s++;
+  // Each coefficient of the result is a sum of at most N products of
+  // s-digit chunks, so it is less than 2^(2 * s * kDigitBits + m).
+  int K_bits = 2 * s * kDigitBits + m + 1;
+  int n = DIV_CEIL(K_bits, kDigitBits);
+  // We use w = 2^(2K / N) as the N-th root of unity, so 2K must be
+  // divisible by N.
+  int alignment = std::max(1, (N / 2) / kDigitBits);
+  n = RoundUp(n, alignment);
+  params->m = m;
+  params->s = s;
+  params->n = n;
+}
+
+uint64_t EstimateCost(const Parameters& params) {
+  uint64_t N = uint64_t{1} << params.m;
+  uint64_t element_len = params.n + 1;
+  // Three transforms with m rounds of N/2 butterflies each, plus N pointwise
+  // multiplications.
+  uint64_t transforms = 3 * params.m * (N / 2) * (4 * element_len);
+  return transforms + N * MultiplicationCost(params.n);
+}
+
+void ChooseParameters(int x_len, int y_len, Parameters* params) {
+  const int kMinM = 4;
+  ComputeParameters(x_len, y_len, kMinM, params);
+  uint64_t best_cost = EstimateCost(*params);
+  for (int m = kMinM + 1; (1 << m) <= x_len + y_len && m < 24; m++) {
+    Parameters candidate;
+    ComputeParameters(x_len, y_len, m, &candidate);
+    uint64_t cost = EstimateCost(candidate);
+    if (cost < best_cost) {
+      best_cost = cost;
+      *params = candidate;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Part 3: The FFT itself.
+
+class FFTContainer {
+ public:
+  FFTContainer(ProcessorImpl* processor, const Parameters& params)
+      : processor_(processor),
+        m_(params.m),
+        N_(1 << params.m),
+        s_(params.s),
+        n_(params.n),
+        element_len_(params.n + 1),
+        // 2K / N bits per step of the root of unity.
+        omega_shift_(2 * params.n * kDigitBits / (1 << params.m)),
+        storage_(new digit_t[N_ * element_len_]),
+        temp_(new digit_t[element_len_]) {}
+
+  digit_t* element(int i) { return storage_.get() + i * element_len_; }
+
+  // Splits {X} into chunks of {s_} digits and loads them into the elements.
+  void Start(Digits X) {
+    int x_index = 0;
+    for (int i = 0; i < N_; i++) {
+      digit_t* e = element(i);
+      int j = 0;
+      for (; j < s_ && x_index < X.len(); j++) e[j] = X[x_index++];
+      for (; j < element_len_; j++) e[j] = 0;
+    }
+  }
+
+  // Forward transform, decimation in frequency. Consumes the elements in
+  // natural order, and leaves the result in bit-reversed order.
+  void FFT() {
+    digit_t* t = temp_.get();
+    for (int half = N_ / 2, step = 1; half >= 1; half /= 2, step *= 2) {
+      for (int start = 0; start < N_; start += 2 * half) {
+        for (int j = 0; j < half; j++) {
+          digit_t* u = element(start + j);
+          digit_t* v = element(start + j + half);
+          ModFn_Sub(t, u, v, n_);
+          ModFn_Add(u, u, v, n_);
+          int shift = j * step * omega_shift_;
+          if (shift == 0) {
+            std::copy(t, t + element_len_, v);
+          } else {
+            ModFn_ShiftLeft(v, t, shift, n_);
+          }
+        }
+      }
+      processor_->AddWorkEstimate(N_ * element_len_);
+      if (processor_->should_terminate()) return;
+    }
+  }
+
+  // Inverse transform, decimation in time. Consumes the elements in
+  // bit-reversed order, and leaves the result in natural order.
+  // Includes the final division by N.
+  void BackwardFFT() {
+    digit_t* t = temp_.get();
+    const int K = n_ * kDigitBits;
+    for (int half = 1, step = N_ / 2; half < N_; half *= 2, step /= 2) {
+      for (int start = 0; start < N_; start += 2 * half) {
+        for (int j = 0; j < half; j++) {
+          digit_t* u = element(start + j);
+          digit_t* v = element(start + j + half);
+          int shift = j * step * omega_shift_;
+          if (shift == 0) {
+            ModFn_Sub(t, u, v, n_);
+            ModFn_Add(u, u, v, n_);
+            std::copy(t, t + element_len_, v);
+          } else {
+            // v * w^(-shift) = v * 2^(2K - shift) = -(v * 2^(K - shift)).
+            ModFn_ShiftLeft(t, v, K - shift, n_);
+            ModFn_Add(v, u, t, n_);
+            ModFn_Sub(u, u, t, n_);
+          }
+        }
+      }
+      processor_->AddWorkEstimate(N_ * element_len_);
+      if (processor_->should_terminate()) return;
+    }
+    // Divide by N: 2^(-m) = 2^(2K - m) = -(2^(K - m)).
+    for (int i = 0; i < N_; i++) {
+      digit_t* e = element(i);
+      ModFn_ShiftLeft(t, e, K - m_, n_);
+      ModFn_Negate(e, t, n_);
+    }
+  }
+
+  // this := this * other, element-wise.
+  void PointwiseMultiply(FFTContainer& other) {
+    ScratchDigits product(2 * n_);
+    for (int i = 0; i < N_; i++) {
+      digit_t* x = element(i);
+      digit_t* y = other.element(i);
+      if (x[n_] != 0) {
+        // x == -1.
+        ModFn_Negate(x, y, n_);
+        continue;
+      }
+      if (y[n_] != 0) {
+        // y == -1.
+        ModFn_Negate(x, x, n_);
+        continue;
+      }
+      processor_->Multiply(product, Digits(x, n_), Digits(y, n_));
+      if (processor_->should_terminate()) return;
+      digit_t* p = product.digits();
+      ModFn_ReduceDouble(x, n_, [=](int j) { return p[j]; });
+    }
+  }
+
+  // Z := sum of all elements, each shifted by its index times {s_} digits.
+  void NormalizeAndRecombine(RWDigits Z) {
+    Z.Clear();
+    for (int i = 0; i < N_; i++) {
+      Digits coefficient(element(i), element_len_);
+      coefficient.Normalize();
+      if (coefficient.len() == 0) continue;
+      digit_t overflow = AddAndReturnOverflow(Z + i * s_, coefficient);
+      DCHECK(overflow == 0);  // NOLINT(readability/check)
+      USE(overflow);
+    }
+  }
+
+ private:
+  ProcessorImpl* processor_;
+  const int m_;
+  const int N_;
+  const int s_;
+  const int n_;
+  const int element_len_;
+  const int omega_shift_;
+  std::unique_ptr<digit_t[]> storage_;
+  std::unique_ptr<digit_t[]> temp_;
+};
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Part 4: Public interface.
+
+// Z := X * Y, for Y.len() >= kFftThreshold.
+void ProcessorImpl::MultiplyFFT(RWDigits Z, Digits X, Digits Y) {
+  DCHECK(Z.len() >= X.len() + Y.len());
+  Parameters params;
+  ChooseParameters(X.len(), Y.len(), &params);
+  FFTContainer a(this, params);
+  a.Start(X);
+  a.FFT();
+  if (should_terminate()) return;
+  if (X == Y) {
+    // Squaring: the second transform can be skipped.
+    a.PointwiseMultiply(a);
+  } else {
+    FFTContainer b(this, params);
+    b.Start(Y);
+    b.FFT();
+    if (should_terminate()) return;
+    a.PointwiseMultiply(b);
+  }
+  if (should_terminate()) return;
+  a.BackwardFFT();
+  if (should_terminate()) return;
+  a.NormalizeAndRecombine(Z);
+}
+
+}  // namespace bigint
+}  // namespace v8
@@ -0,0 +1,154 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Karatsuba multiplication. This is loosely based on Go's implementation
+// found at https://golang.org/src/math/big/nat.go, licensed as follows:
+//
+// Copyright 2009 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file [1].
+//
+// [1] https://golang.org/LICENSE
+
+#include <algorithm>
+#include <utility>
+
+#include "src/bigint/bigint-internal.h"
+#include "src/bigint/digit-arithmetic.h"
+#include "src/bigint/util.h"
+#include "src/bigint/vector-arithmetic.h"
+
+namespace v8 {
+namespace bigint {
+
+namespace {
+
+// Returns the smallest length >= {n} that can be halved repeatedly (without
+// remainder) until it drops below {kKaratsubaThreshold}. Rounding up the
+// input length this way allows the recursion to always split evenly, at the
+// cost of at most 1/kKaratsubaThreshold of padding.
+int KaratsubaLength(int n) {
+  int i = 0;
+  while (((n - 1) >> i) + 1 >= kKaratsubaThreshold) i++;
+  return RoundUp(n, 1 << i);
+}
+
+// Performs the specific subtraction required by {KaratsubaMain} below:
+// result := |X - Y|, flipping {sign} if X < Y.
+void KaratsubaSubtractionHelper(RWDigits result, Digits X, Digits Y,
+                                int* sign) {
+  X.Normalize();
+  Y.Normalize();
+  digit_t borrow = 0;
+  int i = 0;
+  if (!GreaterThanOrEqual(X, Y)) {
+    *sign = -(*sign);
+    std::swap(X, Y);
+  }
+  for (; i < Y.len(); i++) {
+    result[i] = digit_sub2(X[i], Y[i], borrow, &borrow);
+  }
+  for (; i < X.len(); i++) {
+    result[i] = digit_sub(X[i], borrow, &borrow);
+  }
+  DCHECK(borrow == 0);  // NOLINT(readability/check)
+  for (; i < result.len(); i++) result[i] = 0;
+}
+
+}  // namespace
+
+// Z := X * Y, for Y.len() >= kKaratsubaThreshold.
+// Inputs of unequal lengths are handled by chopping the larger one into
+// chunks of the smaller one's (rounded-up) length.
+void ProcessorImpl::MultiplyKaratsuba(RWDigits Z, Digits X, Digits Y) {
+  DCHECK(X.len() >= Y.len());
+  DCHECK(Y.len() >= kKaratsubaThreshold);
+  DCHECK(Z.len() >= X.len() + Y.len());
+  int k = KaratsubaLength(Y.len());
+  ScratchDigits scratch(4 * k);
+  if (X.len() <= k && Z.len() >= 2 * k) {
+    // Fast path: the result can be written to Z directly.
+    KaratsubaMain(Z, X, Y, scratch, k);
+    for (int i = 2 * k; i < Z.len(); i++) Z[i] = 0;
+    return;
+  }
+  ScratchDigits T(2 * k);
+  Z.Clear();
+  for (int i = 0; i < X.len(); i += k) {
+    Digits Xi(X, i, k);
+    KaratsubaMain(T, Xi, Y, scratch, k);
+    if (should_terminate()) return;
+    // Can't overflow, because the final result fits into Z.
+    AddAndReturnOverflow(Z + i, T);
+  }
+}
+
+// The main recursive Karatsuba method.
+// Z := X * Y, where X and Y have at most {n} digits, and Z has exactly 2 * n
+// digits (all of which will be written).
+// {n} must have been computed by {KaratsubaLength}.
+void ProcessorImpl::KaratsubaMain(RWDigits Z, Digits X, Digits Y,
+                                  RWDigits scratch, int n) {
+  if (n < kKaratsubaThreshold) {
+    X.Normalize();
+    Y.Normalize();
+    RWDigits target(Z, 0, 2 * n);
+    if (X.len() == 0 || Y.len() == 0) return target.Clear();
+    if (X.len() >= Y.len()) {
+      return MultiplySchoolbook(target, X, Y);
+    } else {
+      return MultiplySchoolbook(target, Y, X);
+    }
+  }
+  DCHECK(scratch.len() >= 4 * n);
+  DCHECK((n & 1) == 0);  // NOLINT(readability/check)
+  int n2 = n >> 1;
+  Digits X0(X, 0, n2);
+  Digits X1(X, n2, n2);
+  Digits Y0(Y, 0, n2);
+  Digits Y1(Y, n2, n2);
+  RWDigits scratch_for_recursion(scratch, 2 * n, 2 * n);
+  // P0 := X0 * Y0, stored in the lower half of Z.
+  RWDigits P0(Z, 0, n);
+  KaratsubaMain(P0, X0, Y0, scratch_for_recursion, n2);
+  if (should_terminate()) return;
+  // P2 := X1 * Y1, stored in the upper half of Z.
+  RWDigits P2(Z, n, n);
+  KaratsubaMain(P2, X1, Y1, scratch_for_recursion, n2);
+  if (should_terminate()) return;
+  // P1 := |X1 - X0| * |Y0 - Y1|, with its sign tracked separately.
+  RWDigits X_diff(scratch, 0, n2);
+  RWDigits Y_diff(scratch, n2, n2);
+  int sign = 1;
+  KaratsubaSubtractionHelper(X_diff, X1, X0, &sign);
+  KaratsubaSubtractionHelper(Y_diff, Y0, Y1, &sign);
+  RWDigits P1(scratch, n, n);
+  KaratsubaMain(P1, X_diff, Y_diff, scratch_for_recursion, n2);
+  if (should_terminate()) return;
+  // Compute the middle term M := X1 * Y0 + X0 * Y1 = P0 + P2 +/- P1
+  // in-place in P1. M < 2 * beta^n, so it fits into n digits plus
+  // a single bit of {overflow}. Intermediate results may temporarily
+  // wrap around, which the unsigned {overflow} arithmetic tolerates.
+  digit_t overflow;
+  if (sign > 0) {
+    overflow = AddAndReturnOverflow(P1, P0);
+  } else {
+    // P1 := P0 - P1.
+    overflow = 0 - SubtractAndReturnBorrow(P1, P0, P1);
+  }
+  overflow += AddAndReturnOverflow(P1, P2);
+  DCHECK(overflow <= 1);
+  // Z += M * beta^n2. Since the final result fits into 2 * n digits,
+  // none of these additions can overflow.
+  digit_t carry = AddAndReturnOverflow(Z + n2, P1);
+  DCHECK(carry == 0);  // NOLINT(readability/check)
+  if (overflow != 0) {
+    carry = AddAndReturnOverflow(Z + (n2 + n), Digits(&overflow, 1));
+    DCHECK(carry == 0);  // NOLINT(readability/check)
+  }
+  USE(carry);
+}
+
+}  // namespace bigint
+}  // namespace v8
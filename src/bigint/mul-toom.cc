@@ -0,0 +1,165 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Toom-Cook multiplication.
+// Reference: https://en.wikipedia.org/wiki/Toom%E2%80%93Cook_multiplication
+
+#include <algorithm>
+
+#include "src/bigint/bigint-internal.h"
+#include "src/bigint/digit-arithmetic.h"
+#include "src/bigint/div-helpers.h"
+#include "src/bigint/util.h"
+#include "src/bigint/vector-arithmetic.h"
+
+namespace v8 {
+namespace bigint {
+
+namespace {
+
+// X := X / 3, in-place. X must be divisible by 3.
+void DivideByThree(RWDigits X) {
+  digit_t remainder = 0;
+  for (int i = X.len() - 1; i >= 0; i--) {
+    X[i] = digit_div(remainder, X[i], 3, &remainder);
+  }
+  DCHECK(remainder == 0);  // NOLINT(readability/check)
+}
+
+// Z += X * beta^offset. The final result must fit into Z.
+void AddAt(RWDigits Z, Digits X, int offset) {
+  X.Normalize();
+  if (X.len() == 0) return;
+  digit_t overflow = AddAndReturnOverflow(Z + offset, X);
+  DCHECK(overflow == 0);  // NOLINT(readability/check)
+  USE(overflow);
+}
+
+}  // namespace
+
+// Toom-Cook-3 (a.k.a. Toom-3) on inputs of roughly equal lengths.
+// Evaluation points are 0, 1, -1, -2, and infinity; the interpolation
+// sequence is due to Marco Bodrato.
+void ProcessorImpl::Toom3Main(RWDigits Z, Digits X, Digits Y) {
+  DCHECK(Z.len() >= X.len() + Y.len());
+  // Phase 1: Splitting.
+  int i = DIV_CEIL(std::max(X.len(), Y.len()), 3);
+  Digits X0(X, 0, i);
+  Digits X1(X, i, i);
+  Digits X2(X, 2 * i, i);
+  Digits Y0(Y, 0, i);
+  Digits Y1(Y, i, i);
+  Digits Y2(Y, 2 * i, i);
+
+  // Phase 2: Evaluation.
+  // All evaluated values are less than 7 * beta^i, so one extra digit
+  // is enough.
+  int p_len = i + 1;
+  // p0 := X0 + X2
+  ScratchDigits po(p_len);
+  Add(po, X0, X2);
+  // p(1) := p0 + X1
+  ScratchDigits p1(p_len);
+  Add(p1, po, X1);
+  // p(-1) := p0 - X1
+  ScratchDigits pm1(p_len);
+  bool pm1_sign = SubtractSigned(pm1, po, false, X1, false);
+  // p(-2) := (p(-1) + X2) * 2 - X0
+  ScratchDigits pm2(p_len);
+  bool pm2_sign = AddSigned(pm2, pm1, pm1_sign, X2, false);
+  LeftShift(pm2, pm2, 1);
+  pm2_sign = SubtractSigned(pm2, pm2, pm2_sign, X0, false);
+  // Same for Y. The polynomial's value at infinity is the top part (X2, Y2).
+  ScratchDigits qo(p_len);
+  Add(qo, Y0, Y2);
+  ScratchDigits q1(p_len);
+  Add(q1, qo, Y1);
+  ScratchDigits qm1(p_len);
+  bool qm1_sign = SubtractSigned(qm1, qo, false, Y1, false);
+  ScratchDigits qm2(p_len);
+  bool qm2_sign = AddSigned(qm2, qm1, qm1_sign, Y2, false);
+  LeftShift(qm2, qm2, 1);
+  qm2_sign = SubtractSigned(qm2, qm2, qm2_sign, Y0, false);
+
+  // Phase 3: Pointwise multiplication.
+  int r_len = 2 * p_len;
+  ScratchDigits r0(r_len);
+  Multiply(r0, X0, Y0);
+  if (should_terminate()) return;
+  ScratchDigits r1(r_len);
+  Multiply(r1, p1, q1);
+  if (should_terminate()) return;
+  ScratchDigits rm1(r_len);
+  Multiply(rm1, pm1, qm1);
+  if (should_terminate()) return;
+  bool rm1_sign = pm1_sign != qm1_sign;
+  ScratchDigits rm2(r_len);
+  Multiply(rm2, pm2, qm2);
+  if (should_terminate()) return;
+  bool rm2_sign = pm2_sign != qm2_sign;
+  ScratchDigits rinf(r_len);
+  Multiply(rinf, X2, Y2);
+  if (should_terminate()) return;
+
+  // Phase 4: Interpolation.
+  // r3 := (r(-2) - r(1)) / 3
+  Digits R0 = r0;
+  Digits R4 = rinf;
+  RWDigits R3 = rm2;
+  bool r3_sign = SubtractSigned(R3, rm2, rm2_sign, r1, false);
+  DivideByThree(R3);
+  // r1 := (r(1) - r(-1)) / 2
+  RWDigits R1 = r1;
+  bool r1_sign = SubtractSigned(R1, r1, false, rm1, rm1_sign);
+  RightShift(R1, R1, 1);
+  // r2 := r(-1) - r(0)
+  RWDigits R2 = rm1;
+  bool r2_sign = SubtractSigned(R2, rm1, rm1_sign, r0, false);
+  // r3 := (r2 - r3) / 2 + 2 * r(inf)
+  r3_sign = SubtractSigned(R3, R2, r2_sign, R3, r3_sign);
+  RightShift(R3, R3, 1);
+  ScratchDigits rinf2(r_len);
+  LeftShift(rinf2, rinf, 1);
+  r3_sign = AddSigned(R3, R3, r3_sign, rinf2, false);
+  // r2 := r2 + r1 - r(inf)
+  r2_sign = AddSigned(R2, R2, r2_sign, R1, r1_sign);
+  r2_sign = SubtractSigned(R2, R2, r2_sign, R4, false);
+  // r1 := r1 - r3
+  r1_sign = SubtractSigned(R1, R1, r1_sign, R3, r3_sign);
+  // The final coefficients are sums of products of non-negative chunks.
+  DCHECK(!r1_sign && !r2_sign && !r3_sign);
+  USE(r1_sign);
+  USE(r2_sign);
+  USE(r3_sign);
+
+  // Phase 5: Recomposition.
+  // Z := r0 + r1 * beta^i + r2 * beta^(2i) + r3 * beta^(3i) + r4 * beta^(4i)
+  Z.Clear();
+  AddAt(Z, R0, 0);
+  AddAt(Z, R1, i);
+  AddAt(Z, R2, 2 * i);
+  AddAt(Z, R3, 3 * i);
+  AddAt(Z, R4, 4 * i);
+}
+
+// Z := X * Y, for Y.len() >= kToomThreshold.
+// Unbalanced inputs are chopped into chunks of Y's length.
+void ProcessorImpl::MultiplyToomCook(RWDigits Z, Digits X, Digits Y) {
+  DCHECK(X.len() >= Y.len());
+  int k = Y.len();
+  if (X.len() == k) return Toom3Main(Z, X, Y);
+  ScratchDigits T(2 * k);
+  Z.Clear();
+  for (int i = 0; i < X.len(); i += k) {
+    Digits Xi(X, i, k);
+    // Full-size chunks end up in {Toom3Main}, a shorter last chunk
+    // gets whichever algorithm suits its length.
+    Multiply(T, Xi, Y);
+    if (should_terminate()) return;
+    AddAt(Z, T, i);
+  }
+}
+
+}  // namespace bigint
+}  // namespace v8
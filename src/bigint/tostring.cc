@@ -0,0 +1,260 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "src/bigint/bigint-internal.h"
+#include "src/bigint/digit-arithmetic.h"
+#include "src/bigint/div-helpers.h"
+#include "src/bigint/util.h"
+#include "src/bigint/vector-arithmetic.h"
+
+namespace v8 {
+namespace bigint {
+
+namespace {
+
+// Lookup table for the maximum number of bits required per character of a
+// base-N string representation of a number. To increase accuracy, the array
+// value is the actual value multiplied by 32. To generate this table:
+// for (var i = 0; i <= 36; i++) { print(Math.ceil(Math.log2(i) * 32) + ","); }
+constexpr uint8_t kMaxBitsPerChar[] = {
+    0,   0,   32,  51,  64,  75,  83,  90,  96,  // 0..8
+    102, 107, 111, 115, 119, 122, 126, 128,      // 9..16
+    131, 134, 136, 139, 141, 143, 145, 147,      // 17..24
+    149, 151, 153, 154, 156, 158, 159, 160,      // 25..32
+    162, 163, 165, 166,                          // 33..36
+};
+
+static const int kBitsPerCharTableShift = 5;
+static const size_t kBitsPerCharTableMultiplier = 1u << kBitsPerCharTableShift;
+
+static const char kConversionChars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// Raises {base} to the power of {exponent}. Does not check for overflow.
+digit_t digit_pow(digit_t base, digit_t exponent) {
+  digit_t result = 1ull;
+  while (exponent > 0) {
+    if (exponent & 1) {
+      result *= base;
+    }
+    exponent >>= 1;
+    base *= base;
+  }
+  return result;
+}
+
+// Writes the string representation of a BigInt into a char buffer, from
+// the end towards the start, and then moves it to the start of the buffer.
+// Small inputs are converted with the "classic" algorithm of repeatedly
+// dividing by the largest power of the radix that fits into a digit (a
+// "chunk"). Larger inputs are split recursively by dividing by
+// radix^(chunk_chars * 2^i), which makes the conversion subquadratic.
+class ToStringFormatter {
+ public:
+  ToStringFormatter(Digits X, int radix, bool sign, char* out,
+                    int chars_available, ProcessorImpl* processor)
+      : digits_(X),
+        radix_(radix),
+        sign_(sign),
+        out_start_(out),
+        out_end_(out + chars_available),
+        out_(out_end_),
+        processor_(processor) {
+    DCHECK(radix >= 2 && radix <= 36);
+    digits_.Normalize();
+    DCHECK(digits_.len() > 0);
+    chunk_chars_ =
+        kDigitBits * kBitsPerCharTableMultiplier / kMaxBitsPerChar[radix_];
+    chunk_divisor_ = digit_pow(radix_, chunk_chars_);
+    // For power-of-two radixes, the table's values are exact, so the
+    // chunk can be one character too long.
+    if (chunk_divisor_ == 0) {
+      chunk_chars_--;
+      chunk_divisor_ = digit_pow(radix_, chunk_chars_);
+    }
+    DCHECK(chunk_divisor_ != 0);  // NOLINT(readability/check)
+  }
+
+  void Start();
+  int Finish();
+
+ private:
+  // Writes exactly {chunk_chars_} characters for {chunk}, including
+  // leading zeros.
+  void WriteChunk(digit_t chunk) {
+    for (int i = 0; i < chunk_chars_; i++) {
+      *(--out_) = kConversionChars[chunk % radix_];
+      chunk /= radix_;
+    }
+    DCHECK(chunk == 0);  // NOLINT(readability/check)
+  }
+  // Writes the characters for {digit}, without leading zeros.
+  void WriteLastDigit(digit_t digit) {
+    do {
+      *(--out_) = kConversionChars[digit % radix_];
+      digit /= radix_;
+    } while (digit > 0);
+  }
+
+  void Classic(Digits X, int pad_chars);
+  void ProcessLevel(Digits X, int level, int pad_chars);
+  void DivideWithRemainder(RWDigits Q, RWDigits R, Digits A, Digits B);
+
+  Digits digits_;
+  int radix_;
+  bool sign_;
+  char* out_start_;
+  char* out_end_;
+  char* out_;
+  int chunk_chars_;
+  digit_t chunk_divisor_;
+  ProcessorImpl* processor_;
+};
+
+// Converts {X} with repeated single-digit divisions. If {pad_chars} is
+// positive, writes exactly that many characters, padding with leading zeros
+// as needed.
+void ToStringFormatter::Classic(Digits X, int pad_chars) {
+  X.Normalize();
+  char* const start = out_;
+  if (X.len() == 1) {
+    WriteLastDigit(X[0]);
+  } else if (X.len() > 1) {
+    ScratchDigits rest(X.len());
+    Digits dividend = X;
+    do {
+      digit_t chunk;
+      processor_->DivideSingle(rest, &chunk, dividend, chunk_divisor_);
+      WriteChunk(chunk);
+      if (processor_->should_terminate()) return;
+      dividend = rest;
+      dividend.Normalize();
+      rest.set_len(dividend.len());
+    } while (dividend.len() > 1);
+    WriteLastDigit(dividend[0]);
+  }
+  if (pad_chars > 0) {
+    DCHECK(start - out_ <= pad_chars);
+    while (start - out_ < pad_chars) *(--out_) = '0';
+  }
+}
+
+// Q := A / B, R := A % B, for any A and B > 0.
+void ToStringFormatter::DivideWithRemainder(RWDigits Q, RWDigits R, Digits A,
+                                            Digits B) {
+  A.Normalize();
+  if (Compare(A, B) < 0) {
+    Q.Clear();
+    PutAt(R, A, R.len());
+    return;
+  }
+  if (B.len() == 1) {
+    digit_t remainder;
+    processor_->DivideSingle(Q, &remainder, A, B[0]);
+    R.Clear();
+    R[0] = remainder;
+  } else if (B.len() < kBurnikelThreshold) {
+    processor_->DivideSchoolbook(Q, R, A, B);
+  } else if (B.len() < kBarrettThreshold || A.len() == B.len()) {
+    processor_->DivideBurnikelZiegler(Q, R, A, B);
+  } else {
+    processor_->DivideBarrett(Q, R, A, B);
+  }
+}
+
+// Converts {X} < P^2, where P = radix^(chunk_chars_ * 2^level). If
+// {pad_chars} is positive, writes exactly that many characters (which
+// must be 2 * chunk_chars_ * 2^level).
+void ToStringFormatter::ProcessLevel(Digits X, int level, int pad_chars) {
+  X.Normalize();
+  if (level < 0 || X.len() < kToStringFastThreshold) {
+    return Classic(X, pad_chars);
+  }
+  Digits power = processor_->RadixPower(chunk_divisor_, level);
+  if (processor_->should_terminate()) return;
+  // The top part must not have leading zeros, so skip levels until it
+  // doesn't get split into an all-zero high half.
+  if (pad_chars == 0 && Compare(X, power) < 0) {
+    return ProcessLevel(X, level - 1, 0);
+  }
+  const int half_chars = chunk_chars_ << level;
+  // The remainder is at most as long as the power; the quotient is shorter
+  // than the power as well, because X < power^2.
+  int q_len = std::max(X.len() - power.len() + 1, 1);
+  ScratchDigits quotient(q_len);
+  ScratchDigits remainder(power.len());
+  DivideWithRemainder(quotient, remainder, X, power);
+  if (processor_->should_terminate()) return;
+  // The low half, with all its leading zeros...
+  ProcessLevel(remainder, level - 1, half_chars);
+  if (processor_->should_terminate()) return;
+  // ...followed by the high half.
+  ProcessLevel(quotient, level - 1, pad_chars == 0 ? 0 : half_chars);
+}
+
+void ToStringFormatter::Start() {
+  if (digits_.len() < kToStringFastThreshold) return Classic(digits_, 0);
+  // Find a level such that X < power(level)^2, judging by lengths only so
+  // that we don't have to compute the square.
+  int level = 0;
+  while (true) {
+    Digits power = processor_->RadixPower(chunk_divisor_, level);
+    if (processor_->should_terminate()) return;
+    if (2 * power.len() - 1 > digits_.len()) break;
+    level++;
+  }
+  ProcessLevel(digits_, level, 0);
+}
+
+int ToStringFormatter::Finish() {
+  DCHECK(out_ >= out_start_);
+  DCHECK(out_ < out_end_);  // At least one character was written.
+  // Leading zeros shouldn't have been written, but let's be robust.
+  while (out_ < out_end_ - 1 && *out_ == '0') out_++;
+  if (sign_) *(--out_) = '-';
+  int length = static_cast<int>(out_end_ - out_);
+  if (out_ > out_start_) memmove(out_start_, out_, length);
+  return length;
+}
+
+}  // namespace
+
+void ProcessorImpl::ToString(char* out, int* out_length, Digits X, int radix,
+                             bool sign) {
+  X.Normalize();
+  if (X.len() == 0) {
+    *out = '0';
+    *out_length = 1;
+    return;
+  }
+  ToStringFormatter formatter(X, radix, sign, out, *out_length, this);
+  formatter.Start();
+  if (should_terminate()) return;
+  *out_length = formatter.Finish();
+}
+
+int ToStringResultLength(Digits X, int radix, bool sign) {
+  X.Normalize();
+  if (X.len() == 0) return 1;
+  const int bit_length = BitLength(X);
+  // For estimating result length, we have to be pessimistic and work with
+  // the minimum number of bits one character can represent.
+  const uint8_t min_bits_per_char = kMaxBitsPerChar[radix] - 1;
+  // Perform the following computation with uint64_t to avoid overflows.
+  uint64_t chars_required = bit_length;
+  chars_required *= kBitsPerCharTableMultiplier;
+  chars_required += min_bits_per_char - 1;  // Round up.
+  chars_required /= min_bits_per_char;
+  chars_required += sign;
+  DCHECK(chars_required <=
+         static_cast<uint64_t>(std::numeric_limits<int>::max()));
+  return static_cast<int>(chars_required);
+}
+
+}  // namespace bigint
+}  // namespace v8
@@ -0,0 +1,61 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Helper functions that operate on {Digits} vectors of digits.
+
+#ifndef V8_BIGINT_VECTOR_ARITHMETIC_H_
+#define V8_BIGINT_VECTOR_ARITHMETIC_H_
+
+#include "src/bigint/bigint.h"
+#include "src/bigint/digit-arithmetic.h"
+
+namespace v8 {
+namespace bigint {
+
+// Z := X + Y. Z must be long enough to hold the result, any excess digits
+// will be zeroed.
+void Add(RWDigits Z, Digits X, Digits Y);
+// Z := X - Y. Requires X >= Y. Any excess digits of Z will be zeroed.
+void Subtract(RWDigits Z, Digits X, Digits Y);
+
+// These add exactly Y's digits to the matching digits in X, storing the
+// result in (part of) Z, and return the carry/borrow.
+digit_t AddAndReturnCarry(RWDigits Z, Digits X, Digits Y);
+digit_t SubtractAndReturnBorrow(RWDigits Z, Digits X, Digits Y);
+
+// Z += X. Returns the carry that overflowed Z's digits.
+digit_t AddAndReturnOverflow(RWDigits Z, Digits X);
+// Z -= X. Returns the borrow that underflowed Z's digits.
+digit_t SubAndReturnBorrow(RWDigits Z, Digits X);
+
+// Signed-magnitude helpers: Z := (+/-X) + (+/-Y). Returns whether the result
+// is negative. Zero is never reported as negative. Z may alias X or Y.
+bool AddSigned(RWDigits Z, Digits X, bool x_negative, Digits Y,
+               bool y_negative);
+bool SubtractSigned(RWDigits Z, Digits X, bool x_negative, Digits Y,
+                    bool y_negative);
+
+inline bool IsDigitNormalized(Digits X) { return X.len() == 0 || X.msd() != 0; }
+
+inline bool IsZero(Digits X) {
+  X.Normalize();
+  return X.len() == 0;
+}
+
+inline bool IsBitNormalized(Digits X) {
+  return (X.msd() >> (kDigitBits - 1)) == 1;
+}
+
+inline bool GreaterThanOrEqual(Digits A, Digits B) {
+  return Compare(A, B) >= 0;
+}
+
+inline int BitLength(Digits X) {
+  return X.len() * kDigitBits - CountLeadingZeros(X.msd());
+}
+
+}  // namespace bigint
+}  // namespace v8
+
+#endif  // V8_BIGINT_VECTOR_ARITHMETIC_H_
@@ -56,6 +56,7 @@
 #include "src/parsing/pending-compilation-error-handler.h"
 #include "src/parsing/scanner-character-streams.h"
 #include "src/snapshot/code-serializer.h"
+#include "src/snapshot/persistent-code-cache.h"
 #include "src/utils/ostreams.h"
 #include "src/zone/zone-list-inl.h"  // crbug.com/v8/8816
 
@@ -641,77 +642,6 @@ void UpdateSharedFunctionFlagsAfterCompilation(FunctionLiteral* literal,
   shared_info.SetScopeInfo(*literal->scope()->scope_info());
 }
 
-bool CanCompileWithBaseline(Isolate* isolate,
-                            Handle<SharedFunctionInfo> shared) {
-  // Check if we actually have bytecode.
-  if (!shared->HasBytecodeArray()) return false;
-
-  // Do not optimize when debugger needs to hook into every call.
-  if (isolate->debug()->needs_check_on_function_call()) return false;
-
-  // Functions with breakpoints have to stay interpreted.
-  if (shared->HasBreakInfo()) return false;
-
-  // Do not baseline compile if sparkplug is disabled or function doesn't pass
-  // sparkplug_filter.
-  if (!FLAG_sparkplug || !shared->PassesFilter(FLAG_sparkplug_filter)) {
-    return false;
-  }
-
-  return true;
-}
-
-bool CompileSharedWithBaseline(Isolate* isolate,
-                               Handle<SharedFunctionInfo> shared,
-                               Compiler::ClearExceptionFlag flag,
-                               IsCompiledScope* is_compiled_scope) {
-  // We shouldn't be passing uncompiled functions into this function.
-  DCHECK(is_compiled_scope->is_compiled());
-
-  // Early return for already baseline-compiled functions.
-  if (shared->HasBaselineData()) return true;
-
-  // Check if we actually can compile with baseline.
-  if (!CanCompileWithBaseline(isolate, shared)) return false;
-
-  StackLimitCheck check(isolate);
-  if (check.JsHasOverflowed(kStackSpaceRequiredForCompilation * KB)) {
-    if (flag == Compiler::KEEP_EXCEPTION) {
-      isolate->StackOverflow();
-    }
-    return false;
-  }
-
-  CompilerTracer::TraceStartBaselineCompile(isolate, shared);
-  Handle<Code> code;
-  base::TimeDelta time_taken;
-  {
-    ScopedTimer timer(&time_taken);
-    if (!GenerateBaselineCode(isolate, shared).ToHandle(&code)) {
-      // TODO(leszeks): This can only fail because of an OOM. Do we want to
-      // report these somehow, or silently ignore them?
-      return false;
-    }
-
-    Handle<HeapObject> function_data =
-        handle(HeapObject::cast(shared->function_data(kAcquireLoad)), isolate);
-    Handle<BaselineData> baseline_data =
-        isolate->factory()->NewBaselineData(code, function_data);
-    shared->set_baseline_data(*baseline_data);
-  }
-  double time_taken_ms = time_taken.InMillisecondsF();
-
-  CompilerTracer::TraceFinishBaselineCompile(isolate, shared, time_taken_ms);
-
-  if (shared->script().IsScript()) {
-    Compiler::LogFunctionCompilation(
-        isolate, CodeEventListener::FUNCTION_TAG, shared,
-        handle(Script::cast(shared->script()), isolate),
-        Handle<AbstractCode>::cast(code), CodeKind::BASELINE, time_taken_ms);
-  }
-  return true;
-}
-
 // Finalize a single compilation job. This function can return
 // RETRY_ON_MAIN_THREAD if the job cannot be finalized off-thread, in which case
 // it should be safe to call it again on the main thread with the same job.
@@ -1414,8 +1344,8 @@ void CompileAllWithBaseline(Isolate* isolate,
     IsCompiledScope is_compiled_scope(*shared_info, isolate);
     if (!is_compiled_scope.is_compiled()) continue;
     if (!CanCompileWithBaseline(isolate, shared_info)) continue;
-    CompileSharedWithBaseline(isolate, shared_info, Compiler::CLEAR_EXCEPTION,
-                              &is_compiled_scope);
+    Compiler::CompileSharedWithBaseline(
+        isolate, shared_info, Compiler::CLEAR_EXCEPTION, &is_compiled_scope);
   }
 }
 
@@ -1783,6 +1713,37 @@ Handle<Script> BackgroundCompileTask::GetScript(Isolate* isolate) {
   return handle(*script_, isolate);
 }
 
+BackgroundDeserializeTask::BackgroundDeserializeTask(
+    Isolate* isolate, std::unique_ptr<ScriptCompiler::CachedData> cached_data)
+    : isolate_for_local_isolate_(isolate),
+      cached_data_(std::move(cached_data)),
+      // ScriptData takes care of pointer-aligning the data.
+      script_data_(std::make_unique<ScriptData>(cached_data_->data,
+                                                cached_data_->length)) {}
+
+BackgroundDeserializeTask::~BackgroundDeserializeTask() = default;
+
+void BackgroundDeserializeTask::Run() {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+               "V8.DeserializeBackground");
+  LocalIsolate isolate(isolate_for_local_isolate_, ThreadKind::kBackground);
+  UnparkedScope unparked_scope(&isolate);
+  LocalHandleScope handle_scope(&isolate);
+  off_thread_data_ =
+      CodeSerializer::StartDeserializeOffThread(&isolate, script_data_.get());
+}
+
+MaybeHandle<SharedFunctionInfo> BackgroundDeserializeTask::Finish(
+    Isolate* isolate, Handle<String> source,
+    ScriptOriginOptions origin_options) {
+  MaybeHandle<SharedFunctionInfo> result =
+      CodeSerializer::FinishOffThreadDeserialize(
+          isolate, std::move(off_thread_data_), script_data_.get(), source,
+          origin_options);
+  cached_data_->rejected = script_data_->rejected();
+  return result;
+}
+
 // ----------------------------------------------------------------------------
 // Implementation of Compiler
 
@@ -2024,6 +1985,64 @@ bool Compiler::Compile(Isolate* isolate, Handle<JSFunction> function,
   return true;
 }
 
+// static
+bool Compiler::CompileSharedWithBaseline(Isolate* isolate,
+                                         Handle<SharedFunctionInfo> shared,
+                                         Compiler::ClearExceptionFlag flag,
+                                         IsCompiledScope* is_compiled_scope) {
+  // We shouldn't be passing uncompiled functions into this function.
+  DCHECK(is_compiled_scope->is_compiled());
+
+  // Early return for already baseline-compiled functions.
+  if (shared->HasBaselineData()) return true;
+
+  // Check if we actually can compile with baseline.
+  if (!CanCompileWithBaseline(isolate, shared)) return false;
+
+  StackLimitCheck check(isolate);
+  if (check.JsHasOverflowed(kStackSpaceRequiredForCompilation * KB)) {
+    if (flag == Compiler::KEEP_EXCEPTION) {
+      isolate->StackOverflow();
+    }
+    return false;
+  }
+
+  CompilerTracer::TraceStartBaselineCompile(isolate, shared);
+  Handle<Code> code;
+  base::TimeDelta time_taken;
+  {
+    ScopedTimer timer(&time_taken);
+    if (!GenerateBaselineCode(isolate, shared).ToHandle(&code)) {
+      // TODO(leszeks): This can only fail because of an OOM. Do we want to
+      // report these somehow, or silently ignore them?
+      return false;
+    }
+  }
+  InstallBaselineCode(isolate, shared, code, time_taken.InMillisecondsF());
+  return true;
+}
+
+// static
+void Compiler::InstallBaselineCode(Isolate* isolate,
+                                   Handle<SharedFunctionInfo> shared,
+                                   Handle<Code> code, double time_taken_ms) {
+  DCHECK(!shared->HasBaselineData());
+  Handle<HeapObject> function_data =
+      handle(HeapObject::cast(shared->function_data(kAcquireLoad)), isolate);
+  Handle<BaselineData> baseline_data =
+      isolate->factory()->NewBaselineData(code, function_data);
+  shared->set_baseline_data(*baseline_data);
+
+  CompilerTracer::TraceFinishBaselineCompile(isolate, shared, time_taken_ms);
+
+  if (shared->script().IsScript()) {
+    Compiler::LogFunctionCompilation(
+        isolate, CodeEventListener::FUNCTION_TAG, shared,
+        handle(Script::cast(shared->script()), isolate),
+        Handle<AbstractCode>::cast(code), CodeKind::BASELINE, time_taken_ms);
+  }
+}
+
 // static
 bool Compiler::CompileBaseline(Isolate* isolate, Handle<JSFunction> function,
                                ClearExceptionFlag flag,
@@ -2829,23 +2848,24 @@ MaybeHandle<SharedFunctionInfo> CompileScriptOnBothBackgroundAndMainThread(
   return maybe_result;
 }
 
-}  // namespace
-
-// static
-MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
+MaybeHandle<SharedFunctionInfo> GetSharedFunctionInfoForScriptImpl(
     Isolate* isolate, Handle<String> source,
     const Compiler::ScriptDetails& script_details,
     ScriptOriginOptions origin_options, v8::Extension* extension,
-    ScriptData* cached_data, ScriptCompiler::CompileOptions compile_options,
+    ScriptData* cached_data, BackgroundDeserializeTask* deserialize_task,
+    ScriptCompiler::CompileOptions compile_options,
     ScriptCompiler::NoCacheReason no_cache_reason, NativesFlag natives) {
   ScriptCompileTimerScope compile_timer(isolate, no_cache_reason);
 
   if (compile_options == ScriptCompiler::kNoCompileOptions ||
       compile_options == ScriptCompiler::kEagerCompile) {
     DCHECK_NULL(cached_data);
+    DCHECK_NULL(deserialize_task);
   } else {
     DCHECK(compile_options == ScriptCompiler::kConsumeCodeCache);
-    DCHECK(cached_data);
+    // Have to have exactly one of cached_data or deserialize_task.
+    DCHECK(cached_data || deserialize_task);
+    DCHECK(!(cached_data && deserialize_task));
     DCHECK_NULL(extension);
   }
   int source_length = source->length();
@@ -2859,6 +2879,13 @@ MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
   // nor put the compilation result back into the cache.
   const bool use_compilation_cache =
       extension == nullptr && script_details.repl_mode == REPLMode::kNo;
+  // Scripts that are not consumed from embedder-provided cached data can use
+  // the on-disk code cache, if one was configured.
+  PersistentCodeCache* persistent_code_cache =
+      use_compilation_cache && natives == NOT_NATIVES_CODE &&
+              compile_options != ScriptCompiler::kConsumeCodeCache
+          ? isolate->persistent_code_cache()
+          : nullptr;
   MaybeHandle<SharedFunctionInfo> maybe_result;
   IsCompiledScope is_compiled_scope;
   if (use_compilation_cache) {
@@ -2883,10 +2910,13 @@ MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
           isolate, RuntimeCallCounterId::kCompileDeserialize);
       TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
                    "V8.CompileDeserialize");
+      MaybeHandle<SharedFunctionInfo> maybe_inner_result =
+          deserialize_task
+              ? deserialize_task->Finish(isolate, source, origin_options)
+              : CodeSerializer::Deserialize(isolate, cached_data, source,
+                                            origin_options);
       Handle<SharedFunctionInfo> inner_result;
-      if (CodeSerializer::Deserialize(isolate, cached_data, source,
-                                      origin_options)
-              .ToHandle(&inner_result) &&
+      if (maybe_inner_result.ToHandle(&inner_result) &&
           inner_result->is_compiled()) {
         // Promote to per-isolate compilation cache.
         is_compiled_scope = inner_result->is_compiled_scope(isolate);
@@ -2899,6 +2929,56 @@ MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
         // Deserializer failed. Fall through to compile.
         compile_timer.set_consuming_code_cache_failed();
       }
+    } else if (persistent_code_cache != nullptr) {
+      // Then check the on-disk code cache.
+      std::unique_ptr<PersistentCodeCache::Entry> entry =
+          persistent_code_cache->Lookup(isolate, source, origin_options);
+      if (entry) {
+        compile_timer.set_consuming_code_cache();
+        HistogramTimerScope timer(isolate->counters()->compile_deserialize());
+        RuntimeCallTimerScope runtimeTimer(
+            isolate, RuntimeCallCounterId::kCompileDeserialize);
+        TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+                     "V8.CompileDeserialize");
+        // The payload of an entry is pointer-aligned, so ScriptData reads it
+        // from the mapping without a copy.
+        ScriptData script_data(entry->data(), entry->length());
+        Handle<SharedFunctionInfo> inner_result;
+        if (CodeSerializer::Deserialize(isolate, &script_data, source,
+                                        origin_options)
+                .ToHandle(&inner_result) &&
+            inner_result->is_compiled()) {
+          // The entry is keyed by the source only, so the script carries the
+          // name and position of whichever script was stored. Replace them
+          // with the ones of this script.
+          {
+            DisallowGarbageCollection no_gc;
+            Script script = Script::cast(inner_result->script());
+            if (script_details.name_obj.is_null()) {
+              script.set_name(ReadOnlyRoots(isolate).undefined_value());
+              script.set_line_offset(0);
+              script.set_column_offset(0);
+            }
+            SetScriptFieldsFromDetails(isolate, script, script_details,
+                                       &no_gc);
+            LOG(isolate, ScriptDetails(script));
+          }
+          // Promote to per-isolate compilation cache.
+          is_compiled_scope = inner_result->is_compiled_scope(isolate);
+          DCHECK(is_compiled_scope.is_compiled());
+          compilation_cache->PutScript(source, isolate->native_context(),
+                                       language_mode, inner_result);
+          // Store the script again after it ran, in case it compiles more
+          // functions than the cached entry contains.
+          persistent_code_cache->ScheduleStoreScript(isolate, inner_result);
+          maybe_result = inner_result;
+        } else {
+          // The entry is stale, e.g. because of a CPU feature mismatch.
+          // Drop it and fall through to compile.
+          compile_timer.set_consuming_code_cache_failed();
+          persistent_code_cache->Remove(isolate, source, origin_options);
+        }
+      }
     }
   }
 
@@ -2932,6 +3012,9 @@ MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
       DCHECK(is_compiled_scope.is_compiled());
       compilation_cache->PutScript(source, isolate->native_context(),
                                    language_mode, result);
+      if (persistent_code_cache != nullptr) {
+        persistent_code_cache->ScheduleStoreScript(isolate, result);
+      }
     } else if (maybe_result.is_null() && natives != EXTENSION_CODE) {
       isolate->ReportPendingMessages();
     }
@@ -2940,6 +3023,34 @@ MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
   return maybe_result;
 }
 
+}  // namespace
+
+// static
+MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
+    Isolate* isolate, Handle<String> source,
+    const Compiler::ScriptDetails& script_details,
+    ScriptOriginOptions origin_options, v8::Extension* extension,
+    ScriptData* cached_data, ScriptCompiler::CompileOptions compile_options,
+    ScriptCompiler::NoCacheReason no_cache_reason, NativesFlag natives) {
+  return GetSharedFunctionInfoForScriptImpl(
+      isolate, source, script_details, origin_options, extension, cached_data,
+      nullptr, compile_options, no_cache_reason, natives);
+}
+
+// static
+MaybeHandle<SharedFunctionInfo>
+Compiler::GetSharedFunctionInfoForScriptWithDeserializeTask(
+    Isolate* isolate, Handle<String> source,
+    const Compiler::ScriptDetails& script_details,
+    ScriptOriginOptions origin_options,
+    BackgroundDeserializeTask* deserialize_task,
+    ScriptCompiler::CompileOptions compile_options,
+    ScriptCompiler::NoCacheReason no_cache_reason, NativesFlag natives) {
+  return GetSharedFunctionInfoForScriptImpl(
+      isolate, source, script_details, origin_options, nullptr, nullptr,
+      deserialize_task, compile_options, no_cache_reason, natives);
+}
+
 // static
 MaybeHandle<JSFunction> Compiler::GetWrappedFunction(
     Handle<String> source, Handle<FixedArray> arguments,
@@ -19,6 +19,7 @@
 #include "src/objects/debug-objects.h"
 #include "src/parsing/parse-info.h"
 #include "src/parsing/pending-compilation-error-handler.h"
+#include "src/snapshot/code-serializer.h"
 #include "src/utils/allocation.h"
 #include "src/zone/zone.h"
 
@@ -28,6 +29,7 @@ namespace internal {
 // Forward declarations.
 class AstRawString;
 class BackgroundCompileTask;
+class BackgroundDeserializeTask;
 class IsCompiledScope;
 class JavaScriptFrame;
 class OptimizedCompilationInfo;
@@ -74,6 +76,16 @@ class V8_EXPORT_PRIVATE Compiler : public AllStatic {
   static bool CompileBaseline(Isolate* isolate, Handle<JSFunction> function,
                               ClearExceptionFlag flag,
                               IsCompiledScope* is_compiled_scope);
+  // Compiles {shared} with Sparkplug without installing the code on any
+  // closure; closures pick it up from {shared} on their next call.
+  static bool CompileSharedWithBaseline(Isolate* isolate,
+                                        Handle<SharedFunctionInfo> shared,
+                                        ClearExceptionFlag flag,
+                                        IsCompiledScope* is_compiled_scope);
+  // Attaches Sparkplug {code} that was generated for {shared} to it.
+  static void InstallBaselineCode(Isolate* isolate,
+                                  Handle<SharedFunctionInfo> shared,
+                                  Handle<Code> code, double time_taken_ms);
   static bool CompileOptimized(Isolate* isolate, Handle<JSFunction> function,
                                ConcurrencyMode mode, CodeKind code_kind);
   static MaybeHandle<SharedFunctionInfo> CompileToplevel(
@@ -188,6 +200,18 @@ class V8_EXPORT_PRIVATE Compiler : public AllStatic {
       const ScriptDetails& script_details, ScriptOriginOptions origin_options,
       ScriptStreamingData* streaming_data);
 
+  // Create a shared function info object for a String source, consuming the
+  // code cache that |deserialize_task| has deserialized on a background
+  // thread. Falls back to compiling the source if the code cache is rejected.
+  static MaybeHandle<SharedFunctionInfo>
+  GetSharedFunctionInfoForScriptWithDeserializeTask(
+      Isolate* isolate, Handle<String> source,
+      const ScriptDetails& script_details, ScriptOriginOptions origin_options,
+      BackgroundDeserializeTask* deserialize_task,
+      ScriptCompiler::CompileOptions compile_options,
+      ScriptCompiler::NoCacheReason no_cache_reason,
+      NativesFlag is_natives_code);
+
   // Create a shared function info object for the given function literal
   // node (the code may be lazily compiled).
   template <typename LocalIsolate>
@@ -551,6 +575,35 @@ class V8_EXPORT_PRIVATE BackgroundCompileTask {
   LanguageMode language_mode_;
 };
 
+// A task that deserializes a code cache on a background thread into a
+// LocalHeap. The result is finalized on the main thread with
+// Compiler::GetSharedFunctionInfoForScriptWithDeserializeTask, once the source
+// string is available.
+class V8_EXPORT_PRIVATE BackgroundDeserializeTask {
+ public:
+  BackgroundDeserializeTask(Isolate* isolate,
+                            std::unique_ptr<ScriptCompiler::CachedData> data);
+  BackgroundDeserializeTask(const BackgroundDeserializeTask&) = delete;
+  BackgroundDeserializeTask& operator=(const BackgroundDeserializeTask&) =
+      delete;
+  ~BackgroundDeserializeTask();
+
+  void Run();
+
+  MaybeHandle<SharedFunctionInfo> Finish(Isolate* isolate,
+                                         Handle<String> source,
+                                         ScriptOriginOptions origin_options);
+
+  // Whether the code cache was rejected. Only valid after Finish.
+  bool rejected() const { return script_data_->rejected(); }
+
+ private:
+  Isolate* isolate_for_local_isolate_;
+  std::unique_ptr<ScriptCompiler::CachedData> cached_data_;
+  std::unique_ptr<ScriptData> script_data_;
+  CodeSerializer::OffThreadDeserializeData off_thread_data_;
+};
+
 // Contains all data which needs to be transmitted between threads for
 // background parsing and compiling and finalizing it on the main thread.
 struct ScriptStreamingData {
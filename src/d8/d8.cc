@@ -118,6 +118,10 @@ bool fuzzilli_reprl = false;
 const int kMaxSerializerMemoryUsage =
     1 * kMB;  // Arbitrary maximum for testing.
 
+// Strings and ArrayBuffers of at least this many bytes which are posted as the
+// message itself bypass the ValueSerializer.
+const size_t kLargeMessageSize = 64 * 1024;
+
 // Base class for shell ArrayBuffer allocators. It forwards all opertions to
 // the default v8 allocator.
 class ArrayBufferAllocatorBase : public v8::ArrayBuffer::Allocator {
@@ -437,6 +441,26 @@ static platform::tracing::TraceConfig* CreateTraceConfigFromJSON(
 
 }  // namespace tracing
 
+// Owns the contents of a large string message, see SerializationData.
+template <typename Base, typename Char>
+class MessageStringResource : public Base {
+ public:
+  explicit MessageStringResource(size_t length)
+      : data_(new Char[length]), length_(length) {}
+  const Char* data() const override { return data_.get(); }
+  size_t length() const override { return length_; }
+  Char* writable_data() { return data_.get(); }
+
+ private:
+  std::unique_ptr<Char[]> data_;
+  size_t length_;
+};
+
+using OneByteMessageStringResource =
+    MessageStringResource<String::ExternalOneByteStringResource, char>;
+using TwoByteMessageStringResource =
+    MessageStringResource<String::ExternalStringResource, uint16_t>;
+
 class ExternalOwningOneByteStringResource
     : public String::ExternalOneByteStringResource {
  public:
@@ -718,6 +742,10 @@ bool Shell::ExecuteString(Isolate* isolate, Local<String> source,
           ScriptCompiler::CreateCodeCache(script->GetUnboundScript());
       StoreInCodeCache(isolate, source, cached_data);
       delete cached_data;
+      // Also include the lazily compiled functions in the on-disk cache.
+      if (options.code_cache_dir != nullptr) {
+        ScriptCompiler::UpdatePersistentCodeCache(script->GetUnboundScript());
+      }
     }
     if (process_message_queue) {
       if (!EmptyMessageQueues(isolate)) success = false;
@@ -1354,18 +1382,29 @@ bool Shell::ExecuteWebSnapshot(Isolate* isolate, const char* file_name) {
 
   TryCatch try_catch(isolate);
   try_catch.SetVerbose(true);
-  int length = 0;
-  std::unique_ptr<uint8_t[]> snapshot_data(
-      reinterpret_cast<uint8_t*>(ReadChars(absolute_path.c_str(), &length)));
-  if (length == 0) {
+  FILE* file = base::OS::FOpen(absolute_path.c_str(), "rb");
+  if (file == nullptr) {
     Throw(isolate, "Error reading the web snapshot");
     DCHECK(try_catch.HasCaught());
     ReportException(isolate, &try_catch);
     return false;
   }
-  i::WebSnapshotDeserializer deserializer(isolate);
-  if (!deserializer.UseWebSnapshot(snapshot_data.get(),
-                                   static_cast<size_t>(length))) {
+  // Stream the snapshot into the deserializer, so that the sections received
+  // so far are deserialized while the rest is being read.
+  i::WebSnapshotDeserializer deserializer(
+      isolate, options.web_snapshot_lazy
+                   ? i::WebSnapshotDeserializer::Mode::kLazy
+                   : i::WebSnapshotDeserializer::Mode::kEager);
+  static const size_t kChunkSize = 64 * i::KB;
+  std::unique_ptr<uint8_t[]> chunk(new uint8_t[kChunkSize]);
+  bool success = true;
+  while (success) {
+    size_t length = fread(chunk.get(), 1, kChunkSize, file);
+    if (length == 0) break;
+    success = deserializer.AppendChunk(chunk.get(), length);
+  }
+  base::Fclose(file);
+  if (!success || !deserializer.FinishStreaming()) {
     DCHECK(try_catch.HasCaught());
     ReportException(isolate, &try_catch);
     return false;
@@ -1893,6 +1932,52 @@ void Shell::TestVerifySourcePositions(
   }
 }
 
+void Shell::JsonParseStreaming(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope handle_scope(isolate);
+  Local<Context> context = isolate->GetCurrentContext();
+  if (args.Length() < 1 || !args[0]->IsArray()) {
+    Throw(isolate, "Expected an array of chunks as first argument.");
+    return;
+  }
+  JSON::StreamingParser::Encoding encoding = JSON::StreamingParser::UTF8;
+  if (args.Length() > 1) {
+    String::Utf8Value name(isolate, args[1]);
+    if (*name && strcmp(*name, "latin1") == 0) {
+      encoding = JSON::StreamingParser::ONE_BYTE;
+    } else if (*name && strcmp(*name, "utf16") == 0) {
+      encoding = JSON::StreamingParser::TWO_BYTE;
+    } else if (!*name || strcmp(*name, "utf8") != 0) {
+      Throw(isolate, "Expected 'latin1', 'utf8' or 'utf16' as encoding.");
+      return;
+    }
+  }
+
+  // Each chunk is a typed array or DataView with the bytes of the text.
+  JSON::StreamingParser parser(isolate, encoding);
+  Local<Array> chunks = args[0].As<Array>();
+  std::vector<uint8_t> bytes;
+  for (uint32_t i = 0; i < chunks->Length(); i++) {
+    Local<Value> chunk;
+    if (!chunks->Get(context, i).ToLocal(&chunk)) return;
+    if (!chunk->IsArrayBufferView()) {
+      Throw(isolate, "Expected chunks to be typed arrays or DataViews.");
+      return;
+    }
+    Local<ArrayBufferView> view = chunk.As<ArrayBufferView>();
+    bytes.resize(view->ByteLength());
+    view->CopyContents(bytes.data(), bytes.size());
+    if (parser.AppendChunk(context, bytes.data(), bytes.size()).IsNothing()) {
+      return;
+    }
+  }
+  Local<Value> result;
+  if (parser.Finish(context).ToLocal(&result)) {
+    args.GetReturnValue().Set(result);
+  }
+}
+
 // async_hooks.createHook() registers functions to be called for different
 // lifetime events of each async operation.
 void Shell::AsyncHooksCreateHook(
@@ -2719,6 +2804,12 @@ Local<ObjectTemplate> Shell::CreateD8Template(Isolate* isolate) {
         FunctionTemplate::New(isolate, TestVerifySourcePositions));
     d8_template->Set(isolate, "test", test_template);
   }
+  {
+    Local<ObjectTemplate> json_template = ObjectTemplate::New(isolate);
+    json_template->Set(isolate, "parseStreaming",
+                       FunctionTemplate::New(isolate, JsonParseStreaming));
+    d8_template->Set(isolate, "json", json_template);
+  }
   return d8_template;
 }
 
@@ -3525,6 +3616,7 @@ SourceGroup::IsolateThread::IsolateThread(SourceGroup* group)
 void SourceGroup::ExecuteInThread() {
   Isolate::CreateParams create_params;
   create_params.array_buffer_allocator = Shell::array_buffer_allocator;
+  create_params.code_cache_directory = Shell::options.code_cache_dir;
   Isolate* isolate = Isolate::New(create_params);
   Shell::SetWaitUntilDone(isolate, false);
   D8Console console(isolate);
@@ -3574,29 +3666,44 @@ void SourceGroup::JoinThread() {
   thread_->Join();
 }
 
+SerializationDataQueue::SerializationDataQueue()
+    : head_(new Node()), tail_(head_) {}
+
+SerializationDataQueue::~SerializationDataQueue() {
+  while (head_ != nullptr) {
+    Node* next = head_->next.load(std::memory_order_relaxed);
+    delete head_;
+    head_ = next;
+  }
+}
+
 void SerializationDataQueue::Enqueue(std::unique_ptr<SerializationData> data) {
-  base::MutexGuard lock_guard(&mutex_);
-  data_.push_back(std::move(data));
+  Node* node = new Node();
+  node->data = std::move(data);
+  // Publishes the data to the consumer.
+  tail_->next.store(node, std::memory_order_release);
+  tail_ = node;
 }
 
 bool SerializationDataQueue::Dequeue(
     std::unique_ptr<SerializationData>* out_data) {
   out_data->reset();
-  base::MutexGuard lock_guard(&mutex_);
-  if (data_.empty()) return false;
-  *out_data = std::move(data_[0]);
-  data_.erase(data_.begin());
+  Node* next = head_->next.load(std::memory_order_acquire);
+  if (next == nullptr) return false;
+  *out_data = std::move(next->data);
+  delete head_;
+  head_ = next;
   return true;
 }
 
 bool SerializationDataQueue::IsEmpty() {
-  base::MutexGuard lock_guard(&mutex_);
-  return data_.empty();
+  return head_->next.load(std::memory_order_acquire) == nullptr;
 }
 
 void SerializationDataQueue::Clear() {
-  base::MutexGuard lock_guard(&mutex_);
-  data_.clear();
+  std::unique_ptr<SerializationData> data;
+  while (Dequeue(&data)) {
+  }
 }
 
 Worker::Worker(const char* script) : script_(i::StrDup(script)) {
@@ -3759,6 +3866,7 @@ void Worker::ProcessMessages() {
 void Worker::ExecuteInThread() {
   Isolate::CreateParams create_params;
   create_params.array_buffer_allocator = Shell::array_buffer_allocator;
+  create_params.code_cache_directory = Shell::options.code_cache_dir;
   isolate_ = Isolate::New(create_params);
   {
     base::MutexGuard lock_guard(&worker_mutex_);
@@ -3991,6 +4099,9 @@ bool Shell::SetOptions(int argc, char* argv[]) {
         return false;
       }
       argv[i] = nullptr;
+    } else if (strncmp(argv[i], "--code-cache-dir=", 17) == 0) {
+      options.code_cache_dir = argv[i] + 17;
+      argv[i] = nullptr;
     } else if (strcmp(argv[i], "--streaming-compile") == 0) {
       options.streaming_compile = true;
       argv[i] = nullptr;
@@ -4044,6 +4155,9 @@ bool Shell::SetOptions(int argc, char* argv[]) {
     } else if (strncmp(argv[i], "--web-snapshot-config=", 22) == 0) {
       options.web_snapshot_config = argv[i] + 22;
       argv[i] = nullptr;
+    } else if (strcmp(argv[i], "--web-snapshot-lazy") == 0) {
+      options.web_snapshot_lazy = true;
+      argv[i] = nullptr;
 #ifdef V8_FUZZILLI
     } else if (strcmp(argv[i], "--no-fuzzilli-enable-builtins-coverage") == 0) {
       options.fuzzilli_enable_builtins_coverage = false;
@@ -4324,6 +4438,9 @@ class Serializer : public ValueSerializer::Delegate {
     bool ok;
     DCHECK(!data_);
     data_.reset(new SerializationData);
+    if (transfer->IsUndefined() && WriteLargeValue(value)) {
+      return Just(true);
+    }
     if (!PrepareTransfer(context, transfer).To(&ok)) {
       return Nothing<bool>();
     }
@@ -4404,6 +4521,48 @@ class Serializer : public ValueSerializer::Delegate {
   void FreeBufferMemory(void* buffer) override { base::Free(buffer); }
 
  private:
+  static bool IsLargeMessage(size_t byte_length) {
+    return byte_length >= kLargeMessageSize &&
+           byte_length <= static_cast<size_t>(kMaxSerializerMemoryUsage);
+  }
+
+  // Copies the contents of a large string or ArrayBuffer into {data_}, so
+  // that the receiver can use them without another copy. Returns false if the
+  // value needs to go through the ValueSerializer instead.
+  bool WriteLargeValue(Local<Value> value) {
+    if (value->IsString()) {
+      Local<String> string = value.As<String>();
+      int length = string->Length();
+      if (string->IsOneByte()) {
+        if (!IsLargeMessage(length)) return false;
+        auto resource = std::make_unique<OneByteMessageStringResource>(length);
+        string->WriteOneByte(
+            isolate_, reinterpret_cast<uint8_t*>(resource->writable_data()), 0,
+            length, String::NO_NULL_TERMINATION);
+        data_->one_byte_string_ = std::move(resource);
+      } else {
+        if (!IsLargeMessage(length * sizeof(uint16_t))) return false;
+        auto resource = std::make_unique<TwoByteMessageStringResource>(length);
+        string->Write(isolate_, resource->writable_data(), 0, length,
+                      String::NO_NULL_TERMINATION);
+        data_->two_byte_string_ = std::move(resource);
+      }
+      return true;
+    }
+    if (value->IsArrayBuffer()) {
+      Local<ArrayBuffer> array_buffer = value.As<ArrayBuffer>();
+      size_t byte_length = array_buffer->ByteLength();
+      if (!IsLargeMessage(byte_length)) return false;
+      std::unique_ptr<BackingStore> backing_store =
+          ArrayBuffer::NewBackingStore(isolate_, byte_length);
+      memcpy(backing_store->Data(), array_buffer->GetBackingStore()->Data(),
+             byte_length);
+      data_->array_buffer_ = std::move(backing_store);
+      return true;
+    }
+    return false;
+  }
+
   Maybe<bool> PrepareTransfer(Local<Context> context, Local<Value> transfer) {
     if (transfer->IsArray()) {
       Local<Array> transfer_array = transfer.As<Array>();
@@ -4481,6 +4640,20 @@ class Deserializer : public ValueDeserializer::Delegate {
   Deserializer& operator=(const Deserializer&) = delete;
 
   MaybeLocal<Value> ReadValue(Local<Context> context) {
+    if (data_->one_byte_string_) {
+      return String::NewExternalOneByte(isolate_,
+                                        data_->one_byte_string_.release())
+          .FromMaybe(Local<String>());
+    }
+    if (data_->two_byte_string_) {
+      return String::NewExternalTwoByte(isolate_,
+                                        data_->two_byte_string_.release())
+          .FromMaybe(Local<String>());
+    }
+    if (data_->array_buffer_) {
+      return ArrayBuffer::New(isolate_, std::move(data_->array_buffer_));
+    }
+
     bool read_header;
     if (!deserializer_.ReadHeader(context).To(&read_header)) {
       return MaybeLocal<Value>();
@@ -4744,6 +4917,7 @@ int Shell::Main(int argc, char* argv[]) {
   create_params.constraints.ConfigureDefaults(
       base::SysInfo::AmountOfPhysicalMemory(),
       base::SysInfo::AmountOfVirtualMemory());
+  create_params.code_cache_directory = options.code_cache_dir;
 
   Shell::counter_map_ = new CounterMap();
   if (i::FLAG_dump_counters || i::FLAG_dump_counters_nvp ||
@@ -151,20 +151,46 @@ class SerializationData {
   std::vector<std::shared_ptr<v8::BackingStore>> sab_backing_stores_;
   std::vector<CompiledWasmModule> compiled_wasm_modules_;
 
+  // Large strings and ArrayBuffers which are posted as the message itself
+  // don't go through the ValueSerializer. Their contents are copied once by
+  // the sender, and the receiver uses that copy in place, as an external
+  // string or as the backing store of a new ArrayBuffer.
+  std::unique_ptr<v8::String::ExternalOneByteStringResource> one_byte_string_;
+  std::unique_ptr<v8::String::ExternalStringResource> two_byte_string_;
+  std::shared_ptr<v8::BackingStore> array_buffer_;
+
  private:
   friend class Serializer;
+  friend class Deserializer;
 };
 
+// A lock-free queue for passing messages from a single producer thread to a
+// single consumer thread.
 class SerializationDataQueue {
  public:
+  SerializationDataQueue();
+  ~SerializationDataQueue();
+  SerializationDataQueue(const SerializationDataQueue&) = delete;
+  SerializationDataQueue& operator=(const SerializationDataQueue&) = delete;
+
+  // Only called by the producer thread.
   void Enqueue(std::unique_ptr<SerializationData> data);
+  // Only called by the consumer thread.
   bool Dequeue(std::unique_ptr<SerializationData>* data);
   bool IsEmpty();
   void Clear();
 
  private:
-  base::Mutex mutex_;
-  std::vector<std::unique_ptr<SerializationData>> data_;
+  struct Node {
+    std::unique_ptr<SerializationData> data;
+    std::atomic<Node*> next{nullptr};
+  };
+
+  // {head_} is owned by the consumer and {tail_} by the producer. The head
+  // node is a dummy whose successors hold the queued messages, so the
+  // consumer never deletes the node the producer appends to.
+  Node* head_;
+  Node* tail_;
 };
 
 class Worker : public std::enable_shared_from_this<Worker> {
@@ -215,6 +241,8 @@ class Worker : public std::enable_shared_from_this<Worker> {
   void ExecuteInThread();
   static void PostMessageOut(const v8::FunctionCallbackInfo<v8::Value>& args);
 
+  // Messages posted by the worker thread, read by the thread that created the
+  // Worker.
   base::Semaphore out_semaphore_{0};
   SerializationDataQueue out_queue_;
   base::Thread* thread_ = nullptr;
@@ -376,6 +404,8 @@ class ShellOptions {
       compile_options = {"cache", v8::ScriptCompiler::kNoCompileOptions};
   DisallowReassignment<CodeCacheOptions, true> code_cache_options = {
       "cache", CodeCacheOptions::kNoProduceCache};
+  DisallowReassignment<const char*> code_cache_dir = {"code-cache-dir",
+                                                      nullptr};
   DisallowReassignment<bool> streaming_compile = {"streaming-compile", false};
   DisallowReassignment<SourceGroup*> isolate_sources = {"isolate-sources",
                                                         nullptr};
@@ -403,6 +433,7 @@ class ShellOptions {
       "enable-system-instrumentation", false};
   DisallowReassignment<const char*> web_snapshot_config = {
       "web-snapshot-config", nullptr};
+  DisallowReassignment<bool> web_snapshot_lazy = {"web-snapshot-lazy", false};
 };
 
 class Shell : public i::AllStatic {
@@ -475,6 +506,8 @@ class Shell : public i::AllStatic {
   static void LogGetAndStop(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void TestVerifySourcePositions(
       const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void JsonParseStreaming(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
 
   static void AsyncHooksCreateHook(
       const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -22,6 +22,8 @@
 #include "src/base/platform/platform.h"
 #include "src/base/sys-info.h"
 #include "src/base/utils/random-number-generator.h"
+#include "src/baseline/baseline-batch-compiler.h"
+#include "src/bigint/bigint.h"
 #include "src/builtins/builtins-promise.h"
 #include "src/builtins/constants-table-builder.h"
 #include "src/codegen/assembler-inl.h"
@@ -82,6 +84,7 @@
 #include "src/regexp/regexp-stack.h"
 #include "src/snapshot/embedded/embedded-data.h"
 #include "src/snapshot/embedded/embedded-file-writer-interface.h"
+#include "src/snapshot/persistent-code-cache.h"
 #include "src/snapshot/read-only-deserializer.h"
 #include "src/snapshot/startup-deserializer.h"
 #include "src/strings/string-builder-inl.h"
@@ -3031,6 +3034,10 @@ void Isolate::Deinit() {
 
   debug()->Unload();
 
+  // Store the scripts whose store task has not run yet, while the heap is
+  // still intact.
+  if (persistent_code_cache_) persistent_code_cache_->StorePendingScripts(this);
+
 #if V8_ENABLE_WEBASSEMBLY
   wasm_engine()->DeleteCompileJobsOnIsolate(this);
 
@@ -3043,6 +3050,9 @@ void Isolate::Deinit() {
     optimizing_compile_dispatcher_ = nullptr;
   }
 
+  delete baseline_batch_compiler_;
+  baseline_batch_compiler_ = nullptr;
+
   // Help sweeper threads complete sweeping to stop faster.
   heap_.mark_compact_collector()->DrainSweepingWorklists();
   heap_.mark_compact_collector()->sweeper()->EnsureIterabilityCompleted();
@@ -3148,6 +3158,9 @@ Isolate::~Isolate() {
   delete date_cache_;
   date_cache_ = nullptr;
 
+  if (bigint_processor_) bigint_processor_->Destroy();
+  bigint_processor_ = nullptr;
+
   delete regexp_stack_;
   regexp_stack_ = nullptr;
 
@@ -3173,6 +3186,7 @@ Isolate::~Isolate() {
 
   delete compilation_cache_;
   compilation_cache_ = nullptr;
+  persistent_code_cache_.reset();
   delete bootstrapper_;
   bootstrapper_ = nullptr;
   delete inner_pointer_to_code_cache_;
@@ -3473,6 +3487,21 @@ using MapOfLoadsAndStoresPerFunction =
     std::map<std::string /* function_name */,
              std::pair<uint64_t /* loads */, uint64_t /* stores */>>;
 MapOfLoadsAndStoresPerFunction* stack_access_count_map = nullptr;
+
+class BigIntPlatform : public bigint::Platform {
+ public:
+  explicit BigIntPlatform(Isolate* isolate) : isolate_(isolate) {}
+  ~BigIntPlatform() override = default;
+
+  bool InterruptRequested() override {
+    StackLimitCheck interrupt_check(isolate_);
+    return (interrupt_check.InterruptRequested() &&
+            isolate_->stack_guard()->HasTerminationRequest());
+  }
+
+ private:
+  Isolate* isolate_;
+};
 }  // namespace
 
 bool Isolate::Init(SnapshotData* startup_snapshot_data,
@@ -3518,12 +3547,14 @@ bool Isolate::Init(SnapshotData* startup_snapshot_data,
   regexp_stack_ = new RegExpStack();
   regexp_stack_->isolate_ = this;
   date_cache_ = new DateCache();
+  bigint_processor_ = bigint::Processor::New(new BigIntPlatform(this));
   heap_profiler_ = new HeapProfiler(heap());
   interpreter_ = new interpreter::Interpreter(this);
   string_table_.reset(new StringTable(this));
 
   compiler_dispatcher_ =
       new CompilerDispatcher(this, V8::GetCurrentPlatform(), FLAG_stack_size);
+  baseline_batch_compiler_ = new baseline::BaselineBatchCompiler(this);
 
   // Enable logging before setting up the heap
   logger_->SetUp(this);
@@ -3943,6 +3974,11 @@ void Isolate::set_date_cache(DateCache* date_cache) {
   date_cache_ = date_cache;
 }
 
+void Isolate::set_persistent_code_cache(
+    std::unique_ptr<PersistentCodeCache> cache) {
+  persistent_code_cache_ = std::move(cache);
+}
+
 Isolate::KnownPrototype Isolate::IsArrayOrObjectOrStringPrototype(
     Object object) {
   Object context = heap()->native_contexts_list();
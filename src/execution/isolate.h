@@ -54,6 +54,10 @@ namespace base {
 class RandomNumberGenerator;
 }  // namespace base
 
+namespace bigint {
+class Processor;
+}  // namespace bigint
+
 namespace debug {
 class ConsoleDelegate;
 class AsyncEventDelegate;
@@ -92,6 +96,7 @@ class MaterializedObjectStore;
 class Microtask;
 class MicrotaskQueue;
 class OptimizingCompileDispatcher;
+class PersistentCodeCache;
 class PersistentHandles;
 class PersistentHandlesList;
 class ReadOnlyArtifacts;
@@ -113,6 +118,10 @@ struct ManagedPtrDestructor;
 template <StateTag Tag>
 class VMState;
 
+namespace baseline {
+class BaselineBatchCompiler;
+}  // namespace baseline
+
 namespace interpreter {
 class Interpreter;
 }  // namespace interpreter
@@ -999,6 +1008,11 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
   }
   RuntimeProfiler* runtime_profiler() { return runtime_profiler_; }
   CompilationCache* compilation_cache() { return compilation_cache_; }
+  // The on-disk code cache, or nullptr if the embedder did not configure one.
+  PersistentCodeCache* persistent_code_cache() const {
+    return persistent_code_cache_.get();
+  }
+  void set_persistent_code_cache(std::unique_ptr<PersistentCodeCache> cache);
   Logger* logger() {
     // Call InitializeLoggingAndCounters() if logging is needed before
     // the isolate is fully initialized.
@@ -1145,6 +1159,8 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
 
   RegExpStack* regexp_stack() { return regexp_stack_; }
 
+  bigint::Processor* bigint_processor() { return bigint_processor_; }
+
   size_t total_regexp_code_generated() { return total_regexp_code_generated_; }
   void IncreaseTotalRegexpCodeGenerated(Handle<HeapObject> code);
 
@@ -1546,6 +1562,11 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
     return compiler_dispatcher_;
   }
 
+  baseline::BaselineBatchCompiler* baseline_batch_compiler() const {
+    DCHECK_NOT_NULL(baseline_batch_compiler_);
+    return baseline_batch_compiler_;
+  }
+
   bool IsInAnyContext(Object object, uint32_t index);
 
   void ClearKeptObjects();
@@ -1832,6 +1853,7 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
   Bootstrapper* bootstrapper_ = nullptr;
   RuntimeProfiler* runtime_profiler_ = nullptr;
   CompilationCache* compilation_cache_ = nullptr;
+  std::unique_ptr<PersistentCodeCache> persistent_code_cache_;
   std::shared_ptr<Counters> async_counters_;
   base::RecursiveMutex break_access_;
   base::SharedMutex feedback_vector_access_;
@@ -1872,6 +1894,7 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
   RegExpStack* regexp_stack_ = nullptr;
   std::vector<int> regexp_indices_;
   DateCache* date_cache_ = nullptr;
+  bigint::Processor* bigint_processor_ = nullptr;
   base::RandomNumberGenerator* random_number_generator_ = nullptr;
   base::RandomNumberGenerator* fuzzer_rng_ = nullptr;
   std::atomic<RAILMode> rail_mode_;
@@ -1959,6 +1982,7 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
   Zone* compiler_zone_ = nullptr;
 
   CompilerDispatcher* compiler_dispatcher_ = nullptr;
+  baseline::BaselineBatchCompiler* baseline_batch_compiler_ = nullptr;
 
   using InterruptEntry = std::pair<InterruptCallback, void*>;
   std::queue<InterruptEntry> api_interrupts_queue_;
@@ -53,6 +53,7 @@ class V8_EXPORT_PRIVATE LocalIsolate final : private HiddenLocalFactory {
   inline Address isolate_root() const;
   inline ReadOnlyHeap* read_only_heap() const;
   inline Object root(RootIndex index) const;
+  inline Handle<Object> root_handle(RootIndex index) const;
 
   StringTable* string_table() const { return isolate_->string_table(); }
   base::SharedMutex* internalized_string_access() {
@@ -92,6 +93,10 @@ class V8_EXPORT_PRIVATE LocalIsolate final : private HiddenLocalFactory {
 
   LocalIsolate* AsLocalIsolate() { return this; }
 
+  // The main thread Isolate. Only its thread-safe parts, or state that is
+  // immutable after isolate initialization, may be accessed off-thread.
+  Isolate* GetMainThreadIsolateUnsafe() const { return isolate_; }
+
  private:
   friend class v8::internal::LocalFactory;
 
@@ -607,7 +607,19 @@ DEFINE_BOOL(always_sparkplug, false, "directly tier up to Sparkplug code")
 DEFINE_IMPLICATION(always_sparkplug, sparkplug)
 #endif
 DEFINE_STRING(sparkplug_filter, "*", "filter for Sparkplug baseline compiler")
+DEFINE_BOOL(baseline_batch_compilation, false, "batch compile Sparkplug code")
+DEFINE_BOOL(concurrent_sparkplug, false,
+            "compile Sparkplug code in a background thread")
+#if ENABLE_SPARKPLUG
+DEFINE_IMPLICATION(concurrent_sparkplug, sparkplug)
+DEFINE_IMPLICATION(concurrent_sparkplug, baseline_batch_compilation)
+DEFINE_NEG_IMPLICATION(single_threaded, concurrent_sparkplug)
+#endif
+DEFINE_INT(baseline_batch_compilation_threshold, 4 * KB,
+           "the estimated instruction size of a batch to trigger compilation")
 DEFINE_BOOL(trace_baseline, false, "trace baseline compilation")
+DEFINE_BOOL(trace_baseline_batch_compilation, false,
+            "trace baseline batch compilation")
 #if !defined(V8_OS_MACOSX) || !defined(V8_HOST_ARCH_ARM64)
 // Don't disable --write-protect-code-memory on Apple Silicon.
 DEFINE_WEAK_VALUE_IMPLICATION(sparkplug, write_protect_code_memory, false)
@@ -1013,6 +1025,13 @@ DEFINE_SIZE_T(max_semi_space_size, 0,
               "max size of a semi-space (in MBytes), the new space consists of "
               "two semi-spaces")
 DEFINE_INT(semi_space_growth_factor, 2, "factor by which to grow the new space")
+DEFINE_BOOL(adaptive_semi_space_sizing, false,
+            "size the semi-spaces based on allocation throughput and young "
+            "generation GC cost instead of growing them by a fixed factor")
+DEFINE_SIZE_T(adaptive_semi_space_budget, 0,
+              "memory budget for both semi-spaces (in MBytes) used by "
+              "--adaptive-semi-space-sizing, 0 means the maximum semi-space "
+              "size")
 DEFINE_SIZE_T(max_old_space_size, 0, "max size of the old space (in Mbytes)")
 DEFINE_SIZE_T(
     max_heap_size, 0,
@@ -1085,6 +1104,9 @@ DEFINE_INT(incremental_marking_hard_trigger, 0,
            "threshold for starting incremental marking immediately in percent "
            "of available space: limit - size")
 DEFINE_BOOL(trace_unmapper, false, "Trace the unmapping")
+DEFINE_SIZE_T(memory_chunk_pool_size, 16,
+              "max size of the pool of freed data pages that are kept for "
+              "reuse (in Mbytes)")
 DEFINE_BOOL(parallel_scavenge, true, "parallel scavenge")
 DEFINE_BOOL(scavenge_task, true, "schedule scavenge tasks")
 DEFINE_INT(scavenge_task_trigger, 80,
@@ -1112,6 +1134,10 @@ DEFINE_INT(ephemeron_fixpoint_iterations, 10,
 DEFINE_BOOL(trace_concurrent_marking, false, "trace concurrent marking")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
+DEFINE_FLOAT(compaction_pause_budget_ms, 0,
+             "limit old space evacuation per GC to what the traced compaction "
+             "speed allows in this many ms and leave the remaining fragmented "
+             "pages to later GCs (0 means no limit)")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
 DEFINE_BOOL(detect_ineffective_gcs_near_heap_limit, true,
@@ -1170,7 +1196,13 @@ DEFINE_BOOL(memory_reducer_for_small_heaps, true,
             "use memory reducer for small heaps")
 DEFINE_INT(heap_growing_percent, 0,
            "specifies heap growing factor as (1 + heap_growing_percent/100)")
+DEFINE_BOOL(cgroup_memory_limits, false,
+            "size the heap for the memory limit of the cgroup and grow it "
+            "more slowly under cgroup memory pressure (Linux only)")
 DEFINE_INT(v8_os_page_size, 0, "override OS page size (in KBytes)")
+DEFINE_BOOL(transparent_huge_pages, false,
+            "back the heap and code reservations with transparent huge pages "
+            "where the OS supports it")
 DEFINE_BOOL(allocation_buffer_parking, true, "allocation buffer parking")
 DEFINE_BOOL(always_compact, false, "Perform compaction on every full GC")
 DEFINE_BOOL(never_compact, false,
@@ -1364,6 +1396,11 @@ DEFINE_BOOL(always_osr, false, "always try to OSR functions")
 DEFINE_BOOL(prepare_always_opt, false, "prepare for turning on always opt")
 
 DEFINE_BOOL(trace_serializer, false, "print code serializer trace")
+DEFINE_BOOL(trace_persistent_code_cache, false,
+            "trace lookups, stores and evictions of the on-disk code cache")
+DEFINE_INT(persistent_code_cache_store_delay, 5,
+           "seconds after compiling a script before it is serialized into "
+           "the on-disk code cache")
 #ifdef DEBUG
 DEFINE_BOOL(external_reference_stats, false,
             "print statistics on external references used during serialization")
@@ -1424,6 +1461,9 @@ DEFINE_INT(heap_snapshot_string_limit, 1024,
            "truncate strings to this length in the heap snapshot")
 DEFINE_BOOL(heap_profiler_show_hidden_objects, false,
             "use 'native' rather than 'hidden' node type in snapshot")
+DEFINE_BOOL(heap_snapshot_parallel_extraction, false,
+            "extract the references of heap snapshot objects on worker "
+            "threads")
 
 // sampling-heap-profiler.cc
 DEFINE_BOOL(sampling_heap_profiler_suppress_randomness, false,
@@ -1453,6 +1493,9 @@ DEFINE_BOOL(super_ic, true, "use an IC for super property loads")
 
 // objects.cc
 DEFINE_BOOL(thin_strings, true, "Enable ThinString support")
+DEFINE_BOOL(shared_string_table, false,
+            "look up the internalized strings of the shared read-only heap in "
+            "a process-wide table instead of each isolate's string table")
 DEFINE_BOOL(trace_prototype_users, false,
             "Trace updates to prototype user tracking")
 DEFINE_BOOL(trace_for_in_enumerate, false, "Trace for-in enumerate slow-paths")
@@ -1662,6 +1705,8 @@ DEFINE_NEG_NEG_IMPLICATION(text_is_readable, partial_constant_pool)
 // Minor mark compact collector flags.
 //
 #ifdef ENABLE_MINOR_MC
+DEFINE_BOOL(minor_mc_parallel_marking, true,
+            "use parallel marking for the young generation")
 DEFINE_BOOL(trace_minor_mc_parallel_marking, false,
             "trace parallel marking for the young generation")
 DEFINE_BOOL(minor_mc, false, "perform young generation mark compact GCs")
@@ -133,7 +133,11 @@ GCTracer::Event::Event(Type type, GarbageCollectionReason gc_reason,
       young_object_size(0),
       survived_young_object_size(0),
       incremental_marking_bytes(0),
-      incremental_marking_duration(0.0) {
+      incremental_marking_duration(0.0),
+      new_to_old_pages(0),
+      new_to_new_pages(0),
+      new_space_capacity(0),
+      new_space_target_capacity(0) {
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     scopes[i] = 0;
   }
@@ -202,6 +206,7 @@ void GCTracer::ResetForTesting() {
   combined_mark_compact_speed_cache_ = 0.0;
   recorded_minor_gcs_total_.Reset();
   recorded_minor_gcs_survived_.Reset();
+  recorded_minor_mcs_.Reset();
   recorded_compactions_.Reset();
   recorded_mark_compacts_.Reset();
   recorded_incremental_mark_compacts_.Reset();
@@ -342,6 +347,10 @@ void GCTracer::Stop(GarbageCollector collector) {
           MakeBytesAndDuration(current_.young_object_size, duration));
       recorded_minor_gcs_survived_.Push(
           MakeBytesAndDuration(current_.survived_young_object_size, duration));
+      if (current_.type == Event::MINOR_MARK_COMPACTOR) {
+        recorded_minor_mcs_.Push(
+            MakeBytesAndDuration(current_.young_object_size, duration));
+      }
       FetchBackgroundMinorGCCounters();
       break;
     case Event::INCREMENTAL_MARK_COMPACTOR:
@@ -488,6 +497,17 @@ void GCTracer::AddSurvivalRatio(double promotion_ratio) {
   recorded_survival_ratios_.Push(promotion_ratio);
 }
 
+void GCTracer::AddPagePromotions(size_t new_to_old_pages,
+                                 size_t new_to_new_pages) {
+  current_.new_to_old_pages += new_to_old_pages;
+  current_.new_to_new_pages += new_to_new_pages;
+}
+
+void GCTracer::NotifyNewSpaceSizing(size_t target_capacity, size_t capacity) {
+  current_.new_space_target_capacity = target_capacity;
+  current_.new_space_capacity = capacity;
+}
+
 void GCTracer::AddIncrementalMarkingStep(double duration, size_t bytes) {
   if (bytes > 0) {
     incremental_marking_bytes_ += bytes;
@@ -613,7 +633,9 @@ void GCTracer::PrintNVP() const {
           "semi_space_copy_rate=%.1f%% "
           "new_space_allocation_throughput=%.1f "
           "unmapper_chunks=%d "
-          "context_disposal_rate=%.1f\n",
+          "context_disposal_rate=%.1f "
+          "new_space_capacity=%zu "
+          "new_space_target_capacity=%zu\n",
           duration, spent_in_mutator, current_.TypeName(true),
           current_.reduce_memory, current_.scopes[Scope::TIME_TO_SAFEPOINT],
           current_.scopes[Scope::HEAP_PROLOGUE],
@@ -652,7 +674,8 @@ void GCTracer::PrintNVP() const {
           heap_->semi_space_copied_rate_,
           NewSpaceAllocationThroughputInBytesPerMillisecond(),
           heap_->memory_allocator()->unmapper()->NumberOfChunks(),
-          ContextDisposalRateInMilliseconds());
+          ContextDisposalRateInMilliseconds(), current_.new_space_capacity,
+          current_.new_space_target_capacity);
       break;
     case Event::MINOR_MARK_COMPACTOR:
       heap_->isolate()->PrintWithTimestamp(
@@ -682,7 +705,24 @@ void GCTracer::PrintNVP() const {
           "background.unmapper=%.2f "
           "unmapper=%.2f "
           "update_marking_deque=%.2f "
-          "reset_liveness=%.2f\n",
+          "reset_liveness=%.2f "
+          "minor_mc_throughput=%.f "
+          "total_size_before=%zu "
+          "total_size_after=%zu "
+          "holes_size_before=%zu "
+          "holes_size_after=%zu "
+          "allocated=%zu "
+          "promoted=%zu "
+          "semi_space_copied=%zu "
+          "pages_new_to_old=%zu "
+          "pages_new_to_new=%zu "
+          "promotion_ratio=%.1f%% "
+          "average_survival_ratio=%.1f%% "
+          "promotion_rate=%.1f%% "
+          "semi_space_copy_rate=%.1f%% "
+          "new_space_allocation_throughput=%.1f "
+          "new_space_capacity=%zu "
+          "new_space_target_capacity=%zu\n",
           duration, spent_in_mutator, "mmc", current_.reduce_memory,
           current_.scopes[Scope::MINOR_MC],
           current_.scopes[Scope::MINOR_MC_SWEEPING],
@@ -707,7 +747,17 @@ void GCTracer::PrintNVP() const {
           current_.scopes[Scope::BACKGROUND_UNMAPPER],
           current_.scopes[Scope::UNMAPPER],
           current_.scopes[Scope::MINOR_MC_MARKING_DEQUE],
-          current_.scopes[Scope::MINOR_MC_RESET_LIVENESS]);
+          current_.scopes[Scope::MINOR_MC_RESET_LIVENESS],
+          MinorMCSpeedInBytesPerMillisecond(), current_.start_object_size,
+          current_.end_object_size, current_.start_holes_size,
+          current_.end_holes_size, allocated_since_last_gc,
+          heap_->promoted_objects_size(),
+          heap_->semi_space_copied_object_size(), current_.new_to_old_pages,
+          current_.new_to_new_pages, heap_->promotion_ratio_,
+          AverageSurvivalRatio(), heap_->promotion_rate_,
+          heap_->semi_space_copied_rate_,
+          NewSpaceAllocationThroughputInBytesPerMillisecond(),
+          current_.new_space_capacity, current_.new_space_target_capacity);
       break;
     case Event::MARK_COMPACTOR:
     case Event::INCREMENTAL_MARK_COMPACTOR:
@@ -805,7 +855,9 @@ void GCTracer::PrintNVP() const {
           "new_space_allocation_throughput=%.1f "
           "unmapper_chunks=%d "
           "context_disposal_rate=%.1f "
-          "compaction_speed=%.f\n",
+          "compaction_speed=%.f "
+          "new_space_capacity=%zu "
+          "new_space_target_capacity=%zu\n",
           duration, spent_in_mutator, current_.TypeName(true),
           current_.reduce_memory, current_.scopes[Scope::TIME_TO_SAFEPOINT],
           current_.scopes[Scope::HEAP_PROLOGUE],
@@ -897,7 +949,8 @@ void GCTracer::PrintNVP() const {
           NewSpaceAllocationThroughputInBytesPerMillisecond(),
           heap_->memory_allocator()->unmapper()->NumberOfChunks(),
           ContextDisposalRateInMilliseconds(),
-          CompactionSpeedInBytesPerMillisecond());
+          CompactionSpeedInBytesPerMillisecond(), current_.new_space_capacity,
+          current_.new_space_target_capacity);
       break;
     case Event::START:
       break;
@@ -1026,6 +1079,10 @@ double GCTracer::ScavengeSpeedInBytesPerMillisecond(
   }
 }
 
+double GCTracer::MinorMCSpeedInBytesPerMillisecond() const {
+  return AverageSpeed(recorded_minor_mcs_);
+}
+
 double GCTracer::CompactionSpeedInBytesPerMillisecond() const {
   return AverageSpeed(recorded_compactions_);
 }
@@ -1237,6 +1294,13 @@ void GCTracer::RecordGCPhasesHistograms(TimedHistogram* gc_timer) {
         static_cast<int>(current_.scopes[Scope::SCAVENGER_SCAVENGE_PARALLEL]));
     counters->gc_scavenger_scavenge_roots()->AddSample(
         static_cast<int>(current_.scopes[Scope::SCAVENGER_SCAVENGE_ROOTS]));
+  } else if (gc_timer == counters->gc_minor_mc()) {
+    counters->gc_minor_mc_mark()->AddSample(
+        static_cast<int>(current_.scopes[Scope::MINOR_MC_MARK]));
+    counters->gc_minor_mc_evacuate()->AddSample(
+        static_cast<int>(current_.scopes[Scope::MINOR_MC_EVACUATE]));
+    counters->gc_minor_mc_clear()->AddSample(
+        static_cast<int>(current_.scopes[Scope::MINOR_MC_CLEAR]));
   }
 }
 
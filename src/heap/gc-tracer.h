@@ -181,6 +181,16 @@ class V8_EXPORT_PRIVATE GCTracer {
     // Duration of incremental marking steps for INCREMENTAL_MARK_COMPACTOR.
     double incremental_marking_duration;
 
+    // Young generation pages that MINOR_MARK_COMPACTOR moved as a whole to the
+    // old generation resp. within the young generation.
+    size_t new_to_old_pages;
+    size_t new_to_new_pages;
+
+    // Semi-space capacity chosen by --adaptive-semi-space-sizing at the end
+    // of the GC, and the capacity that was requested.
+    size_t new_space_capacity;
+    size_t new_space_target_capacity;
+
     // Amounts of time spent in different scopes during GC.
     double scopes[Scope::NUMBER_OF_SCOPES];
 
@@ -227,6 +237,12 @@ class V8_EXPORT_PRIVATE GCTracer {
 
   void AddSurvivalRatio(double survival_ratio);
 
+  // Log young generation pages that were moved instead of evacuated.
+  void AddPagePromotions(size_t new_to_old_pages, size_t new_to_new_pages);
+
+  // Log the decision of the new space sizing controller.
+  void NotifyNewSpaceSizing(size_t target_capacity, size_t capacity);
+
   // Log an incremental marking step.
   void AddIncrementalMarkingStep(double duration, size_t bytes);
 
@@ -243,6 +259,12 @@ class V8_EXPORT_PRIVATE GCTracer {
   double ScavengeSpeedInBytesPerMillisecond(
       ScavengeSpeedMode mode = kForAllObjects) const;
 
+  // Compute the average speed of minor mark-compacts alone in
+  // bytes/millisecond. The scavenge speed above covers both young generation
+  // collectors.
+  // Returns 0 if no events have been recorded.
+  double MinorMCSpeedInBytesPerMillisecond() const;
+
   // Compute the average compaction speed in bytes/millisecond.
   // Returns 0 if not enough events have been recorded.
   double CompactionSpeedInBytesPerMillisecond() const;
@@ -362,10 +384,14 @@ class V8_EXPORT_PRIVATE GCTracer {
   FRIEND_TEST(GCTracerTest, IncrementalMarkingDetails);
   FRIEND_TEST(GCTracerTest, IncrementalScope);
   FRIEND_TEST(GCTracerTest, IncrementalMarkingSpeed);
+  FRIEND_TEST(GCTracerTest, MinorMCPagePromotions);
+  FRIEND_TEST(GCTracerTest, MinorMCSpeed);
   FRIEND_TEST(GCTracerTest, MutatorUtilization);
   FRIEND_TEST(GCTracerTest, RecordGCSumHistograms);
   FRIEND_TEST(GCTracerTest, RecordMarkCompactHistograms);
+  FRIEND_TEST(GCTracerTest, RecordMinorMCHistograms);
   FRIEND_TEST(GCTracerTest, RecordScavengerHistograms);
+  friend class heap::HeapTester;
 
   struct BackgroundCounter {
     double total_duration_ms;
@@ -473,6 +499,7 @@ class V8_EXPORT_PRIVATE GCTracer {
 
   base::RingBuffer<BytesAndDuration> recorded_minor_gcs_total_;
   base::RingBuffer<BytesAndDuration> recorded_minor_gcs_survived_;
+  base::RingBuffer<BytesAndDuration> recorded_minor_mcs_;
   base::RingBuffer<BytesAndDuration> recorded_compactions_;
   base::RingBuffer<BytesAndDuration> recorded_incremental_mark_compacts_;
   base::RingBuffer<BytesAndDuration> recorded_mark_compacts_;
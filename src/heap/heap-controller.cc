@@ -169,6 +169,61 @@ size_t MemoryController<Trait>::CalculateAllocationLimit(
   return result;
 }
 
+// Given the allocation throughput in bytes per ms, the young generation GC
+// speed for surviving objects in bytes per ms and the size of the objects that
+// survived the last young generation GC, this function returns the semi-space
+// capacity that achieves kTargetMutatorUtilization if the allocation
+// throughput and the amount of surviving objects remain the same.
+//
+// The cost of a young generation GC is dominated by the surviving objects,
+// which for request serving workloads hardly depend on the capacity. Growing
+// the semi-space thus makes GCs rarer but not more expensive:
+//   TG = survived_bytes / gc_speed
+//   TM = capacity / allocation_throughput
+// With MU = TM / (TM + TG), we get TM = TG * MU / (1 - MU) and
+//   capacity = allocation_throughput * TG * MU / (1 - MU).
+// If the mutator allocates slowly, the capacity shrinks accordingly, which
+// releases memory during idle periods.
+size_t NewSpaceController::TargetCapacity(double allocation_throughput,
+                                          double gc_speed,
+                                          size_t survived_bytes,
+                                          size_t current_capacity,
+                                          size_t min_capacity,
+                                          size_t max_capacity) {
+  DCHECK_LE(min_capacity, max_capacity);
+  size_t capacity = current_capacity;
+  if (allocation_throughput != 0 && gc_speed != 0) {
+    const double gc_time = survived_bytes / gc_speed;
+    const double mutator_time = gc_time * kTargetMutatorUtilization /
+                                (1 - kTargetMutatorUtilization);
+    const double target = allocation_throughput * mutator_time;
+    capacity = target < max_capacity ? static_cast<size_t>(target)
+                                     : max_capacity;
+  }
+  if (survived_bytes < max_capacity / kMinCapacityToSurvivedRatio) {
+    capacity =
+        std::max(capacity, survived_bytes * kMinCapacityToSurvivedRatio);
+  } else {
+    capacity = max_capacity;
+  }
+  return std::min(std::max(capacity, min_capacity), max_capacity);
+}
+
+MemoryPressureLevel ContainerMemoryController::PressureLevel(
+    size_t limit, size_t usage, double stall_percentage) {
+  const double usage_ratio =
+      limit > 0 ? static_cast<double>(usage) / limit : 0;
+  if (usage_ratio >= kCriticalUsageRatio ||
+      stall_percentage >= kCriticalStallPercentage) {
+    return MemoryPressureLevel::kCritical;
+  }
+  if (usage_ratio >= kModerateUsageRatio ||
+      stall_percentage >= kModerateStallPercentage) {
+    return MemoryPressureLevel::kModerate;
+  }
+  return MemoryPressureLevel::kNone;
+}
+
 template class V8_EXPORT_PRIVATE MemoryController<V8HeapTrait>;
 template class V8_EXPORT_PRIVATE MemoryController<GlobalMemoryTrait>;
 
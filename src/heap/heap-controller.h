@@ -56,6 +56,39 @@ class V8_EXPORT_PRIVATE MemoryController : public AllStatic {
   FRIEND_TEST(MemoryControllerTest, MaxHeapGrowingFactor);
 };
 
+// Sizes the semi-spaces from the allocation throughput and the cost of young
+// generation GCs (--adaptive-semi-space-sizing).
+class V8_EXPORT_PRIVATE NewSpaceController : public AllStatic {
+ public:
+  static constexpr double kTargetMutatorUtilization = 0.97;
+  // The survivors of a GC should not take more than half of the capacity.
+  static constexpr size_t kMinCapacityToSurvivedRatio = 2;
+
+  static size_t TargetCapacity(double allocation_throughput, double gc_speed,
+                               size_t survived_bytes, size_t current_capacity,
+                               size_t min_capacity, size_t max_capacity);
+};
+
+// Keeps the heap within the memory limit of the cgroup, e.g. the container,
+// that the process runs in (--cgroup-memory-limits). The pressure is derived
+// from the share of the limit that the cgroup uses and from the pressure stall
+// information (PSI) of Linux, i.e. from how long tasks recently waited for
+// memory.
+class V8_EXPORT_PRIVATE ContainerMemoryController : public AllStatic {
+ public:
+  static constexpr double kModerateUsageRatio = 0.8;
+  static constexpr double kCriticalUsageRatio = 0.9;
+  static constexpr double kModerateStallPercentage = 10;
+  static constexpr double kCriticalStallPercentage = 40;
+  // The cgroup is sampled at most this often.
+  static constexpr double kSamplingIntervalMs = 100;
+
+  // A |limit| of zero means that there is no limit, a negative
+  // |stall_percentage| that PSI is not available.
+  static MemoryPressureLevel PressureLevel(size_t limit, size_t usage,
+                                           double stall_percentage);
+};
+
 }  // namespace internal
 }  // namespace v8
 
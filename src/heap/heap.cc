@@ -16,6 +16,7 @@
 #include "src/base/flags.h"
 #include "src/base/once.h"
 #include "src/base/platform/mutex.h"
+#include "src/base/sys-info.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/builtins/accessors.h"
 #include "src/codegen/assembler-inl.h"
@@ -1216,9 +1217,39 @@ void Heap::GarbageCollectionEpilogue() {
   ReportStatisticsAfterGC();
 #endif  // DEBUG
 
+  if (FLAG_cgroup_memory_limits) UpdateContainerMemoryPressure();
+
   last_gc_time_ = MonotonicallyIncreasingTimeInMs();
 }
 
+void Heap::UpdateContainerMemoryPressure() {
+  const double now = MonotonicallyIncreasingTimeInMs();
+  if (now - last_container_memory_sample_ms_ <
+      ContainerMemoryController::kSamplingIntervalMs) {
+    return;
+  }
+  last_container_memory_sample_ms_ = now;
+  if (!cgroup_memory_) cgroup_memory_.reset(new base::CgroupMemory());
+  if (!cgroup_memory_->IsAvailable()) return;
+  const MemoryPressureLevel level = ContainerMemoryController::PressureLevel(
+      static_cast<size_t>(cgroup_memory_->Limit()),
+      static_cast<size_t>(cgroup_memory_->WorkingSet()),
+      cgroup_memory_->PressureStallPercentage());
+  const MemoryPressureLevel previous = container_memory_pressure_level_;
+  container_memory_pressure_level_ = level;
+  if (FLAG_trace_gc_verbose && level != previous) {
+    isolate()->PrintWithTimestamp("Container memory pressure: %d -> %d\n",
+                                  static_cast<int>(previous),
+                                  static_cast<int>(level));
+  }
+  // Only rising pressure triggers a memory reducing GC. The pressure may stay
+  // high because of memory outside of the heap, and repeated GCs would not
+  // help then. The growing mode keeps the heap small in the meantime.
+  if (level > previous) {
+    MemoryPressureNotification(level, /* is_isolate_locked */ false);
+  }
+}
+
 class V8_NODISCARD GCCallbacksScope {
  public:
   explicit GCCallbacksScope(Heap* heap) : heap_(heap) {
@@ -1263,6 +1294,12 @@ void Heap::ScheduleScavengeTaskIfNeeded() {
 }
 
 TimedHistogram* Heap::GCTypePriorityTimer(GarbageCollector collector) {
+  if (collector == MINOR_MARK_COMPACTOR) {
+    if (isolate_->IsIsolateInBackground()) {
+      return isolate_->counters()->gc_minor_mc_background();
+    }
+    return isolate_->counters()->gc_minor_mc_foreground();
+  }
   if (IsYoungGenerationCollector(collector)) {
     if (isolate_->IsIsolateInBackground()) {
       return isolate_->counters()->gc_scavenger_background();
@@ -1291,6 +1328,9 @@ TimedHistogram* Heap::GCTypePriorityTimer(GarbageCollector collector) {
 }
 
 TimedHistogram* Heap::GCTypeTimer(GarbageCollector collector) {
+  if (collector == MINOR_MARK_COMPACTOR) {
+    return isolate_->counters()->gc_minor_mc();
+  }
   if (IsYoungGenerationCollector(collector)) {
     return isolate_->counters()->gc_scavenger();
   }
@@ -1660,7 +1700,8 @@ bool Heap::CollectGarbage(AllocationSpace space,
           CallGCEpilogueCallbacks(gc_type, gc_callback_flags);
         }
       }
-      if (collector == MARK_COMPACTOR || collector == SCAVENGER) {
+      if (collector == MARK_COMPACTOR || collector == SCAVENGER ||
+          collector == MINOR_MARK_COMPACTOR) {
         tracer()->RecordGCPhasesHistograms(gc_type_timer);
       }
     }
@@ -2314,7 +2355,8 @@ void Heap::MarkCompactPrologue() {
 }
 
 void Heap::CheckNewSpaceExpansionCriteria() {
-  if (new_space_->TotalCapacity() < new_space_->MaximumCapacity() &&
+  if (!FLAG_adaptive_semi_space_sizing &&
+      new_space_->TotalCapacity() < new_space_->MaximumCapacity() &&
       survived_since_last_expansion_ > new_space_->TotalCapacity()) {
     // Grow the size of new space if there is room to grow, and enough data
     // has survived scavenge since the last expansion.
@@ -3443,6 +3485,11 @@ void Heap::ReduceNewSpaceSize() {
 
   if (FLAG_predictable) return;
 
+  if (FLAG_adaptive_semi_space_sizing) {
+    ResizeNewSpace();
+    return;
+  }
+
   if (ShouldReduceMemory() ||
       ((allocation_throughput != 0) &&
        (allocation_throughput < kLowAllocationThroughput))) {
@@ -3452,6 +3499,35 @@ void Heap::ReduceNewSpaceSize() {
   }
 }
 
+void Heap::ResizeNewSpace() {
+  const size_t capacity = new_space_->TotalCapacity();
+  const size_t min_capacity = new_space_->InitialTotalCapacity();
+  size_t max_capacity = new_space_->MaximumCapacity();
+  if (FLAG_adaptive_semi_space_budget > 0) {
+    // The budget covers both semi-spaces.
+    max_capacity = std::min(
+        max_capacity,
+        std::max(min_capacity, FLAG_adaptive_semi_space_budget * MB / 2));
+  }
+  size_t target_capacity = min_capacity;
+  if (!ShouldReduceMemory()) {
+    target_capacity = NewSpaceController::TargetCapacity(
+        tracer()->NewSpaceAllocationThroughputInBytesPerMillisecond(
+            GCTracer::kThroughputTimeFrameMs),
+        tracer()->ScavengeSpeedInBytesPerMillisecond(kForSurvivedObjects),
+        SurvivedYoungObjectSize(), capacity, min_capacity, max_capacity);
+  }
+  if (target_capacity > capacity) {
+    new_space_->GrowTo(target_capacity);
+  } else if (target_capacity < capacity) {
+    new_space_->ShrinkTo(target_capacity);
+    UncommitFromSpace();
+  }
+  new_lo_space_->SetCapacity(new_space_->Capacity());
+  tracer()->NotifyNewSpaceSizing(target_capacity,
+                                 new_space_->TotalCapacity());
+}
+
 void Heap::FinalizeIncrementalMarkingIfComplete(
     GarbageCollectionReason gc_reason) {
   if (incremental_marking()->IsMarking() &&
@@ -4635,6 +4711,23 @@ void Heap::ConfigureHeap(const v8::ResourceConstraints& constraints) {
                                     ? max_heap_size - young_generation_size
                                     : 0;
     }
+    if (FLAG_cgroup_memory_limits &&
+        constraints.max_old_generation_size_in_bytes() == 0 &&
+        FLAG_max_old_space_size == 0 && FLAG_max_heap_size == 0) {
+      // Without an explicit limit from the embedder or the flags, size the
+      // heap for the container like for a machine with that much physical
+      // memory.
+      uint64_t cgroup_memory =
+          static_cast<uint64_t>(base::SysInfo::AmountOfCgroupMemory());
+      if (cgroup_memory > 0) {
+        size_t young_generation_size, old_generation_size;
+        GenerationSizesFromHeapSize(HeapSizeFromPhysicalMemory(cgroup_memory),
+                                    &young_generation_size,
+                                    &old_generation_size);
+        max_old_generation_size =
+            std::min(max_old_generation_size, old_generation_size);
+      }
+    }
     max_old_generation_size =
         std::max(max_old_generation_size, MinOldGenerationSize());
     max_old_generation_size = std::min(max_old_generation_size,
@@ -4919,11 +5012,13 @@ bool Heap::IsRetryOfFailedAllocation(LocalHeap* local_heap) {
 }
 
 Heap::HeapGrowingMode Heap::CurrentHeapGrowingMode() {
-  if (ShouldReduceMemory() || FLAG_stress_compaction) {
+  if (ShouldReduceMemory() || FLAG_stress_compaction ||
+      container_memory_pressure_level_ == MemoryPressureLevel::kCritical) {
     return Heap::HeapGrowingMode::kMinimal;
   }
 
-  if (ShouldOptimizeForMemoryUsage()) {
+  if (ShouldOptimizeForMemoryUsage() ||
+      container_memory_pressure_level_ == MemoryPressureLevel::kModerate) {
     return Heap::HeapGrowingMode::kConservative;
   }
 
@@ -39,6 +39,10 @@
 
 namespace v8 {
 
+namespace base {
+class CgroupMemory;
+}  // namespace base
+
 namespace debug {
 using OutOfMemoryCallback = void (*)(void* data);
 }  // namespace debug
@@ -1769,6 +1773,10 @@ class Heap {
 
   void ReduceNewSpaceSize();
 
+  // Grows or shrinks the semi-spaces to the capacity computed by the
+  // NewSpaceController.
+  void ResizeNewSpace();
+
   GCIdleTimeHeapState ComputeHeapState();
 
   bool PerformIdleTimeAction(GCIdleTimeAction action,
@@ -1956,6 +1964,9 @@ class Heap {
 
   void RecomputeLimits(GarbageCollector collector);
 
+  // Samples the memory usage and pressure of the cgroup of the process.
+  void UpdateContainerMemoryPressure();
+
   // ===========================================================================
   // Idle notification. ========================================================
   // ===========================================================================
@@ -2099,6 +2110,14 @@ class Heap {
   // and reset by a mark-compact garbage collection.
   std::atomic<MemoryPressureLevel> memory_pressure_level_;
 
+  // The memory pressure of the cgroup of the process, sampled after GCs
+  // (--cgroup-memory-limits). The cgroup is only looked up for the first
+  // sample.
+  std::unique_ptr<base::CgroupMemory> cgroup_memory_;
+  MemoryPressureLevel container_memory_pressure_level_ =
+      MemoryPressureLevel::kNone;
+  double last_container_memory_sample_ms_ = 0;
+
   std::vector<std::pair<v8::NearHeapLimitCallback, void*>>
       near_heap_limit_callbacks_;
 
@@ -2383,6 +2402,7 @@ class Heap {
 
   // The allocator interface.
   friend class Factory;
+  template <typename IsolateT>
   friend class Deserializer;
 
   // The Isolate constructs us.
@@ -2436,6 +2456,7 @@ class V8_NODISCARD AlwaysAllocateScope {
 
  private:
   friend class AlwaysAllocateScopeForTesting;
+  template <typename IsolateT>
   friend class Deserializer;
   friend class DeserializerAllocator;
   friend class Evacuator;
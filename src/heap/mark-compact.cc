@@ -655,6 +655,26 @@ void MarkCompactCollector::ComputeEvacuationHeuristics(
     }
     *max_evacuated_bytes = kMaxEvacuatedBytes;
   }
+
+  // Memory reducing GCs, which includes last resort GCs, are not limited by
+  // the pause budget, since compaction is what frees memory there.
+  if (FLAG_compaction_pause_budget_ms > 0 && !heap()->ShouldReduceMemory()) {
+    // Compact incrementally: only evacuate what fits into the pause budget.
+    // Candidates are selected from the most fragmented pages first, so the
+    // pages left behind are picked up by the following GCs.
+    double estimated_compaction_speed =
+        heap()->tracer()->CompactionSpeedInBytesPerMillisecond();
+    if (estimated_compaction_speed == 0) {
+      estimated_compaction_speed =
+          GCTracer::kConservativeSpeedInBytesPerMillisecond;
+    }
+    // Always allow a page worth of live objects, so that each GC can release
+    // at least one page.
+    const size_t budget_bytes = std::max(
+        area_size, static_cast<size_t>(estimated_compaction_speed *
+                                       FLAG_compaction_pause_budget_ms));
+    *max_evacuated_bytes = std::min(*max_evacuated_bytes, budget_bytes);
+  }
 }
 
 void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
@@ -2261,7 +2281,7 @@ void MarkCompactCollector::ClearFullMapTransitions() {
         if (constructor_or_back_pointer.IsSmi()) {
           DCHECK(isolate()->has_active_deserializer());
           DCHECK_EQ(constructor_or_back_pointer,
-                    Deserializer::uninitialized_field_value());
+                    Smi::uninitialized_deserialization_value());
           continue;
         }
         Map parent = Map::cast(map.constructor_or_back_pointer());
@@ -2289,7 +2309,7 @@ bool MarkCompactCollector::TransitionArrayNeedsCompaction(
     if (raw_target.IsSmi()) {
       // This target is still being deserialized,
       DCHECK(isolate()->has_active_deserializer());
-      DCHECK_EQ(raw_target.ToSmi(), Deserializer::uninitialized_field_value());
+      DCHECK_EQ(raw_target.ToSmi(), Smi::uninitialized_deserialization_value());
 #ifdef DEBUG
       // Targets can only be dead iff this array is fully deserialized.
       for (int i = 0; i < num_transitions; ++i) {
@@ -4869,6 +4889,9 @@ class YoungGenerationMarkingJob : public v8::JobTask {
     size_t items = remaining_marking_items_.load(std::memory_order_relaxed);
     size_t num_tasks = std::max((items + 1) / kPagesPerTask,
                                 global_worklist_->GlobalPoolSize());
+    if (!FLAG_minor_mc_parallel_marking) {
+      num_tasks = std::min<size_t>(1, num_tasks);
+    }
     return std::min<size_t>(
         num_tasks, MinorMarkCompactCollector::MarkingWorklist::kMaxNumTasks);
   }
@@ -5186,6 +5209,8 @@ void YoungGenerationEvacuator::RawEvacuatePage(MemoryChunk* chunk,
 void MinorMarkCompactCollector::EvacuatePagesInParallel() {
   std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> evacuation_items;
   intptr_t live_bytes = 0;
+  size_t new_to_old_pages = 0;
+  size_t new_to_new_pages = 0;
 
   for (Page* page : new_space_evacuation_pages_) {
     intptr_t live_bytes_on_page = non_atomic_marking_state()->live_bytes(page);
@@ -5194,12 +5219,15 @@ void MinorMarkCompactCollector::EvacuatePagesInParallel() {
     if (ShouldMovePage(page, live_bytes_on_page, false)) {
       if (page->IsFlagSet(MemoryChunk::NEW_SPACE_BELOW_AGE_MARK)) {
         EvacuateNewSpacePageVisitor<NEW_TO_OLD>::Move(page);
+        new_to_old_pages++;
       } else {
         EvacuateNewSpacePageVisitor<NEW_TO_NEW>::Move(page);
+        new_to_new_pages++;
       }
     }
     evacuation_items.emplace_back(ParallelWorkItem{}, page);
   }
+  heap()->tracer()->AddPagePromotions(new_to_old_pages, new_to_new_pages);
 
   // Promote young generation large objects.
   for (auto it = heap()->new_lo_space()->begin();
@@ -409,7 +409,7 @@ int MarkingVisitorBase<ConcreteVisitor, MarkingState>::VisitDescriptorsForMap(
   // If the descriptors are a Smi, then this Map is in the process of being
   // deserialized, and doesn't yet have an initialized descriptor field.
   if (maybe_descriptors.IsSmi()) {
-    DCHECK_EQ(maybe_descriptors, Deserializer::uninitialized_field_value());
+    DCHECK_EQ(maybe_descriptors, Smi::uninitialized_deserialization_value());
     return 0;
   }
 
@@ -14,6 +14,7 @@
 #include "src/heap/heap-inl.h"
 #include "src/heap/memory-chunk.h"
 #include "src/heap/read-only-spaces.h"
+#include "src/logging/counters.h"
 #include "src/logging/log.h"
 #include "src/utils/allocation.h"
 
@@ -88,12 +89,16 @@ void MemoryAllocator::InitializeCodePageAllocator(
   }
   DCHECK(!isolate_->RequiresCodeRange() || requested <= kMaximalCodeRangeSize);
 
+  size_t alignment =
+      std::max(kMinExpectedOSPageSize, page_allocator->AllocatePageSize());
+  if (FLAG_transparent_huge_pages) {
+    alignment = std::max(alignment, kHugePageSize);
+  }
   Address hint =
       RoundDown(code_range_address_hint.Pointer()->GetAddressHint(requested),
-                page_allocator->AllocatePageSize());
-  VirtualMemory reservation(
-      page_allocator, requested, reinterpret_cast<void*>(hint),
-      std::max(kMinExpectedOSPageSize, page_allocator->AllocatePageSize()));
+                alignment);
+  VirtualMemory reservation(page_allocator, requested,
+                            reinterpret_cast<void*>(hint), alignment);
   if (!reservation.IsReserved()) {
     V8::FatalProcessOutOfMemory(isolate_,
                                 "CodeRange setup: allocate virtual memory");
@@ -127,6 +132,8 @@ void MemoryAllocator::InitializeCodePageAllocator(
       NewEvent("CodeRange", reinterpret_cast<void*>(reservation.address()),
                requested));
 
+  AdviseHugePages(aligned_base, size);
+
   code_reservation_ = std::move(reservation);
   code_page_allocator_instance_ = std::make_unique<base::BoundedPageAllocator>(
       page_allocator, aligned_base, size,
@@ -258,6 +265,10 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks(
   // Regular chunks.
   while ((chunk = GetMemoryChunkSafe<kRegular>()) != nullptr) {
     bool pooled = chunk->IsFlagSet(MemoryChunk::POOLED);
+    if (pooled && !HasRoomInPool()) {
+      chunk->ClearFlag(MemoryChunk::POOLED);
+      pooled = false;
+    }
     allocator_->PerformFreeMemory(chunk);
     if (pooled) AddMemoryChunkSafe<kPooled>(chunk);
     if (delegate && delegate->ShouldYield()) return;
@@ -274,6 +285,19 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks(
   PerformFreeMemoryOnQueuedNonRegularChunks();
 }
 
+void MemoryAllocator::Unmapper::ReleasePooledChunks() {
+  MemoryChunk* chunk = nullptr;
+  while ((chunk = GetMemoryChunkSafe<kPooled>()) != nullptr) {
+    allocator_->Free<MemoryAllocator::kAlreadyPooled>(chunk);
+  }
+}
+
+bool MemoryAllocator::Unmapper::HasRoomInPool() {
+  base::MutexGuard guard(&mutex_);
+  return (chunks_[kPooled].size() + 1) * MemoryChunk::kPageSize <=
+         FLAG_memory_chunk_pool_size * MB;
+}
+
 void MemoryAllocator::Unmapper::TearDown() {
   CHECK(!job_handle_ || !job_handle_->IsValid());
   PerformFreeMemoryOnQueuedChunks<FreeMode::kReleasePooled>();
@@ -296,11 +320,16 @@ int MemoryAllocator::Unmapper::NumberOfChunks() {
   return static_cast<int>(result);
 }
 
+size_t MemoryAllocator::Unmapper::PooledMemory() {
+  base::MutexGuard guard(&mutex_);
+  return chunks_[kPooled].size() * MemoryChunk::kPageSize;
+}
+
 size_t MemoryAllocator::Unmapper::CommittedBufferedMemory() {
   base::MutexGuard guard(&mutex_);
 
   size_t sum = 0;
-  // kPooled chunks are already uncommited. We only have to account for
+  // kPooled chunks are already inaccessible. We only have to account for
   // kRegular and kNonRegular chunks.
   for (auto& chunk : chunks_[kRegular]) {
     sum += chunk->size();
@@ -344,6 +373,9 @@ Address MemoryAllocator::AllocateAlignedMemory(
   if (!reservation.IsReserved()) return kNullAddress;
   Address base = reservation.address();
   size_ += reservation.size();
+  // Regular pages are smaller than a huge page. Outside of the pointer
+  // compression cage, only large pages can be backed by huge pages.
+  if (reserve_size >= kHugePageSize) AdviseHugePages(base, reserve_size);
 
   if (executable == EXECUTABLE) {
     if (!CommitExecutableMemory(&reservation, base, commit_size,
@@ -598,7 +630,19 @@ void MemoryAllocator::PerformFreeMemory(MemoryChunk* chunk) {
 
   VirtualMemory* reservation = chunk->reserved_memory();
   if (chunk->IsFlagSet(MemoryChunk::POOLED)) {
-    UncommitMemory(reservation);
+    // Pooled chunks are made inaccessible, so that stale accesses trap, but
+    // their memory is only released lazily (MADV_FREE). The OS reclaims it
+    // under memory pressure, and a chunk that is reused before that does not
+    // have to be faulted in again. With transparent huge pages, discarding a
+    // chunk would split the huge page behind it, so its memory is kept until
+    // the pool is emptied and the whole huge page is free.
+    v8::PageAllocator* page_allocator = reservation->page_allocator();
+    void* address = reinterpret_cast<void*>(reservation->address());
+    CHECK(page_allocator->SetNoAccessWithoutDiscarding(address,
+                                                       reservation->size()));
+    if (!FLAG_transparent_huge_pages) {
+      USE(page_allocator->DiscardSystemPages(address, reservation->size()));
+    }
   } else {
     DCHECK(reservation->IsReserved());
     reservation->Free();
@@ -613,7 +657,7 @@ void MemoryAllocator::Free(MemoryChunk* chunk) {
       PerformFreeMemory(chunk);
       break;
     case kAlreadyPooled:
-      // Pooled pages cannot be touched anymore as their memory is uncommitted.
+      // Pooled pages cannot be touched anymore as they are inaccessible.
       // Pooled pages are not-executable.
       FreeMemory(data_page_allocator(), chunk->address(),
                  static_cast<size_t>(MemoryChunk::kPageSize));
@@ -667,6 +711,9 @@ template EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE)
 template EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE)
     Page* MemoryAllocator::AllocatePage<MemoryAllocator::kRegular, SemiSpace>(
         size_t size, SemiSpace* owner, Executability executable);
+template EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE)
+    Page* MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, PagedSpace>(
+        size_t size, PagedSpace* owner, Executability executable);
 template EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE)
     Page* MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, SemiSpace>(
         size_t size, SemiSpace* owner, Executability executable);
@@ -698,7 +745,11 @@ LargePage* MemoryAllocator::AllocateLargePage(size_t size,
 template <typename SpaceType>
 MemoryChunk* MemoryAllocator::AllocatePagePooled(SpaceType* owner) {
   MemoryChunk* chunk = unmapper()->TryGetPooledMemoryChunkSafe();
-  if (chunk == nullptr) return nullptr;
+  if (chunk == nullptr) {
+    isolate_->counters()->memory_chunk_pool_misses()->Increment();
+    return nullptr;
+  }
+  isolate_->counters()->memory_chunk_pool_hits()->Increment();
   const int size = MemoryChunk::kPageSize;
   const Address start = reinterpret_cast<Address>(chunk);
   const Address area_start =
@@ -80,7 +80,7 @@ class MemoryAllocator {
     MemoryChunk* TryGetPooledMemoryChunkSafe() {
       // Procedure:
       // (1) Try to get a chunk that was declared as pooled and already has
-      // been uncommitted.
+      // been discarded.
       // (2) Try to steal any memory chunk of kPageSize that would've been
       // unmapped.
       MemoryChunk* chunk = GetMemoryChunkSafe<kPooled>();
@@ -95,6 +95,9 @@ class MemoryAllocator {
     }
 
     V8_EXPORT_PRIVATE void FreeQueuedChunks();
+    // Unmaps the chunks in the pool. Chunks that are still queued for
+    // discarding are pooled later on.
+    V8_EXPORT_PRIVATE void ReleasePooledChunks();
     void CancelAndWaitForPendingTasks();
     void PrepareForGC();
     V8_EXPORT_PRIVATE void EnsureUnmappingCompleted();
@@ -102,6 +105,7 @@ class MemoryAllocator {
     size_t NumberOfCommittedChunks();
     V8_EXPORT_PRIVATE int NumberOfChunks();
     size_t CommittedBufferedMemory();
+    V8_EXPORT_PRIVATE size_t PooledMemory();
 
    private:
     static const int kReservedQueueingSlots = 64;
@@ -111,7 +115,7 @@ class MemoryAllocator {
       kRegular,     // Pages of kPageSize that do not live in a CodeRange and
                     // can thus be used for stealing.
       kNonRegular,  // Large chunks and executable chunks.
-      kPooled,      // Pooled chunks, already uncommited and ready for reuse.
+      kPooled,      // Pooled chunks, already discarded and ready for reuse.
       kNumberOfChunkQueues,
     };
 
@@ -137,6 +141,10 @@ class MemoryAllocator {
 
     bool MakeRoomForNewTasks();
 
+    // Whether the pool can take another chunk without exceeding
+    // --memory-chunk-pool-size.
+    bool HasRoomInPool();
+
     template <FreeMode mode>
     void PerformFreeMemoryOnQueuedChunks(JobDelegate* delegate = nullptr);
 
@@ -429,6 +437,9 @@ extern template EXPORT_TEMPLATE_DECLARE(V8_EXPORT_PRIVATE)
 extern template EXPORT_TEMPLATE_DECLARE(V8_EXPORT_PRIVATE)
     Page* MemoryAllocator::AllocatePage<MemoryAllocator::kRegular, SemiSpace>(
         size_t size, SemiSpace* owner, Executability executable);
+extern template EXPORT_TEMPLATE_DECLARE(V8_EXPORT_PRIVATE)
+    Page* MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, PagedSpace>(
+        size_t size, PagedSpace* owner, Executability executable);
 extern template EXPORT_TEMPLATE_DECLARE(V8_EXPORT_PRIVATE)
     Page* MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, SemiSpace>(
         size_t size, SemiSpace* owner, Executability executable);
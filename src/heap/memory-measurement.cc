@@ -4,9 +4,12 @@
 
 #include "src/heap/memory-measurement.h"
 
+#include <algorithm>
+
 #include "include/v8.h"
 #include "src/api/api-inl.h"
 #include "src/execution/isolate-inl.h"
+#include "src/handles/global-handles.h"
 #include "src/heap/factory-inl.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/marking-worklist.h"
@@ -193,8 +196,18 @@ bool MemoryMeasurement::EnqueueRequest(
 }
 
 std::vector<Address> MemoryMeasurement::StartProcessing() {
-  if (received_.empty()) return {};
+  tracked_contexts_.erase(
+      std::remove_if(tracked_contexts_.begin(), tracked_contexts_.end(),
+                     [](const TrackedContext& tracked) {
+                       return *tracked.location == nullptr;
+                     }),
+      tracked_contexts_.end());
+  if (received_.empty() && tracked_contexts_.empty()) return {};
   std::unordered_set<Address> unique_contexts;
+  for (auto& tracked : tracked_contexts_) {
+    tracked.measuring = true;
+    unique_contexts.insert(**tracked.location);
+  }
   DCHECK(processing_.empty());
   processing_ = std::move(received_);
   for (const auto& request : processing_) {
@@ -210,7 +223,16 @@ std::vector<Address> MemoryMeasurement::StartProcessing() {
 }
 
 void MemoryMeasurement::FinishProcessing(const NativeContextStats& stats) {
-  if (processing_.empty()) return;
+  bool limit_exceeded = false;
+  for (auto& tracked : tracked_contexts_) {
+    if (!tracked.measuring || *tracked.location == nullptr) continue;
+    tracked.measuring = false;
+    tracked.live_bytes = stats.Get(**tracked.location);
+    tracked.limit_exceeded =
+        tracked.limit > 0 && tracked.live_bytes > tracked.limit;
+    limit_exceeded |= tracked.limit_exceeded;
+  }
+  if (processing_.empty() && !(limit_exceeded && limit_callback_)) return;
 
   while (!processing_.empty()) {
     Request request = std::move(processing_.front());
@@ -228,6 +250,47 @@ void MemoryMeasurement::FinishProcessing(const NativeContextStats& stats) {
   ScheduleReportingTask();
 }
 
+std::vector<MemoryMeasurement::TrackedContext>::iterator
+MemoryMeasurement::FindTrackedContext(Handle<NativeContext> context) {
+  return std::find_if(tracked_contexts_.begin(), tracked_contexts_.end(),
+                      [context](const TrackedContext& tracked) {
+                        return *tracked.location != nullptr &&
+                               **tracked.location == context->ptr();
+                      });
+}
+
+void MemoryMeasurement::TrackContext(Handle<NativeContext> context,
+                                     size_t limit) {
+  auto it = FindTrackedContext(context);
+  if (it != tracked_contexts_.end()) {
+    it->limit = limit;
+    return;
+  }
+  Handle<NativeContext> global_context =
+      isolate_->global_handles()->Create(*context);
+  auto location = std::make_unique<Address*>(global_context.location());
+  GlobalHandles::MakeWeak(location.get());
+  tracked_contexts_.push_back({std::move(location), limit, 0, false, false});
+}
+
+void MemoryMeasurement::UntrackContext(Handle<NativeContext> context) {
+  auto it = FindTrackedContext(context);
+  if (it == tracked_contexts_.end()) return;
+  GlobalHandles::Destroy(*it->location);
+  tracked_contexts_.erase(it);
+}
+
+size_t MemoryMeasurement::ContextLiveBytes(
+    Handle<NativeContext> context) const {
+  for (const auto& tracked : tracked_contexts_) {
+    if (*tracked.location != nullptr &&
+        **tracked.location == context->ptr()) {
+      return tracked.live_bytes;
+    }
+  }
+  return 0;
+}
+
 void MemoryMeasurement::ScheduleReportingTask() {
   if (reporting_task_pending_) return;
   reporting_task_pending_ = true;
@@ -236,6 +299,7 @@ void MemoryMeasurement::ScheduleReportingTask() {
   taskrunner->PostTask(MakeCancelableTask(isolate_, [this] {
     reporting_task_pending_ = false;
     ReportResults();
+    ReportExceededLimits();
   }));
 }
 
@@ -327,6 +391,24 @@ void MemoryMeasurement::ReportResults() {
   }
 }
 
+void MemoryMeasurement::ReportExceededLimits() {
+  if (!limit_callback_) return;
+  HandleScope handle_scope(isolate_);
+  // The callback may track or untrack contexts, so collect them first.
+  std::vector<std::pair<v8::Local<v8::Context>, size_t>> exceeded;
+  for (auto& tracked : tracked_contexts_) {
+    if (!tracked.limit_exceeded || *tracked.location == nullptr) continue;
+    tracked.limit_exceeded = false;
+    v8::Local<v8::Context> context = Utils::Convert<HeapObject, v8::Context>(
+        handle(HeapObject::cast(Object(**tracked.location)), isolate_));
+    exceeded.push_back(std::make_pair(context, tracked.live_bytes));
+  }
+  for (const auto& context_and_size : exceeded) {
+    limit_callback_(context_and_size.first, context_and_size.second,
+                    limit_callback_data_);
+  }
+}
+
 std::unique_ptr<v8::MeasureMemoryDelegate> MemoryMeasurement::DefaultDelegate(
     Isolate* isolate, Handle<NativeContext> context, Handle<JSPromise> promise,
     v8::MeasureMemoryMode mode) {
@@ -355,7 +437,7 @@ bool NativeContextInferrer::InferForJSFunction(Isolate* isolate,
                                                                     function);
   // The context may be a smi during deserialization.
   if (maybe_context.IsSmi()) {
-    DCHECK_EQ(maybe_context, Deserializer::uninitialized_field_value());
+    DCHECK_EQ(maybe_context, Smi::uninitialized_deserialization_value());
     return false;
   }
   if (!maybe_context.IsContext()) {
@@ -31,6 +31,16 @@ class MemoryMeasurement {
   std::vector<Address> StartProcessing();
   void FinishProcessing(const NativeContextStats& stats);
 
+  // Tracked contexts are measured in every full GC until they die.
+  void TrackContext(Handle<NativeContext> context, size_t limit);
+  void UntrackContext(Handle<NativeContext> context);
+  size_t ContextLiveBytes(Handle<NativeContext> context) const;
+  void SetContextLimitCallback(v8::ContextMemoryLimitCallback callback,
+                               void* data) {
+    limit_callback_ = callback;
+    limit_callback_data_ = data;
+  }
+
   static std::unique_ptr<v8::MeasureMemoryDelegate> DefaultDelegate(
       Isolate* isolate, Handle<NativeContext> context,
       Handle<JSPromise> promise, v8::MeasureMemoryMode mode);
@@ -44,6 +54,20 @@ class MemoryMeasurement {
     size_t shared;
     base::ElapsedTimer timer;
   };
+  struct TrackedContext {
+    // Location of a weak global handle, which is reset when the context dies.
+    std::unique_ptr<Address*> location;
+    size_t limit;
+    size_t live_bytes;
+    // Whether the current GC measures the context. Contexts that are tracked
+    // during marking are measured only by the next GC.
+    bool measuring;
+    // Whether the limit callback is due for the last measurement.
+    bool limit_exceeded;
+  };
+  std::vector<TrackedContext>::iterator FindTrackedContext(
+      Handle<NativeContext> context);
+  void ReportExceededLimits();
   void ScheduleReportingTask();
   void ReportResults();
   void ScheduleGCTask(v8::MeasureMemoryExecution execution);
@@ -55,6 +79,9 @@ class MemoryMeasurement {
   std::list<Request> received_;
   std::list<Request> processing_;
   std::list<Request> done_;
+  std::vector<TrackedContext> tracked_contexts_;
+  v8::ContextMemoryLimitCallback limit_callback_ = nullptr;
+  void* limit_callback_data_ = nullptr;
   Isolate* isolate_;
   bool reporting_task_pending_ = false;
   bool delayed_gc_task_pending_ = false;
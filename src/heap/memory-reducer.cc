@@ -8,6 +8,7 @@
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/incremental-marking.h"
+#include "src/heap/memory-allocator.h"
 #include "src/init/v8.h"
 #include "src/utils/utils.h"
 
@@ -118,6 +119,10 @@ void MemoryReducer::NotifyMarkCompact(const Event& event) {
           "Memory reducer: finished GC #%d (%s)\n", state_.started_gcs,
           state_.action == kWait ? "will do more" : "done");
     }
+    if (state_.action == kDone) {
+      // The mutator is idle, so freed pages are unlikely to be reused soon.
+      heap()->memory_allocator()->unmapper()->ReleasePooledChunks();
+    }
   }
 }
 
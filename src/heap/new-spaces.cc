@@ -429,12 +429,16 @@ void NewSpace::ResetParkedAllocationBuffers() {
 void NewSpace::Flip() { SemiSpace::Swap(&from_space_, &to_space_); }
 
 void NewSpace::Grow() {
-  DCHECK(heap()->safepoint()->IsActive());
   // Double the semispace size but only up to maximum capacity.
   DCHECK(TotalCapacity() < MaximumCapacity());
-  size_t new_capacity = std::min(
-      MaximumCapacity(),
-      static_cast<size_t>(FLAG_semi_space_growth_factor) * TotalCapacity());
+  GrowTo(static_cast<size_t>(FLAG_semi_space_growth_factor) * TotalCapacity());
+}
+
+void NewSpace::GrowTo(size_t new_capacity) {
+  DCHECK(heap()->safepoint()->IsActive());
+  new_capacity =
+      std::min(MaximumCapacity(), ::RoundUp(new_capacity, Page::kPageSize));
+  if (new_capacity <= TotalCapacity()) return;
   if (to_space_.GrowTo(new_capacity)) {
     // Only grow from space if we managed to grow to-space.
     if (!from_space_.GrowTo(new_capacity)) {
@@ -446,8 +450,11 @@ void NewSpace::Grow() {
   DCHECK_SEMISPACE_ALLOCATION_INFO(allocation_info_, to_space_);
 }
 
-void NewSpace::Shrink() {
-  size_t new_capacity = std::max(InitialTotalCapacity(), 2 * Size());
+void NewSpace::Shrink() { ShrinkTo(InitialTotalCapacity()); }
+
+void NewSpace::ShrinkTo(size_t new_capacity) {
+  DCHECK_GE(new_capacity, InitialTotalCapacity());
+  new_capacity = std::max(new_capacity, 2 * Size());
   size_t rounded_new_capacity = ::RoundUp(new_capacity, Page::kPageSize);
   if (rounded_new_capacity < TotalCapacity()) {
     to_space_.ShrinkTo(rounded_new_capacity);
@@ -254,9 +254,17 @@ class V8_EXPORT_PRIVATE NewSpace
   // their maximum capacity.
   void Grow();
 
+  // Grow the capacity of the semispaces to at least |new_capacity|, rounded
+  // up to pages and limited to the maximum capacity.
+  void GrowTo(size_t new_capacity);
+
   // Shrink the capacity of the semispaces.
   void Shrink();
 
+  // Shrink the capacity of the semispaces to |new_capacity|, rounded up to
+  // pages. Keeps room for at least twice the allocated bytes.
+  void ShrinkTo(size_t new_capacity);
+
   // Return the allocated bytes in the active semispace.
   size_t Size() final {
     DCHECK_GE(top(), to_space_.page_low());
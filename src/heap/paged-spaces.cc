@@ -306,8 +306,13 @@ void PagedSpace::ShrinkImmortalImmovablePages() {
 }
 
 Page* PagedSpace::AllocatePage() {
-  return heap()->memory_allocator()->AllocatePage(AreaSize(), this,
-                                                  executable());
+  // Code pages are never pooled, see ReleasePage.
+  if (executable() == EXECUTABLE) {
+    return heap()->memory_allocator()->AllocatePage(AreaSize(), this,
+                                                    executable());
+  }
+  return heap()->memory_allocator()->AllocatePage<MemoryAllocator::kPooled>(
+      AreaSize(), this, executable());
 }
 
 Page* PagedSpace::Expand() {
@@ -466,7 +471,14 @@ void PagedSpace::ReleasePage(Page* page) {
 
   AccountUncommitted(page->size());
   accounting_stats_.DecreaseCapacity(page->area_size());
-  heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(page);
+  // Keep data pages around for reuse instead of unmapping them, so that the
+  // next expansion does not have to map and fault in fresh memory.
+  if (page->executable() == NOT_EXECUTABLE &&
+      page->size() == static_cast<size_t>(MemoryChunk::kPageSize)) {
+    heap()->memory_allocator()->Free<MemoryAllocator::kPooledAndQueue>(page);
+  } else {
+    heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(page);
+  }
 }
 
 void PagedSpace::SetReadable() {
@@ -10,6 +10,7 @@
 #include "src/base/lazy-instance.h"
 #include "src/base/platform/mutex.h"
 #include "src/common/ptr-compr-inl.h"
+#include "src/flags/flags.h"
 #include "src/heap/basic-memory-chunk.h"
 #include "src/heap/heap-write-barrier-inl.h"
 #include "src/heap/memory-chunk.h"
@@ -18,6 +19,7 @@
 #include "src/objects/heap-object-inl.h"
 #include "src/objects/objects-inl.h"
 #include "src/objects/smi.h"
+#include "src/objects/string-table.h"
 #include "src/snapshot/read-only-deserializer.h"
 #include "src/utils/allocation.h"
 
@@ -78,6 +80,9 @@ void ReadOnlyHeap::SetUp(Isolate* isolate,
         ro_heap = CreateInitalHeapForBootstrapping(isolate, artifacts);
         ro_heap->DeseralizeIntoIsolate(isolate, read_only_snapshot_data,
                                        can_rehash);
+        if (FLAG_shared_string_table) {
+          artifacts->InitializeSharedStringTable(isolate);
+        }
         read_only_heap_created = true;
       } else {
         // With pointer compression, there is one ReadOnlyHeap per Isolate.
@@ -88,6 +93,8 @@ void ReadOnlyHeap::SetUp(Isolate* isolate,
       artifacts->VerifyChecksum(read_only_snapshot_data,
                                 read_only_heap_created);
       ro_heap->InitializeIsolateRoots(isolate);
+      isolate->string_table()->set_shared_table(
+          artifacts->shared_string_table());
     } else {
       // This path should only be taken in mksnapshot, should only be run once
       // before tearing down the Isolate that holds this ReadOnlyArtifacts and
@@ -21,6 +21,7 @@
 #include "src/heap/read-only-heap.h"
 #include "src/objects/objects-inl.h"
 #include "src/objects/property-details.h"
+#include "src/objects/string-table.h"
 #include "src/objects/string.h"
 #include "src/snapshot/read-only-deserializer.h"
 
@@ -34,6 +35,10 @@ void CopyAndRebaseRoots(Address* src, Address* dst, Address new_base) {
   }
 }
 
+ReadOnlyArtifacts::ReadOnlyArtifacts() = default;
+
+ReadOnlyArtifacts::~ReadOnlyArtifacts() = default;
+
 void ReadOnlyArtifacts::set_read_only_heap(
     std::unique_ptr<ReadOnlyHeap> read_only_heap) {
   read_only_heap_ = std::move(read_only_heap);
@@ -46,6 +51,11 @@ void ReadOnlyArtifacts::InitializeChecksum(
 #endif  // DEBUG
 }
 
+void ReadOnlyArtifacts::InitializeSharedStringTable(Isolate* isolate) {
+  DCHECK(!shared_string_table_);
+  shared_string_table_ = std::make_unique<SharedStringTable>(isolate);
+}
+
 void ReadOnlyArtifacts::VerifyChecksum(SnapshotData* read_only_snapshot_data,
                                        bool read_only_heap_created) {
 #ifdef DEBUG
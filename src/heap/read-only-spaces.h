@@ -22,6 +22,7 @@ namespace internal {
 
 class MemoryAllocator;
 class ReadOnlyHeap;
+class SharedStringTable;
 class SnapshotData;
 
 class ReadOnlyPage : public BasicMemoryChunk {
@@ -62,7 +63,7 @@ class ReadOnlyPage : public BasicMemoryChunk {
 // Artifacts used to construct a new SharedReadOnlySpace
 class ReadOnlyArtifacts {
  public:
-  virtual ~ReadOnlyArtifacts() = default;
+  virtual ~ReadOnlyArtifacts();
 
   // Initialize the ReadOnlyArtifacts from an Isolate that has just been created
   // either by serialization or by creating the objects directly.
@@ -104,13 +105,22 @@ class ReadOnlyArtifacts {
   void VerifyChecksum(SnapshotData* read_only_snapshot_data,
                       bool read_only_heap_created);
 
+  // Builds the table of read-only internalized strings that is shared by the
+  // string tables of all Isolates. Must be called before the artifacts are
+  // shared.
+  void InitializeSharedStringTable(Isolate* isolate);
+  const SharedStringTable* shared_string_table() const {
+    return shared_string_table_.get();
+  }
+
  protected:
-  ReadOnlyArtifacts() = default;
+  ReadOnlyArtifacts();
 
   std::vector<ReadOnlyPage*> pages_;
   AllocationStats stats_;
   std::unique_ptr<SharedReadOnlySpace> shared_read_only_space_;
   std::unique_ptr<ReadOnlyHeap> read_only_heap_;
+  std::unique_ptr<SharedStringTable> shared_string_table_;
 #ifdef DEBUG
   // The checksum of the blob the read-only heap was deserialized from, if
   // any.
@@ -148,10 +148,13 @@ void IsolateAllocator::CommitPagesForIsolate(Address heap_reservation_address) {
   size_t page_size = RoundUp(size_t{1} << kPageSizeBits,
                              platform_page_allocator->AllocatePageSize());
 
+  // With transparent huge pages, freed heap pages are decommitted in groups
+  // so that the huge pages backing the rest of the group stay intact.
   page_allocator_instance_ = std::make_unique<base::BoundedPageAllocator>(
       platform_page_allocator, isolate_root, kPtrComprHeapReservationSize,
-      page_size);
+      page_size, FLAG_transparent_huge_pages ? kHugePageSize : 0);
   page_allocator_ = page_allocator_instance_.get();
+  AdviseHugePages(isolate_root, kPtrComprHeapReservationSize);
 
   Address isolate_address = isolate_root - Isolate::isolate_root_bias();
   Address isolate_end = isolate_address + sizeof(Isolate);
@@ -6,6 +6,7 @@
 
 #include "src/common/message-template.h"
 #include "src/debug/debug.h"
+#include "src/json/json-simd.h"
 #include "src/numbers/conversions.h"
 #include "src/numbers/hash-seed-inl.h"
 #include "src/objects/field-type.h"
@@ -20,6 +21,106 @@ namespace internal {
 
 namespace {
 
+// The JSON scanner skips over whole blocks of characters at once as long as
+// none of them is interesting, and leaves finding the exact position of the
+// first interesting character to the scalar code. Without vector support, the
+// functions below don't skip anything.
+#if V8_JSON_SIMD_SSE2 || V8_JSON_SIMD_NEON
+
+template <typename Char>
+const Char* SkipPlainJsonStringBlocks(const Char* cursor, const Char* end,
+                                      uc32* bits) {
+  constexpr int kBlockSize = kJsonSimdBlockSize / sizeof(Char);
+  while (end - cursor >= kBlockSize) {
+    if (JsonBlockHasSpecialCharacter(cursor)) break;
+    // Like the scalar code, only record whether there are characters outside
+    // of Latin1.
+    if (sizeof(Char) == 2 && *bits <= unibrow::Latin1::kMaxChar &&
+        JsonBlockHasNonLatin1Character(
+            reinterpret_cast<const uint16_t*>(cursor))) {
+      *bits |= unibrow::Latin1::kMaxChar + 1;
+    }
+    cursor += kBlockSize;
+  }
+  return cursor;
+}
+
+#endif
+
+#if V8_JSON_SIMD_SSE2
+
+template <typename Char>
+const Char* SkipJsonWhitespaceBlocks(const Char* cursor, const Char* end) {
+  constexpr int kBlockSize = kJsonSimdBlockSize / sizeof(Char);
+  while (end - cursor >= kBlockSize) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+    __m128i whitespace;
+    if (sizeof(Char) == 1) {
+      whitespace = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')),
+                       _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n'))),
+          _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')),
+                       _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t'))));
+    } else {
+      whitespace = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi16(chars, _mm_set1_epi16(' ')),
+                       _mm_cmpeq_epi16(chars, _mm_set1_epi16('\n'))),
+          _mm_or_si128(_mm_cmpeq_epi16(chars, _mm_set1_epi16('\r')),
+                       _mm_cmpeq_epi16(chars, _mm_set1_epi16('\t'))));
+    }
+    if (_mm_movemask_epi8(whitespace) != 0xFFFF) break;
+    cursor += kBlockSize;
+  }
+  return cursor;
+}
+
+#elif V8_JSON_SIMD_NEON
+
+const uint8_t* SkipJsonWhitespaceBlocks(const uint8_t* cursor,
+                                        const uint8_t* end) {
+  while (end - cursor >= 16) {
+    uint8x16_t chars = vld1q_u8(cursor);
+    uint8x16_t whitespace =
+        vorrq_u8(vorrq_u8(vceqq_u8(chars, vdupq_n_u8(' ')),
+                          vceqq_u8(chars, vdupq_n_u8('\n'))),
+                 vorrq_u8(vceqq_u8(chars, vdupq_n_u8('\r')),
+                          vceqq_u8(chars, vdupq_n_u8('\t'))));
+    if (vminvq_u8(whitespace) == 0) break;
+    cursor += 16;
+  }
+  return cursor;
+}
+
+const uint16_t* SkipJsonWhitespaceBlocks(const uint16_t* cursor,
+                                         const uint16_t* end) {
+  while (end - cursor >= 8) {
+    uint16x8_t chars = vld1q_u16(cursor);
+    uint16x8_t whitespace =
+        vorrq_u16(vorrq_u16(vceqq_u16(chars, vdupq_n_u16(' ')),
+                            vceqq_u16(chars, vdupq_n_u16('\n'))),
+                  vorrq_u16(vceqq_u16(chars, vdupq_n_u16('\r')),
+                            vceqq_u16(chars, vdupq_n_u16('\t'))));
+    if (vminvq_u16(whitespace) == 0) break;
+    cursor += 8;
+  }
+  return cursor;
+}
+
+#else
+
+template <typename Char>
+const Char* SkipPlainJsonStringBlocks(const Char* cursor, const Char* end,
+                                      uc32* bits) {
+  return cursor;
+}
+
+template <typename Char>
+const Char* SkipJsonWhitespaceBlocks(const Char* cursor, const Char* end) {
+  return cursor;
+}
+
+#endif
+
 constexpr JsonToken GetOneCharJsonToken(uint8_t c) {
   // clang-format off
   return
@@ -201,11 +302,13 @@ bool JsonParseInternalizer::RecurseAndApply(Handle<JSReceiver> holder,
 }
 
 template <typename Char>
-JsonParser<Char>::JsonParser(Isolate* isolate, Handle<String> source)
+JsonParser<Char>::JsonParser(Isolate* isolate, Handle<String> source,
+                             size_t position_offset)
     : isolate_(isolate),
       hash_seed_(HashSeed(isolate)),
       object_constructor_(isolate_->object_function()),
-      original_source_(source) {
+      original_source_(source),
+      position_offset_(position_offset) {
   size_t start = 0;
   size_t length = source->length();
   if (source->IsSlicedString()) {
@@ -245,7 +348,7 @@ void JsonParser<Char>::ReportUnexpectedToken(JsonToken token) {
                    ? SlicedString::cast(*original_source_).offset()
                    : 0;
   int pos = position() - offset;
-  Handle<Object> arg1 = Handle<Smi>(Smi::FromInt(pos), isolate());
+  Handle<Object> arg1 = factory->NewNumberFromSize(position_offset_ + pos);
   Handle<Object> arg2;
 
   switch (token) {
@@ -319,6 +422,11 @@ template <typename Char>
 void JsonParser<Char>::SkipWhitespace() {
   next_ = JsonToken::EOS;
 
+  // Only look for long runs of whitespace, e.g. indentation, if there is any
+  // whitespace at all.
+  if (cursor_ != end_ && V8_UNLIKELY(*cursor_ <= ' ')) {
+    cursor_ = SkipJsonWhitespaceBlocks(cursor_, end_);
+  }
   cursor_ = std::find_if(cursor_, end_, [this](Char c) {
     JsonToken current = V8_LIKELY(c <= unibrow::Latin1::kMaxChar)
                             ? one_char_json_tokens[c]
@@ -398,6 +506,65 @@ Handle<Map> ParentOfDescriptorOwner(Isolate* isolate, Handle<Map> maybe_root,
 }
 }  // namespace
 
+template <typename Char>
+Map JsonParser<Char>::GetSiblingMap(
+    const JsonContinuation& cont,
+    const std::vector<JsonContinuation>& cont_stack,
+    const SmallVector<JsonProperty>& property_stack,
+    const SmallVector<Handle<Object>>& element_stack) {
+  // Find the closest enclosing array. Only objects may be in between.
+  size_t array_level = cont_stack.size();
+  while (true) {
+    if (array_level == 0) return Map();
+    JsonContinuation::Type type = cont_stack[array_level - 1].type();
+    if (type == JsonContinuation::kArrayElement) break;
+    if (type != JsonContinuation::kObjectProperty) return Map();
+    array_level--;
+  }
+  array_level--;
+  if (cont_stack[array_level].index >= element_stack.size() ||
+      !element_stack.back()->IsJSObject()) {
+    return Map();
+  }
+
+  // Walk down from the previous element of the array along the keys that lead
+  // to the object being built.
+  DisallowGarbageCollection no_gc;
+  JSObject sibling = JSObject::cast(*element_stack.back());
+  for (size_t level = array_level + 1; level < cont_stack.size(); level++) {
+    const JsonContinuation& parent = cont_stack[level];
+    size_t child_index = level + 1 < cont_stack.size()
+                             ? cont_stack[level + 1].index
+                             : cont.index;
+    DCHECK_LT(parent.index, child_index);
+    const JsonString& key = property_stack[child_index - 1].string;
+    if (key.is_index() || key.has_escape()) return Map();
+    int descriptor = 0;
+    for (size_t i = parent.index; i < child_index - 1; i++) {
+      if (!property_stack[i].string.is_index()) descriptor++;
+    }
+
+    Map map = sibling.map();
+    if (map.is_dictionary_map() || descriptor >= map.NumberOfOwnDescriptors()) {
+      return Map();
+    }
+    InternalIndex descriptor_index(descriptor);
+    DescriptorArray descriptors = map.instance_descriptors(isolate_);
+    PropertyDetails details = descriptors.GetDetails(descriptor_index);
+    Vector<const Char> chars(chars_ + key.start(), key.length());
+    if (details.location() != kField ||
+        details.representation().IsDouble() ||
+        !String::cast(descriptors.GetKey(descriptor_index)).IsEqualTo(chars)) {
+      return Map();
+    }
+    Object value = sibling.RawFastPropertyAt(
+        FieldIndex::ForDescriptor(map, descriptor_index));
+    if (!value.IsJSObject()) return Map();
+    sibling = JSObject::cast(value);
+  }
+  return sibling.map();
+}
+
 template <typename Char>
 Handle<Object> JsonParser<Char>::BuildJsonObject(
     const JsonContinuation& cont,
@@ -816,11 +983,9 @@ MaybeHandle<Object> JsonParser<Char>::ParseJsonValue() {
           }
 
           Handle<Map> feedback;
-          if (cont_stack.size() > 0 &&
-              cont_stack.back().type() == JsonContinuation::kArrayElement &&
-              cont_stack.back().index < element_stack.size() &&
-              element_stack.back()->IsJSObject()) {
-            Map maybe_feedback = JSObject::cast(*element_stack.back()).map();
+          Map maybe_feedback =
+              GetSiblingMap(cont, cont_stack, property_stack, element_stack);
+          if (!maybe_feedback.is_null()) {
             // Don't consume feedback from objects with a map that's detached
             // from the transition tree.
             if (!maybe_feedback.IsDetached(isolate_)) {
@@ -1103,6 +1268,7 @@ JsonString JsonParser<Char>::ScanJsonString(bool needs_internalization) {
   uc32 bits = 0;
 
   while (true) {
+    cursor_ = SkipPlainJsonStringBlocks(cursor_, end_, &bits);
     cursor_ = std::find_if(cursor_, end_, [&bits](Char c) {
       if (sizeof(Char) == 2 && V8_UNLIKELY(c > unibrow::Latin1::kMaxChar)) {
         bits |= c;
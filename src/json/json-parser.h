@@ -152,6 +152,14 @@ class JsonParser final {
     return result;
   }
 
+  // Parses {source}, which is a part of a larger JSON text that is parsed
+  // piecewise, e.g. as it is streamed in. {position_offset} is the position of
+  // {source} in the larger text, to which the positions in errors refer.
+  V8_WARN_UNUSED_RESULT static MaybeHandle<Object> ParsePart(
+      Isolate* isolate, Handle<String> source, size_t position_offset) {
+    return JsonParser(isolate, source, position_offset).ParseJson();
+  }
+
   static constexpr uc32 kEndOfString = static_cast<uc32>(-1);
   static constexpr uc32 kInvalidUnicodeCharacter = static_cast<uc32>(-1);
 
@@ -178,7 +186,8 @@ class JsonParser final {
     uint32_t elements;
   };
 
-  JsonParser(Isolate* isolate, Handle<String> source);
+  JsonParser(Isolate* isolate, Handle<String> source,
+             size_t position_offset = 0);
   ~JsonParser();
 
   // Parse a string containing a single JSON value.
@@ -291,6 +300,14 @@ class JsonParser final {
   Handle<Object> BuildJsonObject(
       const JsonContinuation& cont,
       const SmallVector<JsonProperty>& property_stack, Handle<Map> feedback);
+  // Returns the map of the object at the same position as the object being
+  // built in the previous element of the closest enclosing array, e.g. of
+  // a.b when building b.b in [{"b": {...}}, {"b": {...}}]. Its map is used as
+  // feedback for building the object with the expected map directly.
+  Map GetSiblingMap(const JsonContinuation& cont,
+                    const std::vector<JsonContinuation>& cont_stack,
+                    const SmallVector<JsonProperty>& property_stack,
+                    const SmallVector<Handle<Object>>& element_stack);
   Handle<Object> BuildJsonArray(
       const JsonContinuation& cont,
       const SmallVector<Handle<Object>>& element_stack);
@@ -341,6 +358,9 @@ class JsonParser final {
   Handle<JSFunction> object_constructor_;
   const Handle<String> original_source_;
   Handle<String> source_;
+  // The position of original_source_ in the JSON text, if it is only a part of
+  // it, for reporting positions in errors.
+  const size_t position_offset_;
 
   // Cached pointer to the raw chars in source. In case source is on-heap, we
   // register an UpdatePointers callback. For this reason, chars_, cursor_ and
@@ -0,0 +1,110 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_JSON_JSON_SIMD_H_
+#define V8_JSON_JSON_SIMD_H_
+
+#include <stdint.h>
+
+#include "src/base/macros.h"
+
+// SSE2 is part of the x64 baseline and NEON part of the arm64 baseline, so
+// the vectorized JSON scanning doesn't need runtime CPU feature detection.
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86) && _M_IX86_FP >= 2)
+#define V8_JSON_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define V8_JSON_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace v8 {
+namespace internal {
+
+// The JSON parser and JSON.stringify both process strings in blocks of this
+// many bytes, as long as no character in a block needs special treatment.
+constexpr int kJsonSimdBlockSize = 16;
+
+#if V8_JSON_SIMD_SSE2
+
+// Returns true if any character of the block at {chars} is a quote, a
+// backslash or a control character, i.e. may end a plain run of a JSON string.
+V8_INLINE bool JsonBlockHasSpecialCharacter(const uint8_t* chars) {
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+  __m128i quote = _mm_cmpeq_epi8(block, _mm_set1_epi8('"'));
+  __m128i backslash = _mm_cmpeq_epi8(block, _mm_set1_epi8('\\'));
+  // Unsigned comparison: block <= 0x1F iff min(block, 0x1F) == block.
+  __m128i control =
+      _mm_cmpeq_epi8(_mm_min_epu8(block, _mm_set1_epi8(0x1F)), block);
+  return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(quote, backslash),
+                                        control)) != 0;
+}
+
+V8_INLINE bool JsonBlockHasSpecialCharacter(const uint16_t* chars) {
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+  __m128i quote = _mm_cmpeq_epi16(block, _mm_set1_epi16('"'));
+  __m128i backslash = _mm_cmpeq_epi16(block, _mm_set1_epi16('\\'));
+  // Unsigned saturating subtraction: block <= 0x1F iff block - 0x1F == 0.
+  __m128i control = _mm_cmpeq_epi16(
+      _mm_subs_epu16(block, _mm_set1_epi16(0x1F)), _mm_setzero_si128());
+  return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(quote, backslash),
+                                        control)) != 0;
+}
+
+// Returns true if any character of the block at {chars} is a surrogate.
+V8_INLINE bool JsonBlockHasSurrogate(const uint16_t* chars) {
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+  __m128i surrogate = _mm_cmpeq_epi16(
+      _mm_and_si128(block, _mm_set1_epi16(static_cast<int16_t>(0xF800))),
+      _mm_set1_epi16(static_cast<int16_t>(0xD800)));
+  return _mm_movemask_epi8(surrogate) != 0;
+}
+
+// Returns true if any character of the block at {chars} is outside of
+// Latin1.
+V8_INLINE bool JsonBlockHasNonLatin1Character(const uint16_t* chars) {
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+  // Unsigned saturating subtraction: block > 0xFF iff block - 0xFF != 0.
+  __m128i latin1 = _mm_cmpeq_epi16(
+      _mm_subs_epu16(block, _mm_set1_epi16(0xFF)), _mm_setzero_si128());
+  return _mm_movemask_epi8(latin1) != 0xFFFF;
+}
+
+#elif V8_JSON_SIMD_NEON
+
+V8_INLINE bool JsonBlockHasSpecialCharacter(const uint8_t* chars) {
+  uint8x16_t block = vld1q_u8(chars);
+  uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(block, vdupq_n_u8('"')),
+                                         vceqq_u8(block, vdupq_n_u8('\\'))),
+                                vcltq_u8(block, vdupq_n_u8(0x20)));
+  return vmaxvq_u8(special) != 0;
+}
+
+V8_INLINE bool JsonBlockHasSpecialCharacter(const uint16_t* chars) {
+  uint16x8_t block = vld1q_u16(chars);
+  uint16x8_t special =
+      vorrq_u16(vorrq_u16(vceqq_u16(block, vdupq_n_u16('"')),
+                          vceqq_u16(block, vdupq_n_u16('\\'))),
+                vcltq_u16(block, vdupq_n_u16(0x20)));
+  return vmaxvq_u16(special) != 0;
+}
+
+V8_INLINE bool JsonBlockHasSurrogate(const uint16_t* chars) {
+  uint16x8_t block = vld1q_u16(chars);
+  uint16x8_t surrogate = vceqq_u16(vandq_u16(block, vdupq_n_u16(0xF800)),
+                                   vdupq_n_u16(0xD800));
+  return vmaxvq_u16(surrogate) != 0;
+}
+
+V8_INLINE bool JsonBlockHasNonLatin1Character(const uint16_t* chars) {
+  return vmaxvq_u16(vld1q_u16(chars)) > 0xFF;
+}
+
+#endif
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_JSON_JSON_SIMD_H_
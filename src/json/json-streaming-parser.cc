@@ -0,0 +1,461 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/json/json-streaming-parser.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "src/base/memory.h"
+#include "src/execution/isolate.h"
+#include "src/handles/global-handles.h"
+#include "src/heap/factory.h"
+#include "src/json/json-parser.h"
+#include "src/objects/fixed-array-inl.h"
+#include "src/objects/js-array-inl.h"
+#include "src/objects/objects-inl.h"
+#include "src/strings/char-predicates-inl.h"
+#include "src/strings/unicode-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+bool IsJsonWhitespace(uc32 c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Own the buffered characters of a top-level value other than an array, so
+// that they can be parsed in place instead of being copied into a string.
+class OneByteBufferResource final
+    : public v8::String::ExternalOneByteStringResource {
+ public:
+  explicit OneByteBufferResource(std::vector<uint8_t> chars)
+      : chars_(std::move(chars)) {}
+
+  const char* data() const override {
+    return reinterpret_cast<const char*>(chars_.data());
+  }
+  size_t length() const override { return chars_.size(); }
+
+ private:
+  const std::vector<uint8_t> chars_;
+};
+
+class TwoByteBufferResource final : public v8::String::ExternalStringResource {
+ public:
+  explicit TwoByteBufferResource(std::vector<uint16_t> chars)
+      : chars_(std::move(chars)) {}
+
+  const uint16_t* data() const override { return chars_.data(); }
+  size_t length() const override { return chars_.size(); }
+
+ private:
+  const std::vector<uint16_t> chars_;
+};
+
+MaybeHandle<SeqOneByteString> NewRawString(Factory* factory,
+                                           const std::vector<uint8_t>& buffer,
+                                           int length) {
+  return factory->NewRawOneByteString(length);
+}
+
+MaybeHandle<SeqTwoByteString> NewRawString(Factory* factory,
+                                           const std::vector<uint16_t>& buffer,
+                                           int length) {
+  return factory->NewRawTwoByteString(length);
+}
+
+}  // namespace
+
+JsonStreamingParser::JsonStreamingParser(Isolate* isolate, Encoding encoding)
+    : isolate_(isolate), encoding_(encoding) {}
+
+JsonStreamingParser::~JsonStreamingParser() {
+  if (!batches_.is_null()) GlobalHandles::Destroy(batches_.location());
+}
+
+Maybe<bool> JsonStreamingParser::AppendChunk(const uint8_t* data,
+                                             size_t length) {
+  switch (encoding_) {
+    case Encoding::ONE_BYTE:
+      AppendOneByte(data, length);
+      break;
+    case Encoding::TWO_BYTE:
+      AppendTwoByte(data, length);
+      break;
+    case Encoding::UTF8:
+      AppendUtf8(data, length);
+      break;
+  }
+  return is_one_byte_ ? Scan(&one_byte_buffer_) : Scan(&two_byte_buffer_);
+}
+
+MaybeHandle<Object> JsonStreamingParser::Finish() {
+  // An incomplete character at the end is decoded as U+FFFD, like it is when
+  // decoding the whole text at once.
+  if (encoding_ == Encoding::UTF8) {
+    uc32 c = unibrow::Utf8::ValueOfIncrementalFinish(&utf8_state_);
+    if (c != unibrow::Utf8::kBufferEmpty) AppendCharacter(c);
+  } else if (has_pending_byte_) {
+    has_pending_byte_ = false;
+    AppendCharacter(unibrow::Utf8::kBadChar);
+  }
+  if (is_one_byte_) {
+    if (Scan(&one_byte_buffer_).IsNothing()) return MaybeHandle<Object>();
+    return FinishBuffer(&one_byte_buffer_);
+  }
+  if (Scan(&two_byte_buffer_).IsNothing()) return MaybeHandle<Object>();
+  return FinishBuffer(&two_byte_buffer_);
+}
+
+void JsonStreamingParser::AppendCharacter(uc32 c) {
+  if (c > unibrow::Utf16::kMaxNonSurrogateCharCode) {
+    AppendCharacter(unibrow::Utf16::LeadSurrogate(c));
+    AppendCharacter(unibrow::Utf16::TrailSurrogate(c));
+    return;
+  }
+  if (is_one_byte_) {
+    if (c <= unibrow::Latin1::kMaxChar) {
+      one_byte_buffer_.push_back(static_cast<uint8_t>(c));
+      return;
+    }
+    ConvertToTwoByte();
+  }
+  two_byte_buffer_.push_back(static_cast<uint16_t>(c));
+}
+
+void JsonStreamingParser::AppendOneByte(const uint8_t* data, size_t length) {
+  if (is_one_byte_) {
+    one_byte_buffer_.insert(one_byte_buffer_.end(), data, data + length);
+  } else {
+    two_byte_buffer_.insert(two_byte_buffer_.end(), data, data + length);
+  }
+}
+
+void JsonStreamingParser::AppendTwoByte(const uint8_t* data, size_t length) {
+  // Code units may be split between chunks.
+  if (has_pending_byte_ && length > 0) {
+    uint8_t bytes[] = {pending_byte_, *data};
+    AppendCharacter(base::ReadUnalignedValue<uint16_t>(
+        reinterpret_cast<Address>(bytes)));
+    has_pending_byte_ = false;
+    data++;
+    length--;
+  }
+  for (; length >= 2; data += 2, length -= 2) {
+    AppendCharacter(
+        base::ReadUnalignedValue<uint16_t>(reinterpret_cast<Address>(data)));
+  }
+  if (length > 0) {
+    has_pending_byte_ = true;
+    pending_byte_ = *data;
+  }
+}
+
+void JsonStreamingParser::AppendUtf8(const uint8_t* data, size_t length) {
+  const uint8_t* cursor = data;
+  const uint8_t* end = data + length;
+  while (cursor < end) {
+    if (utf8_state_ == unibrow::Utf8::State::kAccept &&
+        *cursor <= unibrow::Utf8::kMaxOneByteChar) {
+      const uint8_t* ascii_end = std::find_if(cursor, end, [](uint8_t c) {
+        return c > unibrow::Utf8::kMaxOneByteChar;
+      });
+      AppendOneByte(cursor, ascii_end - cursor);
+      cursor = ascii_end;
+      continue;
+    }
+    uc32 c = unibrow::Utf8::ValueOfIncremental(&cursor, &utf8_state_,
+                                               &utf8_buffer_);
+    if (c != unibrow::Utf8::kIncomplete) AppendCharacter(c);
+  }
+}
+
+void JsonStreamingParser::ConvertToTwoByte() {
+  DCHECK(is_one_byte_);
+  DCHECK(two_byte_buffer_.empty());
+  two_byte_buffer_.assign(one_byte_buffer_.begin(), one_byte_buffer_.end());
+  one_byte_buffer_ = std::vector<uint8_t>();
+  is_one_byte_ = false;
+}
+
+template <typename Char>
+Maybe<bool> JsonStreamingParser::Scan(std::vector<Char>* buffer) {
+  const Char* chars = buffer->data();
+  const size_t length = buffer->size();
+  // The characters before {begin} are no longer needed.
+  size_t begin = 0;
+  for (size_t i = scanned_length_; i < length && state_ != State::kValue;
+       i++) {
+    Char c = chars[i];
+    switch (state_) {
+      case State::kStart:
+        if (IsJsonWhitespace(c)) {
+          begin = i + 1;
+        } else if (c == '[') {
+          state_ = State::kElements;
+          begin = i + 1;
+        } else {
+          state_ = State::kValue;
+        }
+        break;
+
+      case State::kElements:
+        // Only find the ends of the elements here. Whether the elements are
+        // valid is checked by JsonParser.
+        if (in_string_) {
+          if (escaped_) {
+            escaped_ = false;
+          } else if (c == '\\') {
+            escaped_ = true;
+          } else if (c == '"') {
+            in_string_ = false;
+          }
+          break;
+        }
+        if (IsJsonWhitespace(c)) break;
+        if (depth_ > 0 || (c != ',' && c != ']' && c != '}')) {
+          if (c == '"') {
+            in_string_ = true;
+          } else if (c == '[' || c == '{') {
+            depth_++;
+          } else if (depth_ > 0 && (c == ']' || c == '}')) {
+            depth_--;
+          }
+          element_is_empty_ = false;
+          break;
+        }
+
+        // The character ends the current element, which has to be preceded
+        // by a value and may only be empty in an empty array. Errors in the
+        // elements before are reported first.
+        if (c == '}' ||
+            (element_is_empty_ && (c == ',' || element_count_ > 0))) {
+          MAYBE_RETURN(ParseBatch(*buffer, &begin), Nothing<bool>());
+          if (element_is_empty_) {
+            ThrowUnexpectedCharacter(c, buffer_position_ + i);
+          } else {
+            MaybeHandle<Object> result =
+                ParseBuffered(*buffer, begin, i + 1, true, false);
+            DCHECK(result.is_null());
+            USE(result);
+          }
+          return Nothing<bool>();
+        }
+        if (!element_is_empty_) element_count_++;
+        element_is_empty_ = true;
+        has_batch_ = true;
+        batch_end_ = i;
+        if (c == ']') {
+          MAYBE_RETURN(ParseBatch(*buffer, &begin), Nothing<bool>());
+          state_ = State::kDone;
+        }
+        break;
+
+      case State::kDone:
+        if (!IsJsonWhitespace(c)) {
+          ThrowUnexpectedCharacter(c, buffer_position_ + i);
+          return Nothing<bool>();
+        }
+        begin = i + 1;
+        break;
+
+      case State::kValue:
+        UNREACHABLE();
+    }
+  }
+
+  if (state_ == State::kElements && has_batch_ &&
+      batch_end_ - begin >= kMinBatchLength) {
+    MAYBE_RETURN(ParseBatch(*buffer, &begin), Nothing<bool>());
+  }
+  buffer->erase(buffer->begin(), buffer->begin() + begin);
+  buffer_position_ += begin;
+  scanned_length_ = length - begin;
+  if (has_batch_) batch_end_ -= begin;
+  return Just(true);
+}
+
+template <typename Char>
+Maybe<bool> JsonStreamingParser::ParseBatch(const std::vector<Char>& buffer,
+                                            size_t* begin) {
+  if (!has_batch_) return Just(true);
+  Handle<Object> batch;
+  if (!ParseBuffered(buffer, *begin, batch_end_, true, true).ToHandle(&batch)) {
+    return Nothing<bool>();
+  }
+  if (batches_.is_null()) {
+    batches_ =
+        isolate_->global_handles()->Create(*ArrayList::New(isolate_, 1));
+  }
+  Handle<ArrayList> batches = ArrayList::Add(isolate_, batches_, batch);
+  if (!batches.is_identical_to(batches_)) {
+    GlobalHandles::Destroy(batches_.location());
+    batches_ = isolate_->global_handles()->Create(*batches);
+  }
+  *begin = batch_end_ + 1;
+  has_batch_ = false;
+  return Just(true);
+}
+
+template <typename Char>
+MaybeHandle<Object> JsonStreamingParser::ParseBuffered(
+    const std::vector<Char>& buffer, size_t begin, size_t end, bool open,
+    bool close) {
+  DCHECK_LE(begin, end);
+  DCHECK_LE(end, buffer.size());
+  size_t length = end - begin + open + close;
+  if (length > static_cast<size_t>(String::kMaxLength)) {
+    THROW_NEW_ERROR(isolate_, NewInvalidStringLengthError(), Object);
+  }
+  Handle<typename CharTraits<Char>::String> source;
+  if (!NewRawString(isolate_->factory(), buffer, static_cast<int>(length))
+           .ToHandle(&source)) {
+    return MaybeHandle<Object>();
+  }
+  {
+    DisallowGarbageCollection no_gc;
+    Char* chars = source->GetChars(no_gc);
+    if (open) *chars++ = '[';
+    chars = std::copy(buffer.begin() + begin, buffer.begin() + end, chars);
+    if (close) *chars = ']';
+  }
+  DCHECK_LE(static_cast<size_t>(open), buffer_position_ + begin);
+  return JsonParser<Char>::ParsePart(isolate_, source,
+                                     buffer_position_ + begin - open);
+}
+
+template <typename Char>
+MaybeHandle<Object> JsonStreamingParser::FinishBuffer(
+    std::vector<Char>* buffer) {
+  switch (state_) {
+    case State::kStart:
+      // Report the missing value.
+      DCHECK(buffer->empty());
+      return JsonParser<uint8_t>::ParsePart(
+          isolate_, isolate_->factory()->empty_string(), buffer_position_);
+
+    case State::kElements: {
+      size_t begin = 0;
+      if (ParseBatch(*buffer, &begin).IsNothing()) return MaybeHandle<Object>();
+      // Report the incomplete element or the missing end of the array.
+      MaybeHandle<Object> result =
+          ParseBuffered(*buffer, begin, buffer->size(), true, false);
+      DCHECK(result.is_null());
+      return result;
+    }
+
+    case State::kDone:
+      return BuildArray();
+
+    case State::kValue:
+      return ParseValue();
+  }
+  UNREACHABLE();
+}
+
+MaybeHandle<Object> JsonStreamingParser::ParseValue() {
+  Factory* factory = isolate_->factory();
+  Handle<String> source;
+  if (is_one_byte_) {
+    auto resource =
+        std::make_unique<OneByteBufferResource>(std::move(one_byte_buffer_));
+    ASSIGN_RETURN_ON_EXCEPTION(
+        isolate_, source, factory->NewExternalStringFromOneByte(resource.get()),
+        Object);
+    resource.release();
+    return JsonParser<uint8_t>::ParsePart(isolate_, source, buffer_position_);
+  }
+  auto resource =
+      std::make_unique<TwoByteBufferResource>(std::move(two_byte_buffer_));
+  ASSIGN_RETURN_ON_EXCEPTION(
+      isolate_, source, factory->NewExternalStringFromTwoByte(resource.get()),
+      Object);
+  resource.release();
+  return JsonParser<uint16_t>::ParsePart(isolate_, source, buffer_position_);
+}
+
+MaybeHandle<Object> JsonStreamingParser::BuildArray() {
+  Factory* factory = isolate_->factory();
+  Handle<ArrayList> batches = batches_;
+  int count = batches->Length();
+  DCHECK_LT(0, count);
+  if (count == 1) return handle(batches->Get(0), isolate_);
+
+  ElementsKind kind = PACKED_SMI_ELEMENTS;
+  size_t length = 0;
+  for (int i = 0; i < count; i++) {
+    JSArray batch = JSArray::cast(batches->Get(i));
+    kind = GetMoreGeneralElementsKind(kind, batch.GetElementsKind());
+    length += Smi::ToInt(batch.length());
+  }
+  int max_length = IsDoubleElementsKind(kind) ? FixedDoubleArray::kMaxLength
+                                              : FixedArray::kMaxLength;
+  if (length > static_cast<size_t>(max_length)) {
+    THROW_NEW_ERROR(isolate_,
+                    NewRangeError(MessageTemplate::kInvalidArrayLength),
+                    Object);
+  }
+
+  Handle<JSArray> array = factory->NewJSArray(
+      kind, static_cast<int>(length), static_cast<int>(length));
+  int index = 0;
+  for (int i = 0; i < count; i++) {
+    Handle<JSArray> batch(JSArray::cast(batches->Get(i)), isolate_);
+    int batch_length = Smi::ToInt(batch->length());
+    bool batch_is_double = IsDoubleElementsKind(batch->GetElementsKind());
+    if (IsDoubleElementsKind(kind)) {
+      DisallowGarbageCollection no_gc;
+      FixedDoubleArray elements = FixedDoubleArray::cast(array->elements());
+      for (int j = 0; j < batch_length; j++) {
+        double value =
+            batch_is_double
+                ? FixedDoubleArray::cast(batch->elements()).get_scalar(j)
+                : FixedArray::cast(batch->elements()).get(j).Number();
+        elements.set(index++, value);
+      }
+    } else if (batch_is_double) {
+      // The doubles need to be boxed in an array with other values.
+      for (int j = 0; j < batch_length; j++) {
+        HandleScope scope(isolate_);
+        Handle<Object> value = factory->NewNumber(
+            FixedDoubleArray::cast(batch->elements()).get_scalar(j));
+        FixedArray::cast(array->elements()).set(index++, *value);
+      }
+    } else if (batch_length > 0) {
+      DisallowGarbageCollection no_gc;
+      FixedArray elements = FixedArray::cast(array->elements());
+      elements.CopyElements(isolate_, index,
+                            FixedArray::cast(batch->elements()), 0,
+                            batch_length, elements.GetWriteBarrierMode(no_gc));
+      index += batch_length;
+    }
+  }
+  DCHECK_EQ(length, static_cast<size_t>(index));
+  return array;
+}
+
+void JsonStreamingParser::ThrowUnexpectedCharacter(uc32 c, size_t position) {
+  // Use the same messages as JsonParser.
+  Factory* factory = isolate_->factory();
+  Handle<Object> arg = factory->NewNumberFromSize(position);
+  Handle<Object> error;
+  if (c == '"') {
+    error = factory->NewSyntaxError(
+        MessageTemplate::kJsonParseUnexpectedTokenString, arg);
+  } else if (c == '-' || IsDecimalDigit(c)) {
+    error = factory->NewSyntaxError(
+        MessageTemplate::kJsonParseUnexpectedTokenNumber, arg);
+  } else {
+    error = factory->NewSyntaxError(
+        MessageTemplate::kJsonParseUnexpectedToken,
+        factory->LookupSingleCharacterStringFromCode(c), arg);
+  }
+  isolate_->Throw(*error);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,138 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_JSON_JSON_STREAMING_PARSER_H_
+#define V8_JSON_JSON_STREAMING_PARSER_H_
+
+#include <vector>
+
+#include "include/v8.h"
+#include "src/handles/handles.h"
+#include "src/strings/unicode.h"
+
+namespace v8 {
+namespace internal {
+
+class ArrayList;
+class Isolate;
+class Object;
+
+// Parses JSON text which is passed in chunks, without materializing the whole
+// text as a string. The elements of a top-level array are parsed by JsonParser
+// in batches as soon as they have been received completely, so only the
+// elements which haven't been parsed yet need to be buffered. Any other
+// top-level value is buffered and parsed when the input is finished. The
+// result, and the positions in errors, are the same as those of JSON.parse on
+// the concatenated chunks.
+class V8_EXPORT_PRIVATE JsonStreamingParser final {
+ public:
+  using Encoding = v8::JSON::StreamingParser::Encoding;
+
+  JsonStreamingParser(Isolate* isolate, Encoding encoding);
+  ~JsonStreamingParser();
+
+  // Decodes {data} and parses the array elements completed by it. Throws if
+  // the text received so far can't be the start of a JSON text.
+  V8_WARN_UNUSED_RESULT Maybe<bool> AppendChunk(const uint8_t* data,
+                                                size_t length);
+
+  // Returns the parsed value. Throws if the text isn't a complete JSON text.
+  V8_WARN_UNUSED_RESULT MaybeHandle<Object> Finish();
+
+ private:
+  enum class State : uint8_t {
+    // Before the top-level value.
+    kStart,
+    // Inside a top-level array.
+    kElements,
+    // After a top-level array.
+    kDone,
+    // Inside any other top-level value.
+    kValue
+  };
+
+  // Complete elements are parsed in batches of at least this many characters,
+  // to amortize the setup of JsonParser over small chunks and elements.
+  static constexpr size_t kMinBatchLength = 16 * KB;
+
+  JsonStreamingParser(const JsonStreamingParser&) = delete;
+  JsonStreamingParser& operator=(const JsonStreamingParser&) = delete;
+
+  void AppendCharacter(uc32 c);
+  void AppendOneByte(const uint8_t* data, size_t length);
+  void AppendTwoByte(const uint8_t* data, size_t length);
+  void AppendUtf8(const uint8_t* data, size_t length);
+
+  // Copies the buffered characters to the two-byte buffer, before the first
+  // character which doesn't fit into one byte is appended.
+  void ConvertToTwoByte();
+
+  // Scans the characters which were appended since the last call, parses the
+  // complete elements of a top-level array and drops the characters which
+  // are no longer needed from {buffer}.
+  template <typename Char>
+  Maybe<bool> Scan(std::vector<Char>* buffer);
+
+  // Parses the complete elements at the start of {buffer} which haven't been
+  // parsed yet, i.e. those before {batch_end_}.
+  template <typename Char>
+  Maybe<bool> ParseBatch(const std::vector<Char>& buffer, size_t* begin);
+
+  // Parses the buffered characters in [begin, end), preceded by a '[' if
+  // {open} is set and followed by a ']' if {close} is set.
+  template <typename Char>
+  MaybeHandle<Object> ParseBuffered(const std::vector<Char>& buffer,
+                                    size_t begin, size_t end, bool open,
+                                    bool close);
+
+  template <typename Char>
+  MaybeHandle<Object> FinishBuffer(std::vector<Char>* buffer);
+
+  // Parses the buffered top-level value in place.
+  MaybeHandle<Object> ParseValue();
+
+  // Concatenates the parsed batches of elements into the top-level array.
+  MaybeHandle<Object> BuildArray();
+
+  void ThrowUnexpectedCharacter(uc32 c, size_t position);
+
+  Isolate* const isolate_;
+  const Encoding encoding_;
+  State state_ = State::kStart;
+
+  // The decoder state between chunks.
+  unibrow::Utf8::State utf8_state_ = unibrow::Utf8::State::kAccept;
+  unibrow::Utf8::Utf8IncrementalBuffer utf8_buffer_ = 0;
+  bool has_pending_byte_ = false;
+  uint8_t pending_byte_ = 0;
+
+  // The characters which haven't been parsed yet. Only one of the buffers is
+  // used, depending on whether all characters so far fit into one byte.
+  bool is_one_byte_ = true;
+  std::vector<uint8_t> one_byte_buffer_;
+  std::vector<uint16_t> two_byte_buffer_;
+  // The position of the first buffered character in the text.
+  size_t buffer_position_ = 0;
+  // The number of buffered characters which have been scanned already.
+  size_t scanned_length_ = 0;
+
+  // The scanner state inside a top-level array.
+  uint32_t depth_ = 0;
+  bool in_string_ = false;
+  bool escaped_ = false;
+  bool element_is_empty_ = true;
+  size_t element_count_ = 0;
+  // The index of the ',' after the last complete element in the buffer, if
+  // there are complete elements which haven't been parsed yet.
+  bool has_batch_ = false;
+  size_t batch_end_ = 0;
+
+  // The arrays of parsed elements. A global handle.
+  Handle<ArrayList> batches_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_JSON_JSON_STREAMING_PARSER_H_
@@ -4,7 +4,11 @@
 
 #include "src/json/json-stringifier.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "src/common/message-template.h"
+#include "src/json/json-simd.h"
 #include "src/numbers/conversions.h"
 #include "src/objects/heap-number-inl.h"
 #include "src/objects/js-array-inl.h"
@@ -14,14 +18,68 @@
 #include "src/objects/ordered-hash-table.h"
 #include "src/objects/smi.h"
 #include "src/strings/string-builder-inl.h"
+#include "src/strings/unicode-inl.h"
 #include "src/utils/utils.h"
 
 namespace v8 {
 namespace internal {
 
+namespace {
+
+// Returns true if {c} is copied to the output as is, whatever its neighbors
+// are. Surrogates are not, since lone ones are escaped.
+template <typename Char>
+V8_INLINE bool IsUnescapedJsonCharacter(Char c) {
+  return c >= 0x20 && c != '"' && c != '\\' &&
+         (sizeof(Char) == 1 || (c & 0xF800) != 0xD800);
+}
+
+// Strings are copied to the output in runs of characters which don't need to
+// be escaped. The functions below skip whole blocks of such characters at
+// once, and leave finding the exact end of a run to the scalar code. Without
+// vector support, they don't skip anything.
+#if V8_JSON_SIMD_SSE2 || V8_JSON_SIMD_NEON
+
+const uint8_t* SkipUnescapedJsonBlocks(const uint8_t* cursor,
+                                       const uint8_t* end) {
+  while (end - cursor >= kJsonSimdBlockSize) {
+    if (JsonBlockHasSpecialCharacter(cursor)) break;
+    cursor += kJsonSimdBlockSize;
+  }
+  return cursor;
+}
+
+const uint16_t* SkipUnescapedJsonBlocks(const uint16_t* cursor,
+                                        const uint16_t* end) {
+  constexpr int kBlockSize = kJsonSimdBlockSize / sizeof(uint16_t);
+  while (end - cursor >= kBlockSize) {
+    if (JsonBlockHasSpecialCharacter(cursor) ||
+        JsonBlockHasSurrogate(cursor)) {
+      break;
+    }
+    cursor += kBlockSize;
+  }
+  return cursor;
+}
+
+#else
+
+template <typename Char>
+const Char* SkipUnescapedJsonBlocks(const Char* cursor, const Char* end) {
+  return cursor;
+}
+
+#endif
+
+}  // namespace
+
 class JsonStringifier {
  public:
-  explicit JsonStringifier(Isolate* isolate);
+  // If {part_sink} is given, the result is passed to it in parts instead of
+  // being returned as a string.
+  explicit JsonStringifier(
+      Isolate* isolate,
+      IncrementalStringBuilder::PartSink* part_sink = nullptr);
 
   ~JsonStringifier() { DeleteArray(gap_); }
 
@@ -97,6 +155,12 @@ class JsonStringifier {
   template <typename SrcChar, typename DestChar>
   V8_INLINE void SerializeString_(Handle<String> string);
 
+  // Appends the run of characters of {string} starting at {start} which don't
+  // need to be escaped, as far as it fits into the current part. Returns the
+  // number of characters appended.
+  template <typename SrcChar, typename DestChar>
+  V8_INLINE int AppendUnescapedRun_(Handle<String> string, int start);
+
   template <typename Char>
   V8_INLINE static bool DoNotEscape(Char c);
 
@@ -143,6 +207,102 @@ MaybeHandle<Object> JsonStringify(Isolate* isolate, Handle<Object> object,
   return stringifier.Stringify(object, replacer, gap);
 }
 
+namespace {
+
+// Encodes the parts of the JSON text as UTF-8 and passes them to the
+// embedder's sink.
+class JsonUtf8Writer final : public IncrementalStringBuilder::PartSink {
+ public:
+  JsonUtf8Writer(Isolate* isolate, v8::JSON::Utf8Sink* sink)
+      : isolate_(isolate), sink_(sink) {}
+
+  void Write(Handle<String> part) override {
+    part = String::Flatten(isolate_, part);
+    DisallowGarbageCollection no_gc;
+    String::FlatContent content = part->GetFlatContent(no_gc);
+    if (content.IsOneByte()) {
+      Encode(content.ToOneByteVector());
+    } else {
+      Encode(content.ToUC16Vector());
+    }
+  }
+
+  // Writes out a leading surrogate at the end of the last part. JSON text
+  // only contains paired surrogates, so this doesn't happen in practice.
+  void Flush() {
+    if (pending_lead_ == 0) return;
+    char buffer[unibrow::Utf8::kMaxEncodedSize];
+    size_t length =
+        unibrow::Utf8::Encode(buffer, pending_lead_,
+                              unibrow::Utf16::kNoPreviousCharacter, true);
+    pending_lead_ = 0;
+    sink_->Append(buffer, length);
+  }
+
+ private:
+  template <typename Char>
+  void Encode(Vector<const Char> chars) {
+    // Each UTF-16 code unit takes at most three bytes, and a surrogate pair
+    // four bytes.
+    buffer_.resize(3 * static_cast<size_t>(chars.length()) + 1);
+    char* out = buffer_.data();
+    size_t length = 0;
+    int start = 0;
+    if (pending_lead_ != 0) {
+      // A surrogate pair was split between the parts.
+      uc16 next = chars[0];
+      uc32 c = pending_lead_;
+      if (unibrow::Utf16::IsTrailSurrogate(next)) {
+        c = unibrow::Utf16::CombineSurrogatePair(pending_lead_, next);
+        start = 1;
+      }
+      length += unibrow::Utf8::Encode(
+          out, c, unibrow::Utf16::kNoPreviousCharacter, true);
+      pending_lead_ = 0;
+    }
+    int end = chars.length();
+    if (sizeof(Char) == 2 && end > start &&
+        unibrow::Utf16::IsLeadSurrogate(chars[end - 1])) {
+      pending_lead_ = chars[--end];
+    }
+    int previous = unibrow::Utf16::kNoPreviousCharacter;
+    for (int i = start; i < end; i++) {
+      Char c = chars[i];
+      if (c <= unibrow::Utf8::kMaxOneByteChar) {
+        out[length++] = static_cast<char>(c);
+      } else {
+        length += unibrow::Utf8::Encode(out + length, c, previous, true);
+      }
+      previous = c;
+    }
+    if (length > 0) sink_->Append(out, length);
+  }
+
+  Isolate* const isolate_;
+  v8::JSON::Utf8Sink* const sink_;
+  std::vector<char> buffer_;
+  // The leading surrogate at the end of the last part, or 0.
+  uc16 pending_lead_ = 0;
+};
+
+}  // namespace
+
+Maybe<bool> JsonStringifyToUtf8(Isolate* isolate, Handle<Object> object,
+                                Handle<Object> gap,
+                                v8::JSON::Utf8Sink* sink) {
+  JsonUtf8Writer writer(isolate, sink);
+  JsonStringifier stringifier(isolate, &writer);
+  Handle<Object> result;
+  ASSIGN_RETURN_ON_EXCEPTION_VALUE(
+      isolate, result,
+      stringifier.Stringify(object, isolate->factory()->undefined_value(),
+                            gap),
+      Nothing<bool>());
+  if (result->IsUndefined(isolate)) return Just(false);
+  writer.Flush();
+  return Just(true);
+}
+
 // Translation table to escape Latin1 characters.
 // Table entries start at a multiple of 8 and are null-terminated.
 const char* const JsonStringifier::JsonEscapeTable =
@@ -211,13 +371,15 @@ const char* const JsonStringifier::JsonEscapeTable =
     "\xF8\0      \xF9\0      \xFA\0      \xFB\0      "
     "\xFC\0      \xFD\0      \xFE\0      \xFF\0      ";
 
-JsonStringifier::JsonStringifier(Isolate* isolate)
+JsonStringifier::JsonStringifier(Isolate* isolate,
+                                 IncrementalStringBuilder::PartSink* part_sink)
     : isolate_(isolate),
       builder_(isolate),
       gap_(nullptr),
       indent_(0),
       stack_() {
   tojson_string_ = factory()->toJSON_string();
+  if (part_sink != nullptr) builder_.set_part_sink(part_sink);
 }
 
 MaybeHandle<Object> JsonStringifier::Stringify(Handle<Object> object,
@@ -880,11 +1042,20 @@ void JsonStringifier::SerializeStringUnchecked_(
   // Assert that uc16 character is not truncated down to 8 bit.
   // The <uc16, char> version of this method must not be called.
   DCHECK(sizeof(DestChar) >= sizeof(SrcChar));
+  const SrcChar* chars = src.begin();
+  const SrcChar* end = src.end();
   for (int i = 0; i < src.length(); i++) {
+    // Copy the run of characters which don't need to be escaped in bulk.
+    const SrcChar* run_end = SkipUnescapedJsonBlocks(chars + i, end);
+    while (run_end != end && IsUnescapedJsonCharacter(*run_end)) ++run_end;
+    if (run_end != chars + i) {
+      int run_length = static_cast<int>(run_end - (chars + i));
+      dest->AppendChars(chars + i, run_length);
+      i += run_length;
+      if (run_end == end) break;
+    }
     SrcChar c = src[i];
-    if (DoNotEscape(c)) {
-      dest->Append(c);
-    } else if (c >= 0xD800 && c <= 0xDFFF) {
+    if (c >= 0xD800 && c <= 0xDFFF) {
       // The current character is a surrogate.
       if (c <= 0xDBFF) {
         // The current character is a leading surrogate.
@@ -944,6 +1115,11 @@ void JsonStringifier::SerializeString_(Handle<String> string) {
   } else {
     FlatStringReader reader(isolate_, string);
     for (int i = 0; i < reader.length(); i++) {
+      // Copy the run of characters which don't need to be escaped in bulk.
+      // If the current part fills up, the next character is appended below,
+      // which starts a new part.
+      i += AppendUnescapedRun_<SrcChar, DestChar>(string, i);
+      if (i == reader.length()) break;
       SrcChar c = reader.Get<SrcChar>(i);
       if (DoNotEscape(c)) {
         builder_.Append<SrcChar, DestChar>(c);
@@ -994,6 +1170,27 @@ void JsonStringifier::SerializeString_(Handle<String> string) {
   builder_.Append<uint8_t, DestChar>('"');
 }
 
+template <typename SrcChar, typename DestChar>
+int JsonStringifier::AppendUnescapedRun_(Handle<String> string, int start) {
+  // Starting a new part may move {string}, so its characters are only
+  // accessed while no new part is allocated.
+  DisallowGarbageCollection no_gc;
+  Vector<const SrcChar> chars = string->GetCharVector<SrcChar>(no_gc);
+  const SrcChar* run_start = chars.begin() + start;
+  const SrcChar* limit =
+      run_start +
+      std::min(chars.length() - start, builder_.CurrentPartRemaining());
+  const SrcChar* run_end = SkipUnescapedJsonBlocks(run_start, limit);
+  while (run_end != limit && IsUnescapedJsonCharacter(*run_end)) ++run_end;
+  int run_length = static_cast<int>(run_end - run_start);
+  if (run_length > 0) {
+    IncrementalStringBuilder::NoExtendBuilder<DestChar> no_extend(
+        &builder_, run_length, no_gc);
+    no_extend.AppendChars(run_start, run_length);
+  }
+  return run_length;
+}
+
 template <>
 bool JsonStringifier::DoNotEscape(uint8_t c) {
   // https://tc39.github.io/ecma262/#table-json-single-character-escapes
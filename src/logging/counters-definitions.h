@@ -28,6 +28,9 @@ namespace internal {
   HR(gc_finalize_sweep, V8.GCFinalizeMC.Sweep, 0, 10000, 101)                  \
   HR(gc_scavenger_scavenge_main, V8.GCScavenger.ScavengeMain, 0, 10000, 101)   \
   HR(gc_scavenger_scavenge_roots, V8.GCScavenger.ScavengeRoots, 0, 10000, 101) \
+  HR(gc_minor_mc_mark, V8.GCMinorMC.Mark, 0, 10000, 101)                       \
+  HR(gc_minor_mc_evacuate, V8.GCMinorMC.Evacuate, 0, 10000, 101)               \
+  HR(gc_minor_mc_clear, V8.GCMinorMC.Clear, 0, 10000, 101)                     \
   HR(gc_mark_compactor, V8.GCMarkCompactor, 0, 10000, 101)                     \
   HR(gc_marking_sum, V8.GCMarkingSum, 0, 10000, 101)                           \
   /* Range and bucket matches BlinkGC.MainThreadMarkingThroughput. */          \
@@ -119,6 +122,8 @@ namespace internal {
   HT(compile_serialize, V8.CompileSerializeMicroSeconds, 100000, MICROSECOND)  \
   HT(compile_deserialize, V8.CompileDeserializeMicroSeconds, 1000000,          \
      MICROSECOND)                                                              \
+  HT(compile_deserialize_checksum, V8.CompileDeserializeChecksumMicroSeconds,  \
+     1000000, MICROSECOND)                                                     \
   /* Total compilation time incl. caching/parsing */                           \
   HT(compile_script, V8.CompileScriptMicroSeconds, 1000000, MICROSECOND)       \
   /* Total JavaScript execution time (including callbacks and runtime calls */ \
@@ -144,6 +149,9 @@ namespace internal {
   HT(gc_scavenger, V8.GCScavenger, 10000, MILLISECOND)                         \
   HT(gc_scavenger_background, V8.GCScavengerBackground, 10000, MILLISECOND)    \
   HT(gc_scavenger_foreground, V8.GCScavengerForeground, 10000, MILLISECOND)    \
+  HT(gc_minor_mc, V8.GCMinorMC, 10000, MILLISECOND)                            \
+  HT(gc_minor_mc_background, V8.GCMinorMCBackground, 10000, MILLISECOND)       \
+  HT(gc_minor_mc_foreground, V8.GCMinorMCForeground, 10000, MILLISECOND)       \
   HT(measure_memory_delay_ms, V8.MeasureMemoryDelayMilliseconds, 100000,       \
      MILLISECOND)                                                              \
   HT(gc_time_to_safepoint, V8.GC.TimeToSafepoint, 10000000, MICROSECOND)       \
@@ -327,10 +335,14 @@ namespace internal {
   /* Total count of functions compiled using the baseline compiler. */         \
   SC(total_baseline_compile_count, V8.TotalBaselineCompileCount)
 
-#define STATS_COUNTER_TS_LIST(SC)                         \
-  SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes) \
-  SC(wasm_reloc_size, V8.WasmRelocBytes)                  \
-  SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions)
+#define STATS_COUNTER_TS_LIST(SC)                                    \
+  SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes)            \
+  SC(wasm_reloc_size, V8.WasmRelocBytes)                             \
+  SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions) \
+  /* Pages allocated from the pool of freed pages. */                \
+  SC(memory_chunk_pool_hits, V8.MemoryChunkPoolHits)                 \
+  /* Pooled page allocations that had to map fresh memory. */        \
+  SC(memory_chunk_pool_misses, V8.MemoryChunkPoolMisses)
 
 // List of counters that can be incremented from generated code. We need them in
 // a separate list to be able to relocate them.
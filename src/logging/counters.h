@@ -753,7 +753,10 @@ class RuntimeCallTimer final {
   V(Isolate_DateTimeConfigurationChangeNotification)       \
   V(Isolate_LocaleConfigurationChangeNotification)         \
   V(JSON_Parse)                                            \
+  V(JSON_StreamingParser_AppendChunk)                      \
+  V(JSON_StreamingParser_Finish)                           \
   V(JSON_Stringify)                                        \
+  V(JSON_StringifyToUtf8)                                  \
   V(Map_AsArray)                                           \
   V(Map_Clear)                                             \
   V(Map_Delete)                                            \
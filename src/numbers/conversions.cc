@@ -10,6 +10,7 @@
 #include <cmath>
 
 #include "src/base/platform/wrappers.h"
+#include "src/bigint/bigint.h"
 #include "src/common/assert-scope.h"
 #include "src/handles/handles.h"
 #include "src/heap/factory.h"
@@ -901,6 +902,10 @@ class StringToBigIntHelper : public StringToIntHelper<LocalIsolate> {
       case State::kZero:
         return BigInt::Zero(this->isolate(), allocation_type());
       case State::kDone:
+        if (!BigInt::FromAccumulator(this->isolate(), *result_,
+                                     &accumulator_)) {
+          return MaybeHandle<BigInt>();
+        }
         return BigInt::Finalize<Isolate>(result_, this->negative());
       case State::kEmpty:
       case State::kRunning:
@@ -925,8 +930,7 @@ class StringToBigIntHelper : public StringToIntHelper<LocalIsolate> {
   }
 
   void ResultMultiplyAdd(uint32_t multiplier, uint32_t part) override {
-    BigInt::InplaceMultiplyAdd(*result_, static_cast<uintptr_t>(multiplier),
-                               static_cast<uintptr_t>(part));
+    accumulator_.AddPart(multiplier, part);
   }
 
   bool CheckTermination() override;
@@ -940,6 +944,7 @@ class StringToBigIntHelper : public StringToIntHelper<LocalIsolate> {
 
  private:
   Handle<FreshlyAllocatedBigInt> result_;
+  bigint::FromStringAccumulator accumulator_;
   Behavior behavior_;
 };
 
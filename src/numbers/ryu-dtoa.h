@@ -0,0 +1,38 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_NUMBERS_RYU_DTOA_H_
+#define V8_NUMBERS_RYU_DTOA_H_
+
+#include "src/utils/vector.h"
+
+namespace v8 {
+namespace internal {
+
+// RyuDtoa will produce at most kRyuDtoaMaximalLength digits. This does not
+// include the terminating '\0' character.
+const int kRyuDtoaMaximalLength = 17;
+
+// Computes the shortest decimal representation of v, using the Ryu algorithm
+// by Ulf Adams ("Ryū: fast float-to-string conversion", PLDI 2018). Unlike
+// FastDtoa, it always succeeds, so there is no need for a bignum fallback.
+// The result should be interpreted as buffer * 10^(point - length).
+//
+// Precondition:
+//   * v must be a strictly positive finite double.
+//
+// There will be *length digits inside the buffer followed by a null
+// terminator. The result satisfies
+//     v == (double) (buffer * 10^(point - length)).
+// The digits in the buffer are the shortest representation possible, and the
+// last digit is closest to the actual v. If there are two digits at the same
+// distance, then the even one is chosen, like BignumDtoa does.
+// The buffer must be large enough to hold the result.
+V8_EXPORT_PRIVATE void RyuDtoa(double v, Vector<char> buffer, int* length,
+                               int* decimal_point);
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_NUMBERS_RYU_DTOA_H_
@@ -136,35 +136,10 @@ class MutableBigInt : public FreshlyAllocatedBigInt {
       Isolate* isolate, Handle<BigIntBase> x, Handle<BigIntBase> y,
       MutableBigInt result_storage = MutableBigInt());
 
-  static void MultiplyAccumulate(Handle<BigIntBase> multiplicand,
-                                 digit_t multiplier,
-                                 Handle<MutableBigInt> accumulator,
-                                 int accumulator_index);
-  static void InternalMultiplyAdd(BigIntBase source, digit_t factor,
-                                  digit_t summand, int n, MutableBigInt result);
-  void InplaceMultiplyAdd(uintptr_t factor, uintptr_t summand);
-
   // Specialized helpers for Divide/Remainder.
   static void AbsoluteDivSmall(Isolate* isolate, Handle<BigIntBase> x,
                                digit_t divisor, Handle<MutableBigInt>* quotient,
                                digit_t* remainder);
-  static bool AbsoluteDivLarge(Isolate* isolate, Handle<BigIntBase> dividend,
-                               Handle<BigIntBase> divisor,
-                               Handle<MutableBigInt>* quotient,
-                               Handle<MutableBigInt>* remainder);
-  static bool ProductGreaterThan(digit_t factor1, digit_t factor2, digit_t high,
-                                 digit_t low);
-  digit_t InplaceAdd(Handle<BigIntBase> summand, int start_index);
-  digit_t InplaceSub(Handle<BigIntBase> subtrahend, int start_index);
-  void InplaceRightShift(int shift);
-  enum SpecialLeftShiftMode {
-    kSameSizeResult,
-    kAlwaysAddOneDigit,
-  };
-  static MaybeHandle<MutableBigInt> SpecialLeftShift(Isolate* isolate,
-                                                     Handle<BigIntBase> x,
-                                                     int shift,
-                                                     SpecialLeftShiftMode mode);
 
   // Specialized helpers for shift operations.
   static MaybeHandle<BigInt> LeftShiftByAbsolute(Isolate* isolate,
@@ -199,7 +174,6 @@ class MutableBigInt : public FreshlyAllocatedBigInt {
   static inline digit_t digit_mul(digit_t a, digit_t b, digit_t* high);
   static inline digit_t digit_div(digit_t high, digit_t low, digit_t divisor,
                                   digit_t* remainder);
-  static digit_t digit_pow(digit_t base, digit_t exponent);
   static inline bool digit_ismax(digit_t x) {
     return static_cast<digit_t>(~x) == 0;
   }
@@ -252,6 +226,15 @@ struct GetDigits : bigint::Digits {
             bigint.length()) {}
 };
 
+struct GetRWDigits : bigint::RWDigits {
+  explicit GetRWDigits(Handle<BigIntBase> bigint) : GetRWDigits(*bigint) {}
+  explicit GetRWDigits(BigIntBase bigint)
+      : bigint::RWDigits(
+            reinterpret_cast<bigint::digit_t*>(
+                bigint.ptr() + BigIntBase::kDigitsOffset - kHeapObjectTag),
+            bigint.length()) {}
+};
+
 template <typename T, typename Isolate>
 MaybeHandle<T> ThrowBigIntTooBig(Isolate* isolate) {
   // If the result of a BigInt computation is truncated to 64 bit, Turbofan
@@ -536,24 +519,13 @@ MaybeHandle<BigInt> BigInt::Multiply(Isolate* isolate, Handle<BigInt> x,
   if (!MutableBigInt::New(isolate, result_length).ToHandle(&result)) {
     return MaybeHandle<BigInt>();
   }
-  result->InitializeDigits(result_length);
-  uintptr_t work_estimate = 0;
-  for (int i = 0; i < x->length(); i++) {
-    MutableBigInt::MultiplyAccumulate(y, x->digit(i), result, i);
-
-    // Multiplication can take a long time. Check for interrupt requests
-    // every now and then (roughly every 10-20 of milliseconds -- rarely
-    // enough not to create noticeable overhead, frequently enough not to
-    // appear frozen).
-    work_estimate += y->length();
-    if (work_estimate > 5000000) {
-      work_estimate = 0;
-      StackLimitCheck interrupt_check(isolate);
-      if (interrupt_check.InterruptRequested() &&
-          isolate->stack_guard()->HandleInterrupts().IsException(isolate)) {
-        return MaybeHandle<BigInt>();
-      }
-    }
+  DisallowGarbageCollection no_gc;
+  bigint::Status status = isolate->bigint_processor()->Multiply(
+      GetRWDigits(result), GetDigits(x), GetDigits(y));
+  if (status == bigint::Status::kInterrupted) {
+    AllowGarbageCollection terminating_anyway;
+    isolate->TerminateExecution();
+    return {};
   }
   result->set_sign(x->sign() != y->sign());
   return MutableBigInt::MakeImmutable(result);
@@ -582,8 +554,17 @@ MaybeHandle<BigInt> BigInt::Divide(Isolate* isolate, Handle<BigInt> x,
     digit_t remainder;
     MutableBigInt::AbsoluteDivSmall(isolate, x, divisor, &quotient, &remainder);
   } else {
-    if (!MutableBigInt::AbsoluteDivLarge(isolate, x, y, &quotient, nullptr)) {
-      return MaybeHandle<BigInt>();
+    int length = bigint::DivideResultLength(GetDigits(x), GetDigits(y));
+    if (!MutableBigInt::New(isolate, length).ToHandle(&quotient)) {
+      return {};
+    }
+    DisallowGarbageCollection no_gc;
+    bigint::Status status = isolate->bigint_processor()->Divide(
+        GetRWDigits(quotient), GetDigits(x), GetDigits(y));
+    if (status == bigint::Status::kInterrupted) {
+      AllowGarbageCollection terminating_anyway;
+      isolate->TerminateExecution();
+      return {};
     }
   }
   quotient->set_sign(x->sign() != y->sign());
@@ -613,8 +594,17 @@ MaybeHandle<BigInt> BigInt::Remainder(Isolate* isolate, Handle<BigInt> x,
     remainder = MutableBigInt::New(isolate, 1).ToHandleChecked();
     remainder->set_digit(0, remainder_digit);
   } else {
-    if (!MutableBigInt::AbsoluteDivLarge(isolate, x, y, nullptr, &remainder)) {
-      return MaybeHandle<BigInt>();
+    int length = bigint::ModuloResultLength(GetDigits(y));
+    if (!MutableBigInt::New(isolate, length).ToHandle(&remainder)) {
+      return {};
+    }
+    DisallowGarbageCollection no_gc;
+    bigint::Status status = isolate->bigint_processor()->Modulo(
+        GetRWDigits(remainder), GetDigits(x), GetDigits(y));
+    if (status == bigint::Status::kInterrupted) {
+      AllowGarbageCollection terminating_anyway;
+      isolate->TerminateExecution();
+      return {};
     }
   }
   remainder->set_sign(x->sign());
@@ -1449,90 +1439,6 @@ Handle<MutableBigInt> MutableBigInt::AbsoluteXor(Isolate* isolate,
                            [](digit_t a, digit_t b) { return a ^ b; });
 }
 
-// Multiplies {multiplicand} with {multiplier} and adds the result to
-// {accumulator}, starting at {accumulator_index} for the least-significant
-// digit.
-// Callers must ensure that {accumulator} is big enough to hold the result.
-void MutableBigInt::MultiplyAccumulate(Handle<BigIntBase> multiplicand,
-                                       digit_t multiplier,
-                                       Handle<MutableBigInt> accumulator,
-                                       int accumulator_index) {
-  // This is a minimum requirement; the DCHECK in the second loop below
-  // will enforce more as needed.
-  DCHECK(accumulator->length() > multiplicand->length() + accumulator_index);
-  if (multiplier == 0L) return;
-  digit_t carry = 0;
-  digit_t high = 0;
-  for (int i = 0; i < multiplicand->length(); i++, accumulator_index++) {
-    digit_t acc = accumulator->digit(accumulator_index);
-    digit_t new_carry = 0;
-    // Add last round's carryovers.
-    acc = digit_add(acc, high, &new_carry);
-    acc = digit_add(acc, carry, &new_carry);
-    // Compute this round's multiplication.
-    digit_t m_digit = multiplicand->digit(i);
-    digit_t low = digit_mul(multiplier, m_digit, &high);
-    acc = digit_add(acc, low, &new_carry);
-    // Store result and prepare for next round.
-    accumulator->set_digit(accumulator_index, acc);
-    carry = new_carry;
-  }
-  for (; carry != 0 || high != 0; accumulator_index++) {
-    DCHECK(accumulator_index < accumulator->length());
-    digit_t acc = accumulator->digit(accumulator_index);
-    digit_t new_carry = 0;
-    acc = digit_add(acc, high, &new_carry);
-    high = 0;
-    acc = digit_add(acc, carry, &new_carry);
-    accumulator->set_digit(accumulator_index, acc);
-    carry = new_carry;
-  }
-}
-
-// Multiplies {source} with {factor} and adds {summand} to the result.
-// {result} and {source} may be the same BigInt for inplace modification.
-void MutableBigInt::InternalMultiplyAdd(BigIntBase source, digit_t factor,
-                                        digit_t summand, int n,
-                                        MutableBigInt result) {
-  DCHECK(source.length() >= n);
-  DCHECK(result.length() >= n);
-  digit_t carry = summand;
-  digit_t high = 0;
-  for (int i = 0; i < n; i++) {
-    digit_t current = source.digit(i);
-    digit_t new_carry = 0;
-    // Compute this round's multiplication.
-    digit_t new_high = 0;
-    current = digit_mul(current, factor, &new_high);
-    // Add last round's carryovers.
-    current = digit_add(current, high, &new_carry);
-    current = digit_add(current, carry, &new_carry);
-    // Store result and prepare for next round.
-    result.set_digit(i, current);
-    carry = new_carry;
-    high = new_high;
-  }
-  if (result.length() > n) {
-    result.set_digit(n++, carry + high);
-    // Current callers don't pass in such large results, but let's be robust.
-    while (n < result.length()) {
-      result.set_digit(n++, 0);
-    }
-  } else {
-    CHECK_EQ(carry + high, 0);
-  }
-}
-
-// Multiplies {x} with {factor} and then adds {summand} to it.
-void BigInt::InplaceMultiplyAdd(FreshlyAllocatedBigInt x, uintptr_t factor,
-                                uintptr_t summand) {
-  STATIC_ASSERT(sizeof(factor) == sizeof(digit_t));
-  STATIC_ASSERT(sizeof(summand) == sizeof(digit_t));
-  MutableBigInt bigint = MutableBigInt::cast(x);
-  MutableBigInt::InternalMultiplyAdd(bigint, factor, summand, bigint.length(),
-                                     bigint);
-}
-
 // Divides {x} by {divisor}, returning the result in {quotient} and {remainder}.
 // Mathematically, the contract is:
 // quotient = (x - remainder) / divisor, with 0 <= remainder < divisor.
@@ -1563,220 +1469,6 @@ void MutableBigInt::AbsoluteDivSmall(Isolate* isolate, Handle<BigIntBase> x,
   }
 }
 
-// Divides {dividend} by {divisor}, returning the result in {quotient} and
-// {remainder}. Mathematically, the contract is:
-// quotient = (dividend - remainder) / divisor, with 0 <= remainder < divisor.
-// Both {quotient} and {remainder} are optional, for callers that are only
-// interested in one of them.
-// See Knuth, Volume 2, section 4.3.1, Algorithm D.
-bool MutableBigInt::AbsoluteDivLarge(Isolate* isolate,
-                                     Handle<BigIntBase> dividend,
-                                     Handle<BigIntBase> divisor,
-                                     Handle<MutableBigInt>* quotient,
-                                     Handle<MutableBigInt>* remainder) {
-  DCHECK_GE(divisor->length(), 2);
-  DCHECK(dividend->length() >= divisor->length());
-  // The unusual variable names inside this function are consistent with
-  // Knuth's book, as well as with Go's implementation of this algorithm.
-  // Maintaining this consistency is probably more useful than trying to
-  // come up with more descriptive names for them.
-  int n = divisor->length();
-  int m = dividend->length() - n;
-
-  // The quotient to be computed.
-  Handle<MutableBigInt> q;
-  if (quotient != nullptr) q = New(isolate, m + 1).ToHandleChecked();
-  // In each iteration, {qhatv} holds {divisor} * {current quotient digit}.
-  // "v" is the book's name for {divisor}, "qhat" the current quotient digit.
-  Handle<MutableBigInt> qhatv;
-  if (!New(isolate, n + 1).ToHandle(&qhatv)) return false;
-
-  // D1.
-  // Left-shift inputs so that the divisor's MSB is set. This is necessary
-  // to prevent the digit-wise divisions (see digit_div call below) from
-  // overflowing (they take a two digits wide input, and return a one digit
-  // result).
-  int shift = base::bits::CountLeadingZeros(divisor->digit(n - 1));
-  if (shift > 0) {
-    divisor = SpecialLeftShift(isolate, divisor, shift, kSameSizeResult)
-                  .ToHandleChecked();
-  }
-  // Holds the (continuously updated) remaining part of the dividend, which
-  // eventually becomes the remainder.
-  Handle<MutableBigInt> u;
-  if (!SpecialLeftShift(isolate, dividend, shift, kAlwaysAddOneDigit)
-           .ToHandle(&u)) {
-    return false;
-  }
-
-  // D2.
-  // Iterate over the dividend's digit (like the "grad school" algorithm).
-  // {vn1} is the divisor's most significant digit.
-  digit_t vn1 = divisor->digit(n - 1);
-  uintptr_t work_estimate = 0;
-  for (int j = m; j >= 0; j--) {
-    // D3.
-    // Estimate the current iteration's quotient digit (see Knuth for details).
-    // {qhat} is the current quotient digit.
-    digit_t qhat = std::numeric_limits<digit_t>::max();
-    // {ujn} is the dividend's most significant remaining digit.
-    digit_t ujn = u->digit(j + n);
-    if (ujn != vn1) {
-      // {rhat} is the current iteration's remainder.
-      digit_t rhat = 0;
-      // Estimate the current quotient digit by dividing the most significant
-      // digits of dividend and divisor. The result will not be too small,
-      // but could be a bit too large.
-      qhat = digit_div(ujn, u->digit(j + n - 1), vn1, &rhat);
-
-      // Decrement the quotient estimate as needed by looking at the next
-      // digit, i.e. by testing whether
-      // qhat * v_{n-2} > (rhat << kDigitBits) + u_{j+n-2}.
-      digit_t vn2 = divisor->digit(n - 2);
-      digit_t ujn2 = u->digit(j + n - 2);
-      while (ProductGreaterThan(qhat, vn2, rhat, ujn2)) {
-        qhat--;
-        digit_t prev_rhat = rhat;
-        rhat += vn1;
-        // v[n-1] >= 0, so this tests for overflow.
-        if (rhat < prev_rhat) break;
-      }
-    }
-
-    // D4.
-    // Multiply the divisor with the current quotient digit, and subtract
-    // it from the dividend. If there was "borrow", then the quotient digit
-    // was one too high, so we must correct it and undo one subtraction of
-    // the (shifted) divisor.
-    InternalMultiplyAdd(*divisor, qhat, 0, n, *qhatv);
-    digit_t c = u->InplaceSub(qhatv, j);
-    if (c != 0) {
-      c = u->InplaceAdd(divisor, j);
-      u->set_digit(j + n, u->digit(j + n) + c);
-      qhat--;
-    }
-
-    if (quotient != nullptr) q->set_digit(j, qhat);
-
-    // Division can take a long time. Check for interrupt requests every
-    // now and then (roughly every 10-20 of milliseconds -- rarely enough
-    // not to create noticeable overhead, frequently enough not to appear
-    // frozen).
-    work_estimate += n;
-    if (work_estimate > 5000000) {
-      work_estimate = 0;
-      StackLimitCheck interrupt_check(isolate);
-      if (interrupt_check.InterruptRequested() &&
-          isolate->stack_guard()->HandleInterrupts().IsException(isolate)) {
-        return false;
-      }
-    }
-  }
-  if (quotient != nullptr) {
-    *quotient = q;  // Caller will right-trim.
-  }
-  if (remainder != nullptr) {
-    u->InplaceRightShift(shift);
-    *remainder = u;
-  }
-  return true;
-}
-
-// Returns whether (factor1 * factor2) > (high << kDigitBits) + low.
-bool MutableBigInt::ProductGreaterThan(digit_t factor1, digit_t factor2,
-                                       digit_t high, digit_t low) {
-  digit_t result_high;
-  digit_t result_low = digit_mul(factor1, factor2, &result_high);
-  return result_high > high || (result_high == high && result_low > low);
-}
-
-// Adds {summand} onto {this}, starting with {summand}'s 0th digit
-// at {this}'s {start_index}'th digit. Returns the "carry" (0 or 1).
-BigInt::digit_t MutableBigInt::InplaceAdd(Handle<BigIntBase> summand,
-                                          int start_index) {
-  digit_t carry = 0;
-  int n = summand->length();
-  DCHECK(length() >= start_index + n);
-  for (int i = 0; i < n; i++) {
-    digit_t new_carry = 0;
-    digit_t sum =
-        digit_add(digit(start_index + i), summand->digit(i), &new_carry);
-    sum = digit_add(sum, carry, &new_carry);
-    set_digit(start_index + i, sum);
-    carry = new_carry;
-  }
-  return carry;
-}
-
-// Subtracts {subtrahend} from {this}, starting with {subtrahend}'s 0th digit
-// at {this}'s {start_index}-th digit. Returns the "borrow" (0 or 1).
-BigInt::digit_t MutableBigInt::InplaceSub(Handle<BigIntBase> subtrahend,
-                                          int start_index) {
-  digit_t borrow = 0;
-  int n = subtrahend->length();
-  DCHECK(length() >= start_index + n);
-  for (int i = 0; i < n; i++) {
-    digit_t new_borrow = 0;
-    digit_t difference =
-        digit_sub(digit(start_index + i), subtrahend->digit(i), &new_borrow);
-    difference = digit_sub(difference, borrow, &new_borrow);
-    set_digit(start_index + i, difference);
-    borrow = new_borrow;
-  }
-  return borrow;
-}
-
-void MutableBigInt::InplaceRightShift(int shift) {
-  DCHECK_GE(shift, 0);
-  DCHECK_LT(shift, kDigitBits);
-  DCHECK_GT(length(), 0);
-  DCHECK_EQ(digit(0) & ((static_cast<digit_t>(1) << shift) - 1), 0);
-  if (shift == 0) return;
-  digit_t carry = digit(0) >> shift;
-  int last = length() - 1;
-  for (int i = 0; i < last; i++) {
-    digit_t d = digit(i + 1);
-    set_digit(i, (d << (kDigitBits - shift)) | carry);
-    carry = d >> shift;
-  }
-  set_digit(last, carry);
-}
-
-// Always copies the input, even when {shift} == 0.
-// {shift} must be less than kDigitBits, {x} must be non-zero.
-MaybeHandle<MutableBigInt> MutableBigInt::SpecialLeftShift(
-    Isolate* isolate, Handle<BigIntBase> x, int shift,
-    SpecialLeftShiftMode mode) {
-  DCHECK_GE(shift, 0);
-  DCHECK_LT(shift, kDigitBits);
-  DCHECK_GT(x->length(), 0);
-  int n = x->length();
-  int result_length = mode == kAlwaysAddOneDigit ? n + 1 : n;
-  Handle<MutableBigInt> result;
-  if (!New(isolate, result_length).ToHandle(&result)) {
-    return MaybeHandle<MutableBigInt>();
-  }
-  if (shift == 0) {
-    for (int i = 0; i < n; i++) result->set_digit(i, x->digit(i));
-    if (mode == kAlwaysAddOneDigit) result->set_digit(n, 0);
-    return result;
-  }
-  DCHECK_GT(shift, 0);
-  digit_t carry = 0;
-  for (int i = 0; i < n; i++) {
-    digit_t d = x->digit(i);
-    result->set_digit(i, (d << shift) | carry);
-    carry = d >> (kDigitBits - shift);
-  }
-  if (mode == kAlwaysAddOneDigit) {
-    result->set_digit(n, carry);
-  } else {
-    DCHECK_EQ(mode, kSameSizeResult);
-    DCHECK_EQ(carry, 0);
-  }
-  return result;
-}
-
 MaybeHandle<BigInt> MutableBigInt::LeftShiftByAbsolute(Isolate* isolate,
                                                        Handle<BigIntBase> x,
                                                        Handle<BigIntBase> y) {
@@ -1966,6 +1658,30 @@ template MaybeHandle<FreshlyAllocatedBigInt> BigInt::AllocateFor(
     LocalIsolate* isolate, int radix, int charcount, ShouldThrow should_throw,
     AllocationType allocation);
 
+bool BigInt::FromAccumulator(Isolate* isolate, FreshlyAllocatedBigInt x,
+                             bigint::FromStringAccumulator* accumulator) {
+  DisallowGarbageCollection no_gc;
+  bigint::Status status =
+      isolate->bigint_processor()->FromString(GetRWDigits(x), accumulator);
+  if (status == bigint::Status::kInterrupted) {
+    AllowGarbageCollection terminating_anyway;
+    isolate->TerminateExecution();
+    return false;
+  }
+  return true;
+}
+
+bool BigInt::FromAccumulator(LocalIsolate* isolate, FreshlyAllocatedBigInt x,
+                             bigint::FromStringAccumulator* accumulator) {
+  // Background threads have no bigint::Processor of their own (and no way
+  // to be interrupted), so use a temporary one.
+  std::unique_ptr<bigint::Processor, bigint::Processor::Destroyer> processor(
+      bigint::Processor::New(new bigint::Platform()));
+  DisallowGarbageCollection no_gc;
+  processor->FromString(GetRWDigits(x), accumulator);
+  return true;
+}
+
 template <typename LocalIsolate>
 Handle<BigInt> BigInt::Finalize(Handle<FreshlyAllocatedBigInt> x, bool sign) {
   Handle<MutableBigInt> bigint = Handle<MutableBigInt>::cast(x);
@@ -2131,27 +1847,10 @@ MaybeHandle<String> MutableBigInt::ToStringGeneric(Isolate* isolate,
   DCHECK(!x->is_zero());
   Heap* heap = isolate->heap();
 
-  const int length = x->length();
-  const bool sign = x->sign();
-
-  // Compute (an overapproximation of) the length of the resulting string:
-  // Divide bit length of the BigInt by bits representable per character.
-  const size_t bit_length =
-      length * kDigitBits - base::bits::CountLeadingZeros(x->digit(length - 1));
-  // Maximum number of bits we can represent with one character. We'll use this
-  // to find an appropriate chunk size below.
-  const uint8_t max_bits_per_char = kMaxBitsPerChar[radix];
-  // For estimating result length, we have to be pessimistic and work with
-  // the minimum number of bits one character can represent.
-  const uint8_t min_bits_per_char = max_bits_per_char - 1;
-  // Perform the following computation with uint64_t to avoid overflows.
-  uint64_t chars_required = bit_length;
-  chars_required *= kBitsPerCharTableMultiplier;
-  chars_required += min_bits_per_char - 1;  // Round up.
-  chars_required /= min_bits_per_char;
-  chars_required += sign;
-
-  if (chars_required > String::kMaxLength) {
+  // Compute (an overapproximation of) the length of the resulting string.
+  const int chars_allocated =
+      bigint::ToStringResultLength(GetDigits(x), radix, x->sign());
+  if (chars_allocated > String::kMaxLength) {
     if (should_throw == kThrowOnError) {
       THROW_NEW_ERROR(isolate, NewInvalidStringLengthError(), String);
     } else {
@@ -2159,117 +1858,28 @@ MaybeHandle<String> MutableBigInt::ToStringGeneric(Isolate* isolate,
     }
   }
   Handle<SeqOneByteString> result =
-      isolate->factory()
-          ->NewRawOneByteString(static_cast<int>(chars_required))
-          .ToHandleChecked();
-
-#if DEBUG
-  // Zap the string first.
-  {
-    DisallowGarbageCollection no_gc;
-    uint8_t* chars = result->GetChars(no_gc);
-    for (int i = 0; i < static_cast<int>(chars_required); i++) chars[i] = '?';
-  }
-#endif
-
-  // We assemble the result string in reverse order, and then reverse it.
-  // TODO(jkummerow): Consider building the string from the right, and
-  // left-shifting it if the length estimate was too large.
-  int pos = 0;
-
-  digit_t last_digit;
-  if (length == 1) {
-    last_digit = x->digit(0);
-  } else {
-    int chunk_chars =
-        kDigitBits * kBitsPerCharTableMultiplier / max_bits_per_char;
-    digit_t chunk_divisor = digit_pow(radix, chunk_chars);
-    // By construction of chunk_chars, there can't have been overflow.
-    DCHECK_NE(chunk_divisor, 0);
-    int nonzero_digit = length - 1;
-    DCHECK_NE(x->digit(nonzero_digit), 0);
-    // {rest} holds the part of the BigInt that we haven't looked at yet.
-    // Not to be confused with "remainder"!
-    Handle<MutableBigInt> rest;
-    // In the first round, divide the input, allocating a new BigInt for
-    // the result == rest; from then on divide the rest in-place.
-    Handle<BigIntBase>* dividend = &x;
-    uintptr_t work_estimate = 0;
-    do {
-      digit_t chunk;
-      AbsoluteDivSmall(isolate, *dividend, chunk_divisor, &rest, &chunk);
-      DCHECK(!rest.is_null());
-      dividend = reinterpret_cast<Handle<BigIntBase>*>(&rest);
-      DisallowGarbageCollection no_gc;
-      uint8_t* chars = result->GetChars(no_gc);
-      for (int i = 0; i < chunk_chars; i++) {
-        chars[pos++] = kConversionChars[chunk % radix];
-        chunk /= radix;
-      }
-      DCHECK_EQ(chunk, 0);
-      if (rest->digit(nonzero_digit) == 0) nonzero_digit--;
-      // We can never clear more than one digit per iteration, because
-      // chunk_divisor is smaller than max digit value.
-      DCHECK_GT(rest->digit(nonzero_digit), 0);
-
-      // String formatting can take a long time. Check for interrupt requests
-      // every now and then (roughly every 10-20 of milliseconds -- rarely
-      // enough not to create noticeable overhead, frequently enough not to
-      // appear frozen).
-      work_estimate += length;
-      if (work_estimate > 500000) {
-        work_estimate = 0;
-        StackLimitCheck interrupt_check(isolate);
-        if (interrupt_check.InterruptRequested()) {
-          {
-            AllowGarbageCollection might_throw;
-            if (isolate->stack_guard()->HandleInterrupts().IsException(
-                    isolate)) {
-              return MaybeHandle<String>();
-            }
-          }
-          // If there was an interrupt request but no termination, reload
-          // the raw characters pointer (as the string might have moved).
-          chars = result->GetChars(no_gc);
-        }
-      }
-    } while (nonzero_digit > 0);
-    last_digit = rest->digit(0);
-  }
+      isolate->factory()->NewRawOneByteString(chars_allocated).ToHandleChecked();
+  int chars_written = chars_allocated;
   DisallowGarbageCollection no_gc;
-  uint8_t* chars = result->GetChars(no_gc);
-  do {
-    chars[pos++] = kConversionChars[last_digit % radix];
-    last_digit /= radix;
-  } while (last_digit > 0);
-  DCHECK_GE(pos, 1);
-  DCHECK(pos <= static_cast<int>(chars_required));
-  // Remove leading zeroes.
-  while (pos > 1 && chars[pos - 1] == '0') pos--;
-  if (sign) chars[pos++] = '-';
+  char* characters = reinterpret_cast<char*>(result->GetChars(no_gc));
+  bigint::Status status = isolate->bigint_processor()->ToString(
+      characters, &chars_written, GetDigits(x), radix, x->sign());
+  if (status == bigint::Status::kInterrupted) {
+    AllowGarbageCollection terminating_anyway;
+    isolate->TerminateExecution();
+    return {};
+  }
   // Trim any over-allocation (which can happen due to conservative estimates).
-  if (pos < static_cast<int>(chars_required)) {
-    result->synchronized_set_length(pos);
-    int string_size =
-        SeqOneByteString::SizeFor(static_cast<int>(chars_required));
-    int needed_size = SeqOneByteString::SizeFor(pos);
+  if (chars_written < chars_allocated) {
+    result->synchronized_set_length(chars_written);
+    int string_size = SeqOneByteString::SizeFor(chars_allocated);
+    int needed_size = SeqOneByteString::SizeFor(chars_written);
     if (needed_size < string_size) {
       Address new_end = result->address() + needed_size;
       heap->CreateFillerObjectAt(new_end, (string_size - needed_size),
                                  ClearRecordedSlots::kNo);
     }
   }
-  // Reverse the string.
-  for (int i = 0, j = pos - 1; i < j; i++, j--) {
-    uint8_t tmp = chars[i];
-    chars[i] = chars[j];
-    chars[j] = tmp;
-  }
-#if DEBUG
-  // Verify that all characters have been written.
-  DCHECK(result->length() == pos);
-  for (int i = 0; i < pos; i++) DCHECK_NE(chars[i], '?');
-#endif
   return result;
 }
 
@@ -2703,19 +2313,6 @@ BigInt::digit_t MutableBigInt::digit_div(digit_t high, digit_t low,
 #endif
 }
 
-// Raises {base} to the power of {exponent}. Does not check for overflow.
-BigInt::digit_t MutableBigInt::digit_pow(digit_t base, digit_t exponent) {
-  digit_t result = 1ull;
-  while (exponent > 0) {
-    if (exponent & 1) {
-      result *= base;
-    }
-    exponent >>= 1;
-    base *= base;
-  }
-  return result;
-}
-
 #undef HAVE_TWODIGIT_T
 
 void MutableBigInt::set_64_bits(uint64_t bits) {
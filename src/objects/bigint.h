@@ -14,6 +14,11 @@
 #include "src/objects/object-macros.h"
 
 namespace v8 {
+
+namespace bigint {
+class FromStringAccumulator;
+}  // namespace bigint
+
 namespace internal {
 
 void MutableBigInt_AbsoluteAddAndCanonicalize(Address result_addr,
@@ -255,8 +260,12 @@ class BigInt : public BigIntBase {
   static MaybeHandle<FreshlyAllocatedBigInt> AllocateFor(
       LocalIsolate* isolate, int radix, int charcount, ShouldThrow should_throw,
       AllocationType allocation);
-  static void InplaceMultiplyAdd(FreshlyAllocatedBigInt x, uintptr_t factor,
-                                 uintptr_t summand);
+  // Sets {x} to the value collected in {accumulator}. Returns false if the
+  // conversion was terminated, in which case an exception is pending.
+  static bool FromAccumulator(Isolate* isolate, FreshlyAllocatedBigInt x,
+                              bigint::FromStringAccumulator* accumulator);
+  static bool FromAccumulator(LocalIsolate* isolate, FreshlyAllocatedBigInt x,
+                              bigint::FromStringAccumulator* accumulator);
   template <typename LocalIsolate>
   static Handle<BigInt> Finalize(Handle<FreshlyAllocatedBigInt> x, bool sign);
 
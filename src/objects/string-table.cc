@@ -12,6 +12,7 @@
 #include "src/common/globals.h"
 #include "src/common/ptr-compr-inl.h"
 #include "src/execution/isolate-utils-inl.h"
+#include "src/heap/read-only-heap.h"
 #include "src/heap/safepoint.h"
 #include "src/objects/internal-index.h"
 #include "src/objects/object-list-macros.h"
@@ -87,7 +88,8 @@ bool KeyIsMatch(LocalIsolate* isolate, StringTableKey* key, String string) {
 //
 // The elements themselves are stored as an open-addressed hash table, with
 // quadratic probing and Smi 0 and Smi 1 as the empty and deleted sentinels,
-// respectively.
+// respectively. Smi 2 marks empty elements of a table that has been replaced
+// by a resize, see StringTable::LookupKey.
 class StringTable::Data {
  public:
   static std::unique_ptr<Data> New(int capacity);
@@ -106,24 +108,39 @@ class StringTable::Data {
     slot(index).Release_Store(entry);
   }
 
-  void ElementAdded() {
-    DCHECK_LT(number_of_elements_ + 1, capacity());
-    DCHECK(StringTableHasSufficientCapacityToAdd(
-        capacity(), number_of_elements(), number_of_deleted_elements(), 1));
-
-    number_of_elements_++;
+  // Atomically replaces an empty element, and returns the previous value of
+  // the element, which is the empty element on success.
+  Tagged_t CompareAndSwapEmpty(InternalIndex index, Object value) {
+    return AsAtomicTagged::Release_CompareAndSwap(
+        &elements_[index.as_uint32()],
+        static_cast<Tagged_t>(empty_element().ptr()),
+        static_cast<Tagged_t>(value.ptr()));
   }
-  void DeletedElementOverwritten() {
-    DCHECK_LT(number_of_elements_ + 1, capacity());
-    DCHECK(StringTableHasSufficientCapacityToAdd(
-        capacity(), number_of_elements(), number_of_deleted_elements() - 1, 1));
 
-    number_of_elements_++;
-    number_of_deleted_elements_--;
+  void ElementAdded() {
+    DCHECK_LT(number_of_elements() + 1, capacity());
+    number_of_elements_.fetch_add(1, std::memory_order_relaxed);
+  }
+  // Reserves room for one more element, unless that would push the table
+  // past its maximum load factor. Concurrent insertions reserve before they
+  // claim an element, so together they cannot overfill the table.
+  bool TryReserveElement() {
+    int nof = number_of_elements_.load(std::memory_order_relaxed);
+    do {
+      if (!StringTableHasSufficientCapacityToAdd(
+              capacity_, nof, number_of_deleted_elements_, 1)) {
+        return false;
+      }
+    } while (!number_of_elements_.compare_exchange_weak(
+        nof, nof + 1, std::memory_order_relaxed));
+    return true;
+  }
+  void ReleaseReservedElement() {
+    number_of_elements_.fetch_sub(1, std::memory_order_relaxed);
   }
   void ElementsRemoved(int count) {
-    DCHECK_LE(count, number_of_elements_);
-    number_of_elements_ -= count;
+    DCHECK_LE(count, number_of_elements());
+    number_of_elements_.fetch_sub(count, std::memory_order_relaxed);
     number_of_deleted_elements_ += count;
   }
 
@@ -132,7 +149,9 @@ class StringTable::Data {
   void operator delete(void* description);
 
   int capacity() const { return capacity_; }
-  int number_of_elements() const { return number_of_elements_; }
+  int number_of_elements() const {
+    return number_of_elements_.load(std::memory_order_relaxed);
+  }
   int number_of_deleted_elements() const { return number_of_deleted_elements_; }
 
   template <typename LocalIsolate, typename StringTableKey>
@@ -141,10 +160,14 @@ class StringTable::Data {
 
   InternalIndex FindInsertionEntry(IsolateRoot isolate, uint32_t hash) const;
 
+  // Returns the string matching {key}, after inserting {new_string} if there
+  // is none. Returns a null String if this table has been replaced by a
+  // resize, in which case the caller has to retry with the new table. The
+  // caller must have reserved an element (see TryReserveElement), which the
+  // inserted string takes up.
   template <typename LocalIsolate, typename StringTableKey>
-  InternalIndex FindEntryOrInsertionEntry(LocalIsolate* isolate,
-                                          StringTableKey* key,
-                                          uint32_t hash) const;
+  String FindOrInsert(LocalIsolate* isolate, StringTableKey* key, uint32_t hash,
+                      String new_string);
 
   // Helper method for StringTable::TryStringToIndexOrLookupExisting.
   template <typename Char>
@@ -152,7 +175,7 @@ class StringTable::Data {
                                                   String string, String source,
                                                   size_t start);
 
-  void IterateElements(RootVisitor* visitor);
+  void IterateElements(RootVisitor* visitor) const;
 
   Data* PreviousData() { return previous_data_.get(); }
   void DropPreviousData() { previous_data_.reset(); }
@@ -175,7 +198,9 @@ class StringTable::Data {
 
  private:
   std::unique_ptr<Data> previous_data_;
-  int number_of_elements_;
+  // Incremented by concurrent insertions.
+  std::atomic<int> number_of_elements_;
+  // Only changed by the GC.
   int number_of_deleted_elements_;
   const int capacity_;
   Tagged_t elements_[1];
@@ -228,20 +253,32 @@ std::unique_ptr<StringTable::Data> StringTable::Data::Resize(
   std::unique_ptr<Data> new_data(new (capacity) Data(capacity));
 
   DCHECK_LT(data->number_of_elements(), new_data->capacity());
-  DCHECK(StringTableHasSufficientCapacityToAdd(
-      new_data->capacity(), new_data->number_of_elements(),
-      new_data->number_of_deleted_elements(), data->number_of_elements()));
 
-  // Rehash the elements.
+  // Rehash the elements. Concurrent insertions may still be adding elements
+  // to the old table, so each empty element is replaced with the moved
+  // sentinel before moving on. Insertions that find it retry on the new
+  // table, and all other insertions are copied over.
+  int number_of_elements = 0;
   for (InternalIndex i : InternalIndex::Range(data->capacity())) {
     Object element = data->Get(isolate, i);
-    if (element == empty_element() || element == deleted_element()) continue;
+    while (element == empty_element()) {
+      if (data->CompareAndSwapEmpty(i, moved_element()) ==
+          static_cast<Tagged_t>(empty_element().ptr())) {
+        element = moved_element();
+      } else {
+        element = data->Get(isolate, i);
+      }
+    }
+    if (!element.IsHeapObject()) continue;
     String string = String::cast(element);
     uint32_t hash = string.hash();
     InternalIndex insertion_index = new_data->FindInsertionEntry(isolate, hash);
     new_data->Set(insertion_index, string);
+    number_of_elements++;
   }
-  new_data->number_of_elements_ = data->number_of_elements();
+  DCHECK_LT(number_of_elements, new_data->capacity());
+  new_data->number_of_elements_.store(number_of_elements,
+                                      std::memory_order_relaxed);
 
   new_data->previous_data_ = std::move(data);
   return new_data;
@@ -258,7 +295,9 @@ InternalIndex StringTable::Data::FindEntry(LocalIsolate* isolate,
     // TODO(leszeks): Consider delaying the decompression until after the
     // comparisons against empty/deleted.
     Object element = Get(isolate, entry);
-    if (element == empty_element()) return InternalIndex::NotFound();
+    if (element == empty_element() || element == moved_element()) {
+      return InternalIndex::NotFound();
+    }
     if (element == deleted_element()) continue;
     String string = String::cast(element);
     if (KeyIsMatch(isolate, key, string)) return entry;
@@ -280,35 +319,33 @@ InternalIndex StringTable::Data::FindInsertionEntry(IsolateRoot isolate,
 }
 
 template <typename LocalIsolate, typename StringTableKey>
-InternalIndex StringTable::Data::FindEntryOrInsertionEntry(
-    LocalIsolate* isolate, StringTableKey* key, uint32_t hash) const {
-  InternalIndex insertion_entry = InternalIndex::NotFound();
+String StringTable::Data::FindOrInsert(LocalIsolate* isolate,
+                                       StringTableKey* key, uint32_t hash,
+                                       String new_string) {
   uint32_t count = 1;
   // EnsureCapacity will guarantee the hash table is never full.
   for (InternalIndex entry = FirstProbe(hash, capacity_);;
        entry = NextProbe(entry, count++, capacity_)) {
-    // TODO(leszeks): Consider delaying the decompression until after the
-    // comparisons against empty/deleted.
     Object element = Get(isolate, entry);
-    if (element == empty_element()) {
-      // Empty entry, it's our insertion entry if there was no previous Hole.
-      if (insertion_entry.is_not_found()) return entry;
-      return insertion_entry;
-    }
-
-    if (element == deleted_element()) {
-      // Holes are potential insertion candidates, but we continue the search
-      // in case we find the actual matching entry.
-      if (insertion_entry.is_not_found()) insertion_entry = entry;
-      continue;
+    // Insertions only ever claim empty elements. Reusing deleted elements
+    // could insert the same key twice, as another insertion of the key may
+    // already have probed past them.
+    while (element == empty_element()) {
+      if (CompareAndSwapEmpty(entry, new_string) ==
+          static_cast<Tagged_t>(empty_element().ptr())) {
+        return new_string;
+      }
+      // Another insertion claimed this element first; check what it wrote.
+      element = Get(isolate, entry);
     }
-
+    if (element == moved_element()) return String();
+    if (element == deleted_element()) continue;
     String string = String::cast(element);
-    if (KeyIsMatch(isolate, key, string)) return entry;
+    if (KeyIsMatch(isolate, key, string)) return string;
   }
 }
 
-void StringTable::Data::IterateElements(RootVisitor* visitor) {
+void StringTable::Data::IterateElements(RootVisitor* visitor) const {
   OffHeapObjectSlot first_slot = slot(InternalIndex(0));
   OffHeapObjectSlot end_slot = slot(InternalIndex(capacity_));
   visitor->VisitRootPointers(Root::kStringTable, nullptr, first_slot, end_slot);
@@ -323,6 +360,45 @@ void StringTable::Data::Print(IsolateRoot isolate) const {
   os << "}" << std::endl;
 }
 
+SharedStringTable::SharedStringTable(Isolate* isolate) {
+  DisallowGarbageCollection no_gc;
+  std::vector<String> strings;
+  ReadOnlyHeapObjectIterator it(isolate->read_only_heap());
+  for (HeapObject object = it.Next(); !object.is_null(); object = it.Next()) {
+    if (object.IsInternalizedString()) strings.push_back(String::cast(object));
+  }
+
+  int capacity = ComputeStringTableCapacity(static_cast<int>(strings.size()));
+  data_ = StringTable::Data::New(capacity);
+  for (String string : strings) {
+    InternalIndex entry = data_->FindInsertionEntry(isolate, string.hash());
+    data_->Set(entry, string);
+    data_->ElementAdded();
+  }
+}
+
+SharedStringTable::~SharedStringTable() = default;
+
+int SharedStringTable::NumberOfElements() const {
+  return data_->number_of_elements();
+}
+
+template <typename StringTableKey, typename LocalIsolate>
+String SharedStringTable::TryLookupKey(LocalIsolate* isolate,
+                                       StringTableKey* key) const {
+  InternalIndex entry = data_->FindEntry(isolate, key, key->hash());
+  if (entry.is_not_found()) return String();
+  return String::cast(data_->Get(isolate, entry));
+}
+
+void SharedStringTable::IterateElements(RootVisitor* visitor) const {
+  data_->IterateElements(visitor);
+}
+
+size_t SharedStringTable::GetCurrentMemoryUsage() const {
+  return sizeof(*this) + data_->GetCurrentMemoryUsage();
+}
+
 StringTable::StringTable(Isolate* isolate)
     : data_(Data::New(kStringTableMinCapacity).release())
 #ifdef DEBUG
@@ -337,10 +413,7 @@ int StringTable::Capacity() const {
   return data_.load(std::memory_order_acquire)->capacity();
 }
 int StringTable::NumberOfElements() const {
-  {
-    base::MutexGuard table_write_guard(&write_mutex_);
-    return data_.load(std::memory_order_relaxed)->number_of_elements();
-  }
+  return data_.load(std::memory_order_acquire)->number_of_elements();
 }
 
 // InternalizedStringKey carries a string/internalized-string object as key.
@@ -428,39 +501,44 @@ Handle<String> StringTable::LookupString(Isolate* isolate,
 template <typename StringTableKey, typename LocalIsolate>
 Handle<String> StringTable::LookupKey(LocalIsolate* isolate,
                                       StringTableKey* key) {
-  // String table lookups are allowed to be concurrent, assuming that:
+  // String table lookups and insertions are allowed to be concurrent, assuming
+  // that:
   //
   //   - The Heap access is allowed to be concurrent (using LocalHeap or
   //     similar),
-  //   - All writes to the string table are guarded by the Isolate string table
-  //     mutex,
-  //   - Resizes of the string table first copies the old contents to the new
-  //     table, and only then sets the new string table pointer to the new
-  //     table,
+  //   - Insertions only ever replace empty elements, using a compare-and-swap,
+  //   - Resizes first freeze the old table by replacing its empty elements
+  //     with the moved sentinel, then copy the old contents to the new table,
+  //     and only then set the string table pointer to the new table,
   //   - Only GCs can remove elements from the string table.
   //
   // These assumptions allow us to make the following statement:
   //
-  //   "Reads are allowed when not holding the lock, as long as false negatives
-  //    (misses) are ok. We will never get a false positive (hit of an entry no
-  //    longer in the table)"
+  //   "Reads never take a lock, as long as false negatives (misses) are ok. We
+  //    will never get a false positive (hit of an entry no longer in the
+  //    table)"
   //
   // This is because we _know_ that if we find an entry in the string table, any
   // entry will also be in all reallocations of that tables. This is required
   // for strong consistency of internalized string equality implying reference
   // equality.
   //
-  // We therefore try to optimistically read from the string table without
-  // taking the lock (both here and in the NoAllocate version of the lookup),
-  // and on a miss we take the lock and try to write the entry, with a second
-  // read lookup in case the non-locked read missed a write.
+  // Insertions are lock-free as well: two insertions of the same key probe the
+  // same sequence of elements, so they race for the same first empty element
+  // and the loser finds the winner's string there. An insertion that finds the
+  // moved sentinel retries on the new table. Only resizes take the resize
+  // mutex, and they never block readers.
   //
   // One complication is allocation -- we don't want to allocate while holding
-  // the string table lock. This applies to both allocation of new strings, and
-  // re-allocation of the string table on resize. So, we optimistically allocate
-  // (without copying values) outside the lock, and potentially discard the
-  // allocation if another write also did an allocation. This assumes that
-  // writes are rarer than reads.
+  // the resize mutex. So, we optimistically allocate the new string before
+  // inserting it, and discard it if another insertion of the same key wins.
+  // This assumes that writes are rarer than reads.
+
+  // The shared table is immutable, so it can always be read without the lock.
+  if (shared_table_ != nullptr) {
+    String shared = shared_table_->TryLookupKey(isolate, key);
+    if (!shared.is_null()) return handle(shared, isolate);
+  }
 
   // Load the current string table data, in case another thread updates the
   // data while we're reading.
@@ -480,36 +558,28 @@ Handle<String> StringTable::LookupKey(LocalIsolate* isolate,
 
   // Allocate the string before the first insertion attempt, reuse this
   // allocated value on insertion retries. If another thread concurrently
-  // allocates the same string, the insert will fail, the lookup above will
-  // succeed, and this string will be discarded.
+  // inserts the same string, the insertion returns that one instead, and this
+  // string will be discarded.
   Handle<String> new_string = key->AsHandle(isolate);
 
-  {
-    base::MutexGuard table_write_guard(&write_mutex_);
-
+  while (true) {
     Data* data = EnsureCapacity(isolate, 1);
-
-    // Check one last time if the key is present in the table, in case it was
-    // added after the check.
-    entry = data->FindEntryOrInsertionEntry(isolate, key, key->hash());
-
-    Object element = data->Get(isolate, entry);
-    if (element == empty_element()) {
-      // This entry is empty, so write it and register that we added an
-      // element.
-      data->Set(entry, *new_string);
-      data->ElementAdded();
-      return new_string;
-    } else if (element == deleted_element()) {
-      // This entry was deleted, so overwrite it and register that we
-      // overwrote a deleted element.
-      data->Set(entry, *new_string);
-      data->DeletedElementOverwritten();
-      return new_string;
-    } else {
-      // Return the existing string as a handle.
-      return handle(String::cast(element), isolate);
+    // The capacity check in EnsureCapacity is not atomic with the insertion,
+    // so concurrent insertions may have used up the room since. In that case
+    // the next EnsureCapacity finds the table full and resizes it under the
+    // resize lock.
+    if (!data->TryReserveElement()) continue;
+    String result = data->FindOrInsert(isolate, key, key->hash(), *new_string);
+    if (result.is_null() || result != *new_string) {
+      data->ReleaseReservedElement();
+    }
+    if (!result.is_null()) {
+      if (result == *new_string) return new_string;
+      return handle(result, isolate);
     }
+    // The table is being replaced by a concurrent resize. Wait for the resize
+    // to finish before retrying on the new table.
+    base::MutexGuard resize_guard(&resize_mutex_);
   }
 }
 
@@ -529,34 +599,53 @@ template Handle<String> StringTable::LookupKey(LocalIsolate* isolate,
 
 template Handle<String> StringTable::LookupKey(Isolate* isolate,
                                                StringTableInsertionKey* key);
+template Handle<String> StringTable::LookupKey(LocalIsolate* isolate,
+                                               StringTableInsertionKey* key);
 
-StringTable::Data* StringTable::EnsureCapacity(IsolateRoot isolate,
-                                               int additional_elements) {
-  // This call is only allowed while the write mutex is held.
-  write_mutex_.AssertHeld();
-
-  // This load can be relaxed as the table pointer can only be modified while
-  // the lock is held.
-  Data* data = data_.load(std::memory_order_relaxed);
+namespace {
 
+// Returns the capacity the table should be resized to before adding
+// {additional_elements}, or -1 if it does not need to be resized.
+int ComputeStringTableResizeCapacity(int current_capacity, int current_nof,
+                                     int number_of_deleted_elements,
+                                     int additional_elements) {
   // Grow or shrink table if needed. We first try to shrink the table, if it
   // is sufficiently empty; otherwise we make sure to grow it so that it has
   // enough space.
-  int current_capacity = data->capacity();
-  int current_nof = data->number_of_elements();
-  int capacity_after_shrinking =
-      ComputeStringTableCapacityWithShrink(current_capacity, current_nof + 1);
+  int capacity_after_shrinking = ComputeStringTableCapacityWithShrink(
+      current_capacity, current_nof + additional_elements);
 
-  int new_capacity = -1;
   if (capacity_after_shrinking < current_capacity) {
-    DCHECK(StringTableHasSufficientCapacityToAdd(capacity_after_shrinking,
-                                                 current_nof, 0, 1));
-    new_capacity = capacity_after_shrinking;
+    DCHECK(StringTableHasSufficientCapacityToAdd(
+        capacity_after_shrinking, current_nof, 0, additional_elements));
+    return capacity_after_shrinking;
   } else if (!StringTableHasSufficientCapacityToAdd(
-                 current_capacity, current_nof,
-                 data->number_of_deleted_elements(), 1)) {
-    new_capacity = ComputeStringTableCapacity(current_nof + 1);
+                 current_capacity, current_nof, number_of_deleted_elements,
+                 additional_elements)) {
+    return ComputeStringTableCapacity(current_nof + additional_elements);
   }
+  return -1;
+}
+
+}  // namespace
+
+StringTable::Data* StringTable::EnsureCapacity(IsolateRoot isolate,
+                                               int additional_elements) {
+  Data* data = data_.load(std::memory_order_acquire);
+  if (ComputeStringTableResizeCapacity(
+          data->capacity(), data->number_of_elements(),
+          data->number_of_deleted_elements(), additional_elements) == -1) {
+    return data;
+  }
+
+  base::MutexGuard resize_guard(&resize_mutex_);
+
+  // This load can be relaxed as the table pointer can only be modified while
+  // the lock is held. Another thread may have resized the table already.
+  data = data_.load(std::memory_order_relaxed);
+  int new_capacity = ComputeStringTableResizeCapacity(
+      data->capacity(), data->number_of_elements(),
+      data->number_of_deleted_elements(), additional_elements);
 
   if (new_capacity != -1) {
     std::unique_ptr<Data> new_data =
@@ -615,17 +704,24 @@ Address StringTable::Data::TryStringToIndexOrLookupExisting(Isolate* isolate,
     return Smi::FromInt(ResultSentinel::kUnsupported).ptr();
   }
 
-  Data* string_table_data =
-      isolate->string_table()->data_.load(std::memory_order_acquire);
-
-  InternalIndex entry = string_table_data->FindEntry(isolate, &key, key.hash());
-  if (entry.is_not_found()) {
-    // A string that's not an array index, and not in the string table,
-    // cannot have been used as a property name before.
-    return Smi::FromInt(ResultSentinel::kNotFound).ptr();
+  StringTable* string_table = isolate->string_table();
+  String internalized;
+  if (string_table->shared_table() != nullptr) {
+    internalized = string_table->shared_table()->TryLookupKey(isolate, &key);
   }
+  if (internalized.is_null()) {
+    Data* string_table_data =
+        string_table->data_.load(std::memory_order_acquire);
 
-  String internalized = String::cast(string_table_data->Get(isolate, entry));
+    InternalIndex entry =
+        string_table_data->FindEntry(isolate, &key, key.hash());
+    if (entry.is_not_found()) {
+      // A string that's not an array index, and not in the string table,
+      // cannot have been used as a property name before.
+      return Smi::FromInt(ResultSentinel::kNotFound).ptr();
+    }
+    internalized = String::cast(string_table_data->Get(isolate, entry));
+  }
   if (FLAG_thin_strings) {
     string.MakeThin(isolate, internalized);
   }
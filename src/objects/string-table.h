@@ -5,6 +5,8 @@
 #ifndef V8_OBJECTS_STRING_TABLE_H_
 #define V8_OBJECTS_STRING_TABLE_H_
 
+#include <memory>
+
 #include "src/common/assert-scope.h"
 #include "src/objects/string.h"
 #include "src/roots/roots.h"
@@ -39,9 +41,11 @@ class StringTableKey {
 };
 
 class SeqOneByteString;
+class SharedStringTable;
 
 // StringTable, for internalizing strings. The Lookup methods are designed to be
-// thread-safe, in combination with GC safepoints.
+// thread-safe, in combination with GC safepoints. Lookups never block, and
+// insertions only block while the table is being resized.
 //
 // The string table layout is defined by its Data implementation class, see
 // StringTable::Data for details.
@@ -49,6 +53,7 @@ class V8_EXPORT_PRIVATE StringTable {
  public:
   static constexpr Smi empty_element() { return Smi::FromInt(0); }
   static constexpr Smi deleted_element() { return Smi::FromInt(1); }
+  static constexpr Smi moved_element() { return Smi::FromInt(2); }
 
   explicit StringTable(Isolate* isolate);
   ~StringTable();
@@ -75,26 +80,64 @@ class V8_EXPORT_PRIVATE StringTable {
   void Print(IsolateRoot isolate) const;
   size_t GetCurrentMemoryUsage() const;
 
-  // The following methods must be called either while holding the write lock,
-  // or while in a Heap safepoint.
+  // The process-wide table of read-only strings, if any. It is searched before
+  // this table, so the strings in it are never added to this table.
+  const SharedStringTable* shared_table() const { return shared_table_; }
+  void set_shared_table(const SharedStringTable* shared_table) {
+    DCHECK_EQ(0, NumberOfElements());
+    shared_table_ = shared_table;
+  }
+
+  // The following methods must be called while in a Heap safepoint.
   void IterateElements(RootVisitor* visitor);
   void DropOldData();
   void NotifyElementsRemoved(int count);
 
  private:
   class Data;
+  friend class SharedStringTable;
 
   Data* EnsureCapacity(IsolateRoot isolate, int additional_elements);
 
   std::atomic<Data*> data_;
-  // Write mutex is mutable so that readers of concurrently mutated values (e.g.
-  // NumberOfElements) are allowed to lock it while staying const.
-  mutable base::Mutex write_mutex_;
+  const SharedStringTable* shared_table_ = nullptr;
+  // Only held while resizing. Lookups and insertions do not take it.
+  base::Mutex resize_mutex_;
 #ifdef DEBUG
   Isolate* isolate_;
 #endif
 };
 
+// SharedStringTable holds the internalized strings of the read-only heap that
+// is shared by all isolates of the process. It is filled once, before the
+// read-only heap is shared, and never changes afterwards, so lookups do not
+// need any synchronization.
+//
+// The elements are stored as tagged values. With pointer compression, each
+// isolate maps the read-only pages at the same offset in its cage, so the same
+// compressed values are valid in every isolate.
+class V8_EXPORT_PRIVATE SharedStringTable {
+ public:
+  // Collects the internalized strings in the read-only heap of {isolate}.
+  explicit SharedStringTable(Isolate* isolate);
+  ~SharedStringTable();
+
+  int NumberOfElements() const;
+
+  // Returns the string matching {key}, or a null String if there is none.
+  template <typename StringTableKey, typename LocalIsolate>
+  String TryLookupKey(LocalIsolate* isolate, StringTableKey* key) const;
+
+  // Visits the elements for serialization. The strings are read-only, so they
+  // must not be visited by the GC.
+  void IterateElements(RootVisitor* visitor) const;
+
+  size_t GetCurrentMemoryUsage() const;
+
+ private:
+  std::unique_ptr<StringTable::Data> data_;
+};
+
 }  // namespace internal
 }  // namespace v8
 
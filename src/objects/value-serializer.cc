@@ -10,6 +10,7 @@
 #include "include/v8.h"
 #include "src/api/api-inl.h"
 #include "src/base/logging.h"
+#include "src/base/memory.h"
 #include "src/base/platform/wrappers.h"
 #include "src/execution/isolate.h"
 #include "src/flags/flags.h"
@@ -69,6 +70,30 @@ static size_t BytesNeededForVarint(T value) {
   return result;
 }
 
+// Writes an unsigned integer as a base-128 varint to {dest}, which must have
+// room for BytesNeededForVarint(value) bytes, and returns the end of it.
+// The number is written, 7 bits at a time, from the least significant to the
+// most significant 7 bits. Each byte, except the last, has the MSB set.
+// See also https://developers.google.com/protocol-buffers/docs/encoding
+template <typename T>
+static uint8_t* EncodeVarint(T value, uint8_t* dest) {
+  static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value,
+                "Only unsigned integer types can be written as varints.");
+  do {
+    *dest = (value & 0x7F) | 0x80;
+    dest++;
+    value >>= 7;
+  } while (value);
+  *(dest - 1) &= 0x7F;
+  return dest;
+}
+
+// ZigZag encodes a Smi value (i.e. 0 is encoded as 0, -1 as 1, 1 as 2, -2 as
+// 3, and so on), like ValueSerializer::WriteZigZag.
+static uint32_t ZigZagEncodeSmi(int32_t value) {
+  return (static_cast<uint32_t>(value) << 1) ^ (value >> 31);
+}
+
 enum class SerializationTag : uint8_t {
   // version:uint32_t (if at beginning of data, sets version > 0)
   kVersion = 0xFF,
@@ -269,21 +294,9 @@ void ValueSerializer::WriteTag(SerializationTag tag) {
 
 template <typename T>
 void ValueSerializer::WriteVarint(T value) {
-  // Writes an unsigned integer as a base-128 varint.
-  // The number is written, 7 bits at a time, from the least significant to the
-  // most significant 7 bits. Each byte, except the last, has the MSB set.
-  // See also https://developers.google.com/protocol-buffers/docs/encoding
-  static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value,
-                "Only unsigned integer types can be written as varints.");
   uint8_t stack_buffer[sizeof(T) * 8 / 7 + 1];
-  uint8_t* next_byte = &stack_buffer[0];
-  do {
-    *next_byte = (value & 0x7F) | 0x80;
-    next_byte++;
-    value >>= 7;
-  } while (value);
-  *(next_byte - 1) &= 0x7F;
-  WriteRawBytes(stack_buffer, next_byte - stack_buffer);
+  uint8_t* end = EncodeVarint(value, stack_buffer);
+  WriteRawBytes(stack_buffer, end - stack_buffer);
 }
 
 template <typename T>
@@ -345,6 +358,12 @@ Maybe<uint8_t*> ValueSerializer::ReserveRawBytes(size_t bytes) {
   return Just(&buffer_[old_size]);
 }
 
+Maybe<bool> ValueSerializer::ReserveCapacity(size_t bytes) {
+  size_t required_capacity = buffer_size_ + bytes;
+  if (V8_LIKELY(required_capacity <= buffer_capacity_)) return Just(true);
+  return ExpandBuffer(required_capacity);
+}
+
 Maybe<bool> ValueSerializer::ExpandBuffer(size_t required_capacity) {
   DCHECK_GT(required_capacity, buffer_capacity_);
   size_t requested_capacity =
@@ -486,6 +505,12 @@ void ValueSerializer::WriteString(Handle<String> string) {
   DisallowGarbageCollection no_gc;
   String::FlatContent flat = string->GetFlatContent(no_gc);
   DCHECK(flat.IsFlat());
+  // Make room for the padding, the tag, the length and the characters at once.
+  const size_t kMaxHeaderSize = 2 + sizeof(uint32_t) * 8 / 7 + 1;
+  size_t content_size = flat.IsOneByte()
+                            ? flat.ToOneByteVector().length()
+                            : flat.ToUC16Vector().length() * sizeof(uc16);
+  if (ReserveCapacity(kMaxHeaderSize + content_size).IsNothing()) return;
   if (flat.IsOneByte()) {
     Vector<const uint8_t> chars = flat.ToOneByteVector();
     WriteTag(SerializationTag::kOneByteString);
@@ -677,20 +702,50 @@ Maybe<bool> ValueSerializer::WriteJSArray(Handle<JSArray> array) {
     // structure of the elements changing.
     switch (array->GetElementsKind()) {
       case PACKED_SMI_ELEMENTS: {
-        Handle<FixedArray> elements(FixedArray::cast(array->elements()),
-                                    isolate_);
-        for (; i < length; i++) WriteSmi(Smi::cast(elements->get(i)));
+        // Each element is written like WriteSmi does. The elements are
+        // measured first, so that they can be encoded into the buffer as one
+        // block.
+        static_assert(kSmiValueSize <= 32, "Expected SMI <= 32 bits.");
+        {
+          DisallowGarbageCollection no_gc;
+          FixedArray elements = FixedArray::cast(array->elements());
+          size_t byte_length = 0;
+          for (uint32_t j = 0; j < length; j++) {
+            int32_t value = Smi::ToInt(elements.get(j));
+            byte_length += 1 + BytesNeededForVarint(ZigZagEncodeSmi(value));
+          }
+          uint8_t* dest;
+          if (ReserveRawBytes(byte_length).To(&dest)) {
+            for (; i < length; i++) {
+              int32_t value = Smi::ToInt(elements.get(i));
+              *dest++ = static_cast<uint8_t>(SerializationTag::kInt32);
+              dest = EncodeVarint(ZigZagEncodeSmi(value), dest);
+            }
+            DCHECK_EQ(dest, buffer_ + buffer_size_);
+          }
+        }
+        if (i < length) return ThrowIfOutOfMemory();
         break;
       }
       case PACKED_DOUBLE_ELEMENTS: {
         // Elements are empty_fixed_array, not a FixedDoubleArray, if the array
         // is empty. No elements to encode in this case anyhow.
         if (length == 0) break;
-        Handle<FixedDoubleArray> elements(
-            FixedDoubleArray::cast(array->elements()), isolate_);
+        // Each element is a kDouble tag followed by the raw double, so the
+        // elements can be written as one block.
+        // Warning: this uses host endianness.
+        const size_t kElementSize = 1 + sizeof(double);
+        uint8_t* dest;
+        if (!ReserveRawBytes(length * kElementSize).To(&dest)) {
+          return ThrowIfOutOfMemory();
+        }
+        DisallowGarbageCollection no_gc;
+        FixedDoubleArray elements = FixedDoubleArray::cast(array->elements());
         for (; i < length; i++) {
-          WriteTag(SerializationTag::kDouble);
-          WriteDouble(elements->get_scalar(i));
+          dest[0] = static_cast<uint8_t>(SerializationTag::kDouble);
+          base::WriteUnalignedValue<double>(
+              reinterpret_cast<Address>(dest + 1), elements.get_scalar(i));
+          dest += kElementSize;
         }
         break;
       }
@@ -1560,32 +1615,43 @@ MaybeHandle<JSArray> ValueDeserializer::ReadDenseJSArray() {
 
   uint32_t id = next_id_++;
   HandleScope scope(isolate_);
-  Handle<JSArray> array = isolate_->factory()->NewJSArray(
-      HOLEY_ELEMENTS, length, length, INITIALIZE_ARRAY_ELEMENTS_WITH_HOLE);
-  AddObjectWithID(id, array);
+  Handle<JSArray> array;
+  SerializationTag first_tag;
+  if (length > 0 && PeekTag().To(&first_tag) &&
+      ((first_tag == SerializationTag::kInt32 &&
+        ReadPackedSmiJSArray(length).ToHandle(&array)) ||
+       (first_tag == SerializationTag::kDouble &&
+        ReadPackedDoubleJSArray(length).ToHandle(&array)))) {
+    AddObjectWithID(id, array);
+  } else {
+    array = isolate_->factory()->NewJSArray(
+        HOLEY_ELEMENTS, length, length, INITIALIZE_ARRAY_ELEMENTS_WITH_HOLE);
+    AddObjectWithID(id, array);
 
-  Handle<FixedArray> elements(FixedArray::cast(array->elements()), isolate_);
-  for (uint32_t i = 0; i < length; i++) {
-    SerializationTag tag;
-    if (PeekTag().To(&tag) && tag == SerializationTag::kTheHole) {
-      ConsumeTag(SerializationTag::kTheHole);
-      continue;
-    }
+    Handle<FixedArray> elements(FixedArray::cast(array->elements()),
+                                isolate_);
+    for (uint32_t i = 0; i < length; i++) {
+      SerializationTag tag;
+      if (PeekTag().To(&tag) && tag == SerializationTag::kTheHole) {
+        ConsumeTag(SerializationTag::kTheHole);
+        continue;
+      }
 
-    Handle<Object> element;
-    if (!ReadObject().ToHandle(&element)) return MaybeHandle<JSArray>();
+      Handle<Object> element;
+      if (!ReadObject().ToHandle(&element)) return MaybeHandle<JSArray>();
 
-    // Serialization versions less than 11 encode the hole the same as
-    // undefined. For consistency with previous behavior, store these as the
-    // hole. Past version 11, undefined means undefined.
-    if (version_ < 11 && element->IsUndefined(isolate_)) continue;
+      // Serialization versions less than 11 encode the hole the same as
+      // undefined. For consistency with previous behavior, store these as the
+      // hole. Past version 11, undefined means undefined.
+      if (version_ < 11 && element->IsUndefined(isolate_)) continue;
 
-    // Safety check.
-    if (i >= static_cast<uint32_t>(elements->length())) {
-      return MaybeHandle<JSArray>();
-    }
+      // Safety check.
+      if (i >= static_cast<uint32_t>(elements->length())) {
+        return MaybeHandle<JSArray>();
+      }
 
-    elements->set(i, *element);
+      elements->set(i, *element);
+    }
   }
 
   uint32_t num_properties;
@@ -1603,6 +1669,67 @@ MaybeHandle<JSArray> ValueDeserializer::ReadDenseJSArray() {
   return scope.CloseAndEscape(array);
 }
 
+MaybeHandle<JSArray> ValueDeserializer::ReadPackedSmiJSArray(
+    uint32_t length) {
+  // Check that all elements are kInt32 values in Smi range before allocating
+  // anything, then read them again.
+  const uint8_t* start = position_;
+  for (uint32_t i = 0; i < length; i++) {
+    SerializationTag tag;
+    int32_t value;
+    if (!ReadTag().To(&tag) || tag != SerializationTag::kInt32 ||
+        !ReadZigZag<int32_t>().To(&value) || !Smi::IsValid(value)) {
+      position_ = start;
+      return MaybeHandle<JSArray>();
+    }
+  }
+  position_ = start;
+
+  Handle<FixedArray> elements =
+      isolate_->factory()->NewFixedArray(static_cast<int>(length));
+  {
+    DisallowGarbageCollection no_gc;
+    FixedArray raw_elements = *elements;
+    for (uint32_t i = 0; i < length; i++) {
+      ReadTag().ToChecked();
+      raw_elements.set(i, Smi::FromInt(ReadZigZag<int32_t>().ToChecked()));
+    }
+  }
+  return isolate_->factory()->NewJSArrayWithElements(
+      elements, PACKED_SMI_ELEMENTS, static_cast<int>(length));
+}
+
+MaybeHandle<JSArray> ValueDeserializer::ReadPackedDoubleJSArray(
+    uint32_t length) {
+  // Check that all elements are kDouble values before allocating anything,
+  // then read them again.
+  const uint8_t* start = position_;
+  for (uint32_t i = 0; i < length; i++) {
+    SerializationTag tag;
+    if (!ReadTag().To(&tag) || tag != SerializationTag::kDouble ||
+        position_ > end_ - sizeof(double)) {
+      position_ = start;
+      return MaybeHandle<JSArray>();
+    }
+    position_ += sizeof(double);
+  }
+  position_ = start;
+
+  Handle<FixedDoubleArray> elements = Handle<FixedDoubleArray>::cast(
+      isolate_->factory()->NewFixedDoubleArray(static_cast<int>(length)));
+  {
+    DisallowGarbageCollection no_gc;
+    FixedDoubleArray raw_elements = *elements;
+    for (uint32_t i = 0; i < length; i++) {
+      ReadTag().ToChecked();
+      // ReadDouble canonicalizes NaNs, so none of them is the hole.
+      raw_elements.set(i, ReadDouble().ToChecked());
+    }
+  }
+  return isolate_->factory()->NewJSArrayWithElements(
+      elements, PACKED_DOUBLE_ELEMENTS, static_cast<int>(length));
+}
+
 MaybeHandle<JSDate> ValueDeserializer::ReadJSDate() {
   double value;
   if (!ReadDouble().To(&value)) return MaybeHandle<JSDate>();
@@ -98,6 +98,9 @@ class ValueSerializer {
 
   // Managing allocations of the internal buffer.
   Maybe<bool> ExpandBuffer(size_t required_capacity);
+  // Makes room for writing {bytes} more bytes with at most one reallocation,
+  // before they are written piecewise.
+  Maybe<bool> ReserveCapacity(size_t bytes);
 
   // Writing the wire format.
   void WriteTag(SerializationTag tag);
@@ -268,6 +271,13 @@ class ValueDeserializer {
   MaybeHandle<JSObject> ReadJSObject() V8_WARN_UNUSED_RESULT;
   MaybeHandle<JSArray> ReadSparseJSArray() V8_WARN_UNUSED_RESULT;
   MaybeHandle<JSArray> ReadDenseJSArray() V8_WARN_UNUSED_RESULT;
+  // Fast paths for dense arrays whose elements are all Smis or all doubles,
+  // which don't allocate a heap object per element. They return an empty
+  // handle, without consuming anything, if the elements don't match.
+  MaybeHandle<JSArray> ReadPackedSmiJSArray(uint32_t length)
+      V8_WARN_UNUSED_RESULT;
+  MaybeHandle<JSArray> ReadPackedDoubleJSArray(uint32_t length)
+      V8_WARN_UNUSED_RESULT;
   MaybeHandle<JSDate> ReadJSDate() V8_WARN_UNUSED_RESULT;
   MaybeHandle<JSPrimitiveWrapper> ReadJSPrimitiveWrapper(SerializationTag tag)
       V8_WARN_UNUSED_RESULT;
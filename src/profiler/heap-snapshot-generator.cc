@@ -4,6 +4,7 @@
 
 #include "src/profiler/heap-snapshot-generator.h"
 
+#include <atomic>
 #include <utility>
 
 #include "src/api/api-inl.h"
@@ -12,8 +13,10 @@
 #include "src/common/globals.h"
 #include "src/debug/debug.h"
 #include "src/handles/global-handles.h"
+#include "src/heap/basic-memory-chunk.h"
 #include "src/heap/combined-heap.h"
 #include "src/heap/safepoint.h"
+#include "src/init/v8.h"
 #include "src/numbers/conversions.h"
 #include "src/objects/allocation-site-inl.h"
 #include "src/objects/api-callbacks.h"
@@ -81,15 +84,38 @@ HeapEntry::HeapEntry(HeapSnapshot* snapshot, int index, Type type,
 void HeapEntry::SetNamedReference(HeapGraphEdge::Type type,
                                   const char* name,
                                   HeapEntry* entry) {
-  ++children_count_;
-  snapshot_->edges().emplace_back(type, name, this, entry);
+  SetNamedReference(type, name, entry, &snapshot_->edges());
 }
 
 void HeapEntry::SetIndexedReference(HeapGraphEdge::Type type,
                                     int index,
                                     HeapEntry* entry) {
+  SetIndexedReference(type, index, entry, &snapshot_->edges());
+}
+
+void HeapEntry::SetNamedReference(HeapGraphEdge::Type type, const char* name,
+                                  HeapEntry* entry,
+                                  std::deque<HeapGraphEdge>* edges) {
+  ++children_count_;
+  edges->emplace_back(type, name, this, entry);
+}
+
+void HeapEntry::SetIndexedReference(HeapGraphEdge::Type type, int index,
+                                    HeapEntry* entry,
+                                    std::deque<HeapGraphEdge>* edges) {
   ++children_count_;
-  snapshot_->edges().emplace_back(type, index, this, entry);
+  edges->emplace_back(type, index, this, entry);
+}
+
+void HeapEntry::RemoveReferencesAfter(size_t size,
+                                      std::deque<HeapGraphEdge>* edges) {
+  DCHECK_LE(size, edges->size());
+  while (edges->size() > size) {
+    DCHECK_EQ(this, edges->back().from());
+    DCHECK_LT(0u, children_count_);
+    --children_count_;
+    edges->pop_back();
+  }
 }
 
 void HeapEntry::SetNamedAutoIndexReference(HeapGraphEdge::Type type,
@@ -547,7 +573,19 @@ V8HeapExplorer::V8HeapExplorer(HeapSnapshot* snapshot,
       heap_object_map_(snapshot_->profiler()->heap_object_map()),
       progress_(progress),
       generator_(nullptr),
-      global_object_name_resolver_(resolver) {}
+      global_object_name_resolver_(resolver),
+      edges_(&snapshot->edges()) {}
+
+V8HeapExplorer::V8HeapExplorer(V8HeapExplorer* main_explorer)
+    : heap_(main_explorer->heap_),
+      snapshot_(main_explorer->snapshot_),
+      names_(main_explorer->names_),
+      heap_object_map_(main_explorer->heap_object_map_),
+      progress_(nullptr),
+      generator_(main_explorer->generator_),
+      global_object_name_resolver_(nullptr),
+      edges_(nullptr),
+      is_worker_(true) {}
 
 HeapEntry* V8HeapExplorer::AllocateEntry(HeapThing ptr) {
   return AddEntry(HeapObject::cast(Object(reinterpret_cast<Address>(ptr))));
@@ -1257,10 +1295,18 @@ void V8HeapExplorer::ExtractJSArrayBufferReferences(HeapEntry* entry,
   if (!buffer.backing_store()) return;
   size_t data_size = buffer.byte_length();
   JSArrayBufferDataEntryAllocator allocator(data_size, this);
-  HeapEntry* data_entry =
-      generator_->FindOrAddEntry(buffer.backing_store(), &allocator);
+  HeapEntry* data_entry;
+  if (is_worker_) {
+    data_entry = generator_->FindEntry(buffer.backing_store());
+    if (data_entry == nullptr) {
+      missing_entry_ = true;
+      return;
+    }
+  } else {
+    data_entry = generator_->FindOrAddEntry(buffer.backing_store(), &allocator);
+  }
   entry->SetNamedReference(HeapGraphEdge::kInternal, "backing_store",
-                           data_entry);
+                           data_entry, edges_);
 }
 
 void V8HeapExplorer::ExtractJSPromiseReferences(HeapEntry* entry,
@@ -1476,9 +1522,15 @@ String V8HeapExplorer::GetConstructorName(JSObject object) {
 }
 
 HeapEntry* V8HeapExplorer::GetEntry(Object obj) {
-  return obj.IsHeapObject() ? generator_->FindOrAddEntry(
-                                  reinterpret_cast<void*>(obj.ptr()), this)
-                            : nullptr;
+  if (!obj.IsHeapObject()) return nullptr;
+  void* ptr = reinterpret_cast<void*>(obj.ptr());
+  if (is_worker_) {
+    // Entries are only added on the main thread.
+    HeapEntry* entry = generator_->FindEntry(ptr);
+    if (entry == nullptr) missing_entry_ = true;
+    return entry;
+  }
+  return generator_->FindOrAddEntry(ptr, this);
 }
 
 class RootsReferencesExtractor : public RootVisitor {
@@ -1545,42 +1597,194 @@ bool V8HeapExplorer::IterateAndExtractReferences(
 
   bool interrupted = false;
 
+  // Properties of dictionary mode prototypes are iterated with handles, which
+  // the worker threads cannot create.
+  if (FLAG_heap_snapshot_parallel_extraction && !V8_DICT_MODE_PROTOTYPES_BOOL) {
+    interrupted = !ExtractReferencesInParallel();
+  } else {
+    CombinedHeapObjectIterator iterator(heap_,
+                                        HeapObjectIterator::kFilterUnreachable);
+    // Heap iteration with filtering must be finished in any case.
+    for (HeapObject obj = iterator.Next(); !obj.is_null();
+         obj = iterator.Next(), progress_->ProgressStep()) {
+      if (interrupted) continue;
+
+      HeapEntry* entry = GetEntry(obj);
+      ExtractReferencesForObject(entry, obj);
+
+      // Extract location for specific object types
+      ExtractLocation(entry, obj);
+
+      if (!progress_->ProgressReport(false)) interrupted = true;
+    }
+  }
+
+  generator_ = nullptr;
+  return interrupted ? false : progress_->ProgressReport(true);
+}
+
+void V8HeapExplorer::ExtractReferencesForObject(HeapEntry* entry,
+                                                HeapObject obj) {
+  size_t max_pointer = obj.Size() / kTaggedSize;
+  if (max_pointer > visited_fields_.size()) {
+    // Clear the current bits.
+    std::vector<bool>().swap(visited_fields_);
+    // Reallocate to right size.
+    visited_fields_.resize(max_pointer, false);
+  }
+
+  ExtractReferences(entry, obj);
+  SetInternalReference(entry, "map", obj.map(), HeapObject::kMapOffset);
+  // Extract unvisited fields as hidden references and restore tags
+  // of visited fields.
+  IndexedReferencesExtractor refs_extractor(this, obj, entry);
+  obj.Iterate(&refs_extractor);
+
+  // Ensure visited_fields_ doesn't leak to the next object.
+  for (size_t i = 0; i < max_pointer; ++i) {
+    DCHECK(!visited_fields_[i]);
+  }
+}
+
+class V8HeapExplorer::ExtractionJob final : public v8::JobTask {
+ public:
+  ExtractionJob(std::vector<std::unique_ptr<V8HeapExplorer>>* workers,
+                const ExtractionChunk* chunks,
+                std::vector<ExtractedReferences>* results)
+      : workers_(workers), chunks_(chunks), results_(results) {}
+
+  void Run(JobDelegate* delegate) override {
+    DCHECK_LT(delegate->GetTaskId(), workers_->size());
+    V8HeapExplorer* worker = (*workers_)[delegate->GetTaskId()].get();
+    while (!delegate->ShouldYield()) {
+      size_t index = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+      if (index >= results_->size()) return;
+      worker->ExtractChunkReferences(chunks_[index], &(*results_)[index]);
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    size_t next_chunk = next_chunk_.load(std::memory_order_relaxed);
+    if (next_chunk >= results_->size()) return 0;
+    return std::min(workers_->size(), results_->size() - next_chunk);
+  }
+
+ private:
+  std::vector<std::unique_ptr<V8HeapExplorer>>* workers_;
+  const ExtractionChunk* chunks_;
+  std::vector<ExtractedReferences>* results_;
+  std::atomic<size_t> next_chunk_{0};
+};
+
+bool V8HeapExplorer::ExtractReferencesInParallel() {
+  // Add the entries of all objects up front, so that the workers only have to
+  // look them up. Locations are extracted here as well, because finding the
+  // constructor of an object needs handles. Only the boundaries of the runs
+  // of adjacent objects are kept, the workers walk the runs themselves.
+  std::vector<ExtractionChunk> chunks;
+  BasicMemoryChunk* current_page = nullptr;
+  Address run_end = kNullAddress;
+  bool interrupted = false;
   CombinedHeapObjectIterator iterator(heap_,
                                       HeapObjectIterator::kFilterUnreachable);
   // Heap iteration with filtering must be finished in any case.
   for (HeapObject obj = iterator.Next(); !obj.is_null();
        obj = iterator.Next(), progress_->ProgressStep()) {
     if (interrupted) continue;
-
-    size_t max_pointer = obj.Size() / kTaggedSize;
-    if (max_pointer > visited_fields_.size()) {
-      // Clear the current bits.
-      std::vector<bool>().swap(visited_fields_);
-      // Reallocate to right size.
-      visited_fields_.resize(max_pointer, false);
+    BasicMemoryChunk* page = BasicMemoryChunk::FromHeapObject(obj);
+    if (page != current_page) {
+      chunks.emplace_back();
+      current_page = page;
+      run_end = kNullAddress;
     }
-
-    HeapEntry* entry = GetEntry(obj);
-    ExtractReferences(entry, obj);
-    SetInternalReference(entry, "map", obj.map(), HeapObject::kMapOffset);
-    // Extract unvisited fields as hidden references and restore tags
-    // of visited fields.
-    IndexedReferencesExtractor refs_extractor(this, obj, entry);
-    obj.Iterate(&refs_extractor);
-
-    // Ensure visited_fields_ doesn't leak to the next object.
-    for (size_t i = 0; i < max_pointer; ++i) {
-      DCHECK(!visited_fields_[i]);
+    // Fillers and unreachable objects that the iterator skipped end the run.
+    if (obj.address() != run_end) {
+      chunks.back().runs.emplace_back(obj.address(), obj.address());
     }
-
-    // Extract location for specific object types
-    ExtractLocation(entry, obj);
-
+    run_end = obj.address() + obj.Size();
+    chunks.back().runs.back().second = run_end;
+    ExtractLocation(GetEntry(obj), obj);
     if (!progress_->ProgressReport(false)) interrupted = true;
   }
+  if (interrupted) return false;
+
+  std::vector<std::unique_ptr<V8HeapExplorer>> workers;
+  const int num_workers = V8::GetCurrentPlatform()->NumberOfWorkerThreads() + 1;
+  for (int i = 0; i < num_workers; ++i) {
+    workers.emplace_back(new V8HeapExplorer(this));
+  }
+
+  // Extract a bounded number of pages at a time and merge them into the
+  // snapshot before starting on the next ones, so that only the edges of
+  // those pages are buffered in addition to the snapshot.
+  const size_t batch_size = workers.size() * kExtractionChunksPerWorker;
+  for (size_t begin = 0; begin < chunks.size(); begin += batch_size) {
+    std::vector<ExtractedReferences> results(
+        std::min(batch_size, chunks.size() - begin));
+    V8::GetCurrentPlatform()
+        ->PostJob(v8::TaskPriority::kUserBlocking,
+                  std::make_unique<ExtractionJob>(&workers, &chunks[begin],
+                                                  &results))
+        ->Join();
+    for (ExtractedReferences& result : results) {
+      MergeChunk(&result);
+      // Release the memory of the chunk as early as possible.
+      result = ExtractedReferences();
+      if (!progress_->ProgressReport(false)) return false;
+    }
+  }
+  return true;
+}
+
+void V8HeapExplorer::ExtractChunkReferences(const ExtractionChunk& chunk,
+                                            ExtractedReferences* result) {
+  DCHECK(is_worker_);
+  edges_ = &result->edges;
+  tags_ = &result->tags;
+  for (const std::pair<Address, Address>& run : chunk.runs) {
+    for (Address address = run.first; address < run.second;) {
+      HeapObject obj = HeapObject::FromAddress(address);
+      address += obj.Size();
+      HeapEntry* entry =
+          generator_->FindEntry(reinterpret_cast<void*>(obj.ptr()));
+      DCHECK_NOT_NULL(entry);
+      size_t edges_start = edges_->size();
+      size_t tags_start = tags_->size();
+      // Ephemeron hash tables add references to the entries of their keys.
+      if (!obj.IsEphemeronHashTable()) {
+        missing_entry_ = false;
+        ExtractReferencesForObject(entry, obj);
+        if (!missing_entry_) continue;
+        // The object references an object that has no entry yet, e.g. through
+        // a weak field. Drop its references and let the main thread redo
+        // them.
+        entry->RemoveReferencesAfter(edges_start, edges_);
+        tags_->resize(tags_start);
+      }
+      result->deferred.push_back({obj, edges_start, tags_start});
+    }
+  }
+  edges_ = nullptr;
+  tags_ = nullptr;
+}
 
-  generator_ = nullptr;
-  return interrupted ? false : progress_->ProgressReport(true);
+void V8HeapExplorer::MergeChunk(ExtractedReferences* chunk) {
+  DCHECK(!is_worker_);
+  size_t edges_merged = 0;
+  size_t tags_merged = 0;
+  auto merge_until = [&](size_t edges_end, size_t tags_end) {
+    for (; edges_merged < edges_end; ++edges_merged) {
+      edges_->push_back(chunk->edges[edges_merged]);
+    }
+    for (; tags_merged < tags_end; ++tags_merged) {
+      SetTag(chunk->tags[tags_merged].first, chunk->tags[tags_merged].second);
+    }
+  };
+  for (const ExtractedReferences::DeferredObject& deferred : chunk->deferred) {
+    merge_until(deferred.edges_end, deferred.tags_end);
+    ExtractReferencesForObject(GetEntry(deferred.object), deferred.object);
+  }
+  merge_until(chunk->edges.size(), chunk->tags.size());
 }
 
 bool V8HeapExplorer::IsEssentialObject(Object object) {
@@ -1618,7 +1822,8 @@ void V8HeapExplorer::SetContextReference(HeapEntry* parent_entry,
   HeapEntry* child_entry = GetEntry(child_obj);
   if (child_entry == nullptr) return;
   parent_entry->SetNamedReference(HeapGraphEdge::kContextVariable,
-                                  names_->GetName(reference_name), child_entry);
+                                  names_->GetName(reference_name), child_entry,
+                                  edges_);
   MarkVisitedField(field_offset);
 }
 
@@ -1635,7 +1840,7 @@ void V8HeapExplorer::SetNativeBindReference(HeapEntry* parent_entry,
   HeapEntry* child_entry = GetEntry(child_obj);
   if (child_entry == nullptr) return;
   parent_entry->SetNamedReference(HeapGraphEdge::kShortcut, reference_name,
-                                  child_entry);
+                                  child_entry, edges_);
 }
 
 void V8HeapExplorer::SetElementReference(HeapEntry* parent_entry, int index,
@@ -1643,7 +1848,7 @@ void V8HeapExplorer::SetElementReference(HeapEntry* parent_entry, int index,
   HeapEntry* child_entry = GetEntry(child_obj);
   if (child_entry == nullptr) return;
   parent_entry->SetIndexedReference(HeapGraphEdge::kElement, index,
-                                    child_entry);
+                                    child_entry, edges_);
 }
 
 void V8HeapExplorer::SetInternalReference(HeapEntry* parent_entry,
@@ -1653,7 +1858,7 @@ void V8HeapExplorer::SetInternalReference(HeapEntry* parent_entry,
   if (child_entry == nullptr) return;
   if (IsEssentialObject(child_obj)) {
     parent_entry->SetNamedReference(HeapGraphEdge::kInternal, reference_name,
-                                    child_entry);
+                                    child_entry, edges_);
   }
   MarkVisitedField(field_offset);
 }
@@ -1664,7 +1869,8 @@ void V8HeapExplorer::SetInternalReference(HeapEntry* parent_entry, int index,
   if (child_entry == nullptr) return;
   if (IsEssentialObject(child_obj)) {
     parent_entry->SetNamedReference(HeapGraphEdge::kInternal,
-                                    names_->GetName(index), child_entry);
+                                    names_->GetName(index), child_entry,
+                                    edges_);
   }
   MarkVisitedField(field_offset);
 }
@@ -1677,7 +1883,7 @@ void V8HeapExplorer::SetHiddenReference(HeapObject parent_obj,
   if (child_entry != nullptr && IsEssentialObject(child_obj) &&
       IsEssentialHiddenReference(parent_obj, field_offset)) {
     parent_entry->SetIndexedReference(HeapGraphEdge::kHidden, index,
-                                      child_entry);
+                                      child_entry, edges_);
   }
 }
 
@@ -1688,7 +1894,7 @@ void V8HeapExplorer::SetWeakReference(HeapEntry* parent_entry,
   if (child_entry == nullptr) return;
   if (IsEssentialObject(child_obj)) {
     parent_entry->SetNamedReference(HeapGraphEdge::kWeak, reference_name,
-                                    child_entry);
+                                    child_entry, edges_);
   }
   MarkVisitedField(field_offset);
 }
@@ -1698,8 +1904,9 @@ void V8HeapExplorer::SetWeakReference(HeapEntry* parent_entry, int index,
   HeapEntry* child_entry = GetEntry(child_obj);
   if (child_entry == nullptr) return;
   if (IsEssentialObject(child_obj)) {
-    parent_entry->SetNamedReference(
-        HeapGraphEdge::kWeak, names_->GetFormatted("%d", index), child_entry);
+    parent_entry->SetNamedReference(HeapGraphEdge::kWeak,
+                                    names_->GetFormatted("%d", index),
+                                    child_entry, edges_);
   }
   MarkVisitedField(field_offset);
 }
@@ -1735,7 +1942,7 @@ void V8HeapExplorer::SetPropertyReference(HeapEntry* parent_entry,
                     .get())
           : names_->GetName(reference_name);
 
-  parent_entry->SetNamedReference(type, name, child_entry);
+  parent_entry->SetNamedReference(type, name, child_entry, edges_);
   MarkVisitedField(field_offset);
 }
 
@@ -1805,12 +2012,22 @@ const char* V8HeapExplorer::GetStrongGcSubrootName(Object object) {
 void V8HeapExplorer::TagObject(Object obj, const char* tag) {
   if (IsEssentialObject(obj)) {
     HeapEntry* entry = GetEntry(obj);
-    if (entry->name()[0] == '\0') {
-      entry->set_name(tag);
+    if (entry == nullptr) return;
+    if (tags_ != nullptr) {
+      tags_->emplace_back(entry, tag);
+    } else {
+      SetTag(entry, tag);
     }
   }
 }
 
+// static
+void V8HeapExplorer::SetTag(HeapEntry* entry, const char* tag) {
+  if (entry->name()[0] == '\0') {
+    entry->set_name(tag);
+  }
+}
+
 class GlobalObjectsEnumerator : public RootVisitor {
  public:
   explicit GlobalObjectsEnumerator(Isolate* isolate) : isolate_(isolate) {}
@@ -144,6 +144,15 @@ class HeapEntry {
       HeapGraphEdge::Type type, int index, HeapEntry* entry);
   void SetNamedReference(
       HeapGraphEdge::Type type, const char* name, HeapEntry* entry);
+  // Same as above, but the edge is added to |edges| rather than to the edges
+  // of the snapshot.
+  void SetIndexedReference(HeapGraphEdge::Type type, int index,
+                           HeapEntry* entry, std::deque<HeapGraphEdge>* edges);
+  void SetNamedReference(HeapGraphEdge::Type type, const char* name,
+                         HeapEntry* entry, std::deque<HeapGraphEdge>* edges);
+  // Removes the references that this entry added to the end of |edges| after
+  // it had |size| elements.
+  void RemoveReferencesAfter(size_t size, std::deque<HeapGraphEdge>* edges);
   void SetIndexedAutoIndexReference(HeapGraphEdge::Type type,
                                     HeapEntry* child) {
     SetIndexedReference(type, children_count_ + 1, child);
@@ -356,6 +365,43 @@ class V8_EXPORT_PRIVATE V8HeapExplorer : public HeapEntriesAllocator {
   static String GetConstructorName(JSObject object);
 
  private:
+  class ExtractionJob;
+
+  // The reachable heap objects on one page, as runs [first, second) of
+  // adjacent objects.
+  struct ExtractionChunk {
+    std::vector<std::pair<Address, Address>> runs;
+  };
+
+  // The references of the objects of a chunk, which a worker thread extracts
+  // for the main thread to merge into the snapshot in heap iteration order.
+  struct ExtractedReferences {
+    // An object that is extracted on the main thread while the chunk is
+    // merged, after the edges and tags of the objects preceding it.
+    struct DeferredObject {
+      HeapObject object;
+      size_t edges_end;
+      size_t tags_end;
+    };
+
+    std::deque<HeapGraphEdge> edges;
+    std::vector<std::pair<HeapEntry*, const char*>> tags;
+    std::vector<DeferredObject> deferred;
+  };
+
+  // The number of chunks per worker that are extracted before they are merged.
+  static const size_t kExtractionChunksPerWorker = 4;
+
+  // Creates an explorer that extracts references of chunks on behalf of
+  // |main_explorer| on a worker thread.
+  explicit V8HeapExplorer(V8HeapExplorer* main_explorer);
+
+  bool ExtractReferencesInParallel();
+  void ExtractChunkReferences(const ExtractionChunk& chunk,
+                              ExtractedReferences* result);
+  void MergeChunk(ExtractedReferences* chunk);
+  void ExtractReferencesForObject(HeapEntry* entry, HeapObject obj);
+
   void MarkVisitedField(int offset);
 
   HeapEntry* AddEntry(HeapObject object);
@@ -443,6 +489,7 @@ class V8_EXPORT_PRIVATE V8HeapExplorer : public HeapEntriesAllocator {
                              Object child);
   const char* GetStrongGcSubrootName(Object object);
   void TagObject(Object obj, const char* tag);
+  static void SetTag(HeapEntry* entry, const char* tag);
 
   HeapEntry* GetEntry(Object obj);
 
@@ -463,6 +510,15 @@ class V8_EXPORT_PRIVATE V8HeapExplorer : public HeapEntriesAllocator {
 
   std::vector<bool> visited_fields_;
 
+  // The edges and tags of the extracted objects. Worker explorers point them
+  // at the chunk they are extracting, and tag entries only when it is merged.
+  std::deque<HeapGraphEdge>* edges_;
+  std::vector<std::pair<HeapEntry*, const char*>>* tags_ = nullptr;
+  // Worker explorers only look up entries. Failing to find one sets
+  // missing_entry_, and the object is then extracted on the main thread.
+  const bool is_worker_ = false;
+  bool missing_entry_ = false;
+
   friend class IndexedReferencesExtractor;
   friend class RootsReferencesExtractor;
 };
@@ -4,6 +4,7 @@
 
 #include "src/api/api-inl.h"
 #include "src/base/platform/mutex.h"
+#include "src/baseline/baseline-batch-compiler.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/codegen/compiler.h"
 #include "src/codegen/pending-optimization-table.h"
@@ -342,6 +343,39 @@ RUNTIME_FUNCTION(Runtime_CompileBaseline) {
   return *function;
 }
 
+RUNTIME_FUNCTION(Runtime_EnqueueForBaselineBatchCompilation) {
+  HandleScope scope(isolate);
+  if (args.length() != 1 || !args[0].IsJSFunction() ||
+      !FLAG_baseline_batch_compilation) {
+    return CrashUnlessFuzzing(isolate);
+  }
+  CONVERT_ARG_HANDLE_CHECKED(JSFunction, function, 0);
+  if (!function->shared(isolate).IsUserJavaScript() ||
+      !EnsureFeedbackVector(isolate, function)) {
+    return CrashUnlessFuzzing(isolate);
+  }
+  isolate->baseline_batch_compiler()->EnqueueFunction(function);
+  return ReadOnlyRoots(isolate).undefined_value();
+}
+
+RUNTIME_FUNCTION(Runtime_CompileBaselineBatch) {
+  HandleScope scope(isolate);
+  if (args.length() != 0 || !FLAG_baseline_batch_compilation) {
+    return CrashUnlessFuzzing(isolate);
+  }
+  isolate->baseline_batch_compiler()->CompileBatchForTesting();
+  return ReadOnlyRoots(isolate).undefined_value();
+}
+
+RUNTIME_FUNCTION(Runtime_FinalizeBaselineBatchCompilation) {
+  HandleScope scope(isolate);
+  if (args.length() != 0 || !FLAG_baseline_batch_compilation) {
+    return CrashUnlessFuzzing(isolate);
+  }
+  isolate->baseline_batch_compiler()->AwaitAndInstallBatchesForTesting();
+  return ReadOnlyRoots(isolate).undefined_value();
+}
+
 RUNTIME_FUNCTION(Runtime_OptimizeFunctionOnNextCall) {
   HandleScope scope(isolate);
   return OptimizeFunctionOnNextCall(args, isolate, TierupKind::kTierupBytecode);
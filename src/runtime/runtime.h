@@ -467,6 +467,7 @@ namespace internal {
   F(ArraySpeciesProtector, 0, 1)               \
   F(ClearFunctionFeedback, 1, 1)               \
   F(ClearMegamorphicStubCache, 0, 1)           \
+  F(CompileBaselineBatch, 0, 1)                \
   F(CompleteInobjectSlackTracking, 1, 1)       \
   F(ConstructConsString, 2, 1)                 \
   F(ConstructDouble, 2, 1)                     \
@@ -482,7 +483,9 @@ namespace internal {
   F(IsTopTierTurboprop, 0, 1)                  \
   F(IsMidTierTurboprop, 0, 1)                  \
   F(EnableCodeLoggingForTesting, 0, 1)         \
+  F(EnqueueForBaselineBatchCompilation, 1, 1)  \
   F(EnsureFeedbackVectorForFunction, 1, 1)     \
+  F(FinalizeBaselineBatchCompilation, 0, 1)    \
   F(GetCallable, 0, 1)                         \
   F(GetInitializerFunction, 1, 1)              \
   F(GetOptimizationStatus, -1, 1)              \
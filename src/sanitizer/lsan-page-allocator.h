@@ -48,6 +48,10 @@ class LsanPageAllocator : public v8::PageAllocator {
     return page_allocator_->SetPermissions(address, size, access);
   }
 
+  bool SetNoAccessWithoutDiscarding(void* address, size_t size) override {
+    return page_allocator_->SetNoAccessWithoutDiscarding(address, size);
+  }
+
  private:
   v8::PageAllocator* const page_allocator_;
   const size_t allocate_page_size_;
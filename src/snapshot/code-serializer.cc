@@ -8,8 +8,11 @@
 #include "src/codegen/macro-assembler.h"
 #include "src/common/globals.h"
 #include "src/debug/debug.h"
+#include "src/handles/persistent-handles.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/local-factory-inl.h"
+#include "src/heap/local-heap-inl.h"
+#include "src/heap/parked-scope.h"
 #include "src/logging/counters.h"
 #include "src/logging/log.h"
 #include "src/objects/objects-inl.h"
@@ -264,37 +267,135 @@ void CreateInterpreterDataForDeserializedCode(Isolate* isolate,
 #endif  // V8_TARGET_ARCH_ARM
 
 namespace {
+
+void FinalizeDeserialization(Isolate* isolate,
+                             Handle<SharedFunctionInfo> result,
+                             const base::ElapsedTimer& timer) {
+  const bool log_code_creation =
+      isolate->logger()->is_listening_to_code_events() ||
+      isolate->is_profiling() ||
+      isolate->code_event_dispatcher()->IsListeningToCodeEvents();
+
+#ifndef V8_TARGET_ARCH_ARM
+  if (V8_UNLIKELY(FLAG_interpreted_frames_native_stack))
+    CreateInterpreterDataForDeserializedCode(isolate, result,
+                                             log_code_creation);
+#endif  // V8_TARGET_ARCH_ARM
+
+  bool needs_source_positions = isolate->NeedsSourcePositionsForProfiling();
+
+  if (log_code_creation || FLAG_log_function_events) {
+    Handle<Script> script(Script::cast(result->script()), isolate);
+    Handle<String> name(script->name().IsString()
+                            ? String::cast(script->name())
+                            : ReadOnlyRoots(isolate).empty_string(),
+                        isolate);
+
+    if (FLAG_log_function_events) {
+      LOG(isolate,
+          FunctionEvent("deserialize", script->id(),
+                        timer.Elapsed().InMillisecondsF(),
+                        result->StartPosition(), result->EndPosition(), *name));
+    }
+    if (log_code_creation) {
+      Script::InitLineEnds(isolate, script);
+
+      SharedFunctionInfo::ScriptIterator iter(isolate, *script);
+      for (SharedFunctionInfo info = iter.Next(); !info.is_null();
+           info = iter.Next()) {
+        if (info.is_compiled()) {
+          Handle<SharedFunctionInfo> shared_info(info, isolate);
+          if (needs_source_positions) {
+            SharedFunctionInfo::EnsureSourcePositionsAvailable(isolate,
+                                                               shared_info);
+          }
+          DisallowGarbageCollection no_gc;
+          int line_num =
+              script->GetLineNumber(shared_info->StartPosition()) + 1;
+          int column_num =
+              script->GetColumnNumber(shared_info->StartPosition()) + 1;
+          PROFILE(
+              isolate,
+              CodeCreateEvent(
+                  shared_info->is_toplevel() ? CodeEventListener::SCRIPT_TAG
+                                             : CodeEventListener::FUNCTION_TAG,
+                  handle(shared_info->abstract_code(isolate), isolate),
+                  shared_info, name, line_num, column_num));
+        }
+      }
+    }
+  }
+
+  if (needs_source_positions) {
+    Handle<Script> script(Script::cast(result->script()), isolate);
+    Script::InitLineEnds(isolate, script);
+  }
+}
+
 class StressOffThreadDeserializeThread final : public base::Thread {
  public:
   explicit StressOffThreadDeserializeThread(Isolate* isolate,
-                                            const SerializedCodeData* scd)
+                                            ScriptData* cached_data)
       : Thread(
             base::Thread::Options("StressOffThreadDeserializeThread", 2 * MB)),
         isolate_(isolate),
-        scd_(scd) {}
-
-  MaybeHandle<SharedFunctionInfo> maybe_result() const { return maybe_result_; }
+        cached_data_(cached_data) {}
 
   void Run() final {
     LocalIsolate local_isolate(isolate_, ThreadKind::kBackground);
-    MaybeHandle<SharedFunctionInfo> local_maybe_result =
-        ObjectDeserializer::DeserializeSharedFunctionInfoOffThread(
-            &local_isolate, scd_, local_isolate.factory()->empty_string());
+    UnparkedScope unparked_scope(&local_isolate);
+    LocalHandleScope handle_scope(&local_isolate);
+    off_thread_data_ =
+        CodeSerializer::StartDeserializeOffThread(&local_isolate, cached_data_);
+  }
 
-    maybe_result_ =
-        local_isolate.heap()->NewPersistentMaybeHandle(local_maybe_result);
+  MaybeHandle<SharedFunctionInfo> Finalize(Isolate* isolate,
+                                           Handle<String> source,
+                                           ScriptOriginOptions origin_options) {
+    return CodeSerializer::FinishOffThreadDeserialize(
+        isolate, std::move(off_thread_data_), cached_data_, source,
+        origin_options);
   }
 
  private:
   Isolate* isolate_;
-  const SerializedCodeData* scd_;
-  MaybeHandle<SharedFunctionInfo> maybe_result_;
+  ScriptData* cached_data_;
+  CodeSerializer::OffThreadDeserializeData off_thread_data_;
 };
+
+MaybeHandle<SharedFunctionInfo> DeserializeOnBackgroundThread(
+    Isolate* isolate, ScriptData* cached_data, Handle<String> source,
+    ScriptOriginOptions origin_options) {
+  StressOffThreadDeserializeThread thread(isolate, cached_data);
+  CHECK(thread.Start());
+  {
+    // The background thread may have to wait for a GC, which needs the main
+    // thread to be parked.
+    ParkedScope parked_scope(isolate->main_thread_local_isolate());
+    thread.Join();
+  }
+  return thread.Finalize(isolate, source, origin_options);
+}
+
 }  // namespace
 
+CodeSerializer::OffThreadDeserializeData::OffThreadDeserializeData() = default;
+CodeSerializer::OffThreadDeserializeData::~OffThreadDeserializeData() =
+    default;
+CodeSerializer::OffThreadDeserializeData::OffThreadDeserializeData(
+    OffThreadDeserializeData&&) V8_NOEXCEPT = default;
+CodeSerializer::OffThreadDeserializeData&
+CodeSerializer::OffThreadDeserializeData::operator=(OffThreadDeserializeData&&)
+    V8_NOEXCEPT = default;
+
 MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
     Isolate* isolate, ScriptData* cached_data, Handle<String> source,
     ScriptOriginOptions origin_options) {
+  if (FLAG_stress_background_compile) {
+    return DeserializeOnBackgroundThread(isolate, cached_data, source,
+                                         origin_options);
+  }
+
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization || FLAG_log_function_events) timer.Start();
 
@@ -303,7 +404,8 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
   SerializedCodeData::SanityCheckResult sanity_check_result =
       SerializedCodeData::CHECK_SUCCESS;
   const SerializedCodeData scd = SerializedCodeData::FromCachedData(
-      cached_data, SerializedCodeData::SourceHash(source, origin_options),
+      isolate, cached_data,
+      SerializedCodeData::SourceHash(source, origin_options),
       &sanity_check_result);
   if (sanity_check_result != SerializedCodeData::CHECK_SUCCESS) {
     if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
@@ -314,24 +416,8 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
   }
 
   // Deserialize.
-  MaybeHandle<SharedFunctionInfo> maybe_result;
-  // TODO(leszeks): Add LocalHeap support to deserializer
-  if (false && FLAG_stress_background_compile) {
-    StressOffThreadDeserializeThread thread(isolate, &scd);
-    CHECK(thread.Start());
-    thread.Join();
-
-    maybe_result = thread.maybe_result();
-
-    // Fix-up result script source.
-    Handle<SharedFunctionInfo> result;
-    if (maybe_result.ToHandle(&result)) {
-      Script::cast(result->script()).set_source(*source);
-    }
-  } else {
-    maybe_result = ObjectDeserializer::DeserializeSharedFunctionInfo(
-        isolate, &scd, source);
-  }
+  MaybeHandle<SharedFunctionInfo> maybe_result =
+      ObjectDeserializer::DeserializeSharedFunctionInfo(isolate, &scd, source);
 
   Handle<SharedFunctionInfo> result;
   if (!maybe_result.ToHandle(&result)) {
@@ -346,65 +432,99 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
     PrintF("[Deserializing from %d bytes took %0.3f ms]\n", length, ms);
   }
 
-  const bool log_code_creation =
-      isolate->logger()->is_listening_to_code_events() ||
-      isolate->is_profiling() ||
-      isolate->code_event_dispatcher()->IsListeningToCodeEvents();
+  FinalizeDeserialization(isolate, result, timer);
+  return scope.CloseAndEscape(result);
+}
 
-#ifndef V8_TARGET_ARCH_ARM
-  if (V8_UNLIKELY(FLAG_interpreted_frames_native_stack))
-    CreateInterpreterDataForDeserializedCode(isolate, result,
-                                             log_code_creation);
-#endif  // V8_TARGET_ARCH_ARM
+// static
+CodeSerializer::OffThreadDeserializeData
+CodeSerializer::StartDeserializeOffThread(LocalIsolate* local_isolate,
+                                          ScriptData* cached_data) {
+  OffThreadDeserializeData result;
+
+  const SerializedCodeData scd =
+      SerializedCodeData::FromCachedDataWithoutSource(
+          cached_data, &result.sanity_check_result);
+  if (result.sanity_check_result != SerializedCodeData::CHECK_SUCCESS) {
+    // The source hash has not been checked yet, but the data is rejected
+    // anyway.
+    DCHECK(cached_data->rejected());
+    return result;
+  }
 
-  bool needs_source_positions = isolate->NeedsSourcePositionsForProfiling();
+  MaybeHandle<SharedFunctionInfo> local_maybe_result =
+      OffThreadObjectDeserializer::DeserializeSharedFunctionInfo(
+          local_isolate, &scd, &result.scripts, &result.objects_to_rehash);
 
-  if (log_code_creation || FLAG_log_function_events) {
-    Handle<Script> script(Script::cast(result->script()), isolate);
-    Handle<String> name(script->name().IsString()
-                            ? String::cast(script->name())
-                            : ReadOnlyRoots(isolate).empty_string(),
-                        isolate);
+  result.maybe_result =
+      local_isolate->heap()->NewPersistentMaybeHandle(local_maybe_result);
+  result.persistent_handles = local_isolate->heap()->DetachPersistentHandles();
 
-    if (FLAG_log_function_events) {
-      LOG(isolate,
-          FunctionEvent("deserialize", script->id(),
-                        timer.Elapsed().InMillisecondsF(),
-                        result->StartPosition(), result->EndPosition(), *name));
-    }
-    if (log_code_creation) {
-      Script::InitLineEnds(isolate, script);
+  return result;
+}
 
-      SharedFunctionInfo::ScriptIterator iter(isolate, *script);
-      for (SharedFunctionInfo info = iter.Next(); !info.is_null();
-           info = iter.Next()) {
-        if (info.is_compiled()) {
-          Handle<SharedFunctionInfo> shared_info(info, isolate);
-          if (needs_source_positions) {
-            SharedFunctionInfo::EnsureSourcePositionsAvailable(isolate,
-                                                               shared_info);
-          }
-          DisallowGarbageCollection no_gc;
-          int line_num =
-              script->GetLineNumber(shared_info->StartPosition()) + 1;
-          int column_num =
-              script->GetColumnNumber(shared_info->StartPosition()) + 1;
-          PROFILE(
-              isolate,
-              CodeCreateEvent(
-                  shared_info->is_toplevel() ? CodeEventListener::SCRIPT_TAG
-                                             : CodeEventListener::FUNCTION_TAG,
-                  handle(shared_info->abstract_code(isolate), isolate),
-                  shared_info, name, line_num, column_num));
-        }
-      }
+// static
+MaybeHandle<SharedFunctionInfo> CodeSerializer::FinishOffThreadDeserialize(
+    Isolate* isolate, OffThreadDeserializeData&& data, ScriptData* cached_data,
+    Handle<String> source, ScriptOriginOptions origin_options) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization || FLAG_log_function_events) timer.Start();
+
+  HandleScope scope(isolate);
+
+  // The source hash can only be checked now that the source is available.
+  SerializedCodeData::SanityCheckResult sanity_check_result =
+      data.sanity_check_result;
+  SerializedCodeData::FromPartiallySanityCheckedCachedData(
+      cached_data, SerializedCodeData::SourceHash(source, origin_options),
+      &sanity_check_result);
+  if (sanity_check_result != SerializedCodeData::CHECK_SUCCESS) {
+    if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
+    DCHECK(cached_data->rejected());
+    isolate->counters()->code_cache_reject_reason()->AddSample(
+        sanity_check_result);
+    return MaybeHandle<SharedFunctionInfo>();
+  }
+
+  Handle<SharedFunctionInfo> result;
+  if (!data.maybe_result.ToHandle(&result)) {
+    if (FLAG_profile_deserialization) PrintF("[Deserializing failed]\n");
+    return MaybeHandle<SharedFunctionInfo>();
+  }
+  // Move the result out of the persistent handles, which die with {data}.
+  result = handle(*result, isolate);
+
+  // Rehashing may allocate, so it was deferred to the main thread. The
+  // objects are not reachable from JavaScript yet.
+  for (Handle<HeapObject> object : data.objects_to_rehash) {
+    object->RehashBasedOnMap(isolate);
+  }
+
+  // The scripts were deserialized with the empty string as a placeholder for
+  // the source, and with the ids they had when they were serialized.
+  Handle<WeakArrayList> list = isolate->factory()->script_list();
+  for (Handle<Script> script : data.scripts) {
+    if (script->source() == ReadOnlyRoots(isolate).empty_string()) {
+      script->set_source(*source);
     }
+    // Assign a new script id to avoid collision.
+    script->set_id(isolate->GetNextScriptId());
+    LOG(isolate,
+        ScriptEvent(Logger::ScriptEventType::kDeserialize, script->id()));
+    LOG(isolate, ScriptDetails(*script));
+    list = WeakArrayList::AddToEnd(isolate, list,
+                                   MaybeObjectHandle::Weak(script));
   }
+  isolate->heap()->SetRootScriptList(*list);
 
-  if (needs_source_positions) {
-    Handle<Script> script(Script::cast(result->script()), isolate);
-    Script::InitLineEnds(isolate, script);
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int length = cached_data->length();
+    PrintF("[Finishing off-thread deserialize from %d bytes took %0.3f ms]\n",
+           length, ms);
   }
+
+  FinalizeDeserialization(isolate, result, timer);
   return scope.CloseAndEscape(result);
 }
 
@@ -440,17 +560,34 @@ SerializedCodeData::SerializedCodeData(const std::vector<byte>* payload,
 }
 
 SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
+    Isolate* isolate, uint32_t expected_source_hash) const {
+  SanityCheckResult result;
+  {
+    HistogramTimerScope timer(
+        isolate->counters()->compile_deserialize_checksum());
+    result = SanityCheckWithoutSource();
+  }
+  if (result != CHECK_SUCCESS) return result;
+  return SanityCheckJustSource(expected_source_hash);
+}
+
+SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheckJustSource(
     uint32_t expected_source_hash) const {
+  uint32_t source_hash = GetHeaderValue(kSourceHashOffset);
+  if (source_hash != expected_source_hash) return SOURCE_MISMATCH;
+  return CHECK_SUCCESS;
+}
+
+SerializedCodeData::SanityCheckResult
+SerializedCodeData::SanityCheckWithoutSource() const {
   if (this->size_ < kHeaderSize) return INVALID_HEADER;
   uint32_t magic_number = GetMagicNumber();
   if (magic_number != kMagicNumber) return MAGIC_NUMBER_MISMATCH;
   uint32_t version_hash = GetHeaderValue(kVersionHashOffset);
-  uint32_t source_hash = GetHeaderValue(kSourceHashOffset);
   uint32_t flags_hash = GetHeaderValue(kFlagHashOffset);
   uint32_t payload_length = GetHeaderValue(kPayloadLengthOffset);
   uint32_t c = GetHeaderValue(kChecksumOffset);
   if (version_hash != Version::Hash()) return VERSION_MISMATCH;
-  if (source_hash != expected_source_hash) return SOURCE_MISMATCH;
   if (flags_hash != FlagList::Hash()) return FLAGS_MISMATCH;
   uint32_t max_payload_length = this->size_ - kHeaderSize;
   if (payload_length > max_payload_length) return LENGTH_MISMATCH;
@@ -491,11 +628,42 @@ SerializedCodeData::SerializedCodeData(ScriptData* data)
     : SerializedData(const_cast<byte*>(data->data()), data->length()) {}
 
 SerializedCodeData SerializedCodeData::FromCachedData(
+    Isolate* isolate, ScriptData* cached_data, uint32_t expected_source_hash,
+    SanityCheckResult* rejection_result) {
+  DisallowGarbageCollection no_gc;
+  SerializedCodeData scd(cached_data);
+  *rejection_result = scd.SanityCheck(isolate, expected_source_hash);
+  if (*rejection_result != CHECK_SUCCESS) {
+    cached_data->Reject();
+    return SerializedCodeData(nullptr, 0);
+  }
+  return scd;
+}
+
+SerializedCodeData SerializedCodeData::FromCachedDataWithoutSource(
+    ScriptData* cached_data, SanityCheckResult* rejection_result) {
+  DisallowGarbageCollection no_gc;
+  SerializedCodeData scd(cached_data);
+  *rejection_result = scd.SanityCheckWithoutSource();
+  if (*rejection_result != CHECK_SUCCESS) {
+    cached_data->Reject();
+    return SerializedCodeData(nullptr, 0);
+  }
+  return scd;
+}
+
+SerializedCodeData SerializedCodeData::FromPartiallySanityCheckedCachedData(
     ScriptData* cached_data, uint32_t expected_source_hash,
     SanityCheckResult* rejection_result) {
   DisallowGarbageCollection no_gc;
+  // {rejection_result} holds the result of FromCachedDataWithoutSource, which
+  // may already have rejected the data.
+  if (*rejection_result != CHECK_SUCCESS) {
+    DCHECK(cached_data->rejected());
+    return SerializedCodeData(nullptr, 0);
+  }
   SerializedCodeData scd(cached_data);
-  *rejection_result = scd.SanityCheck(expected_source_hash);
+  *rejection_result = scd.SanityCheckJustSource(expected_source_hash);
   if (*rejection_result != CHECK_SUCCESS) {
     cached_data->Reject();
     return SerializedCodeData(nullptr, 0);
@@ -5,6 +5,9 @@
 #ifndef V8_SNAPSHOT_CODE_SERIALIZER_H_
 #define V8_SNAPSHOT_CODE_SERIALIZER_H_
 
+#include <memory>
+#include <vector>
+
 #include "src/base/macros.h"
 #include "src/snapshot/serializer.h"
 #include "src/snapshot/snapshot-data.h"
@@ -12,6 +15,9 @@
 namespace v8 {
 namespace internal {
 
+class CodeSerializer;
+class PersistentHandles;
+
 class V8_EXPORT_PRIVATE ScriptData {
  public:
   ScriptData(const byte* data, int length);
@@ -44,37 +50,6 @@ class V8_EXPORT_PRIVATE ScriptData {
   int length_;
 };
 
-class CodeSerializer : public Serializer {
- public:
-  CodeSerializer(const CodeSerializer&) = delete;
-  CodeSerializer& operator=(const CodeSerializer&) = delete;
-  V8_EXPORT_PRIVATE static ScriptCompiler::CachedData* Serialize(
-      Handle<SharedFunctionInfo> info);
-
-  ScriptData* SerializeSharedFunctionInfo(Handle<SharedFunctionInfo> info);
-
-  V8_WARN_UNUSED_RESULT static MaybeHandle<SharedFunctionInfo> Deserialize(
-      Isolate* isolate, ScriptData* cached_data, Handle<String> source,
-      ScriptOriginOptions origin_options);
-
-  uint32_t source_hash() const { return source_hash_; }
-
- protected:
-  CodeSerializer(Isolate* isolate, uint32_t source_hash);
-  ~CodeSerializer() override { OutputStatistics("CodeSerializer"); }
-
-  virtual bool ElideObject(Object obj) { return false; }
-  void SerializeGeneric(Handle<HeapObject> heap_object);
-
- private:
-  void SerializeObjectImpl(Handle<HeapObject> o) override;
-
-  bool SerializeReadOnlyObject(Handle<HeapObject> obj);
-
-  DISALLOW_GARBAGE_COLLECTION(no_gc_)
-  uint32_t source_hash_;
-};
-
 // Wrapper around ScriptData to provide code-serializer-specific functionality.
 class SerializedCodeData : public SerializedData {
  public:
@@ -106,9 +81,18 @@ class SerializedCodeData : public SerializedData {
   static const uint32_t kHeaderSize = POINTER_SIZE_ALIGN(kUnalignedHeaderSize);
 
   // Used when consuming.
-  static SerializedCodeData FromCachedData(ScriptData* cached_data,
+  static SerializedCodeData FromCachedData(Isolate* isolate,
+                                           ScriptData* cached_data,
                                            uint32_t expected_source_hash,
                                            SanityCheckResult* rejection_result);
+  // For deserializing off-thread, where the source is not available: checks
+  // everything but the source hash, which is checked on the main thread with
+  // FromPartiallySanityCheckedCachedData.
+  static SerializedCodeData FromCachedDataWithoutSource(
+      ScriptData* cached_data, SanityCheckResult* rejection_result);
+  static SerializedCodeData FromPartiallySanityCheckedCachedData(
+      ScriptData* cached_data, uint32_t expected_source_hash,
+      SanityCheckResult* rejection_result);
 
   // Used when producing.
   SerializedCodeData(const std::vector<byte>* payload,
@@ -131,7 +115,71 @@ class SerializedCodeData : public SerializedData {
     return Vector<const byte>(data_ + kHeaderSize, size_ - kHeaderSize);
   }
 
-  SanityCheckResult SanityCheck(uint32_t expected_source_hash) const;
+  SanityCheckResult SanityCheck(Isolate* isolate,
+                                uint32_t expected_source_hash) const;
+  SanityCheckResult SanityCheckJustSource(uint32_t expected_source_hash) const;
+  SanityCheckResult SanityCheckWithoutSource() const;
+};
+
+class CodeSerializer : public Serializer {
+ public:
+  // The result of the off-thread part of deserializing a code cache. The
+  // handles are owned by {persistent_handles}.
+  struct OffThreadDeserializeData {
+    MaybeHandle<SharedFunctionInfo> maybe_result;
+    std::vector<Handle<Script>> scripts;
+    std::vector<Handle<HeapObject>> objects_to_rehash;
+    std::unique_ptr<PersistentHandles> persistent_handles;
+    SerializedCodeData::SanityCheckResult sanity_check_result =
+        SerializedCodeData::CHECK_SUCCESS;
+
+    OffThreadDeserializeData();
+    ~OffThreadDeserializeData();
+    OffThreadDeserializeData(OffThreadDeserializeData&&) V8_NOEXCEPT;
+    OffThreadDeserializeData& operator=(OffThreadDeserializeData&&)
+        V8_NOEXCEPT;
+  };
+
+  CodeSerializer(const CodeSerializer&) = delete;
+  CodeSerializer& operator=(const CodeSerializer&) = delete;
+  V8_EXPORT_PRIVATE static ScriptCompiler::CachedData* Serialize(
+      Handle<SharedFunctionInfo> info);
+
+  ScriptData* SerializeSharedFunctionInfo(Handle<SharedFunctionInfo> info);
+
+  V8_WARN_UNUSED_RESULT static MaybeHandle<SharedFunctionInfo> Deserialize(
+      Isolate* isolate, ScriptData* cached_data, Handle<String> source,
+      ScriptOriginOptions origin_options);
+
+  // Deserializes {cached_data} into the LocalHeap of {local_isolate}, which
+  // may belong to a background thread. The result has to be passed to
+  // FinishOffThreadDeserialize on the main thread before it can be used.
+  // {cached_data} must stay alive until then.
+  V8_EXPORT_PRIVATE static OffThreadDeserializeData StartDeserializeOffThread(
+      LocalIsolate* local_isolate, ScriptData* cached_data);
+
+  V8_EXPORT_PRIVATE V8_WARN_UNUSED_RESULT static MaybeHandle<
+      SharedFunctionInfo>
+  FinishOffThreadDeserialize(Isolate* isolate, OffThreadDeserializeData&& data,
+                             ScriptData* cached_data, Handle<String> source,
+                             ScriptOriginOptions origin_options);
+
+  uint32_t source_hash() const { return source_hash_; }
+
+ protected:
+  CodeSerializer(Isolate* isolate, uint32_t source_hash);
+  ~CodeSerializer() override { OutputStatistics("CodeSerializer"); }
+
+  virtual bool ElideObject(Object obj) { return false; }
+  void SerializeGeneric(Handle<HeapObject> heap_object);
+
+ private:
+  void SerializeObjectImpl(Handle<HeapObject> o) override;
+
+  bool SerializeReadOnlyObject(Handle<HeapObject> obj);
+
+  DISALLOW_GARBAGE_COLLECTION(no_gc_)
+  uint32_t source_hash_;
 };
 
 }  // namespace internal
@@ -11,9 +11,11 @@
 #include "src/common/external-pointer.h"
 #include "src/common/globals.h"
 #include "src/execution/isolate.h"
+#include "src/execution/local-isolate-inl.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap-write-barrier-inl.h"
 #include "src/heap/heap-write-barrier.h"
+#include "src/heap/local-heap-inl.h"
 #include "src/heap/read-only-heap.h"
 #include "src/interpreter/interpreter.h"
 #include "src/logging/log.h"
@@ -28,6 +30,7 @@
 #include "src/objects/objects.h"
 #include "src/objects/slots.h"
 #include "src/objects/smi.h"
+#include "src/objects/string-inl.h"
 #include "src/objects/string.h"
 #include "src/roots/roots.h"
 #include "src/snapshot/embedded/embedded-data.h"
@@ -150,9 +153,10 @@ class SlotAccessorForRootSlots {
 
 // A SlotAccessor for creating a Handle, which saves a Handle allocation when
 // a Handle already exists.
+template <typename IsolateT>
 class SlotAccessorForHandle {
  public:
-  SlotAccessorForHandle(Handle<HeapObject>* handle, Isolate* isolate)
+  SlotAccessorForHandle(Handle<HeapObject>* handle, IsolateT* isolate)
       : handle_(handle), isolate_(isolate) {}
 
   MaybeObjectSlot slot() const { UNREACHABLE(); }
@@ -186,36 +190,91 @@ class SlotAccessorForHandle {
 
  private:
   Handle<HeapObject>* handle_;
-  Isolate* isolate_;
+  IsolateT* isolate_;
 };
 
+namespace {
+
+// Helpers for the operations that differ between deserializing on the main
+// thread and deserializing into a LocalHeap on a background thread.
+
+Isolate* GetMainThreadIsolate(Isolate* isolate) { return isolate; }
+Isolate* GetMainThreadIsolate(LocalIsolate* isolate) {
+  return isolate->GetMainThreadIsolateUnsafe();
+}
+
+HeapObject AllocateRaw(Isolate* isolate, int size, AllocationType type,
+                       AllocationAlignment alignment) {
+  return isolate->heap()->AllocateRawWith<Heap::kRetryOrFail>(
+      size, type, AllocationOrigin::kRuntime, alignment);
+}
+HeapObject AllocateRaw(LocalIsolate* isolate, int size, AllocationType type,
+                       AllocationAlignment alignment) {
+  // Background threads can only allocate in old space; code caches contain
+  // neither code objects nor maps.
+  CHECK_EQ(type, AllocationType::kOld);
+  return HeapObject::FromAddress(isolate->heap()->AllocateRawOrFail(
+      size, type, AllocationOrigin::kRuntime, alignment));
+}
+
+void RehashBasedOnMap(Isolate* isolate, Handle<HeapObject> object) {
+  object->RehashBasedOnMap(isolate);
+}
+void RehashBasedOnMap(LocalIsolate* isolate, Handle<HeapObject> object) {
+  // Rehashing can allocate on the main thread heap, so it is left to the main
+  // thread (see OffThreadObjectDeserializer).
+  UNREACHABLE();
+}
+
+void MakeThin(Isolate* isolate, Handle<String> string, String internalized) {
+  string->MakeThin(isolate, internalized);
+}
+void MakeThin(LocalIsolate* isolate, Handle<String> string,
+              String internalized) {
+  // The deserialized string is not reachable from anywhere but the
+  // deserializer, which is patched to use {internalized} instead, so it is
+  // simply left to die.
+}
+
+}  // namespace
+
+template <typename IsolateT>
+Isolate* Deserializer<IsolateT>::main_thread_isolate() const {
+  return GetMainThreadIsolate(isolate_);
+}
+
+template <typename IsolateT>
 template <typename TSlot>
-int Deserializer::WriteAddress(TSlot dest, Address value) {
+int Deserializer<IsolateT>::WriteAddress(TSlot dest, Address value) {
   DCHECK(!next_reference_is_weak_);
   base::Memcpy(dest.ToVoidPtr(), &value, kSystemPointerSize);
   STATIC_ASSERT(IsAligned(kSystemPointerSize, TSlot::kSlotDataSize));
   return (kSystemPointerSize / TSlot::kSlotDataSize);
 }
 
+template <typename IsolateT>
 template <typename TSlot>
-int Deserializer::WriteExternalPointer(TSlot dest, Address value,
-                                       ExternalPointerTag tag) {
+int Deserializer<IsolateT>::WriteExternalPointer(TSlot dest, Address value,
+                                                 ExternalPointerTag tag) {
   DCHECK(!next_reference_is_weak_);
-  InitExternalPointerField(dest.address(), isolate(), value, tag);
+  InitExternalPointerField(dest.address(), main_thread_isolate(), value, tag);
   STATIC_ASSERT(IsAligned(kExternalPointerSize, TSlot::kSlotDataSize));
   return (kExternalPointerSize / TSlot::kSlotDataSize);
 }
 
-Deserializer::Deserializer(Isolate* isolate, Vector<const byte> payload,
-                           uint32_t magic_number, bool deserializing_user_code,
-                           bool can_rehash)
+template <typename IsolateT>
+Deserializer<IsolateT>::Deserializer(IsolateT* isolate,
+                                     Vector<const byte> payload,
+                                     uint32_t magic_number,
+                                     bool deserializing_user_code,
+                                     bool can_rehash)
     : isolate_(isolate),
       source_(payload),
       magic_number_(magic_number),
       deserializing_user_code_(deserializing_user_code),
       can_rehash_(can_rehash) {
   DCHECK_NOT_NULL(isolate);
-  isolate_->RegisterDeserializerStarted();
+  main_thread_isolate()->RegisterDeserializerStarted();
 
   // We start the indices here at 1, so that we can distinguish between an
   // actual index and a nullptr (serialized as kNullRefSentinel) in a
@@ -225,13 +284,17 @@ Deserializer::Deserializer(Isolate* isolate, Vector<const byte> payload,
 
 #ifdef DEBUG
   num_api_references_ = 0;
+  Isolate* main_isolate = main_thread_isolate();
   // The read-only deserializer is run by read-only heap set-up before the
   // heap is fully set up. External reference table relies on a few parts of
   // this set-up (like old-space), so it may be uninitialized at this point.
-  if (isolate->isolate_data()->external_reference_table()->is_initialized()) {
+  if (main_isolate->isolate_data()
+          ->external_reference_table()
+          ->is_initialized()) {
     // Count the number of external references registered through the API.
-    if (isolate->api_external_references() != nullptr) {
-      while (isolate->api_external_references()[num_api_references_] != 0) {
+    if (main_isolate->api_external_references() != nullptr) {
+      while (main_isolate->api_external_references()[num_api_references_] !=
+             0) {
         num_api_references_++;
       }
     }
@@ -240,14 +303,16 @@ Deserializer::Deserializer(Isolate* isolate, Vector<const byte> payload,
   CHECK_EQ(magic_number_, SerializedData::kMagicNumber);
 }
 
-void Deserializer::Rehash() {
+template <typename IsolateT>
+void Deserializer<IsolateT>::Rehash() {
   DCHECK(can_rehash() || deserializing_user_code());
   for (Handle<HeapObject> item : to_rehash_) {
-    item->RehashBasedOnMap(isolate());
+    RehashBasedOnMap(isolate(), item);
   }
 }
 
-Deserializer::~Deserializer() {
+template <typename IsolateT>
+Deserializer<IsolateT>::~Deserializer() {
 #ifdef DEBUG
   // Do not perform checks if we aborted deserialization.
   if (source_.position() == 0) return;
@@ -257,38 +322,46 @@ Deserializer::~Deserializer() {
   DCHECK_EQ(num_unresolved_forward_refs_, 0);
   DCHECK(unresolved_forward_refs_.empty());
 #endif  // DEBUG
-  isolate_->RegisterDeserializerFinished();
+  main_thread_isolate()->RegisterDeserializerFinished();
 }
 
 // This is called on the roots.  It is the driver of the deserialization
 // process.  It is also called on the body of each function.
-void Deserializer::VisitRootPointers(Root root, const char* description,
-                                     FullObjectSlot start, FullObjectSlot end) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::VisitRootPointers(Root root,
+                                               const char* description,
+                                               FullObjectSlot start,
+                                               FullObjectSlot end) {
   ReadData(FullMaybeObjectSlot(start), FullMaybeObjectSlot(end));
 }
 
-void Deserializer::Synchronize(VisitorSynchronization::SyncTag tag) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::Synchronize(VisitorSynchronization::SyncTag tag) {
   static const byte expected = kSynchronize;
   CHECK_EQ(expected, source_.Get());
 }
 
-void Deserializer::DeserializeDeferredObjects() {
+template <typename IsolateT>
+void Deserializer<IsolateT>::DeserializeDeferredObjects() {
   for (int code = source_.Get(); code != kSynchronize; code = source_.Get()) {
     SnapshotSpace space = NewObject::Decode(code);
     ReadObject(space);
   }
 }
 
-void Deserializer::LogNewMapEvents() {
+template <typename IsolateT>
+void Deserializer<IsolateT>::LogNewMapEvents() {
   DisallowGarbageCollection no_gc;
+  // Maps are only deserialized on the main thread.
   for (Handle<Map> map : new_maps_) {
     DCHECK(FLAG_log_maps);
-    LOG(isolate(), MapCreate(*map));
-    LOG(isolate(), MapDetails(*map));
+    LOG(main_thread_isolate(), MapCreate(*map));
+    LOG(main_thread_isolate(), MapDetails(*map));
   }
 }
 
-void Deserializer::WeakenDescriptorArrays() {
+template <typename IsolateT>
+void Deserializer<IsolateT>::WeakenDescriptorArrays() {
   DisallowGarbageCollection no_gc;
   for (Handle<DescriptorArray> descriptor_array : new_descriptor_arrays_) {
     DCHECK(descriptor_array->IsStrongDescriptorArray());
@@ -298,7 +371,8 @@ void Deserializer::WeakenDescriptorArrays() {
   }
 }
 
-void Deserializer::LogScriptEvents(Script script) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::LogScriptEvents(Script script) {
   DisallowGarbageCollection no_gc;
   LOG(isolate(),
       ScriptEvent(Logger::ScriptEventType::kDeserialize, script.id()));
@@ -316,18 +390,46 @@ bool StringTableInsertionKey::IsMatch(Isolate* isolate, String string) {
   return string_->SlowEquals(string);
 }
 
+bool StringTableInsertionKey::IsMatch(LocalIsolate* isolate, String string) {
+  // The deserialized string is not yet visible to other threads, so its
+  // characters can be read without the string access lock. {string} is read
+  // under the lock.
+  DCHECK(string_->IsSeqString());
+  DisallowGarbageCollection no_gc;
+  if (string_->IsOneByteRepresentation()) {
+    Vector<const uint8_t> chars(
+        SeqOneByteString::cast(*string_).GetChars(
+            no_gc, SharedStringAccessGuardIfNeeded::NotNeeded()),
+        length());
+    return string.IsEqualTo<String::EqualityType::kNoLengthCheck>(chars,
+                                                                  isolate);
+  }
+  Vector<const uint16_t> chars(
+      SeqTwoByteString::cast(*string_).GetChars(
+          no_gc, SharedStringAccessGuardIfNeeded::NotNeeded()),
+      length());
+  return string.IsEqualTo<String::EqualityType::kNoLengthCheck>(chars,
+                                                                isolate);
+}
+
 Handle<String> StringTableInsertionKey::AsHandle(Isolate* isolate) {
   return string_;
 }
 
+Handle<String> StringTableInsertionKey::AsHandle(LocalIsolate* isolate) {
+  return string_;
+}
+
 uint32_t StringTableInsertionKey::ComputeRawHashField(String string) {
   // Make sure raw_hash_field() is computed.
   string.EnsureHash();
   return string.raw_hash_field();
 }
 
-void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
-                                        SnapshotSpace space) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::PostProcessNewObject(Handle<Map> map,
+                                                  Handle<HeapObject> obj,
+                                                  SnapshotSpace space) {
   DCHECK_EQ(*map, obj->map());
   DisallowGarbageCollection no_gc;
   InstanceType instance_type = map->instance_type();
@@ -358,7 +460,7 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
           isolate()->string_table()->LookupKey(isolate(), &key);
 
       if (FLAG_thin_strings && *result != *string) {
-        string->MakeThin(isolate(), *result);
+        MakeThin(isolate(), string, *result);
         // Mutate the given object handle so that the backreference entry is
         // also updated.
         obj.PatchValue(*result);
@@ -403,13 +505,14 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
   } else if (InstanceTypeChecker::IsExternalString(instance_type)) {
     Handle<ExternalString> string = Handle<ExternalString>::cast(obj);
     uint32_t index = string->GetResourceRefForDeserialization();
+    Isolate* main_isolate = main_thread_isolate();
     Address address =
-        static_cast<Address>(isolate()->api_external_references()[index]);
-    string->AllocateExternalPointerEntries(isolate());
-    string->set_address_as_resource(isolate(), address);
-    isolate()->heap()->UpdateExternalString(*string, 0,
-                                            string->ExternalPayloadSize());
-    isolate()->heap()->RegisterExternalString(*string);
+        static_cast<Address>(main_isolate->api_external_references()[index]);
+    string->AllocateExternalPointerEntries(main_isolate);
+    string->set_address_as_resource(main_isolate, address);
+    main_isolate->heap()->UpdateExternalString(*string, 0,
+                                               string->ExternalPayloadSize());
+    main_isolate->heap()->RegisterExternalString(*string);
   } else if (InstanceTypeChecker::IsJSDataView(instance_type)) {
     Handle<JSDataView> data_view = Handle<JSDataView>::cast(obj);
     JSArrayBuffer buffer = JSArrayBuffer::cast(data_view->buffer());
@@ -421,18 +524,18 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
       // a numbered reference to an already deserialized backing store.
       backing_store = backing_stores_[store_index]->buffer_start();
     }
-    data_view->AllocateExternalPointerEntries(isolate());
+    data_view->AllocateExternalPointerEntries(main_thread_isolate());
     data_view->set_data_pointer(
-        isolate(),
+        main_thread_isolate(),
         reinterpret_cast<uint8_t*>(backing_store) + data_view->byte_offset());
   } else if (InstanceTypeChecker::IsJSTypedArray(instance_type)) {
     Handle<JSTypedArray> typed_array = Handle<JSTypedArray>::cast(obj);
     // Fixup typed array pointers.
     if (typed_array->is_on_heap()) {
       Address raw_external_pointer = typed_array->external_pointer_raw();
-      typed_array->AllocateExternalPointerEntries(isolate());
+      typed_array->AllocateExternalPointerEntries(main_thread_isolate());
       typed_array->SetOnHeapDataPtr(
-          isolate(), HeapObject::cast(typed_array->base_pointer()),
+          main_thread_isolate(), HeapObject::cast(typed_array->base_pointer()),
           raw_external_pointer);
     } else {
       // Serializer writes backing store ref as a DataPtr() value.
@@ -442,8 +545,8 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
       auto start = backing_store
                        ? reinterpret_cast<byte*>(backing_store->buffer_start())
                        : nullptr;
-      typed_array->AllocateExternalPointerEntries(isolate());
-      typed_array->SetOffHeapDataPtr(isolate(), start,
+      typed_array->AllocateExternalPointerEntries(main_thread_isolate());
+      typed_array->SetOffHeapDataPtr(main_thread_isolate(), start,
                                      typed_array->byte_offset());
     }
   } else if (InstanceTypeChecker::IsJSArrayBuffer(instance_type)) {
@@ -452,8 +555,8 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
     if (buffer->GetBackingStoreRefForDeserialization() != kNullRefSentinel) {
       new_off_heap_array_buffers_.push_back(buffer);
     } else {
-      buffer->AllocateExternalPointerEntries(isolate());
-      buffer->set_backing_store(isolate(), nullptr);
+      buffer->AllocateExternalPointerEntries(main_thread_isolate());
+      buffer->set_backing_store(main_thread_isolate(), nullptr);
     }
   } else if (InstanceTypeChecker::IsBytecodeArray(instance_type)) {
     // TODO(mythria): Remove these once we store the default values for these
@@ -471,7 +574,9 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
                                     HeapObject::RequiredAlignment(*map)));
 }
 
-HeapObjectReferenceType Deserializer::GetAndResetNextReferenceType() {
+template <typename IsolateT>
+HeapObjectReferenceType
+Deserializer<IsolateT>::GetAndResetNextReferenceType() {
   HeapObjectReferenceType type = next_reference_is_weak_
                                      ? HeapObjectReferenceType::WEAK
                                      : HeapObjectReferenceType::STRONG;
@@ -479,7 +584,8 @@ HeapObjectReferenceType Deserializer::GetAndResetNextReferenceType() {
   return type;
 }
 
-Handle<HeapObject> Deserializer::GetBackReferencedObject() {
+template <typename IsolateT>
+Handle<HeapObject> Deserializer<IsolateT>::GetBackReferencedObject() {
   Handle<HeapObject> obj = back_refs_[source_.GetInt()];
 
   // We don't allow ThinStrings in backreferences -- if internalization produces
@@ -491,15 +597,17 @@ Handle<HeapObject> Deserializer::GetBackReferencedObject() {
   return obj;
 }
 
-Handle<HeapObject> Deserializer::ReadObject() {
+template <typename IsolateT>
+Handle<HeapObject> Deserializer<IsolateT>::ReadObject() {
   Handle<HeapObject> ret;
-  CHECK_EQ(ReadSingleBytecodeData(source_.Get(),
-                                  SlotAccessorForHandle(&ret, isolate())),
+  CHECK_EQ(ReadSingleBytecodeData(
+               source_.Get(), SlotAccessorForHandle<IsolateT>(&ret, isolate())),
            1);
   return ret;
 }
 
-Handle<HeapObject> Deserializer::ReadObject(SnapshotSpace space) {
+template <typename IsolateT>
+Handle<HeapObject> Deserializer<IsolateT>::ReadObject(SnapshotSpace space) {
   const int size_in_tagged = source_.GetInt();
   const int size_in_bytes = size_in_tagged * kTaggedSize;
 
@@ -519,9 +627,9 @@ Handle<HeapObject> Deserializer::ReadObject(SnapshotSpace space) {
   //   * The rest of the object is filled with a fixed Smi value
   //     - This is a Smi so that tagged fields become initialized to a valid
   //       tagged value.
-  //     - It's a fixed value, "uninitialized_field_value", so that we can
-  //       DCHECK for it when reading objects that are assumed to be partially
-  //       initialized objects.
+  //     - It's a fixed value, "uninitialized_deserialization_value", so that
+  //       we can DCHECK for it when reading objects that are assumed to be
+  //       partially initialized objects.
   //   * The fields of the object are deserialized in order, under the
   //     assumption that objects are laid out in such a way that any fields
   //     required for object iteration (e.g. length fields) are deserialized
@@ -531,8 +639,8 @@ Handle<HeapObject> Deserializer::ReadObject(SnapshotSpace space) {
   HeapObject raw_obj =
       Allocate(space, size_in_bytes, HeapObject::RequiredAlignment(*map));
   raw_obj.set_map_after_allocation(*map);
-  MemsetTagged(raw_obj.RawField(kTaggedSize), uninitialized_field_value(),
-               size_in_tagged - 1);
+  MemsetTagged(raw_obj.RawField(kTaggedSize),
+               Smi::uninitialized_deserialization_value(), size_in_tagged - 1);
 
   // Make sure BytecodeArrays have a valid age, so that the marker doesn't
   // break when making them older.
@@ -583,15 +691,16 @@ Handle<HeapObject> Deserializer::ReadObject(SnapshotSpace space) {
   return obj;
 }
 
-Handle<HeapObject> Deserializer::ReadMetaMap() {
+template <typename IsolateT>
+Handle<HeapObject> Deserializer<IsolateT>::ReadMetaMap() {
   const SnapshotSpace space = SnapshotSpace::kReadOnlyHeap;
   const int size_in_bytes = Map::kSize;
   const int size_in_tagged = size_in_bytes / kTaggedSize;
 
   HeapObject raw_obj = Allocate(space, size_in_bytes, kWordAligned);
   raw_obj.set_map_after_allocation(Map::unchecked_cast(raw_obj));
-  MemsetTagged(raw_obj.RawField(kTaggedSize), uninitialized_field_value(),
-               size_in_tagged - 1);
+  MemsetTagged(raw_obj.RawField(kTaggedSize),
+               Smi::uninitialized_deserialization_value(), size_in_tagged - 1);
 
   Handle<HeapObject> obj = handle(raw_obj, isolate());
   back_refs_.push_back(obj);
@@ -605,7 +714,8 @@ Handle<HeapObject> Deserializer::ReadMetaMap() {
   return obj;
 }
 
-class Deserializer::RelocInfoVisitor {
+template <typename IsolateT>
+class Deserializer<IsolateT>::RelocInfoVisitor {
  public:
   RelocInfoVisitor(Deserializer* deserializer,
                    const std::vector<Handle<HeapObject>>* objects)
@@ -620,7 +730,8 @@ class Deserializer::RelocInfoVisitor {
   void VisitOffHeapTarget(Code host, RelocInfo* rinfo);
 
  private:
-  Isolate* isolate() { return deserializer_->isolate(); }
+  // Code objects are only deserialized on the main thread.
+  Isolate* isolate() { return deserializer_->main_thread_isolate(); }
   SnapshotByteSource& source() { return deserializer_->source_; }
 
   Deserializer* deserializer_;
@@ -628,27 +739,31 @@ class Deserializer::RelocInfoVisitor {
   int current_object_;
 };
 
-void Deserializer::RelocInfoVisitor::VisitCodeTarget(Code host,
-                                                     RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitCodeTarget(
+    Code host, RelocInfo* rinfo) {
   HeapObject object = *objects_->at(current_object_++);
   rinfo->set_target_address(Code::cast(object).raw_instruction_start());
 }
 
-void Deserializer::RelocInfoVisitor::VisitEmbeddedPointer(Code host,
-                                                          RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitEmbeddedPointer(
+    Code host, RelocInfo* rinfo) {
   HeapObject object = *objects_->at(current_object_++);
   // Embedded object reference must be a strong one.
   rinfo->set_target_object(isolate()->heap(), object);
 }
 
-void Deserializer::RelocInfoVisitor::VisitRuntimeEntry(Code host,
-                                                       RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitRuntimeEntry(
+    Code host, RelocInfo* rinfo) {
   // We no longer serialize code that contains runtime entries.
   UNREACHABLE();
 }
 
-void Deserializer::RelocInfoVisitor::VisitExternalReference(Code host,
-                                                            RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitExternalReference(
+    Code host, RelocInfo* rinfo) {
   byte data = source().Get();
   CHECK_EQ(data, kExternalReference);
 
@@ -663,8 +778,9 @@ void Deserializer::RelocInfoVisitor::VisitExternalReference(Code host,
   }
 }
 
-void Deserializer::RelocInfoVisitor::VisitInternalReference(Code host,
-                                                            RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitInternalReference(
+    Code host, RelocInfo* rinfo) {
   byte data = source().Get();
   CHECK_EQ(data, kInternalReference);
 
@@ -681,8 +797,9 @@ void Deserializer::RelocInfoVisitor::VisitInternalReference(Code host,
       rinfo->pc(), target, rinfo->rmode());
 }
 
-void Deserializer::RelocInfoVisitor::VisitOffHeapTarget(Code host,
-                                                        RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitOffHeapTarget(
+    Code host, RelocInfo* rinfo) {
   byte data = source().Get();
   CHECK_EQ(data, kOffHeapTarget);
 
@@ -704,9 +821,10 @@ void Deserializer::RelocInfoVisitor::VisitOffHeapTarget(Code host,
   }
 }
 
+template <typename IsolateT>
 template <typename SlotAccessor>
-int Deserializer::ReadRepeatedObject(SlotAccessor slot_accessor,
-                                     int repeat_count) {
+int Deserializer<IsolateT>::ReadRepeatedObject(SlotAccessor slot_accessor,
+                                               int repeat_count) {
   CHECK_LE(2, repeat_count);
 
   Handle<HeapObject> heap_object = ReadObject();
@@ -758,8 +876,10 @@ constexpr byte VerifyBytecodeCount(byte bytecode) {
       : case SpaceEncoder<bytecode>::Encode(SnapshotSpace::kMap)  \
       : case SpaceEncoder<bytecode>::Encode(SnapshotSpace::kReadOnlyHeap)
 
-void Deserializer::ReadData(Handle<HeapObject> object, int start_slot_index,
-                            int end_slot_index) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::ReadData(Handle<HeapObject> object,
+                                      int start_slot_index,
+                                      int end_slot_index) {
   int current = start_slot_index;
   while (current < end_slot_index) {
     byte data = source_.Get();
@@ -769,8 +889,9 @@ void Deserializer::ReadData(Handle<HeapObject> object, int start_slot_index,
   CHECK_EQ(current, end_slot_index);
 }
 
-void Deserializer::ReadData(FullMaybeObjectSlot start,
-                            FullMaybeObjectSlot end) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::ReadData(FullMaybeObjectSlot start,
+                                      FullMaybeObjectSlot end) {
   FullMaybeObjectSlot current = start;
   while (current < end) {
     byte data = source_.Get();
@@ -779,9 +900,10 @@ void Deserializer::ReadData(FullMaybeObjectSlot start,
   CHECK_EQ(current, end);
 }
 
+template <typename IsolateT>
 template <typename SlotAccessor>
-int Deserializer::ReadSingleBytecodeData(byte data,
-                                         SlotAccessor slot_accessor) {
+int Deserializer<IsolateT>::ReadSingleBytecodeData(byte data,
+                                                   SlotAccessor slot_accessor) {
   using TSlot = decltype(slot_accessor.slot());
 
   switch (data) {
@@ -805,11 +927,12 @@ int Deserializer::ReadSingleBytecodeData(byte data,
     // Reference an object in the read-only heap. This should be used when an
     // object is read-only, but is not a root.
     case kReadOnlyHeapRef: {
-      DCHECK(isolate()->heap()->deserialization_complete());
+      DCHECK(main_thread_isolate()->heap()->deserialization_complete());
       uint32_t chunk_index = source_.GetInt();
       uint32_t chunk_offset = source_.GetInt();
 
-      ReadOnlySpace* read_only_space = isolate()->heap()->read_only_space();
+      ReadOnlySpace* read_only_space =
+          isolate()->read_only_heap()->read_only_space();
       ReadOnlyPage* page = read_only_space->pages()[chunk_index];
       Address address = page->OffsetToAddress(chunk_offset);
       HeapObject heap_object = HeapObject::FromAddress(address);
@@ -834,8 +957,8 @@ int Deserializer::ReadSingleBytecodeData(byte data,
       int cache_index = source_.GetInt();
       // TODO(leszeks): Could we use the address of the startup_object_cache
       // entry as a Handle backing?
-      HeapObject heap_object =
-          HeapObject::cast(isolate()->startup_object_cache()->at(cache_index));
+      HeapObject heap_object = HeapObject::cast(
+          main_thread_isolate()->startup_object_cache()->at(cache_index));
       return slot_accessor.Write(heap_object, GetAndResetNextReferenceType());
     }
 
@@ -1000,11 +1123,13 @@ int Deserializer::ReadSingleBytecodeData(byte data,
     }
 
     case kOffHeapBackingStore: {
-      AlwaysAllocateScope scope(isolate()->heap());
+      // Off-heap backing stores are only deserialized on the main thread.
+      Isolate* main_isolate = main_thread_isolate();
+      AlwaysAllocateScope scope(main_isolate->heap());
       int byte_length = source_.GetInt();
-      std::unique_ptr<BackingStore> backing_store =
-          BackingStore::Allocate(isolate(), byte_length, SharedFlag::kNotShared,
-                                 InitializedFlag::kUninitialized);
+      std::unique_ptr<BackingStore> backing_store = BackingStore::Allocate(
+          main_isolate, byte_length, SharedFlag::kNotShared,
+          InitializedFlag::kUninitialized);
       CHECK_NOT_NULL(backing_store);
       source_.CopyRaw(backing_store->buffer_start(), byte_length);
       backing_stores_.push_back(std::move(backing_store));
@@ -1015,11 +1140,12 @@ int Deserializer::ReadSingleBytecodeData(byte data,
     case kApiReference: {
       uint32_t reference_id = static_cast<uint32_t>(source_.GetInt());
       Address address;
-      if (isolate()->api_external_references()) {
+      Isolate* main_isolate = main_thread_isolate();
+      if (main_isolate->api_external_references()) {
         DCHECK_WITH_MSG(reference_id < num_api_references_,
                         "too few external references provided through the API");
         address = static_cast<Address>(
-            isolate()->api_external_references()[reference_id]);
+            main_isolate->api_external_references()[reference_id]);
       } else {
         address = reinterpret_cast<Address>(NoExternalReferencesCallback);
       }
@@ -1110,9 +1236,11 @@ int Deserializer::ReadSingleBytecodeData(byte data,
 #undef CASE_R2
 #undef CASE_R1
 
-Address Deserializer::ReadExternalReferenceCase() {
+template <typename IsolateT>
+Address Deserializer<IsolateT>::ReadExternalReferenceCase() {
   uint32_t reference_id = static_cast<uint32_t>(source_.GetInt());
-  return isolate()->external_reference_table()->address(reference_id);
+  return main_thread_isolate()->external_reference_table()->address(
+      reference_id);
 }
 
 namespace {
@@ -1130,8 +1258,9 @@ AllocationType SpaceToType(SnapshotSpace space) {
 }
 }  // namespace
 
-HeapObject Deserializer::Allocate(SnapshotSpace space, int size,
-                                  AllocationAlignment alignment) {
+template <typename IsolateT>
+HeapObject Deserializer<IsolateT>::Allocate(SnapshotSpace space, int size,
+                                            AllocationAlignment alignment) {
 #ifdef DEBUG
   if (!previous_allocation_obj_.is_null()) {
     // Make sure that the previous object is initialized sufficiently to
@@ -1141,8 +1270,8 @@ HeapObject Deserializer::Allocate(SnapshotSpace space, int size,
   }
 #endif
 
-  HeapObject obj = isolate()->heap()->AllocateRawWith<Heap::kRetryOrFail>(
-      size, SpaceToType(space), AllocationOrigin::kRuntime, alignment);
+  HeapObject obj =
+      AllocateRaw(isolate(), size, SpaceToType(space), alignment);
 
 #ifdef DEBUG
   previous_allocation_obj_ = handle(obj, isolate());
@@ -1152,5 +1281,9 @@ HeapObject Deserializer::Allocate(SnapshotSpace space, int size,
   return obj;
 }
 
+template class EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE) Deserializer<Isolate>;
+template class EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE)
+    Deserializer<LocalIsolate>;
+
 }  // namespace internal
 }  // namespace v8
@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "src/base/export-template.h"
 #include "src/common/globals.h"
 #include "src/objects/allocation-site.h"
 #include "src/objects/api-callbacks.h"
@@ -24,6 +25,7 @@ namespace v8 {
 namespace internal {
 
 class HeapObject;
+class LocalIsolate;
 class Object;
 
 // Used for platforms with embedded constant pools to trigger deserialization
@@ -38,21 +40,16 @@ class Object;
 #endif
 
 // A Deserializer reads a snapshot and reconstructs the Object graph it defines.
-class V8_EXPORT_PRIVATE Deserializer : public SerializerDeserializer {
+//
+// The Deserializer is parameterized on the isolate type: Deserializer<Isolate>
+// runs on the main thread, while Deserializer<LocalIsolate> deserializes into
+// a LocalHeap on a background thread. The latter only supports the object
+// graphs produced by the CodeSerializer, which contain neither code, maps nor
+// off-heap data.
+template <typename IsolateT>
+class EXPORT_TEMPLATE_DECLARE(V8_EXPORT_PRIVATE) Deserializer
+    : public SerializerDeserializer {
  public:
-  // Smi value for filling in not-yet initialized tagged field values with a
-  // valid tagged pointer. A field value equal to this doesn't necessarily
-  // indicate that a field is uninitialized, but an uninitialized field should
-  // definitely equal this value.
-  //
-  // This _has_ to be kNullAddress, so that an uninitialized_field_value read as
-  // an embedded pointer field is interpreted as nullptr. This is so that
-  // uninitialised embedded pointers are not forwarded to the embedded as part
-  // of embedder tracing (and similar mechanisms), as nullptrs are skipped for
-  // those cases and otherwise the embedder would try to dereference the
-  // uninitialized pointer value.
-  static constexpr Smi uninitialized_field_value() { return Smi(kNullAddress); }
-
   ~Deserializer() override;
   Deserializer(const Deserializer&) = delete;
   Deserializer& operator=(const Deserializer&) = delete;
@@ -61,7 +58,7 @@ class V8_EXPORT_PRIVATE Deserializer : public SerializerDeserializer {
 
  protected:
   // Create a deserializer from a snapshot byte source.
-  Deserializer(Isolate* isolate, Vector<const byte> payload,
+  Deserializer(IsolateT* isolate, Vector<const byte> payload,
                uint32_t magic_number, bool deserializing_user_code,
                bool can_rehash);
 
@@ -91,7 +88,7 @@ class V8_EXPORT_PRIVATE Deserializer : public SerializerDeserializer {
     CHECK_EQ(new_off_heap_array_buffers().size(), 0);
   }
 
-  Isolate* isolate() const { return isolate_; }
+  IsolateT* isolate() const { return isolate_; }
 
   SnapshotByteSource* source() { return &source_; }
   const std::vector<Handle<AllocationSite>>& new_allocation_sites() const {
@@ -127,6 +124,13 @@ class V8_EXPORT_PRIVATE Deserializer : public SerializerDeserializer {
   bool deserializing_user_code() const { return deserializing_user_code_; }
   bool can_rehash() const { return can_rehash_; }
 
+  // Objects whose hash-based layout has to be recomputed after
+  // deserialization. Rehashing may allocate, so off-thread deserializers pass
+  // these on to the main thread instead of calling Rehash().
+  const std::vector<Handle<HeapObject>>& to_rehash() const {
+    return to_rehash_;
+  }
+
   void Rehash();
 
   Handle<HeapObject> ReadObject();
@@ -207,8 +211,12 @@ class V8_EXPORT_PRIVATE Deserializer : public SerializerDeserializer {
   HeapObject Allocate(SnapshotSpace space, int size,
                       AllocationAlignment alignment);
 
+  // The main thread Isolate, for the parts of the deserializer that only
+  // read isolate-wide state (e.g. the external reference table).
+  Isolate* main_thread_isolate() const;
+
   // Cached current isolate.
-  Isolate* isolate_;
+  IsolateT* isolate_;
 
   // Objects from the attached object descriptions in the serialized user code.
   std::vector<Handle<HeapObject>> attached_objects_;
@@ -271,6 +279,7 @@ class StringTableInsertionKey final : public StringTableKey {
   explicit StringTableInsertionKey(Handle<String> string);
 
   bool IsMatch(Isolate* isolate, String string);
+  bool IsMatch(LocalIsolate* isolate, String string);
 
   V8_WARN_UNUSED_RESULT Handle<String> AsHandle(Isolate* isolate);
   V8_WARN_UNUSED_RESULT Handle<String> AsHandle(LocalIsolate* isolate);
@@ -6,7 +6,11 @@
 
 #include "src/codegen/assembler-inl.h"
 #include "src/execution/isolate.h"
+#include "src/execution/local-isolate-inl.h"
+#include "src/handles/local-handles-inl.h"
 #include "src/heap/heap-inl.h"
+#include "src/heap/local-factory-inl.h"
+#include "src/heap/local-heap-inl.h"
 #include "src/objects/allocation-site-inl.h"
 #include "src/objects/js-array-buffer-inl.h"
 #include "src/objects/objects.h"
@@ -34,14 +38,6 @@ ObjectDeserializer::DeserializeSharedFunctionInfo(
              : MaybeHandle<SharedFunctionInfo>();
 }
 
-MaybeHandle<SharedFunctionInfo>
-ObjectDeserializer::DeserializeSharedFunctionInfoOffThread(
-    LocalIsolate* isolate, const SerializedCodeData* data,
-    Handle<String> source) {
-  // TODO(leszeks): Add LocalHeap support to deserializer
-  UNREACHABLE();
-}
-
 MaybeHandle<HeapObject> ObjectDeserializer::Deserialize() {
   DCHECK(deserializing_user_code());
   HandleScope scope(isolate());
@@ -100,5 +96,54 @@ void ObjectDeserializer::LinkAllocationSites() {
   }
 }
 
+OffThreadObjectDeserializer::OffThreadObjectDeserializer(
+    LocalIsolate* isolate, const SerializedCodeData* data)
+    : Deserializer(isolate, data->Payload(), data->GetMagicNumber(), true,
+                   false) {}
+
+MaybeHandle<SharedFunctionInfo>
+OffThreadObjectDeserializer::DeserializeSharedFunctionInfo(
+    LocalIsolate* isolate, const SerializedCodeData* data,
+    std::vector<Handle<Script>>* deserialized_scripts,
+    std::vector<Handle<HeapObject>>* objects_to_rehash) {
+  OffThreadObjectDeserializer d(isolate, data);
+
+  // The source is attached on the main thread.
+  d.AddAttachedObject(isolate->factory()->empty_string());
+
+  Handle<HeapObject> result;
+  if (!d.Deserialize(deserialized_scripts, objects_to_rehash)
+           .ToHandle(&result)) {
+    return MaybeHandle<SharedFunctionInfo>();
+  }
+  return Handle<SharedFunctionInfo>::cast(result);
+}
+
+MaybeHandle<HeapObject> OffThreadObjectDeserializer::Deserialize(
+    std::vector<Handle<Script>>* deserialized_scripts,
+    std::vector<Handle<HeapObject>>* objects_to_rehash) {
+  DCHECK(deserializing_user_code());
+  LocalHandleScope scope(isolate());
+  Handle<HeapObject> result;
+  {
+    result = ReadObject();
+    DeserializeDeferredObjects();
+    CHECK(new_code_objects().empty());
+    CHECK(new_allocation_sites().empty());
+    CHECK(new_maps().empty());
+    WeakenDescriptorArrays();
+  }
+  CHECK(new_off_heap_array_buffers().empty());
+
+  LocalHeap* heap = isolate()->heap();
+  for (Handle<Script> script : new_scripts()) {
+    deserialized_scripts->push_back(heap->NewPersistentHandle(script));
+  }
+  for (Handle<HeapObject> object : to_rehash()) {
+    objects_to_rehash->push_back(heap->NewPersistentHandle(object));
+  }
+  return scope.CloseAndEscape(result);
+}
+
 }  // namespace internal
 }  // namespace v8
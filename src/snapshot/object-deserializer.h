@@ -5,22 +5,22 @@
 #ifndef V8_SNAPSHOT_OBJECT_DESERIALIZER_H_
 #define V8_SNAPSHOT_OBJECT_DESERIALIZER_H_
 
+#include <vector>
+
 #include "src/snapshot/deserializer.h"
 
 namespace v8 {
 namespace internal {
 
+class Script;
 class SerializedCodeData;
 class SharedFunctionInfo;
 
 // Deserializes the object graph rooted at a given object.
-class ObjectDeserializer final : public Deserializer {
+class ObjectDeserializer final : public Deserializer<Isolate> {
  public:
   static MaybeHandle<SharedFunctionInfo> DeserializeSharedFunctionInfo(
       Isolate* isolate, const SerializedCodeData* data, Handle<String> source);
-  static MaybeHandle<SharedFunctionInfo> DeserializeSharedFunctionInfoOffThread(
-      LocalIsolate* isolate, const SerializedCodeData* data,
-      Handle<String> source);
 
  private:
   explicit ObjectDeserializer(Isolate* isolate, const SerializedCodeData* data);
@@ -32,6 +32,28 @@ class ObjectDeserializer final : public Deserializer {
   void CommitPostProcessedObjects();
 };
 
+// Deserializes the object graph rooted at a given object into a LocalHeap on
+// a background thread. The script source is not available off-thread, so the
+// empty string is attached in its place. Work that has to happen on the main
+// thread (fixing up the script source, assigning script ids, registering the
+// scripts and rehashing) is left to CodeSerializer::FinishOffThreadDeserialize;
+// the objects it needs are returned in persistent handles.
+class OffThreadObjectDeserializer final : public Deserializer<LocalIsolate> {
+ public:
+  static MaybeHandle<SharedFunctionInfo> DeserializeSharedFunctionInfo(
+      LocalIsolate* isolate, const SerializedCodeData* data,
+      std::vector<Handle<Script>>* deserialized_scripts,
+      std::vector<Handle<HeapObject>>* objects_to_rehash);
+
+ private:
+  explicit OffThreadObjectDeserializer(LocalIsolate* isolate,
+                                       const SerializedCodeData* data);
+
+  MaybeHandle<HeapObject> Deserialize(
+      std::vector<Handle<Script>>* deserialized_scripts,
+      std::vector<Handle<HeapObject>>* objects_to_rehash);
+};
+
 }  // namespace internal
 }  // namespace v8
 
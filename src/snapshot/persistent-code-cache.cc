@@ -0,0 +1,542 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/snapshot/persistent-code-cache.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "src/base/bits.h"
+#include "src/base/platform/time.h"
+#include "src/flags/flags.h"
+#include "src/handles/global-handles.h"
+#include "src/init/v8.h"
+#include "src/objects/script-inl.h"
+#include "src/objects/shared-function-info-inl.h"
+#include "src/objects/string-inl.h"
+#include "src/snapshot/code-serializer.h"
+#include "src/utils/utils.h"
+#include "src/utils/version.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+constexpr uint32_t kEntryMagicNumber = 0xC0DECAC1;
+constexpr uint32_t kIndexMagicNumber = 0xC0DECAC2;
+
+// The header of an entry file. It is followed by the payload produced by
+// the CodeSerializer. Its size is a multiple of the pointer size, so that
+// the memory-mapped payload is suitably aligned for deserialization without
+// a copy.
+struct EntryHeader {
+  uint32_t magic;
+  uint32_t version_hash;
+  uint32_t flag_hash;
+  uint32_t source_length;
+  uint32_t payload_length;
+  uint32_t reserved;
+  uint64_t hash;
+  uint64_t check;
+};
+STATIC_ASSERT(sizeof(EntryHeader) % kPointerAlignment == 0);
+
+// The header of the index log. It is followed by IndexLogRecords. The
+// generation changes whenever a process compacts the log, so that other
+// processes know to read it again from the start.
+struct IndexLogHeader {
+  uint32_t magic;
+  uint32_t generation;
+  uint64_t reserved;
+};
+
+// The log is compacted once it has this many more records than live entries.
+constexpr size_t kMinObsoleteIndexLogRecords = 256;
+
+int64_t Now() { return base::Time::Now().ToInternalValue(); }
+
+constexpr uint64_t kFNVOffsetBasis = 0xCBF29CE484222325ull;
+constexpr uint64_t kFNVPrime = 0x100000001B3ull;
+
+// Hashes the code units of {chars} twice: once with 64-bit FNV-1a, which
+// serves as the key, and once with an independent multiplicative hash, which
+// is stored in the entry to detect collisions of the key.
+template <typename Char>
+void HashChars(const Char* chars, int length, uint64_t* hash,
+               uint64_t* check) {
+  uint64_t h = *hash;
+  uint64_t c = *check;
+  for (int i = 0; i < length; i++) {
+    uint16_t unit = static_cast<uint16_t>(chars[i]);
+    h = (h ^ unit) * kFNVPrime;
+    c = base::bits::RotateLeft64(c ^ unit, 29) * 0x9E3779B97F4A7C15ull;
+  }
+  *hash = h;
+  *check = c;
+}
+
+}  // namespace
+
+class PersistentCodeCache::WriteTask final : public CancelableTask {
+ public:
+  explicit WriteTask(PersistentCodeCache* cache)
+      : CancelableTask(&cache->task_manager_), cache_(cache) {}
+
+  void RunInternal() final { cache_->FlushPendingWrites(); }
+
+ private:
+  PersistentCodeCache* const cache_;
+};
+
+class PersistentCodeCache::StoreTask final : public CancelableTask {
+ public:
+  StoreTask(Isolate* isolate, PersistentCodeCache* cache)
+      : CancelableTask(isolate), isolate_(isolate), cache_(cache) {}
+
+  void RunInternal() final {
+    cache_->store_task_posted_ = false;
+    cache_->StorePendingScripts(isolate_);
+  }
+
+ private:
+  Isolate* const isolate_;
+  PersistentCodeCache* const cache_;
+};
+
+PersistentCodeCache::PersistentCodeCache(const char* directory,
+                                         size_t max_size)
+    : directory_(directory), max_size_(max_size) {
+  {
+    base::MutexGuard write_guard(&write_mutex_);
+    ReadIndexLog();
+  }
+  if (total_size_ > max_size_) ScheduleWrite();
+}
+
+PersistentCodeCache::~PersistentCodeCache() {
+  for (const std::unique_ptr<Address*>& location : pending_scripts_) {
+    if (*location != nullptr) GlobalHandles::Destroy(*location);
+  }
+  task_manager_.CancelAndWait();
+  FlushPendingWrites();
+}
+
+PersistentCodeCache::Key PersistentCodeCache::ComputeKey(
+    Isolate* isolate, Handle<String> source,
+    ScriptOriginOptions origin_options) const {
+  source = String::Flatten(isolate, source);
+  Key key;
+  key.source_length = static_cast<uint32_t>(source->length());
+  key.hash = kFNVOffsetBasis;
+  key.check = static_cast<uint64_t>(key.source_length);
+  {
+    DisallowGarbageCollection no_gc;
+    String::FlatContent content = source->GetFlatContent(no_gc);
+    DCHECK(content.IsFlat());
+    if (content.IsOneByte()) {
+      Vector<const uint8_t> chars = content.ToOneByteVector();
+      HashChars(chars.begin(), chars.length(), &key.hash, &key.check);
+    } else {
+      Vector<const uc16> chars = content.ToUC16Vector();
+      HashChars(chars.begin(), chars.length(), &key.hash, &key.check);
+    }
+  }
+  // Different origin options produce different code (e.g. modules), so they
+  // are part of the key.
+  uint16_t flags = static_cast<uint16_t>(origin_options.Flags());
+  HashChars(&flags, 1, &key.hash, &key.check);
+  return key;
+}
+
+std::string PersistentCodeCache::EntryPath(uint64_t hash) const {
+  char name[32];
+  SNPrintF(ArrayVector(name), "%016" PRIx64 ".v8cc", hash);
+  return directory_ + base::OS::DirectorySeparator() + name;
+}
+
+std::string PersistentCodeCache::IndexPath() const {
+  return directory_ + base::OS::DirectorySeparator() + "index.v8cc";
+}
+
+std::string PersistentCodeCache::TemporaryPath(const std::string& path) {
+  return path + ".tmp." + std::to_string(base::OS::GetCurrentProcessId()) +
+         "." + std::to_string(temporary_counter_++);
+}
+
+bool PersistentCodeCache::WriteFile(const std::string& path,
+                                    const void* header, size_t header_size,
+                                    const void* data, size_t length) {
+  std::string temporary_path = TemporaryPath(path);
+  FILE* file = base::OS::FOpen(temporary_path.c_str(), "wb");
+  if (file == nullptr) return false;
+  bool success = fwrite(header, 1, header_size, file) == header_size &&
+                 fwrite(data, 1, length, file) == length;
+  success = fclose(file) == 0 && success;
+  if (success && rename(temporary_path.c_str(), path.c_str()) != 0) {
+    // Some platforms do not allow renaming over an existing file.
+    base::OS::Remove(path.c_str());
+    success = rename(temporary_path.c_str(), path.c_str()) == 0;
+  }
+  if (!success) base::OS::Remove(temporary_path.c_str());
+  return success;
+}
+
+std::unique_ptr<PersistentCodeCache::Entry> PersistentCodeCache::Lookup(
+    Isolate* isolate, Handle<String> source,
+    ScriptOriginOptions origin_options) {
+  Key key = ComputeKey(isolate, source, origin_options);
+  std::unique_ptr<Entry> result;
+  {
+    base::MutexGuard guard(&mutex_);
+    std::string path = EntryPath(key.hash);
+    std::unique_ptr<base::OS::MemoryMappedFile> file(
+        base::OS::MemoryMappedFile::open(
+            path.c_str(), base::OS::MemoryMappedFile::FileMode::kReadOnly));
+    if (!file) {
+      // The entry might have been evicted by another process, which also
+      // logged its removal.
+      auto it = index_.find(key.hash);
+      if (it != index_.end()) {
+        total_size_ -= it->second.size;
+        index_.erase(it);
+      }
+      return nullptr;
+    }
+
+    size_t size = file->size();
+    const byte* memory = static_cast<const byte*>(file->memory());
+    EntryHeader header;
+    bool valid = size >= sizeof(header);
+    if (valid) {
+      memcpy(&header, memory, sizeof(header));
+      valid = header.magic == kEntryMagicNumber &&
+              header.version_hash == Version::Hash() &&
+              header.flag_hash == FlagList::Hash() &&
+              header.payload_length == size - sizeof(header) &&
+              header.hash == key.hash && header.check == key.check &&
+              header.source_length == key.source_length;
+    }
+    if (valid) {
+      // Entries written by other processes are adopted into the index.
+      IndexRecord& record = index_[key.hash];
+      total_size_ = total_size_ - record.size + size;
+      record.size = size;
+      record.last_use = Now();
+      pending_records_.push_back({key.hash, size, record.last_use});
+      if (FLAG_trace_persistent_code_cache) {
+        PrintF("[PersistentCodeCache: hit %s (%zu bytes)]\n", path.c_str(),
+               size);
+      }
+      result = std::make_unique<Entry>(std::move(file),
+                                       memory + sizeof(header),
+                                       static_cast<int>(header.payload_length));
+    } else {
+      if (FLAG_trace_persistent_code_cache) {
+        PrintF("[PersistentCodeCache: rejected %s]\n", path.c_str());
+      }
+      file.reset();
+      RemoveEntry(key.hash);
+    }
+  }
+  ScheduleWrite();
+  return result;
+}
+
+bool PersistentCodeCache::Store(Isolate* isolate, Handle<String> source,
+                                ScriptOriginOptions origin_options,
+                                const byte* data, int length) {
+  DCHECK_LT(0, length);
+  size_t size = sizeof(EntryHeader) + length;
+  if (size > max_size_) return false;
+  Key key = ComputeKey(isolate, source, origin_options);
+  {
+    base::MutexGuard guard(&mutex_);
+    IndexRecord& record = index_[key.hash];
+    if (record.size >= size) return true;
+    // The index is updated right away, so that later stores of the same
+    // source are dropped. The entry is removed again if the write fails.
+    total_size_ = total_size_ - record.size + size;
+    record.size = size;
+    record.last_use = Now();
+    pending_entries_.push_back({key, std::vector<byte>(data, data + length)});
+  }
+  ScheduleWrite();
+  return true;
+}
+
+bool PersistentCodeCache::StoreScript(Isolate* isolate,
+                                      Handle<SharedFunctionInfo> shared) {
+  DCHECK(shared->is_toplevel());
+  Handle<Script> script(Script::cast(shared->script()), isolate);
+  Handle<String> source(String::cast(script->source()), isolate);
+  std::unique_ptr<ScriptCompiler::CachedData> cached_data(
+      CodeSerializer::Serialize(shared));
+  if (!cached_data) return false;
+  return Store(isolate, source, script->origin_options(), cached_data->data,
+               cached_data->length);
+}
+
+void PersistentCodeCache::ScheduleStoreScript(
+    Isolate* isolate, Handle<SharedFunctionInfo> shared) {
+  DCHECK(shared->is_toplevel());
+  Handle<Object> global = isolate->global_handles()->Create(*shared);
+  pending_scripts_.push_back(std::make_unique<Address*>(global.location()));
+  GlobalHandles::MakeWeak(pending_scripts_.back().get());
+  if (store_task_posted_) return;
+  store_task_posted_ = true;
+  std::shared_ptr<v8::TaskRunner> taskrunner =
+      V8::GetCurrentPlatform()->GetForegroundTaskRunner(
+          reinterpret_cast<v8::Isolate*>(isolate));
+  taskrunner->PostDelayedTask(std::make_unique<StoreTask>(isolate, this),
+                              FLAG_persistent_code_cache_store_delay);
+}
+
+void PersistentCodeCache::StorePendingScripts(Isolate* isolate) {
+  std::vector<std::unique_ptr<Address*>> scripts;
+  scripts.swap(pending_scripts_);
+  for (const std::unique_ptr<Address*>& location : scripts) {
+    // The handle was cleared if the script died in the meantime.
+    if (*location == nullptr) continue;
+    {
+      HandleScope scope(isolate);
+      StoreScript(isolate, Handle<SharedFunctionInfo>(*location));
+    }
+    GlobalHandles::Destroy(*location);
+  }
+}
+
+void PersistentCodeCache::Remove(Isolate* isolate, Handle<String> source,
+                                 ScriptOriginOptions origin_options) {
+  Key key = ComputeKey(isolate, source, origin_options);
+  {
+    base::MutexGuard guard(&mutex_);
+    RemoveEntry(key.hash);
+  }
+  ScheduleWrite();
+}
+
+void PersistentCodeCache::ScheduleWrite() {
+  {
+    base::MutexGuard guard(&mutex_);
+    if (write_scheduled_) return;
+    write_scheduled_ = true;
+  }
+  if (FLAG_single_threaded) {
+    FlushPendingWrites();
+  } else {
+    V8::GetCurrentPlatform()->CallOnWorkerThread(
+        std::make_unique<WriteTask>(this));
+  }
+}
+
+void PersistentCodeCache::FlushPendingWrites() {
+  base::MutexGuard write_guard(&write_mutex_);
+  std::vector<PendingEntry> entries;
+  {
+    base::MutexGuard guard(&mutex_);
+    entries.swap(pending_entries_);
+    write_scheduled_ = false;
+  }
+
+  std::vector<IndexLogRecord> records;
+  for (const PendingEntry& entry : entries) {
+    size_t size = sizeof(EntryHeader) + entry.payload.size();
+    if (WriteEntry(entry)) {
+      records.push_back({entry.key.hash, size, Now()});
+      continue;
+    }
+    base::MutexGuard guard(&mutex_);
+    auto it = index_.find(entry.key.hash);
+    if (it != index_.end() && it->second.size == size) {
+      total_size_ -= size;
+      index_.erase(it);
+    }
+  }
+  {
+    base::MutexGuard guard(&mutex_);
+    records.insert(records.end(), pending_records_.begin(),
+                   pending_records_.end());
+    pending_records_.clear();
+  }
+  AppendToIndexLog(records);
+
+  // Catch up with the entries that other processes added or removed, so that
+  // the maximum size holds for the whole directory.
+  ReadIndexLog();
+  {
+    base::MutexGuard guard(&mutex_);
+    EvictIfNeeded();
+    records = std::move(pending_records_);
+    pending_records_.clear();
+  }
+  AppendToIndexLog(records);
+  CompactIndexLogIfNeeded();
+}
+
+bool PersistentCodeCache::WriteEntry(const PendingEntry& entry) {
+  EntryHeader header;
+  header.magic = kEntryMagicNumber;
+  header.version_hash = Version::Hash();
+  header.flag_hash = FlagList::Hash();
+  header.source_length = entry.key.source_length;
+  header.payload_length = static_cast<uint32_t>(entry.payload.size());
+  header.reserved = 0;
+  header.hash = entry.key.hash;
+  header.check = entry.key.check;
+
+  std::string path = EntryPath(entry.key.hash);
+  if (!WriteFile(path, &header, sizeof(header), entry.payload.data(),
+                 entry.payload.size())) {
+    return false;
+  }
+  if (FLAG_trace_persistent_code_cache) {
+    PrintF("[PersistentCodeCache: stored %s (%zu bytes)]\n", path.c_str(),
+           sizeof(header) + entry.payload.size());
+  }
+  return true;
+}
+
+void PersistentCodeCache::RemoveEntry(uint64_t hash) {
+  base::OS::Remove(EntryPath(hash).c_str());
+  auto it = index_.find(hash);
+  if (it == index_.end()) return;
+  total_size_ -= it->second.size;
+  index_.erase(it);
+  pending_records_.push_back({hash, 0, 0});
+}
+
+void PersistentCodeCache::EvictIfNeeded() {
+  while (total_size_ > max_size_ && !index_.empty()) {
+    auto oldest = std::min_element(
+        index_.begin(), index_.end(), [](const auto& a, const auto& b) {
+          return a.second.last_use < b.second.last_use;
+        });
+    if (FLAG_trace_persistent_code_cache) {
+      PrintF("[PersistentCodeCache: evicted %016" PRIx64 " (%zu bytes)]\n",
+             oldest->first, oldest->second.size);
+    }
+    RemoveEntry(oldest->first);
+  }
+}
+
+void PersistentCodeCache::ApplyIndexLogRecord(const IndexLogRecord& record) {
+  auto it = index_.find(record.hash);
+  if (record.size == 0) {
+    if (it == index_.end()) return;
+    total_size_ -= it->second.size;
+    index_.erase(it);
+    return;
+  }
+  if (it == index_.end()) {
+    it = index_.emplace(record.hash, IndexRecord{0, record.last_use}).first;
+  }
+  total_size_ = total_size_ - it->second.size + record.size;
+  it->second.size = static_cast<size_t>(record.size);
+  it->second.last_use = std::max(it->second.last_use, record.last_use);
+}
+
+void PersistentCodeCache::ReadIndexLog() {
+  FILE* file = base::OS::FOpen(IndexPath().c_str(), "rb");
+  if (file == nullptr) {
+    index_log_offset_ = 0;
+    return;
+  }
+  IndexLogHeader header;
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      header.magic != kIndexMagicNumber) {
+    // The log is recreated on the next append.
+    fclose(file);
+    index_log_offset_ = 0;
+    return;
+  }
+  bool start_over =
+      index_log_offset_ == 0 || header.generation != index_log_generation_;
+  if (start_over) {
+    index_log_generation_ = header.generation;
+    index_log_offset_ = sizeof(header);
+    index_log_records_ = 0;
+  }
+  std::vector<IndexLogRecord> records;
+  if (fseek(file, static_cast<long>(index_log_offset_), SEEK_SET) == 0) {
+    // A record that another process is still appending is read next time.
+    IndexLogRecord record;
+    while (fread(&record, sizeof(record), 1, file) == 1) {
+      records.push_back(record);
+    }
+  }
+  fclose(file);
+  index_log_offset_ += records.size() * sizeof(IndexLogRecord);
+  index_log_records_ += records.size();
+
+  base::MutexGuard guard(&mutex_);
+  if (start_over) {
+    index_.clear();
+    total_size_ = 0;
+  }
+  for (const IndexLogRecord& record : records) ApplyIndexLogRecord(record);
+}
+
+void PersistentCodeCache::AppendToIndexLog(
+    const std::vector<IndexLogRecord>& records) {
+  if (records.empty()) return;
+  if (index_log_offset_ == 0) {
+    // There is no valid log yet; writing one from the in-memory index also
+    // covers {records}.
+    CompactIndexLog();
+    return;
+  }
+  // The file is opened in append mode and written unbuffered, so the records
+  // end up at the end of the log with a single write, even if other processes
+  // append at the same time.
+  FILE* file = base::OS::FOpen(IndexPath().c_str(), "ab");
+  if (file == nullptr) return;
+  setvbuf(file, nullptr, _IONBF, 0);
+  fwrite(records.data(), sizeof(IndexLogRecord), records.size(), file);
+  fclose(file);
+}
+
+void PersistentCodeCache::CompactIndexLogIfNeeded() {
+  size_t live_records;
+  {
+    base::MutexGuard guard(&mutex_);
+    live_records = index_.size();
+  }
+  if (index_log_records_ > 2 * live_records + kMinObsoleteIndexLogRecords) {
+    CompactIndexLog();
+  }
+}
+
+void PersistentCodeCache::CompactIndexLog() {
+  IndexLogHeader header;
+  header.magic = kIndexMagicNumber;
+  header.generation = static_cast<uint32_t>(Now());
+  if (header.generation == index_log_generation_) header.generation++;
+  header.reserved = 0;
+  std::vector<IndexLogRecord> records;
+  {
+    base::MutexGuard guard(&mutex_);
+    records.reserve(index_.size());
+    for (const auto& entry : index_) {
+      records.push_back(
+          {entry.first, entry.second.size, entry.second.last_use});
+    }
+  }
+  // Records that other processes append while the log is rewritten are lost.
+  // This only delays the eviction of their entries until they are looked up
+  // again.
+  if (WriteFile(IndexPath(), &header, sizeof(header), records.data(),
+                records.size() * sizeof(IndexLogRecord))) {
+    index_log_generation_ = header.generation;
+    index_log_offset_ =
+        sizeof(header) + records.size() * sizeof(IndexLogRecord);
+    index_log_records_ = records.size();
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,197 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_SNAPSHOT_PERSISTENT_CODE_CACHE_H_
+#define V8_SNAPSHOT_PERSISTENT_CODE_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include/v8.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+#include "src/common/globals.h"
+#include "src/handles/handles.h"
+#include "src/tasks/cancelable-task.h"
+
+namespace v8 {
+namespace internal {
+
+class SharedFunctionInfo;
+class String;
+
+// A code cache that persists serialized scripts (see CodeSerializer) in a
+// directory on disk, so that they survive process restarts. Entries are keyed
+// by a hash of the full source text and the script origin options; each entry
+// lives in its own file and is memory-mapped on lookup. Entries produced by a
+// different V8 version or with different flags are rejected and removed.
+// When the total size of all entries exceeds the configured maximum, the
+// least recently used entries are evicted.
+//
+// The directory must exist. Multiple processes may share a directory: entry
+// files are written to a temporary location first and then renamed into
+// place, so readers never observe partially written entries. The index is an
+// append-only log of fixed-size records, so that updates from different
+// processes do not overwrite each other; each process replays the records of
+// the others before evicting, which enforces the maximum size for the whole
+// directory. Entry files and index records are written on a worker thread.
+//
+// Scripts are not serialized when they are compiled, since at that point only
+// their toplevel code exists. They are scheduled instead, and serialized on
+// the main thread from a delayed task or when the isolate is torn down, so
+// that the entries also contain the functions that were compiled lazily while
+// the scripts ran.
+class V8_EXPORT_PRIVATE PersistentCodeCache {
+ public:
+  static constexpr size_t kDefaultMaxSize = 64 * MB;
+
+  // A memory-mapped cache entry. The payload stays valid for the lifetime of
+  // the entry.
+  class Entry {
+   public:
+    Entry(std::unique_ptr<base::OS::MemoryMappedFile> file, const byte* data,
+          int length)
+        : file_(std::move(file)), data_(data), length_(length) {}
+
+    const byte* data() const { return data_; }
+    int length() const { return length_; }
+
+   private:
+    std::unique_ptr<base::OS::MemoryMappedFile> file_;
+    const byte* data_;
+    int length_;
+  };
+
+  PersistentCodeCache(const char* directory, size_t max_size);
+  ~PersistentCodeCache();
+
+  PersistentCodeCache(const PersistentCodeCache&) = delete;
+  PersistentCodeCache& operator=(const PersistentCodeCache&) = delete;
+
+  // Returns the cached data for {source}, or nullptr if there is no valid
+  // entry.
+  std::unique_ptr<Entry> Lookup(Isolate* isolate, Handle<String> source,
+                                ScriptOriginOptions origin_options);
+
+  // Schedules {data} to be stored as the cached data for {source}. Existing
+  // entries are only replaced by larger ones, since those contain more
+  // compiled functions. Returns false if the entry is not written.
+  bool Store(Isolate* isolate, Handle<String> source,
+             ScriptOriginOptions origin_options, const byte* data, int length);
+
+  // Serializes the toplevel {shared} with the CodeSerializer and stores the
+  // result for its script source.
+  bool StoreScript(Isolate* isolate, Handle<SharedFunctionInfo> shared);
+
+  // Schedules the toplevel {shared} to be stored with StoreScript once its
+  // script had time to run. Scripts that were loaded from the cache are
+  // scheduled as well, so that their entries pick up the functions compiled
+  // in this run.
+  void ScheduleStoreScript(Isolate* isolate, Handle<SharedFunctionInfo> shared);
+
+  // Stores the scheduled scripts that are still alive. Called from a delayed
+  // task and when the isolate is torn down.
+  void StorePendingScripts(Isolate* isolate);
+
+  // Removes the entry for {source}, e.g. after it was rejected by the
+  // deserializer.
+  void Remove(Isolate* isolate, Handle<String> source,
+              ScriptOriginOptions origin_options);
+
+  // Writes all scheduled entries and index records. Blocks until a write
+  // that is in progress on a worker thread has finished.
+  void FlushPendingWrites();
+
+  size_t total_size() const { return total_size_; }
+  size_t max_size() const { return max_size_; }
+
+ private:
+  class StoreTask;
+  class WriteTask;
+
+  struct Key {
+    uint64_t hash;
+    uint64_t check;
+    uint32_t source_length;
+  };
+
+  struct IndexRecord {
+    size_t size;
+    int64_t last_use;
+  };
+
+  // A record of the index log. A size of zero marks a removed entry.
+  struct IndexLogRecord {
+    uint64_t hash;
+    uint64_t size;
+    int64_t last_use;
+  };
+
+  struct PendingEntry {
+    Key key;
+    std::vector<byte> payload;
+  };
+
+  Key ComputeKey(Isolate* isolate, Handle<String> source,
+                 ScriptOriginOptions origin_options) const;
+  std::string EntryPath(uint64_t hash) const;
+  std::string IndexPath() const;
+  std::string TemporaryPath(const std::string& path);
+
+  // Writes {header} followed by {data} into {path}. The file is written to a
+  // temporary location first and then renamed, so that the update is atomic.
+  bool WriteFile(const std::string& path, const void* header,
+                 size_t header_size, const void* data, size_t length);
+
+  bool WriteEntry(const PendingEntry& entry);
+
+  // Reads the records that were appended to the index log since the last
+  // call, including those written by other processes. Starts over if another
+  // process compacted the log in the meantime.
+  void ReadIndexLog();
+  // Appends {records} to the index log with a single write.
+  void AppendToIndexLog(const std::vector<IndexLogRecord>& records);
+  // Rewrites the index log from the in-memory index once it is mostly
+  // obsolete records.
+  void CompactIndexLogIfNeeded();
+  void CompactIndexLog();
+  void ApplyIndexLogRecord(const IndexLogRecord& record);
+
+  void ScheduleWrite();
+  void RemoveEntry(uint64_t hash);
+  void EvictIfNeeded();
+
+  const std::string directory_;
+  const size_t max_size_;
+
+  // Protects the in-memory index and the pending work.
+  base::Mutex mutex_;
+  std::unordered_map<uint64_t, IndexRecord> index_;
+  size_t total_size_ = 0;
+  std::vector<PendingEntry> pending_entries_;
+  std::vector<IndexLogRecord> pending_records_;
+  bool write_scheduled_ = false;
+
+  // Serializes writes to the directory. Acquired before {mutex_}.
+  base::Mutex write_mutex_;
+  int temporary_counter_ = 0;
+  uint32_t index_log_generation_ = 0;
+  size_t index_log_offset_ = 0;
+  size_t index_log_records_ = 0;
+
+  CancelableTaskManager task_manager_;
+
+  // Weak global handles to the toplevel SharedFunctionInfos of the scheduled
+  // scripts. They are cleared when a script dies. Only used on the main
+  // thread.
+  std::vector<std::unique_ptr<Address*>> pending_scripts_;
+  bool store_task_posted_ = false;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_SNAPSHOT_PERSISTENT_CODE_CACHE_H_
@@ -95,7 +95,11 @@ void StartupDeserializer::DeserializeStringTable() {
     DCHECK_EQ(*result, *string);
   }
 
-  DCHECK_EQ(string_table_size, isolate()->string_table()->NumberOfElements());
+  // Read-only strings are found in the shared string table, if there is one,
+  // and are not added to the Isolate's string table.
+  DCHECK_IMPLIES(isolate()->string_table()->shared_table() == nullptr,
+                 string_table_size ==
+                     isolate()->string_table()->NumberOfElements());
 }
 
 void StartupDeserializer::LogNewMapEvents() {
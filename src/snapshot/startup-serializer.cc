@@ -197,10 +197,15 @@ void StartupSerializer::SerializeStringTable(StringTable* string_table) {
   //   string N
   //
   // Notably, the hashmap structure, including empty and deleted elements, is
-  // not serialized.
+  // not serialized. The strings of the shared string table, if any, are
+  // serialized as well, so that the snapshot can be used without one.
 
-  sink_.PutInt(isolate()->string_table()->NumberOfElements(),
-               "String table number of elements");
+  const SharedStringTable* shared_table = string_table->shared_table();
+  int number_of_elements = string_table->NumberOfElements();
+  if (shared_table != nullptr) {
+    number_of_elements += shared_table->NumberOfElements();
+  }
+  sink_.PutInt(number_of_elements, "String table number of elements");
 
   // Custom RootVisitor which walks the string table, but only serializes the
   // string entries. This is an inline class to be able to access the non-public
@@ -234,7 +239,10 @@ void StartupSerializer::SerializeStringTable(StringTable* string_table) {
   };
 
   StartupSerializerStringTableVisitor string_table_visitor(this);
-  isolate()->string_table()->IterateElements(&string_table_visitor);
+  string_table->IterateElements(&string_table_visitor);
+  if (shared_table != nullptr) {
+    shared_table->IterateElements(&string_table_visitor);
+  }
 }
 
 void StartupSerializer::SerializeStrongReferences(
@@ -12,6 +12,7 @@
 #include "src/objects/fixed-array.h"
 #include "src/objects/objects.h"
 #include "src/objects/string-inl.h"
+#include "src/utils/memcopy.h"
 #include "src/utils/utils.h"
 
 namespace v8 {
@@ -117,6 +118,20 @@ class IncrementalStringBuilder {
  public:
   explicit IncrementalStringBuilder(Isolate* isolate);
 
+  // Receives the finished parts of the string instead of the accumulator,
+  // e.g. to write them out as they are produced. The string then never
+  // exists as a whole, and Finish() returns the empty string.
+  class PartSink {
+   public:
+    virtual ~PartSink() = default;
+    virtual void Write(Handle<String> part) = 0;
+  };
+
+  void set_part_sink(PartSink* part_sink) {
+    DCHECK_EQ(0, Length());
+    part_sink_ = part_sink;
+  }
+
   V8_INLINE String::Encoding CurrentEncoding() { return encoding_; }
 
   template <typename SrcChar, typename DestChar>
@@ -158,6 +173,12 @@ class IncrementalStringBuilder {
     return part_length_ - current_index_ > length;
   }
 
+  // The number of characters that a NoExtendBuilder can append to the current
+  // part.
+  V8_INLINE int CurrentPartRemaining() {
+    return part_length_ - current_index_ - 1;
+  }
+
   // We make a rough estimate to find out if the current string can be
   // serialized without allocating a new string part. The worst case length of
   // an escaped character is 6. Shifting the remaining string length right by 3
@@ -208,6 +229,12 @@ class IncrementalStringBuilder {
       const uint8_t* u = reinterpret_cast<const uint8_t*>(s);
       while (*u != '\0') Append(*(u++));
     }
+    template <typename SrcChar>
+    V8_INLINE void AppendChars(const SrcChar* chars, int length) {
+      DCHECK_LE(sizeof(SrcChar), sizeof(DestChar));
+      CopyChars(cursor_, chars, length);
+      cursor_ += length;
+    }
 
     int written() { return static_cast<int>(cursor_ - start_); }
 
@@ -299,6 +326,7 @@ class IncrementalStringBuilder {
   int current_index_;
   Handle<String> accumulator_;
   Handle<String> current_part_;
+  PartSink* part_sink_ = nullptr;
 };
 
 template <typename SrcChar, typename DestChar>
@@ -246,6 +246,10 @@ int IncrementalStringBuilder::Length() const {
 }
 
 void IncrementalStringBuilder::Accumulate(Handle<String> new_part) {
+  if (part_sink_ != nullptr) {
+    if (new_part->length() > 0) part_sink_->Write(new_part);
+    return;
+  }
   Handle<String> new_accumulator;
   if (accumulator()->length() + new_part->length() > String::kMaxLength) {
     // Set the flag and carry on. Delay throwing the exception till the end.
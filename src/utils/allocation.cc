@@ -203,6 +203,15 @@ bool SetPermissions(v8::PageAllocator* page_allocator, void* address,
   return page_allocator->SetPermissions(address, size, access);
 }
 
+void AdviseHugePages(Address address, size_t size) {
+  if (!FLAG_transparent_huge_pages) return;
+  Address begin = RoundUp(address, kHugePageSize);
+  Address end = RoundDown(address + size, kHugePageSize);
+  if (begin >= end) return;
+  // This is advisory; the memory works the same without huge pages.
+  USE(base::OS::AdviseHugePages(reinterpret_cast<void*>(begin), end - begin));
+}
+
 bool OnCriticalMemoryPressure(size_t length) {
   // TODO(bbudge) Rework retry logic once embedders implement the more
   // informative overload.
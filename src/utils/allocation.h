@@ -156,6 +156,13 @@ inline bool SetPermissions(v8::PageAllocator* page_allocator, Address address,
                         access);
 }
 
+// The size of transparent huge pages on x64 and arm64 Linux.
+constexpr size_t kHugePageSize = 2 * MB;
+
+// Asks the OS to back the |kHugePageSize|-aligned part of the given region
+// with transparent huge pages if --transparent-huge-pages is set.
+V8_EXPORT_PRIVATE void AdviseHugePages(Address address, size_t size);
+
 // Function that may release reserved memory regions to allow failed allocations
 // to succeed. |length| is the amount of memory needed. Returns |true| if memory
 // could be released, false otherwise.
@@ -8,14 +8,46 @@
 
 #include "include/v8.h"
 #include "src/api/api-inl.h"
+#include "src/base/memory.h"
 #include "src/base/platform/wrappers.h"
+#include "src/handles/global-handles.h"
 #include "src/handles/handles.h"
+#include "src/objects/backing-store.h"
 #include "src/objects/contexts.h"
+#include "src/objects/js-array-buffer-inl.h"
+#include "src/objects/js-collection-inl.h"
+#include "src/objects/managed.h"
+#include "src/objects/ordered-hash-table.h"
 #include "src/objects/script.h"
 
 namespace v8 {
 namespace internal {
 
+namespace {
+
+// Integers are zigzag encoded, so that small negative integers stay small.
+uint32_t ZigZagEncode(int32_t value) {
+  return (static_cast<uint32_t>(value) << 1) ^
+         static_cast<uint32_t>(value >> 31);
+}
+
+int32_t ZigZagDecode(uint32_t value) {
+  return static_cast<int32_t>((value >> 1) ^ (0u - (value & 1)));
+}
+
+size_t TypedArrayElementSize(ExternalArrayType type) {
+  switch (type) {
+#define TYPED_ARRAY_CASE(Type, type, TYPE, ctype) \
+  case kExternal##Type##Array:                    \
+    return sizeof(ctype);
+    TYPED_ARRAYS(TYPED_ARRAY_CASE)
+#undef TYPED_ARRAY_CASE
+  }
+  UNREACHABLE();
+}
+
+}  // namespace
+
 // When encountering an error during deserializing, we note down the error but
 // don't bail out from processing the snapshot further. This is to speed up
 // deserialization; the error case is now slower since we don't bail out, but
@@ -52,7 +84,9 @@ WebSnapshotSerializer::WebSnapshotSerializer(v8::Isolate* isolate)
       map_ids_(isolate_->heap()),
       context_ids_(isolate_->heap()),
       function_ids_(isolate_->heap()),
-      object_ids_(isolate_->heap()) {}
+      object_ids_(isolate_->heap()),
+      discovered_objects_(isolate_->heap()),
+      array_buffer_ids_(isolate_->heap()) {}
 
 WebSnapshotSerializer::~WebSnapshotSerializer() {}
 
@@ -88,61 +122,46 @@ bool WebSnapshotSerializer::TakeSnapshot(
 }
 
 // Format (full snapshot):
-// - String count
-// - For each string:
-//   - Serialized string
-// - Shape count
-// - For each shape:
-//   - Serialized shape
-// - Context count
-// - For each context:
-//   - Serialized context
-// - Function count
-// - For each function:
-//   - Serialized function
-// - Object count
-// - For each object:
-//   - Serialized object
-// - Export count
-// - For each export:
-//   - Serialized export
+// - Strings section
+// - Shapes section
+// - Contexts section
+// - Functions section
+// - Objects section
+// - Exports section
+//
+// Format (section):
+// - Item count
+// - Byte length of the items
+// - For each item:
+//   - Serialized item
+//
+// The byte lengths allow deserializing the snapshot section by section while
+// it is being streamed in, and skipping over the sections which are
+// materialized lazily.
 void WebSnapshotSerializer::WriteSnapshot(uint8_t*& buffer,
                                           size_t& buffer_size) {
-  while (!pending_objects_.empty()) {
-    const Handle<JSObject>& object = pending_objects_.front();
-    SerializePendingObject(object);
-    pending_objects_.pop();
-  }
-
   ValueSerializer total_serializer(isolate_, nullptr);
   size_t needed_size =
       string_serializer_.buffer_size_ + map_serializer_.buffer_size_ +
       context_serializer_.buffer_size_ + function_serializer_.buffer_size_ +
       object_serializer_.buffer_size_ + export_serializer_.buffer_size_ +
-      6 * sizeof(uint32_t);
+      12 * sizeof(uint32_t);
   if (total_serializer.ExpandBuffer(needed_size).IsNothing()) {
     Throw("Web snapshot: Out of memory");
     return;
   }
 
-  total_serializer.WriteUint32(static_cast<uint32_t>(string_count()));
-  total_serializer.WriteRawBytes(string_serializer_.buffer_,
-                                 string_serializer_.buffer_size_);
-  total_serializer.WriteUint32(static_cast<uint32_t>(map_count()));
-  total_serializer.WriteRawBytes(map_serializer_.buffer_,
-                                 map_serializer_.buffer_size_);
-  total_serializer.WriteUint32(static_cast<uint32_t>(context_count()));
-  total_serializer.WriteRawBytes(context_serializer_.buffer_,
-                                 context_serializer_.buffer_size_);
-  total_serializer.WriteUint32(static_cast<uint32_t>(function_count()));
-  total_serializer.WriteRawBytes(function_serializer_.buffer_,
-                                 function_serializer_.buffer_size_);
-  total_serializer.WriteUint32(static_cast<uint32_t>(object_count()));
-  total_serializer.WriteRawBytes(object_serializer_.buffer_,
-                                 object_serializer_.buffer_size_);
-  total_serializer.WriteUint32(export_count_);
-  total_serializer.WriteRawBytes(export_serializer_.buffer_,
-                                 export_serializer_.buffer_size_);
+  WriteSection(total_serializer, static_cast<uint32_t>(string_count()),
+               string_serializer_);
+  WriteSection(total_serializer, static_cast<uint32_t>(map_count()),
+               map_serializer_);
+  WriteSection(total_serializer, static_cast<uint32_t>(context_count()),
+               context_serializer_);
+  WriteSection(total_serializer, static_cast<uint32_t>(function_count()),
+               function_serializer_);
+  WriteSection(total_serializer, static_cast<uint32_t>(object_count()),
+               object_serializer_);
+  WriteSection(total_serializer, export_count_, export_serializer_);
 
   if (has_error()) {
     return;
@@ -153,6 +172,20 @@ void WebSnapshotSerializer::WriteSnapshot(uint8_t*& buffer,
   buffer_size = result.second;
 }
 
+void WebSnapshotSerializer::WriteSection(
+    ValueSerializer& total_serializer, uint32_t count,
+    const ValueSerializer& section_serializer) {
+  if (section_serializer.buffer_size_ > std::numeric_limits<uint32_t>::max()) {
+    Throw("Web snapshot: Section too large");
+    return;
+  }
+  total_serializer.WriteUint32(count);
+  total_serializer.WriteUint32(
+      static_cast<uint32_t>(section_serializer.buffer_size_));
+  total_serializer.WriteRawBytes(section_serializer.buffer_,
+                                 section_serializer.buffer_size_);
+}
+
 bool WebSnapshotSerializer::InsertIntoIndexMap(ObjectCacheIndexMap& map,
                                                Handle<HeapObject> object,
                                                uint32_t& id) {
@@ -239,6 +272,10 @@ void WebSnapshotSerializer::SerializeMap(Handle<Map> map, uint32_t& id) {
 // Format (serialized function):
 // - 0 if there's no context, 1 + context id otherwise
 // - String id (source string)
+// - Function type (FunctionType enum)
+//
+// Class constructors are recreated by evaluating the source of the whole
+// class, which also recreates the prototype methods and static members.
 void WebSnapshotSerializer::SerializeFunction(Handle<JSFunction> function,
                                               uint32_t& id) {
   if (InsertIntoIndexMap(function_ids_, function, id)) {
@@ -250,6 +287,26 @@ void WebSnapshotSerializer::SerializeFunction(Handle<JSFunction> function,
     return;
   }
 
+  if (function->shared().is_class_constructor()) {
+    // The class scope is recreated by evaluating the class, but any other
+    // context would be lost.
+    Context context = function->context();
+    while (context.IsBlockContext() &&
+           context.scope_info().scope_type() == CLASS_SCOPE) {
+      context = context.previous();
+    }
+    if (!context.IsNativeContext() && !context.IsScriptContext()) {
+      Throw("Web snapshot: Classes with a context not supported");
+      return;
+    }
+    function_serializer_.WriteUint32(0);
+    uint32_t source_id = 0;
+    SerializeString(JSFunction::ToString(function), source_id);
+    function_serializer_.WriteUint32(source_id);
+    function_serializer_.WriteUint32(FunctionType::CLASS_CONSTRUCTOR);
+    return;
+  }
+
   Handle<Context> context(function->context(), isolate_);
   if (context->IsNativeContext()) {
     function_serializer_.WriteUint32(0);
@@ -273,6 +330,7 @@ void WebSnapshotSerializer::SerializeFunction(Handle<JSFunction> function,
   uint32_t source_id = 0;
   SerializeString(source, source_id);
   function_serializer_.WriteUint32(source_id);
+  function_serializer_.WriteUint32(FunctionType::NORMAL_FUNCTION);
 
   // TODO(v8:11525): Serialize .prototype.
   // TODO(v8:11525): Support properties in functions.
@@ -323,21 +381,100 @@ void WebSnapshotSerializer::SerializeContext(Handle<Context> context,
   }
 }
 
+// Format (serialized object):
+// - Object type (ObjectType enum)
+// - Data, depending on the object type (see below)
+//
+// The objects an object refers to are serialized before it and thus have lower
+// ids, which allows deserializing (and lazily materializing) each object after
+// the objects it refers to. Cycles are not supported.
 void WebSnapshotSerializer::SerializeObject(Handle<JSObject> object,
                                             uint32_t& id) {
   DCHECK(!object->IsJSFunction());
-  if (InsertIntoIndexMap(object_ids_, object, id)) {
+  // Can't use InsertIntoIndexMap here, because the objects this object refers
+  // to need to get lower ids.
+  int index_out = 0;
+  if (object_ids_.Lookup(object, &index_out)) {
+    id = static_cast<uint32_t>(index_out);
+    return;
+  }
+  if (discovered_objects_.LookupOrInsert(object, &index_out)) {
+    // TODO(v8:11525): Support cycles.
+    Throw("Web snapshot: Cycles not supported");
+    return;
+  }
+
+  if (object->IsJSTypedArray()) {
+    // Typed arrays don't refer to other objects, so they can be written to the
+    // objects section directly, which is needed for aligning the contents.
+    InsertIntoIndexMap(object_ids_, object, id);
+    SerializeTypedArray(Handle<JSTypedArray>::cast(object));
     return;
   }
-  pending_objects_.push(object);
+
+  StackLimitCheck stack_check(isolate_);
+  if (stack_check.HasOverflowed()) {
+    Throw("Web snapshot: Too deeply nested objects");
+    return;
+  }
+
+  // Writing the object to a separate buffer first lets the objects it refers
+  // to be written to the objects section while we're serializing it.
+  ValueSerializer item_serializer(isolate_, nullptr);
+  switch (object->map().instance_type()) {
+    case JS_ARRAY_TYPE:
+      SerializeArray(Handle<JSArray>::cast(object), item_serializer);
+      break;
+    case JS_MAP_TYPE:
+      SerializeJSMap(Handle<JSMap>::cast(object), item_serializer);
+      break;
+    case JS_SET_TYPE:
+      SerializeJSSet(Handle<JSSet>::cast(object), item_serializer);
+      break;
+    default:
+      SerializePlainObject(object, item_serializer);
+      break;
+  }
+
+  InsertIntoIndexMap(object_ids_, object, id);
+  object_serializer_.WriteRawBytes(item_serializer.buffer_,
+                                   item_serializer.buffer_size_);
 }
 
-// Format (serialized object):
+// Format (serialized plain object or class instance):
 // - Shape id
+// - Function id (class constructor), for class instances only
 // - For each property:
 //   - Serialized value
-void WebSnapshotSerializer::SerializePendingObject(Handle<JSObject> object) {
+void WebSnapshotSerializer::SerializePlainObject(Handle<JSObject> object,
+                                                 ValueSerializer& serializer) {
   Handle<Map> map(object->map(), isolate_);
+  if (map->instance_type() != JS_OBJECT_TYPE) {
+    Throw("Web snapshot: Unsupported object");
+    return;
+  }
+
+  Handle<HeapObject> prototype(map->prototype(), isolate_);
+  uint32_t constructor_id = 0;
+  bool is_class_instance =
+      *prototype != isolate_->native_context()->initial_object_prototype();
+  if (is_class_instance) {
+    Handle<Object> constructor = isolate_->factory()->undefined_value();
+    if (prototype->IsJSReceiver()) {
+      constructor = JSReceiver::GetDataProperty(
+          Handle<JSReceiver>::cast(prototype),
+          isolate_->factory()->constructor_string());
+    }
+    if (!constructor->IsJSFunction() ||
+        !JSFunction::cast(*constructor).shared().is_class_constructor() ||
+        !JSFunction::cast(*constructor).has_instance_prototype() ||
+        JSFunction::cast(*constructor).instance_prototype() != *prototype) {
+      Throw("Web snapshot: Unsupported prototype");
+      return;
+    }
+    SerializeFunction(Handle<JSFunction>::cast(constructor), constructor_id);
+  }
+
   uint32_t map_id = 0;
   SerializeMap(map, map_id);
 
@@ -346,7 +483,12 @@ void WebSnapshotSerializer::SerializePendingObject(Handle<JSObject> object) {
     return;
   }
 
-  object_serializer_.WriteUint32(map_id);
+  serializer.WriteUint32(is_class_instance ? ObjectType::CLASS_INSTANCE
+                                           : ObjectType::PLAIN_OBJECT);
+  serializer.WriteUint32(map_id);
+  if (is_class_instance) {
+    serializer.WriteUint32(constructor_id);
+  }
 
   for (InternalIndex i : map->IterateOwnDescriptors()) {
     PropertyDetails details =
@@ -354,7 +496,190 @@ void WebSnapshotSerializer::SerializePendingObject(Handle<JSObject> object) {
     FieldIndex field_index = FieldIndex::ForDescriptor(*map, i);
     Handle<Object> value =
         JSObject::FastPropertyAt(object, details.representation(), field_index);
-    WriteValue(value, object_serializer_);
+    WriteValue(value, serializer);
+  }
+}
+
+// Format (serialized array):
+// - Array type (ArrayType enum)
+// - Length
+// - For each element:
+//   - Zigzag encoded integer (for SMI_ARRAY)
+//   - Raw double (for DOUBLE_ARRAY)
+//   - Serialized value (for TAGGED_ARRAY)
+void WebSnapshotSerializer::SerializeArray(Handle<JSArray> array,
+                                           ValueSerializer& serializer) {
+  if (array->map().prototype() !=
+          isolate_->native_context()->initial_array_prototype() ||
+      array->map().NumberOfOwnDescriptors() != 1) {
+    // TODO(v8:11525): Support properties in arrays.
+    Throw("Web snapshot: Unsupported array");
+    return;
+  }
+  if (!array->length().IsSmi()) {
+    Throw("Web snapshot: Unsupported array");
+    return;
+  }
+  int length = Smi::ToInt(array->length());
+  ElementsKind kind = array->GetElementsKind();
+  if (IsSmiElementsKind(kind)) {
+    serializer.WriteUint32(ArrayType::SMI_ARRAY);
+    serializer.WriteUint32(static_cast<uint32_t>(length));
+    FixedArray elements = FixedArray::cast(array->elements());
+    for (int i = 0; i < length; ++i) {
+      Object element = elements.get(i);
+      if (!element.IsSmi()) {
+        // TODO(v8:11525): Support holey arrays.
+        Throw("Web snapshot: Holey arrays not supported");
+        return;
+      }
+      serializer.WriteUint32(ZigZagEncode(Smi::ToInt(element)));
+    }
+  } else if (IsDoubleElementsKind(kind)) {
+    serializer.WriteUint32(ArrayType::DOUBLE_ARRAY);
+    serializer.WriteUint32(static_cast<uint32_t>(length));
+    if (length == 0) return;
+    FixedDoubleArray elements = FixedDoubleArray::cast(array->elements());
+    for (int i = 0; i < length; ++i) {
+      if (elements.is_the_hole(i)) {
+        Throw("Web snapshot: Holey arrays not supported");
+        return;
+      }
+      serializer.WriteDouble(elements.get_scalar(i));
+    }
+  } else if (IsObjectElementsKind(kind)) {
+    serializer.WriteUint32(ArrayType::TAGGED_ARRAY);
+    serializer.WriteUint32(static_cast<uint32_t>(length));
+    Handle<FixedArray> elements(FixedArray::cast(array->elements()), isolate_);
+    for (int i = 0; i < length; ++i) {
+      Handle<Object> element(elements->get(i), isolate_);
+      if (element->IsTheHole(isolate_)) {
+        Throw("Web snapshot: Holey arrays not supported");
+        return;
+      }
+      WriteValue(element, serializer);
+    }
+  } else {
+    // TODO(v8:11525): Support dictionary elements.
+    Throw("Web snapshot: Unsupported array");
+  }
+}
+
+// Format (serialized typed array):
+// - Element type (ExternalArrayType enum)
+// - Length
+// - Padding length, followed by that many zero bytes, so that the contents are
+//   aligned to kTypedArrayAlignment relative to the start of the objects
+//   section
+// - Raw bytes (contents)
+void WebSnapshotSerializer::SerializeTypedArray(
+    Handle<JSTypedArray> typed_array) {
+  if (typed_array->map().NumberOfOwnDescriptors() != 0) {
+    // TODO(v8:11525): Support properties in typed arrays.
+    Throw("Web snapshot: Unsupported typed array");
+    return;
+  }
+  if (typed_array->WasDetached()) {
+    Throw("Web snapshot: Detached typed arrays not supported");
+    return;
+  }
+  if (typed_array->length() > std::numeric_limits<uint32_t>::max()) {
+    Throw("Web snapshot: Typed array too large");
+    return;
+  }
+  Handle<JSArrayBuffer> buffer(JSArrayBuffer::cast(typed_array->buffer()),
+                               isolate_);
+  int buffer_id = 0;
+  if (buffer->is_shared() || typed_array->byte_offset() != 0 ||
+      typed_array->byte_length() != buffer->byte_length() ||
+      array_buffer_ids_.LookupOrInsert(buffer, &buffer_id)) {
+    // TODO(v8:11525): Support typed arrays which share their buffer.
+    Throw("Web snapshot: Typed arrays sharing a buffer not supported");
+    return;
+  }
+
+  size_t byte_length = typed_array->byte_length();
+  object_serializer_.WriteUint32(ObjectType::TYPED_ARRAY_OBJECT);
+  object_serializer_.WriteUint32(typed_array->type());
+  object_serializer_.WriteUint32(static_cast<uint32_t>(typed_array->length()));
+  // The padding length fits in a single byte.
+  STATIC_ASSERT(kTypedArrayAlignment <= 0x80);
+  size_t padding =
+      RoundUp(object_serializer_.buffer_size_ + 1, kTypedArrayAlignment) -
+      (object_serializer_.buffer_size_ + 1);
+  object_serializer_.WriteUint32(static_cast<uint32_t>(padding));
+  static const uint8_t kZeros[kTypedArrayAlignment] = {0};
+  object_serializer_.WriteRawBytes(kZeros, padding);
+  DCHECK(IsAligned(object_serializer_.buffer_size_, kTypedArrayAlignment));
+  DisallowGarbageCollection no_gc;
+  object_serializer_.WriteRawBytes(typed_array->DataPtr(), byte_length);
+}
+
+// Format (serialized Map):
+// - Entry count
+// - For each entry:
+//   - Serialized key
+//   - Serialized value
+void WebSnapshotSerializer::SerializeJSMap(Handle<JSMap> map,
+                                           ValueSerializer& serializer) {
+  if (map->map() != isolate_->native_context()->js_map_map()) {
+    // TODO(v8:11525): Support subclasses and properties.
+    Throw("Web snapshot: Unsupported Map");
+    return;
+  }
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(map->table()), isolate_);
+  int length = table->NumberOfElements() * 2;
+  Handle<FixedArray> entries = isolate_->factory()->NewFixedArray(length);
+  {
+    DisallowGarbageCollection no_gc;
+    Oddball the_hole = ReadOnlyRoots(isolate_).the_hole_value();
+    int result_index = 0;
+    for (InternalIndex entry : table->IterateEntries()) {
+      Object key = table->KeyAt(entry);
+      if (key == the_hole) continue;
+      entries->set(result_index++, key);
+      entries->set(result_index++, table->ValueAt(entry));
+    }
+    DCHECK_EQ(result_index, length);
+  }
+
+  serializer.WriteUint32(ObjectType::MAP_OBJECT);
+  serializer.WriteUint32(static_cast<uint32_t>(length / 2));
+  for (int i = 0; i < length; ++i) {
+    WriteValue(handle(entries->get(i), isolate_), serializer);
+  }
+}
+
+// Format (serialized Set):
+// - Entry count
+// - For each entry:
+//   - Serialized value
+void WebSnapshotSerializer::SerializeJSSet(Handle<JSSet> set,
+                                           ValueSerializer& serializer) {
+  if (set->map() != isolate_->native_context()->js_set_map()) {
+    // TODO(v8:11525): Support subclasses and properties.
+    Throw("Web snapshot: Unsupported Set");
+    return;
+  }
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(set->table()), isolate_);
+  int length = table->NumberOfElements();
+  Handle<FixedArray> entries = isolate_->factory()->NewFixedArray(length);
+  {
+    DisallowGarbageCollection no_gc;
+    Oddball the_hole = ReadOnlyRoots(isolate_).the_hole_value();
+    int result_index = 0;
+    for (InternalIndex entry : table->IterateEntries()) {
+      Object key = table->KeyAt(entry);
+      if (key == the_hole) continue;
+      entries->set(result_index++, key);
+    }
+    DCHECK_EQ(result_index, length);
+  }
+
+  serializer.WriteUint32(ObjectType::SET_OBJECT);
+  serializer.WriteUint32(static_cast<uint32_t>(length));
+  for (int i = 0; i < length; ++i) {
+    WriteValue(handle(entries->get(i), isolate_), serializer);
   }
 }
 
@@ -387,24 +712,45 @@ void WebSnapshotSerializer::WriteValue(Handle<Object> object,
                                        ValueSerializer& serializer) {
   uint32_t id = 0;
   if (object->IsSmi()) {
-    // TODO(v8:11525): Implement.
-    UNREACHABLE();
+    serializer.WriteUint32(ValueType::INTEGER);
+    serializer.WriteUint32(ZigZagEncode(Smi::ToInt(*object)));
+    return;
   }
 
   DCHECK(object->IsHeapObject());
   switch (HeapObject::cast(*object).map().instance_type()) {
     case ODDBALL_TYPE:
-      // TODO(v8:11525): Implement.
-      UNREACHABLE();
+      switch (Oddball::cast(*object).kind()) {
+        case Oddball::kFalse:
+          serializer.WriteUint32(ValueType::FALSE_CONSTANT);
+          return;
+        case Oddball::kTrue:
+          serializer.WriteUint32(ValueType::TRUE_CONSTANT);
+          return;
+        case Oddball::kNull:
+          serializer.WriteUint32(ValueType::NULL_CONSTANT);
+          return;
+        case Oddball::kUndefined:
+          serializer.WriteUint32(ValueType::UNDEFINED_CONSTANT);
+          return;
+        default:
+          Throw("Web snapshot: Unsupported oddball");
+          return;
+      }
     case HEAP_NUMBER_TYPE:
-      // TODO(v8:11525): Implement.
-      UNREACHABLE();
+      serializer.WriteUint32(ValueType::DOUBLE);
+      serializer.WriteDouble(HeapNumber::cast(*object).value());
+      break;
     case JS_FUNCTION_TYPE:
       SerializeFunction(Handle<JSFunction>::cast(object), id);
       serializer.WriteUint32(ValueType::FUNCTION_ID);
       serializer.WriteUint32(id);
       break;
     case JS_OBJECT_TYPE:
+    case JS_ARRAY_TYPE:
+    case JS_TYPED_ARRAY_TYPE:
+    case JS_MAP_TYPE:
+    case JS_SET_TYPE:
       SerializeObject(Handle<JSObject>::cast(object), id);
       serializer.WriteUint32(ValueType::OBJECT_ID);
       serializer.WriteUint32(id);
@@ -421,13 +767,119 @@ void WebSnapshotSerializer::WriteValue(Handle<Object> object,
   // TODO(v8:11525): Support more types.
 }
 
-WebSnapshotDeserializer::WebSnapshotDeserializer(v8::Isolate* isolate)
+struct WebSnapshotDeserializer::LazyData {
+  // The serialized items of a section, and the offset of each item.
+  struct Items {
+    std::vector<uint8_t> data;
+    std::vector<uint32_t> offsets;
+
+    // Returns the serialized data starting at the item with {id}.
+    Vector<const uint8_t> Get(uint32_t id) const {
+      DCHECK_LT(id, offsets.size());
+      uint32_t offset = offsets[id];
+      return Vector<const uint8_t>(data.data() + offset, data.size() - offset);
+    }
+
+    size_t size() const {
+      return data.size() + offsets.size() * sizeof(uint32_t);
+    }
+  };
+
+  size_t size() const {
+    return strings.size() + functions.size() + objects.size();
+  }
+
+  Items strings;
+  Items functions;
+  Items objects;
+};
+
+WebSnapshotDeserializer::WebSnapshotDeserializer(v8::Isolate* isolate,
+                                                 Mode mode)
     : WebSnapshotSerializerDeserializer(
-          reinterpret_cast<v8::internal::Isolate*>(isolate)) {}
+          reinterpret_cast<v8::internal::Isolate*>(isolate)),
+      mode_(mode),
+      owns_state_(true) {
+  Handle<FixedArray> state = isolate_->factory()->NewFixedArray(kStateLength);
+  for (int i = 0; i < kLazyDataIndex; ++i) {
+    state->set(i, ReadOnlyRoots(isolate_).empty_fixed_array());
+  }
+  state_ = isolate_->global_handles()->Create(*state);
+  if (mode_ == Mode::kLazy) {
+    lazy_data_ = std::make_shared<LazyData>();
+  }
+}
+
+WebSnapshotDeserializer::WebSnapshotDeserializer(Isolate* isolate,
+                                                 Handle<FixedArray> state)
+    : WebSnapshotSerializerDeserializer(isolate),
+      mode_(Mode::kLazy),
+      next_section_(Section::kDone),
+      state_(state),
+      owns_state_(false),
+      lazy_data_(Managed<LazyData>::cast(state->get(kLazyDataIndex)).get()) {}
+
+WebSnapshotDeserializer::~WebSnapshotDeserializer() {
+  if (owns_state_) {
+    GlobalHandles::Destroy(state_.location());
+  }
+}
+
+FixedArray WebSnapshotDeserializer::table(StateIndex index) const {
+  DCHECK_LT(index, kLazyDataIndex);
+  return FixedArray::cast(state_->get(index));
+}
+
+Handle<FixedArray> WebSnapshotDeserializer::NewTable(StateIndex index,
+                                                     uint32_t count) {
+  Handle<FixedArray> table = isolate_->factory()->NewFixedArray(count);
+  state_->set(index, *table);
+  return table;
+}
+
+size_t WebSnapshotDeserializer::string_count() const {
+  return table(kStringsIndex).length();
+}
+
+size_t WebSnapshotDeserializer::map_count() const {
+  return table(kMapsIndex).length();
+}
+
+size_t WebSnapshotDeserializer::context_count() const {
+  return table(kContextsIndex).length();
+}
+
+size_t WebSnapshotDeserializer::function_count() const {
+  return table(kFunctionsIndex).length();
+}
+
+size_t WebSnapshotDeserializer::object_count() const {
+  return table(kObjectsIndex).length();
+}
+
+namespace {
+
+size_t CountMaterialized(Isolate* isolate, FixedArray table) {
+  size_t count = 0;
+  for (int i = 0; i < table.length(); ++i) {
+    if (!table.get(i).IsUndefined(isolate)) ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+size_t WebSnapshotDeserializer::materialized_function_count() const {
+  return CountMaterialized(isolate_, table(kFunctionsIndex));
+}
+
+size_t WebSnapshotDeserializer::materialized_object_count() const {
+  return CountMaterialized(isolate_, table(kObjectsIndex));
+}
 
 bool WebSnapshotDeserializer::UseWebSnapshot(const uint8_t* data,
                                              size_t buffer_size) {
-  if (strings_.size() > 0) {
+  if (next_section_ != Section::kStrings || !stream_buffer_.empty()) {
     Throw("Web snapshot: Can't reuse WebSnapshotDeserializer");
     return false;
   }
@@ -440,13 +892,10 @@ bool WebSnapshotDeserializer::UseWebSnapshot(const uint8_t* data,
 
   HandleScope scope(isolate_);
   size_t ix = 0;
-  DeserializeStrings(data, ix, buffer_size);
-  DeserializeMaps(data, ix, buffer_size);
-  DeserializeContexts(data, ix, buffer_size);
-  DeserializeFunctions(data, ix, buffer_size);
-  DeserializeObjects(data, ix, buffer_size);
-  DeserializeExports(data, ix, buffer_size);
-  if (ix != buffer_size) {
+  while (next_section_ != Section::kDone &&
+         DeserializeSection(data, ix, buffer_size)) {
+  }
+  if (next_section_ != Section::kDone || ix != buffer_size) {
     Throw("Web snapshot: Snapshot length mismatch");
     return false;
   }
@@ -461,51 +910,162 @@ bool WebSnapshotDeserializer::UseWebSnapshot(const uint8_t* data,
   return !has_error();
 }
 
-void WebSnapshotDeserializer::DeserializeStrings(const uint8_t* data,
+bool WebSnapshotDeserializer::AppendChunk(const uint8_t* data, size_t size) {
+  if (next_section_ == Section::kDone) {
+    Throw("Web snapshot: Snapshot length mismatch");
+    return false;
+  }
+  stream_buffer_.insert(stream_buffer_.end(), data, data + size);
+
+  HandleScope scope(isolate_);
+  size_t ix = 0;
+  while (next_section_ != Section::kDone &&
+         DeserializeSection(stream_buffer_.data(), ix, stream_buffer_.size())) {
+  }
+  // Only keep the incomplete section around.
+  stream_buffer_.erase(stream_buffer_.begin(), stream_buffer_.begin() + ix);
+  return !has_error();
+}
+
+bool WebSnapshotDeserializer::FinishStreaming() {
+  if (next_section_ != Section::kDone || !stream_buffer_.empty()) {
+    Throw("Web snapshot: Snapshot length mismatch");
+    return false;
+  }
+  return !has_error();
+}
+
+bool WebSnapshotDeserializer::DeserializeSection(const uint8_t* data,
                                                  size_t& ix, size_t size) {
-  ValueDeserializer deserializer(isolate_, &data[ix], size - ix);
+  DCHECK_NE(next_section_, Section::kDone);
+  ValueDeserializer header_deserializer(isolate_, &data[ix], size - ix);
   uint32_t count;
-  if (!deserializer.ReadUint32(&count)) {
-    Throw("Web snapshot: Malformed string table");
+  uint32_t length;
+  if (!header_deserializer.ReadUint32(&count) ||
+      !header_deserializer.ReadUint32(&length)) {
+    return false;
+  }
+  size_t start = header_deserializer.position_ - data;
+  if (length > size - start) {
+    return false;
+  }
+
+  // Every item takes at least one byte, which bounds the table sizes by the
+  // size of the snapshot.
+  if (count > length) {
+    Throw("Web snapshot: Malformed section");
+  } else {
+    ValueDeserializer deserializer(isolate_, &data[start], length);
+    switch (next_section_) {
+      case Section::kStrings:
+        DeserializeStrings(deserializer, count);
+        break;
+      case Section::kMaps:
+        DeserializeMaps(deserializer, count);
+        break;
+      case Section::kContexts:
+        DeserializeContexts(deserializer, count);
+        break;
+      case Section::kFunctions:
+        DeserializeFunctions(deserializer, count);
+        break;
+      case Section::kObjects:
+        DeserializeObjects(deserializer, count);
+        break;
+      case Section::kExports:
+        DeserializeExports(deserializer, count);
+        break;
+      case Section::kDone:
+        UNREACHABLE();
+    }
+    if (deserializer.position_ != deserializer.end_) {
+      Throw("Web snapshot: Section length mismatch");
+    }
+  }
+
+  ix = start + length;
+  next_section_ = static_cast<Section>(static_cast<int>(next_section_) + 1);
+  return true;
+}
+
+void WebSnapshotDeserializer::DeserializeStrings(
+    ValueDeserializer& deserializer, uint32_t count) {
+  NewTable(kStringsIndex, count);
+  if (!is_lazy()) {
+    for (uint32_t i = 0; i < count; ++i) {
+      DeserializeString(deserializer, i);
+    }
     return;
   }
+
+  LazyData::Items& items = lazy_data_->strings;
+  const uint8_t* start = deserializer.position_;
+  items.data.assign(start, deserializer.end_);
+  items.offsets.reserve(count);
   for (uint32_t i = 0; i < count; ++i) {
-    // TODO(v8:11525): Read strings as UTF-8.
-    MaybeHandle<String> maybe_string = deserializer.ReadOneByteString();
-    Handle<String> string;
-    if (!maybe_string.ToHandle(&string)) {
+    items.offsets.push_back(
+        static_cast<uint32_t>(deserializer.position_ - start));
+    uint32_t length;
+    const void* chars;
+    if (!deserializer.ReadUint32(&length) ||
+        !deserializer.ReadRawBytes(length, &chars)) {
       Throw("Web snapshot: Malformed string");
       return;
     }
-    strings_.emplace_back(string);
   }
-  ix = deserializer.position_ - data;
+}
+
+void WebSnapshotDeserializer::DeserializeString(
+    ValueDeserializer& deserializer, uint32_t id) {
+  // TODO(v8:11525): Read strings as UTF-8.
+  MaybeHandle<String> maybe_string = deserializer.ReadOneByteString();
+  Handle<String> string;
+  if (!maybe_string.ToHandle(&string)) {
+    Throw("Web snapshot: Malformed string");
+    return;
+  }
+  table(kStringsIndex).set(id, *string);
+}
+
+Handle<String> WebSnapshotDeserializer::GetString(uint32_t id) {
+  if (table(kStringsIndex).get(id).IsUndefined(isolate_)) {
+    if (!is_lazy()) {
+      // The string was malformed.
+      DCHECK(has_error());
+      return isolate_->factory()->empty_string();
+    }
+    Vector<const uint8_t> data = lazy_data_->strings.Get(id);
+    ValueDeserializer deserializer(isolate_, data.begin(), data.size());
+    DeserializeString(deserializer, id);
+    if (table(kStringsIndex).get(id).IsUndefined(isolate_)) {
+      return isolate_->factory()->empty_string();
+    }
+  }
+  return handle(String::cast(table(kStringsIndex).get(id)), isolate_);
 }
 
 Handle<String> WebSnapshotDeserializer::ReadString(
     ValueDeserializer& deserializer, bool internalize) {
   uint32_t string_id;
-  if (!deserializer.ReadUint32(&string_id) || string_id >= strings_.size()) {
+  if (!deserializer.ReadUint32(&string_id) ||
+      string_id >= string_count()) {
     Throw("Web snapshot: malformed string id\n");
     return isolate_->factory()->empty_string();
   }
-  Handle<String> string = strings_[string_id];
+  Handle<String> string = GetString(string_id);
   if (internalize && !string->IsInternalizedString()) {
     string = isolate_->factory()->InternalizeString(string);
-    strings_[string_id] = string;
+    table(kStringsIndex).set(string_id, *string);
   }
   return string;
 }
 
-void WebSnapshotDeserializer::DeserializeMaps(const uint8_t* data, size_t& ix,
-                                              size_t size) {
-  ValueDeserializer deserializer(isolate_, &data[ix], size - ix);
-  uint32_t map_count;
-  if (!deserializer.ReadUint32(&map_count)) {
-    Throw("Web snapshot: Malformed shape table");
-    return;
-  }
-  for (uint32_t i = 0; i < map_count; ++i) {
+void WebSnapshotDeserializer::DeserializeMaps(ValueDeserializer& deserializer,
+                                              uint32_t count) {
+  Handle<FixedArray> maps = NewTable(kMapsIndex, count);
+  Handle<JSObject> object_prototype(
+      isolate_->native_context()->initial_object_prototype(), isolate_);
+  for (uint32_t i = 0; i < count; ++i) {
     uint32_t property_count;
     if (!deserializer.ReadUint32(&property_count)) {
       Throw("Web snapshot: Malformed shape");
@@ -534,26 +1094,23 @@ void WebSnapshotDeserializer::DeserializeMaps(const uint8_t* data, size_t& ix,
     Handle<Map> map = isolate_->factory()->NewMap(
         JS_OBJECT_TYPE, JSObject::kHeaderSize * kTaggedSize, HOLEY_ELEMENTS, 0);
     map->InitializeDescriptors(isolate_, *descriptors);
+    // Class instances switch to the prototype of their class when they are
+    // deserialized.
+    Map::SetPrototype(isolate_, map, object_prototype);
 
-    maps_.emplace_back(map);
+    maps->set(i, *map);
   }
-  ix = deserializer.position_ - data;
 }
 
-void WebSnapshotDeserializer::DeserializeContexts(const uint8_t* data,
-                                                  size_t& ix, size_t size) {
-  ValueDeserializer deserializer(isolate_, &data[ix], size - ix);
-  uint32_t count;
-  if (!deserializer.ReadUint32(&count)) {
-    Throw("Web snapshot: Malformed context table");
-    return;
-  }
+void WebSnapshotDeserializer::DeserializeContexts(
+    ValueDeserializer& deserializer, uint32_t count) {
+  Handle<FixedArray> contexts = NewTable(kContextsIndex, count);
   for (uint32_t i = 0; i < count; ++i) {
     uint32_t parent_context_id;
     // Parent context is serialized before child context. Note: not >= on
     // purpose, we're going to subtract 1 later.
     if (!deserializer.ReadUint32(&parent_context_id) ||
-        parent_context_id > contexts_.size()) {
+        parent_context_id > i) {
       Throw("Web snapshot: Malformed context");
       return;
     }
@@ -569,7 +1126,8 @@ void WebSnapshotDeserializer::DeserializeContexts(const uint8_t* data,
 
     Handle<Context> parent_context;
     if (parent_context_id > 0) {
-      parent_context = contexts_[parent_context_id - 1];
+      parent_context =
+          handle(Context::cast(contexts->get(parent_context_id - 1)), isolate_);
       scope_info->set_outer_scope_info(parent_context->scope_info());
     } else {
       parent_context = handle(isolate_->context(), isolate_);
@@ -577,7 +1135,7 @@ void WebSnapshotDeserializer::DeserializeContexts(const uint8_t* data,
 
     Handle<Context> context =
         isolate_->factory()->NewFunctionContext(parent_context, scope_info);
-    contexts_.emplace_back(context);
+    contexts->set(i, *context);
 
     const int context_local_base = ScopeInfo::kVariablePartIndex;
     const int context_local_info_base = context_local_base + variable_count;
@@ -602,10 +1160,14 @@ void WebSnapshotDeserializer::DeserializeContexts(const uint8_t* data,
       Handle<Object> value;
       Representation representation;
       ReadValue(deserializer, value, representation);
+      if (value.is_null()) {
+        // The value was malformed.
+        DCHECK(has_error());
+        return;
+      }
       context->set(scope_info->ContextHeaderLength() + variable_index, *value);
     }
   }
-  ix = deserializer.position_ - data;
 }
 
 Handle<ScopeInfo> WebSnapshotDeserializer::CreateScopeInfo(
@@ -651,125 +1213,632 @@ Handle<ScopeInfo> WebSnapshotDeserializer::CreateScopeInfo(
   return scope_info;
 }
 
-void WebSnapshotDeserializer::DeserializeFunctions(const uint8_t* data,
-                                                   size_t& ix, size_t size) {
-  ValueDeserializer deserializer(isolate_, &data[ix], size - ix);
-  uint32_t count;
-  if (!deserializer.ReadUint32(&count)) {
-    Throw("Web snapshot: Malformed function table");
+void WebSnapshotDeserializer::DeserializeFunctions(
+    ValueDeserializer& deserializer, uint32_t count) {
+  NewTable(kFunctionsIndex, count);
+  if (!is_lazy()) {
+    for (uint32_t i = 0; i < count; ++i) {
+      DeserializeFunction(deserializer, i);
+    }
     return;
   }
+
+  LazyData::Items& items = lazy_data_->functions;
+  const uint8_t* start = deserializer.position_;
+  items.data.assign(start, deserializer.end_);
+  items.offsets.reserve(count);
   for (uint32_t i = 0; i < count; ++i) {
+    items.offsets.push_back(
+        static_cast<uint32_t>(deserializer.position_ - start));
     uint32_t context_id;
-    // Note: > (not >= on purpose, we will subtract 1).
+    uint32_t source_id;
+    uint32_t function_type;
     if (!deserializer.ReadUint32(&context_id) ||
-        context_id > contexts_.size()) {
+        !deserializer.ReadUint32(&source_id) ||
+        !deserializer.ReadUint32(&function_type)) {
       Throw("Web snapshot: Malformed function");
       return;
     }
+  }
+}
+
+void WebSnapshotDeserializer::DeserializeFunction(
+    ValueDeserializer& deserializer, uint32_t id) {
+  uint32_t context_id;
+  // Note: > (not >= on purpose, we will subtract 1).
+  if (!deserializer.ReadUint32(&context_id) ||
+      context_id > context_count()) {
+    Throw("Web snapshot: Malformed function");
+    return;
+  }
+
+  Handle<String> source = ReadString(deserializer, false);
 
-    Handle<String> source = ReadString(deserializer, false);
-
-    // TODO(v8:11525): Support other function kinds.
-    // TODO(v8:11525): Support (exported) top level functions.
-    Handle<Script> script = isolate_->factory()->NewScript(source);
-    // TODO(v8:11525): Deduplicate the SFIs for inner functions the user creates
-    // post-deserialization (by calling the outer function, if it's also in the
-    // snapshot) against the ones we create here.
-    Handle<SharedFunctionInfo> shared =
-        isolate_->factory()->NewSharedFunctionInfo(
-            isolate_->factory()->empty_string(), MaybeHandle<Code>(),
-            Builtins::kCompileLazy, FunctionKind::kNormalFunction);
-    shared->set_function_literal_id(1);
-    // TODO(v8:11525): Decide how to handle language modes.
-    shared->set_language_mode(LanguageMode::kStrict);
-    shared->set_uncompiled_data(
-        *isolate_->factory()->NewUncompiledDataWithoutPreparseData(
-            ReadOnlyRoots(isolate_).empty_string_handle(), 0,
-            source->length()));
-    shared->set_script(*script);
-    Handle<WeakFixedArray> infos(
-        isolate_->factory()->NewWeakFixedArray(3, AllocationType::kOld));
-    infos->Set(1, HeapObjectReference::Weak(*shared));
-    script->set_shared_function_infos(*infos);
-
-    Handle<JSFunction> function =
-        Factory::JSFunctionBuilder(isolate_, shared, isolate_->native_context())
-            .Build();
+  uint32_t function_type;
+  if (!deserializer.ReadUint32(&function_type) ||
+      function_type > FunctionType::CLASS_CONSTRUCTOR) {
+    Throw("Web snapshot: Malformed function");
+    return;
+  }
+  if (function_type == FunctionType::CLASS_CONSTRUCTOR) {
     if (context_id > 0) {
-      DCHECK_LT(context_id - 1, contexts_.size());
-      Handle<Context> context = contexts_[context_id - 1];
-      function->set_context(*context);
-      shared->set_outer_scope_info(context->scope_info());
+      Throw("Web snapshot: Malformed function");
+      return;
     }
-    functions_.emplace_back(function);
+    DeserializeClass(source, id);
+    return;
+  }
+
+  // TODO(v8:11525): Support other function kinds.
+  // TODO(v8:11525): Support (exported) top level functions.
+  Handle<Script> script = isolate_->factory()->NewScript(source);
+  // TODO(v8:11525): Deduplicate the SFIs for inner functions the user creates
+  // post-deserialization (by calling the outer function, if it's also in the
+  // snapshot) against the ones we create here.
+  Handle<SharedFunctionInfo> shared =
+      isolate_->factory()->NewSharedFunctionInfo(
+          isolate_->factory()->empty_string(), MaybeHandle<Code>(),
+          Builtins::kCompileLazy, FunctionKind::kNormalFunction);
+  shared->set_function_literal_id(1);
+  // TODO(v8:11525): Decide how to handle language modes.
+  shared->set_language_mode(LanguageMode::kStrict);
+  shared->set_uncompiled_data(
+      *isolate_->factory()->NewUncompiledDataWithoutPreparseData(
+          ReadOnlyRoots(isolate_).empty_string_handle(), 0,
+          source->length()));
+  shared->set_script(*script);
+  Handle<WeakFixedArray> infos(
+      isolate_->factory()->NewWeakFixedArray(3, AllocationType::kOld));
+  infos->Set(1, HeapObjectReference::Weak(*shared));
+  script->set_shared_function_infos(*infos);
+
+  Handle<JSFunction> function =
+      Factory::JSFunctionBuilder(isolate_, shared, isolate_->native_context())
+          .Build();
+  if (context_id > 0) {
+    DCHECK_LT(context_id - 1, context_count());
+    Handle<Context> context(
+        Context::cast(table(kContextsIndex).get(context_id - 1)), isolate_);
+    function->set_context(*context);
+    shared->set_outer_scope_info(context->scope_info());
   }
-  ix = deserializer.position_ - data;
+  table(kFunctionsIndex).set(id, *function);
 }
 
-void WebSnapshotDeserializer::DeserializeObjects(const uint8_t* data,
-                                                 size_t& ix, size_t size) {
-  ValueDeserializer deserializer(isolate_, &data[ix], size - ix);
-  uint32_t object_count;
-  if (!deserializer.ReadUint32(&object_count)) {
-    Throw("Web snapshot: Malformed objects table");
+void WebSnapshotDeserializer::DeserializeClass(Handle<String> source,
+                                               uint32_t id) {
+  // Evaluate the class as an expression. This also creates the prototype
+  // methods and the static members.
+  // TODO(v8:11525): Avoid running the static initializers and the computed
+  // property names of the class.
+  Factory* factory = isolate_->factory();
+  Handle<String> expression;
+  if (!factory->NewConsString(factory->LookupSingleCharacterStringFromCode('('),
+                              source)
+           .ToHandle(&expression) ||
+      !factory->NewConsString(expression,
+                              factory->LookupSingleCharacterStringFromCode(')'))
+           .ToHandle(&expression)) {
+    Throw("Web snapshot: Out of memory");
     return;
   }
-  for (size_t i = 0; i < object_count; ++i) {
-    uint32_t map_id;
-    if (!deserializer.ReadUint32(&map_id) || map_id >= maps_.size()) {
+
+  v8::Local<v8::Context> context =
+      Utils::ToLocal(Handle<Context>::cast(isolate_->native_context()));
+  v8::Local<v8::Script> script;
+  v8::Local<v8::Value> result;
+  if (!v8::Script::Compile(context, Utils::ToLocal(expression))
+           .ToLocal(&script) ||
+      !script->Run(context).ToLocal(&result)) {
+    Throw("Web snapshot: Evaluating class failed");
+    return;
+  }
+  Handle<Object> function = Utils::OpenHandle(*result);
+  if (!function->IsJSFunction() ||
+      !JSFunction::cast(*function).shared().is_class_constructor()) {
+    Throw("Web snapshot: Malformed class");
+    return;
+  }
+  table(kFunctionsIndex).set(id, *function);
+}
+
+Handle<JSFunction> WebSnapshotDeserializer::GetFunction(uint32_t id) {
+  if (table(kFunctionsIndex).get(id).IsUndefined(isolate_)) {
+    if (is_lazy()) {
+      Vector<const uint8_t> data = lazy_data_->functions.Get(id);
+      ValueDeserializer deserializer(isolate_, data.begin(), data.size());
+      DeserializeFunction(deserializer, id);
+    }
+    if (table(kFunctionsIndex).get(id).IsUndefined(isolate_)) {
+      // The function was malformed.
+      DCHECK(has_error());
+      return Handle<JSFunction>();
+    }
+  }
+  return handle(JSFunction::cast(table(kFunctionsIndex).get(id)), isolate_);
+}
+
+void WebSnapshotDeserializer::DeserializeObjects(
+    ValueDeserializer& deserializer, uint32_t count) {
+  NewTable(kObjectsIndex, count);
+  if (!is_lazy()) {
+    for (uint32_t i = 0; i < count; ++i) {
+      DeserializeObject(deserializer, i);
+    }
+    return;
+  }
+
+  LazyData::Items& items = lazy_data_->objects;
+  const uint8_t* start = deserializer.position_;
+  items.data.assign(start, deserializer.end_);
+  items.offsets.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    items.offsets.push_back(
+        static_cast<uint32_t>(deserializer.position_ - start));
+    if (!SkipObject(deserializer)) {
       Throw("Web snapshot: Malformed object");
       return;
     }
-    Handle<Map> map = maps_[map_id];
-    Handle<DescriptorArray> descriptors =
-        handle(map->instance_descriptors(kRelaxedLoad), isolate_);
-    int no_properties = map->NumberOfOwnDescriptors();
-    Handle<PropertyArray> property_array =
-        isolate_->factory()->NewPropertyArray(no_properties);
-    for (int i = 0; i < no_properties; ++i) {
-      Handle<Object> value;
-      Representation wanted_representation = Representation::None();
-      ReadValue(deserializer, value, wanted_representation);
-      // Read the representation from the map.
-      PropertyDetails details = descriptors->GetDetails(InternalIndex(i));
-      CHECK_EQ(details.location(), kField);
-      CHECK_EQ(kData, details.kind());
-      Representation r = details.representation();
-      if (r.IsNone()) {
-        // Switch over to wanted_representation.
-        details = details.CopyWithRepresentation(wanted_representation);
-        descriptors->SetDetails(InternalIndex(i), details);
-      } else if (!r.Equals(wanted_representation)) {
-        // TODO(v8:11525): Support this case too.
-        UNREACHABLE();
+  }
+}
+
+bool WebSnapshotDeserializer::SkipObject(ValueDeserializer& deserializer) {
+  uint32_t object_type;
+  if (!deserializer.ReadUint32(&object_type)) {
+    return false;
+  }
+  uint32_t value_count;
+  switch (object_type) {
+    case ObjectType::PLAIN_OBJECT:
+    case ObjectType::CLASS_INSTANCE: {
+      uint32_t map_id;
+      if (!deserializer.ReadUint32(&map_id) || map_id >= map_count()) {
+        return false;
+      }
+      uint32_t constructor_id;
+      if (object_type == ObjectType::CLASS_INSTANCE &&
+          !deserializer.ReadUint32(&constructor_id)) {
+        return false;
+      }
+      value_count =
+          Map::cast(table(kMapsIndex).get(map_id)).NumberOfOwnDescriptors();
+      break;
+    }
+    case ObjectType::ARRAY_OBJECT: {
+      uint32_t array_type;
+      if (!deserializer.ReadUint32(&array_type) ||
+          !deserializer.ReadUint32(&value_count)) {
+        return false;
       }
+      if (array_type == ArrayType::SMI_ARRAY) {
+        for (uint32_t i = 0; i < value_count; ++i) {
+          uint32_t element;
+          if (!deserializer.ReadUint32(&element)) return false;
+        }
+        return true;
+      }
+      if (array_type == ArrayType::DOUBLE_ARRAY) {
+        size_t remaining = deserializer.end_ - deserializer.position_;
+        const void* elements;
+        return value_count <= remaining / kDoubleSize &&
+               deserializer.ReadRawBytes(value_count * kDoubleSize, &elements);
+      }
+      if (array_type != ArrayType::TAGGED_ARRAY) {
+        return false;
+      }
+      break;
+    }
+    case ObjectType::TYPED_ARRAY_OBJECT: {
+      ExternalArrayType type;
+      uint32_t length;
+      const void* contents;
+      return ReadTypedArrayContents(deserializer, type, length, contents);
+    }
+    case ObjectType::MAP_OBJECT: {
+      uint32_t entry_count;
+      if (!deserializer.ReadUint32(&entry_count)) {
+        return false;
+      }
+      for (uint32_t i = 0; i < entry_count; ++i) {
+        if (!SkipValue(deserializer) || !SkipValue(deserializer)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case ObjectType::SET_OBJECT:
+      if (!deserializer.ReadUint32(&value_count)) {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+  for (uint32_t i = 0; i < value_count; ++i) {
+    if (!SkipValue(deserializer)) {
+      return false;
+    }
+  }
+  return true;
+}
 
-      property_array->set(i, *value);
+bool WebSnapshotDeserializer::SkipValue(ValueDeserializer& deserializer) {
+  uint32_t value_type;
+  if (!deserializer.ReadUint32(&value_type)) {
+    return false;
+  }
+  switch (value_type) {
+    case ValueType::STRING_ID:
+    case ValueType::OBJECT_ID:
+    case ValueType::FUNCTION_ID:
+    case ValueType::INTEGER: {
+      uint32_t value;
+      return deserializer.ReadUint32(&value);
+    }
+    case ValueType::DOUBLE: {
+      double value;
+      return deserializer.ReadDouble(&value);
     }
-    Handle<JSObject> object = isolate_->factory()->NewJSObjectFromMap(map);
-    object->set_raw_properties_or_hash(*property_array);
-    objects_.emplace_back(object);
+    case ValueType::FALSE_CONSTANT:
+    case ValueType::TRUE_CONSTANT:
+    case ValueType::NULL_CONSTANT:
+    case ValueType::UNDEFINED_CONSTANT:
+      return true;
+    default:
+      return false;
   }
-  ix = deserializer.position_ - data;
 }
 
-void WebSnapshotDeserializer::DeserializeExports(const uint8_t* data,
-                                                 size_t& ix, size_t size) {
-  ValueDeserializer deserializer(isolate_, &data[ix], size - ix);
-  uint32_t count;
-  if (!deserializer.ReadUint32(&count)) {
-    Throw("Web snapshot: Malformed export table");
+void WebSnapshotDeserializer::DeserializeObject(
+    ValueDeserializer& deserializer, uint32_t id) {
+  uint32_t object_type;
+  if (!deserializer.ReadUint32(&object_type)) {
+    Throw("Web snapshot: Malformed object");
     return;
   }
+
+  uint32_t outer_object_id_limit = object_id_limit_;
+  object_id_limit_ = id;
+  Handle<JSObject> object;
+  switch (object_type) {
+    case ObjectType::PLAIN_OBJECT:
+      object = DeserializePlainObject(deserializer, false);
+      break;
+    case ObjectType::CLASS_INSTANCE:
+      object = DeserializePlainObject(deserializer, true);
+      break;
+    case ObjectType::ARRAY_OBJECT:
+      object = DeserializeArray(deserializer);
+      break;
+    case ObjectType::TYPED_ARRAY_OBJECT:
+      object = DeserializeTypedArray(deserializer);
+      break;
+    case ObjectType::MAP_OBJECT:
+      object = DeserializeJSMap(deserializer);
+      break;
+    case ObjectType::SET_OBJECT:
+      object = DeserializeJSSet(deserializer);
+      break;
+    default:
+      Throw("Web snapshot: Malformed object");
+      break;
+  }
+  object_id_limit_ = outer_object_id_limit;
+
+  if (!object.is_null()) {
+    table(kObjectsIndex).set(id, *object);
+  }
+}
+
+Handle<JSObject> WebSnapshotDeserializer::DeserializePlainObject(
+    ValueDeserializer& deserializer, bool is_class_instance) {
+  uint32_t map_id;
+  if (!deserializer.ReadUint32(&map_id) || map_id >= map_count()) {
+    Throw("Web snapshot: Malformed object");
+    return Handle<JSObject>();
+  }
+  Handle<Map> map(Map::cast(table(kMapsIndex).get(map_id)), isolate_);
+
+  if (is_class_instance) {
+    uint32_t constructor_id;
+    if (!deserializer.ReadUint32(&constructor_id) ||
+        constructor_id >= function_count()) {
+      Throw("Web snapshot: Malformed object");
+      return Handle<JSObject>();
+    }
+    Handle<JSFunction> constructor = GetFunction(constructor_id);
+    if (constructor.is_null()) {
+      return Handle<JSObject>();
+    }
+    if (!constructor->shared().is_class_constructor() ||
+        !constructor->has_instance_prototype()) {
+      Throw("Web snapshot: Malformed object");
+      return Handle<JSObject>();
+    }
+    Handle<HeapObject> prototype(constructor->instance_prototype(), isolate_);
+    map = Map::TransitionToPrototype(isolate_, map, prototype);
+  }
+
+  Handle<DescriptorArray> descriptors =
+      handle(map->instance_descriptors(kRelaxedLoad), isolate_);
+  int no_properties = map->NumberOfOwnDescriptors();
+  Handle<PropertyArray> property_array =
+      isolate_->factory()->NewPropertyArray(no_properties);
+  for (int i = 0; i < no_properties; ++i) {
+    Handle<Object> value;
+    Representation wanted_representation = Representation::None();
+    ReadValue(deserializer, value, wanted_representation);
+    if (value.is_null()) {
+      // The value was malformed.
+      DCHECK(has_error());
+      return Handle<JSObject>();
+    }
+    // Read the representation from the map.
+    PropertyDetails details = descriptors->GetDetails(InternalIndex(i));
+    CHECK_EQ(details.location(), kField);
+    CHECK_EQ(kData, details.kind());
+    Representation r = details.representation();
+    if (r.IsNone()) {
+      // Switch over to wanted_representation.
+      details = details.CopyWithRepresentation(wanted_representation);
+      descriptors->SetDetails(InternalIndex(i), details);
+    } else if (!r.Equals(wanted_representation)) {
+      // TODO(v8:11525): Support this case too.
+      UNREACHABLE();
+    }
+
+    property_array->set(i, *value);
+  }
+
+  Handle<JSObject> object = isolate_->factory()->NewJSObjectFromMap(map);
+  object->set_raw_properties_or_hash(*property_array);
+  return object;
+}
+
+Handle<JSArray> WebSnapshotDeserializer::DeserializeArray(
+    ValueDeserializer& deserializer) {
+  uint32_t array_type;
+  uint32_t length;
+  if (!deserializer.ReadUint32(&array_type) ||
+      !deserializer.ReadUint32(&length)) {
+    Throw("Web snapshot: Malformed array");
+    return Handle<JSArray>();
+  }
+  // Every element takes at least one byte, which bounds the length by the
+  // size of the snapshot.
+  size_t remaining = deserializer.end_ - deserializer.position_;
+  if (length > remaining ||
+      length > static_cast<uint32_t>(FixedArray::kMaxLength)) {
+    Throw("Web snapshot: Malformed array");
+    return Handle<JSArray>();
+  }
+  Factory* factory = isolate_->factory();
+  int int_length = static_cast<int>(length);
+
+  switch (array_type) {
+    case ArrayType::SMI_ARRAY: {
+      Handle<FixedArray> elements = factory->NewFixedArray(int_length);
+      for (int i = 0; i < int_length; ++i) {
+        uint32_t element;
+        if (!deserializer.ReadUint32(&element)) {
+          Throw("Web snapshot: Malformed array");
+          return Handle<JSArray>();
+        }
+        int32_t value = ZigZagDecode(element);
+        if (!Smi::IsValid(value)) {
+          Throw("Web snapshot: Malformed array");
+          return Handle<JSArray>();
+        }
+        elements->set(i, Smi::FromInt(value));
+      }
+      return factory->NewJSArrayWithElements(elements, PACKED_SMI_ELEMENTS,
+                                             int_length);
+    }
+    case ArrayType::DOUBLE_ARRAY: {
+      const void* raw_elements;
+      if (length > remaining / kDoubleSize ||
+          !deserializer.ReadRawBytes(length * kDoubleSize, &raw_elements)) {
+        Throw("Web snapshot: Malformed array");
+        return Handle<JSArray>();
+      }
+      Handle<FixedArrayBase> elements =
+          factory->NewFixedDoubleArray(int_length);
+      if (int_length > 0) {
+        DisallowGarbageCollection no_gc;
+        FixedDoubleArray double_elements = FixedDoubleArray::cast(*elements);
+        Address source = reinterpret_cast<Address>(raw_elements);
+        for (int i = 0; i < int_length; ++i) {
+          // set() canonicalizes NaNs, so no holes can be smuggled in.
+          double_elements.set(
+              i, base::ReadUnalignedValue<double>(source + i * kDoubleSize));
+        }
+      }
+      return factory->NewJSArrayWithElements(elements, PACKED_DOUBLE_ELEMENTS,
+                                             int_length);
+    }
+    case ArrayType::TAGGED_ARRAY: {
+      Handle<FixedArray> elements = factory->NewFixedArray(int_length);
+      for (int i = 0; i < int_length; ++i) {
+        Handle<Object> value;
+        Representation representation;
+        ReadValue(deserializer, value, representation);
+        if (value.is_null()) {
+          // The value was malformed.
+          DCHECK(has_error());
+          return Handle<JSArray>();
+        }
+        elements->set(i, *value);
+      }
+      return factory->NewJSArrayWithElements(elements, PACKED_ELEMENTS,
+                                             int_length);
+    }
+    default:
+      Throw("Web snapshot: Malformed array");
+      return Handle<JSArray>();
+  }
+}
+
+bool WebSnapshotDeserializer::ReadTypedArrayContents(
+    ValueDeserializer& deserializer, ExternalArrayType& type,
+    uint32_t& length, const void*& contents) {
+  uint32_t raw_type;
+  uint32_t padding;
+  const void* padding_bytes;
+  if (!deserializer.ReadUint32(&raw_type) || raw_type < kExternalInt8Array ||
+      raw_type > kExternalBigUint64Array || !deserializer.ReadUint32(&length) ||
+      !deserializer.ReadUint32(&padding) || padding >= kTypedArrayAlignment ||
+      !deserializer.ReadRawBytes(padding, &padding_bytes)) {
+    return false;
+  }
+  type = static_cast<ExternalArrayType>(raw_type);
+  size_t element_size = TypedArrayElementSize(type);
+  size_t remaining = deserializer.end_ - deserializer.position_;
+  return length <= remaining / element_size &&
+         length <= JSTypedArray::kMaxLength &&
+         deserializer.ReadRawBytes(length * element_size, &contents);
+}
+
+Handle<JSTypedArray> WebSnapshotDeserializer::DeserializeTypedArray(
+    ValueDeserializer& deserializer) {
+  ExternalArrayType type;
+  uint32_t length;
+  const void* contents;
+  if (!ReadTypedArrayContents(deserializer, type, length, contents)) {
+    Throw("Web snapshot: Malformed typed array");
+    return Handle<JSTypedArray>();
+  }
+  size_t byte_length = length * TypedArrayElementSize(type);
+
+  Handle<JSArrayBuffer> buffer;
+  if (is_lazy() && byte_length > 0 &&
+      IsAligned(reinterpret_cast<Address>(contents), kTypedArrayAlignment)) {
+    // The snapshot data of a lazily deserialized snapshot is kept alive anyway,
+    // so the contents can be used in place. Each typed array is materialized
+    // at most once, so no two buffers share the same contents.
+    auto* lazy_data = new std::shared_ptr<LazyData>(lazy_data_);
+    std::unique_ptr<BackingStore> backing_store = BackingStore::WrapAllocation(
+        const_cast<void*>(contents), byte_length,
+        [](void*, size_t, void* lazy_data) {
+          delete static_cast<std::shared_ptr<LazyData>*>(lazy_data);
+        },
+        lazy_data, SharedFlag::kNotShared);
+    buffer = isolate_->factory()->NewJSArrayBuffer(std::move(backing_store));
+  } else {
+    if (!isolate_->factory()
+             ->NewJSArrayBufferAndBackingStore(byte_length,
+                                               InitializedFlag::kUninitialized)
+             .ToHandle(&buffer)) {
+      Throw("Web snapshot: Out of memory");
+      return Handle<JSTypedArray>();
+    }
+    if (byte_length > 0) {
+      memcpy(buffer->backing_store(), contents, byte_length);
+    }
+  }
+  return isolate_->factory()->NewJSTypedArray(type, buffer, 0, length);
+}
+
+Handle<JSMap> WebSnapshotDeserializer::DeserializeJSMap(
+    ValueDeserializer& deserializer) {
+  uint32_t entry_count;
+  // Every key and every value takes at least one byte.
+  if (!deserializer.ReadUint32(&entry_count) ||
+      entry_count >
+          static_cast<size_t>(deserializer.end_ - deserializer.position_) / 2) {
+    Throw("Web snapshot: Malformed Map");
+    return Handle<JSMap>();
+  }
+  Handle<JSMap> map = isolate_->factory()->NewJSMap();
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(map->table()), isolate_);
+  for (uint32_t i = 0; i < entry_count; ++i) {
+    Handle<Object> key;
+    Handle<Object> value;
+    Representation representation;
+    ReadValue(deserializer, key, representation);
+    if (key.is_null()) {
+      DCHECK(has_error());
+      return Handle<JSMap>();
+    }
+    ReadValue(deserializer, value, representation);
+    if (value.is_null()) {
+      DCHECK(has_error());
+      return Handle<JSMap>();
+    }
+    if (!OrderedHashMap::Add(isolate_, table, key, value).ToHandle(&table)) {
+      Throw("Web snapshot: Map too large");
+      return Handle<JSMap>();
+    }
+  }
+  map->set_table(*table);
+  return map;
+}
+
+Handle<JSSet> WebSnapshotDeserializer::DeserializeJSSet(
+    ValueDeserializer& deserializer) {
+  uint32_t entry_count;
+  // Every value takes at least one byte.
+  if (!deserializer.ReadUint32(&entry_count) ||
+      entry_count >
+          static_cast<size_t>(deserializer.end_ - deserializer.position_)) {
+    Throw("Web snapshot: Malformed Set");
+    return Handle<JSSet>();
+  }
+  Handle<JSSet> set = isolate_->factory()->NewJSSet();
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(set->table()), isolate_);
+  for (uint32_t i = 0; i < entry_count; ++i) {
+    Handle<Object> value;
+    Representation representation;
+    ReadValue(deserializer, value, representation);
+    if (value.is_null()) {
+      DCHECK(has_error());
+      return Handle<JSSet>();
+    }
+    if (!OrderedHashSet::Add(isolate_, table, value).ToHandle(&table)) {
+      Throw("Web snapshot: Set too large");
+      return Handle<JSSet>();
+    }
+  }
+  set->set_table(*table);
+  return set;
+}
+
+Handle<JSObject> WebSnapshotDeserializer::GetObject(uint32_t id) {
+  if (table(kObjectsIndex).get(id).IsUndefined(isolate_) && is_lazy()) {
+    // Materializing an object materializes the objects it refers to, so the
+    // recursion is bounded by the length of the longest chain of objects.
+    StackLimitCheck stack_check(isolate_);
+    if (stack_check.HasOverflowed()) {
+      isolate_->StackOverflow();
+      Throw("Web snapshot: Stack overflow");
+      return Handle<JSObject>();
+    }
+    Vector<const uint8_t> data = lazy_data_->objects.Get(id);
+    ValueDeserializer deserializer(isolate_, data.begin(), data.size());
+    DeserializeObject(deserializer, id);
+  }
+  if (table(kObjectsIndex).get(id).IsUndefined(isolate_)) {
+    // The object was malformed.
+    DCHECK(has_error());
+    return Handle<JSObject>();
+  }
+  return handle(JSObject::cast(table(kObjectsIndex).get(id)), isolate_);
+}
+
+void WebSnapshotDeserializer::DeserializeExports(
+    ValueDeserializer& deserializer, uint32_t count) {
+  if (is_lazy() && count > 0) {
+    state_->set(kLazyDataIndex,
+                *Managed<LazyData>::FromSharedPtr(isolate_, lazy_data_->size(),
+                                                  lazy_data_));
+  }
   for (uint32_t i = 0; i < count; ++i) {
     Handle<String> export_name = ReadString(deserializer, true);
     uint32_t object_id = 0;
-    if (!deserializer.ReadUint32(&object_id) || object_id >= objects_.size()) {
+    if (!deserializer.ReadUint32(&object_id) ||
+        object_id >= object_count()) {
       Throw("Web snapshot: Malformed export");
       return;
     }
-    Handle<Object> exported_object = objects_[object_id];
 
     // Check for the correctness of the snapshot (thus far) before producing
     // something observable. TODO(v8:11525): Strictly speaking, we should
@@ -779,6 +1848,23 @@ void WebSnapshotDeserializer::DeserializeExports(const uint8_t* data,
       return;
     }
 
+    if (is_lazy()) {
+      Handle<FixedArray> export_data = isolate_->factory()->NewFixedArray(2);
+      export_data->set(0, *state_);
+      export_data->set(1, Smi::FromInt(static_cast<int>(object_id)));
+      v8::Local<v8::Context> context =
+          Utils::ToLocal(Handle<Context>::cast(isolate_->native_context()));
+      Maybe<bool> result = context->Global()->SetLazyDataProperty(
+          context, Utils::ToLocal(export_name), &MaterializeLazyExport,
+          Utils::ToLocal(Handle<Object>::cast(export_data)));
+      if (!result.FromMaybe(false)) {
+        Throw("Web snapshot: Setting global property failed");
+        return;
+      }
+      continue;
+    }
+
+    Handle<Object> exported_object = GetObject(object_id);
     auto result = Object::SetProperty(isolate_, isolate_->global_object(),
                                       export_name, exported_object);
     if (result.is_null()) {
@@ -786,7 +1872,28 @@ void WebSnapshotDeserializer::DeserializeExports(const uint8_t* data,
       return;
     }
   }
-  ix = deserializer.position_ - data;
+}
+
+// static
+void WebSnapshotDeserializer::MaterializeLazyExport(
+    v8::Local<v8::Name> property,
+    const v8::PropertyCallbackInfo<v8::Value>& info) {
+  Isolate* isolate = reinterpret_cast<Isolate*>(info.GetIsolate());
+  HandleScope scope(isolate);
+  Handle<FixedArray> export_data =
+      Handle<FixedArray>::cast(Utils::OpenHandle(*info.Data()));
+  Handle<FixedArray> state(FixedArray::cast(export_data->get(0)), isolate);
+  uint32_t object_id =
+      static_cast<uint32_t>(Smi::ToInt(export_data->get(1)));
+
+  WebSnapshotDeserializer deserializer(isolate, state);
+  Handle<JSObject> object = deserializer.GetObject(object_id);
+  if (object.is_null()) {
+    // An exception has been thrown.
+    DCHECK(deserializer.has_error());
+    return;
+  }
+  info.GetReturnValue().Set(Utils::ToLocal(object));
 }
 
 void WebSnapshotDeserializer::ReadValue(ValueDeserializer& deserializer,
@@ -807,24 +1914,61 @@ void WebSnapshotDeserializer::ReadValue(ValueDeserializer& deserializer,
     case ValueType::OBJECT_ID:
       uint32_t object_id;
       if (!deserializer.ReadUint32(&object_id) ||
-          object_id >= objects_.size()) {
+          object_id >= object_id_limit_) {
         // TODO(v8:11525): Handle circular references + contexts referencing
         // objects.
         Throw("Web snapshot: Malformed variable");
         return;
       }
-      value = objects_[object_id];
+      value = GetObject(object_id);
       representation = Representation::Tagged();
       break;
     case ValueType::FUNCTION_ID:
       // TODO(v8:11525): Handle contexts referencing functions.
       uint32_t function_id;
       if (!deserializer.ReadUint32(&function_id) ||
-          function_id >= functions_.size()) {
+          function_id >= function_count()) {
         Throw("Web snapshot: Malformed object property");
         return;
       }
-      value = functions_[function_id];
+      value = GetFunction(function_id);
+      representation = Representation::Tagged();
+      break;
+    case ValueType::INTEGER: {
+      uint32_t integer;
+      if (!deserializer.ReadUint32(&integer)) {
+        Throw("Web snapshot: Malformed variable");
+        return;
+      }
+      value = isolate_->factory()->NewNumberFromInt(ZigZagDecode(integer));
+      // TODO(v8:11525): Use the Smi and Double representations.
+      representation = Representation::Tagged();
+      break;
+    }
+    case ValueType::DOUBLE: {
+      double number;
+      if (!deserializer.ReadDouble(&number)) {
+        Throw("Web snapshot: Malformed variable");
+        return;
+      }
+      value = isolate_->factory()->NewNumber(number);
+      representation = Representation::Tagged();
+      break;
+    }
+    case ValueType::FALSE_CONSTANT:
+      value = isolate_->factory()->false_value();
+      representation = Representation::Tagged();
+      break;
+    case ValueType::TRUE_CONSTANT:
+      value = isolate_->factory()->true_value();
+      representation = Representation::Tagged();
+      break;
+    case ValueType::NULL_CONSTANT:
+      value = isolate_->factory()->null_value();
+      representation = Representation::Tagged();
+      break;
+    case ValueType::UNDEFINED_CONSTANT:
+      value = isolate_->factory()->undefined_value();
       representation = Representation::Tagged();
       break;
     default:
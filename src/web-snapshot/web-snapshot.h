@@ -5,7 +5,7 @@
 #ifndef V8_WEB_SNAPSHOT_WEB_SNAPSHOT_H_
 #define V8_WEB_SNAPSHOT_WEB_SNAPSHOT_H_
 
-#include <queue>
+#include <memory>
 #include <vector>
 
 #include "src/handles/handles.h"
@@ -16,13 +16,21 @@ namespace v8 {
 
 class Context;
 class Isolate;
+class Name;
+class Value;
 
 template <typename T>
 class Local;
+template <typename T>
+class PropertyCallbackInfo;
 
 namespace internal {
 
 class Context;
+class JSArray;
+class JSMap;
+class JSSet;
+class JSTypedArray;
 class Map;
 class Object;
 class String;
@@ -38,7 +46,34 @@ class WebSnapshotSerializerDeserializer {
   bool has_error() const { return error_message_ != nullptr; }
   const char* error_message() const { return error_message_; }
 
-  enum ValueType : uint8_t { STRING_ID, OBJECT_ID, FUNCTION_ID };
+  enum ValueType : uint8_t {
+    STRING_ID,
+    OBJECT_ID,
+    FUNCTION_ID,
+    INTEGER,
+    DOUBLE,
+    FALSE_CONSTANT,
+    TRUE_CONSTANT,
+    NULL_CONSTANT,
+    UNDEFINED_CONSTANT
+  };
+
+  enum ObjectType : uint8_t {
+    PLAIN_OBJECT,
+    CLASS_INSTANCE,
+    ARRAY_OBJECT,
+    TYPED_ARRAY_OBJECT,
+    MAP_OBJECT,
+    SET_OBJECT
+  };
+
+  enum ArrayType : uint8_t { SMI_ARRAY, DOUBLE_ARRAY, TAGGED_ARRAY };
+
+  enum FunctionType : uint8_t { NORMAL_FUNCTION, CLASS_CONSTRUCTOR };
+
+  // The contents of typed arrays are aligned to this relative to the start of
+  // the objects section, so that they can be used in place.
+  static constexpr size_t kTypedArrayAlignment = 8;
 
  protected:
   explicit WebSnapshotSerializerDeserializer(Isolate* isolate)
@@ -88,6 +123,8 @@ class V8_EXPORT WebSnapshotSerializer
   WebSnapshotSerializer& operator=(const WebSnapshotSerializer&) = delete;
 
   void WriteSnapshot(uint8_t*& buffer, size_t& buffer_size);
+  void WriteSection(ValueSerializer& total_serializer, uint32_t count,
+                    const ValueSerializer& section_serializer);
 
   // Returns true if the object was already in the map, false if it was added.
   bool InsertIntoIndexMap(ObjectCacheIndexMap& map, Handle<HeapObject> object,
@@ -98,7 +135,12 @@ class V8_EXPORT WebSnapshotSerializer
   void SerializeFunction(Handle<JSFunction> function, uint32_t& id);
   void SerializeContext(Handle<Context> context, uint32_t& id);
   void SerializeObject(Handle<JSObject> object, uint32_t& id);
-  void SerializePendingObject(Handle<JSObject> object);
+  void SerializePlainObject(Handle<JSObject> object,
+                            ValueSerializer& serializer);
+  void SerializeArray(Handle<JSArray> array, ValueSerializer& serializer);
+  void SerializeTypedArray(Handle<JSTypedArray> typed_array);
+  void SerializeJSMap(Handle<JSMap> map, ValueSerializer& serializer);
+  void SerializeJSSet(Handle<JSSet> set, ValueSerializer& serializer);
   void SerializeExport(Handle<JSObject> object, const std::string& export_name);
   void WriteValue(Handle<Object> object, ValueSerializer& serializer);
 
@@ -116,44 +158,149 @@ class V8_EXPORT WebSnapshotSerializer
   ObjectCacheIndexMap object_ids_;
   uint32_t export_count_ = 0;
 
-  std::queue<Handle<JSObject>> pending_objects_;
+  // Objects which are being serialized or have been serialized. The objects
+  // referenced by an object are serialized before it, so an object which has
+  // been discovered but doesn't have an id yet is part of a cycle.
+  ObjectCacheIndexMap discovered_objects_;
+  ObjectCacheIndexMap array_buffer_ids_;
 };
 
 class V8_EXPORT WebSnapshotDeserializer
     : public WebSnapshotSerializerDeserializer {
  public:
-  explicit WebSnapshotDeserializer(v8::Isolate* v8_isolate);
+  enum class Mode {
+    // Everything in the snapshot is materialized before the exports are
+    // installed.
+    kEager,
+    // Only the shapes and contexts are materialized up front. The exports are
+    // installed as lazy data properties, and the strings, functions and
+    // objects reachable from an export are materialized when the export is
+    // first read. The snapshot data is copied and kept alive for as long as
+    // an export refers to it, which also allows typed arrays to use their
+    // contents in place. Errors in lazily materialized parts of the snapshot
+    // are only reported when they are materialized.
+    kLazy
+  };
+
+  explicit WebSnapshotDeserializer(v8::Isolate* v8_isolate,
+                                   Mode mode = Mode::kEager);
+  ~WebSnapshotDeserializer();
+
   bool UseWebSnapshot(const uint8_t* data, size_t buffer_size);
 
+  // Streaming deserialization: the snapshot is passed in chunks of arbitrary
+  // size, and each section is deserialized as soon as it has been received
+  // completely, so the whole snapshot never needs to be in memory at once.
+  // The exports are installed when the last section has been received.
+  // FinishStreaming fails if the snapshot is incomplete.
+  bool AppendChunk(const uint8_t* data, size_t size);
+  bool FinishStreaming();
+
   // For inspecting the state after taking a snapshot.
-  size_t string_count() const { return strings_.size(); }
-  size_t map_count() const { return maps_.size(); }
-  size_t context_count() const { return contexts_.size(); }
-  size_t function_count() const { return functions_.size(); }
-  size_t object_count() const { return objects_.size(); }
+  size_t string_count() const;
+  size_t map_count() const;
+  size_t context_count() const;
+  size_t function_count() const;
+  size_t object_count() const;
+
+  // For inspecting how much of a lazily deserialized snapshot has been
+  // materialized so far. This includes the objects materialized through the
+  // lazy exports after UseWebSnapshot returned.
+  size_t materialized_function_count() const;
+  size_t materialized_object_count() const;
 
  private:
+  enum class Section : uint8_t {
+    kStrings,
+    kMaps,
+    kContexts,
+    kFunctions,
+    kObjects,
+    kExports,
+    kDone
+  };
+
+  // The layout of {state_}, which holds a table per section. Entries of
+  // lazily materialized tables are undefined until they are materialized.
+  enum StateIndex {
+    kStringsIndex,
+    kMapsIndex,
+    kContextsIndex,
+    kFunctionsIndex,
+    kObjectsIndex,
+    kLazyDataIndex,
+    kStateLength
+  };
+
+  // The serialized strings, functions and objects of a lazily deserialized
+  // snapshot, together with the offset of each item.
+  struct LazyData;
+
+  // Creates a deserializer that materializes parts of a lazily deserialized
+  // snapshot, which is described by {state}.
+  WebSnapshotDeserializer(Isolate* isolate, Handle<FixedArray> state);
+
   WebSnapshotDeserializer(const WebSnapshotDeserializer&) = delete;
   WebSnapshotDeserializer& operator=(const WebSnapshotDeserializer&) = delete;
 
-  void DeserializeStrings(const uint8_t* data, size_t& ix, size_t size);
+  bool is_lazy() const { return lazy_data_ != nullptr; }
+  FixedArray table(StateIndex index) const;
+  Handle<FixedArray> NewTable(StateIndex index, uint32_t count);
+
+  // Deserializes the section starting at {ix}, if it is completely contained
+  // in {data}. Otherwise, returns false without consuming anything.
+  bool DeserializeSection(const uint8_t* data, size_t& ix, size_t size);
+
+  void DeserializeStrings(ValueDeserializer& deserializer, uint32_t count);
+  void DeserializeString(ValueDeserializer& deserializer, uint32_t id);
+  Handle<String> GetString(uint32_t id);
   Handle<String> ReadString(ValueDeserializer& deserializer,
                             bool internalize = false);
-  void DeserializeMaps(const uint8_t* data, size_t& ix, size_t size);
-  void DeserializeContexts(const uint8_t* data, size_t& ix, size_t size);
+  void DeserializeMaps(ValueDeserializer& deserializer, uint32_t count);
+  void DeserializeContexts(ValueDeserializer& deserializer, uint32_t count);
   Handle<ScopeInfo> CreateScopeInfo(uint32_t variable_count, bool has_parent);
-  void DeserializeFunctions(const uint8_t* data, size_t& ix, size_t size);
-  void DeserializeObjects(const uint8_t* data, size_t& ix, size_t size);
-  void DeserializeExports(const uint8_t* data, size_t& ix, size_t size);
+  void DeserializeFunctions(ValueDeserializer& deserializer, uint32_t count);
+  void DeserializeFunction(ValueDeserializer& deserializer, uint32_t id);
+  void DeserializeClass(Handle<String> source, uint32_t id);
+  Handle<JSFunction> GetFunction(uint32_t id);
+  void DeserializeObjects(ValueDeserializer& deserializer, uint32_t count);
+  void DeserializeObject(ValueDeserializer& deserializer, uint32_t id);
+  Handle<JSObject> DeserializePlainObject(ValueDeserializer& deserializer,
+                                          bool is_class_instance);
+  Handle<JSArray> DeserializeArray(ValueDeserializer& deserializer);
+  bool ReadTypedArrayContents(ValueDeserializer& deserializer,
+                              ExternalArrayType& type, uint32_t& length,
+                              const void*& contents);
+  Handle<JSTypedArray> DeserializeTypedArray(ValueDeserializer& deserializer);
+  Handle<JSMap> DeserializeJSMap(ValueDeserializer& deserializer);
+  Handle<JSSet> DeserializeJSSet(ValueDeserializer& deserializer);
+  Handle<JSObject> GetObject(uint32_t id);
+  void DeserializeExports(ValueDeserializer& deserializer, uint32_t count);
   void ReadValue(ValueDeserializer& deserializer, Handle<Object>& value,
                  Representation& representation);
 
-  // TODO(v8:11525): Make these FixedArrays.
-  std::vector<Handle<String>> strings_;
-  std::vector<Handle<Map>> maps_;
-  std::vector<Handle<Context>> contexts_;
-  std::vector<Handle<JSFunction>> functions_;
-  std::vector<Handle<JSObject>> objects_;
+  // Skip over an item of a lazily materialized section.
+  bool SkipObject(ValueDeserializer& deserializer);
+  bool SkipValue(ValueDeserializer& deserializer);
+
+  // The getter of a lazy export.
+  static void MaterializeLazyExport(
+      v8::Local<v8::Name> property,
+      const v8::PropertyCallbackInfo<v8::Value>& info);
+
+  const Mode mode_;
+  Section next_section_ = Section::kStrings;
+
+  // A global handle, unless this deserializer materializes a lazy export.
+  Handle<FixedArray> state_;
+  bool owns_state_;
+  std::shared_ptr<LazyData> lazy_data_;
+
+  // Objects may only refer to objects with lower ids, which rules out cycles.
+  uint32_t object_id_limit_ = 0;
+
+  // The data of the incomplete section when streaming.
+  std::vector<uint8_t> stream_buffer_;
 };
 
 }  // namespace internal
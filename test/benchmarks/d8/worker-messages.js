@@ -0,0 +1,72 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the throughput of messages echoed back and forth between d8 and a
+// Worker, for small structured messages and for large strings and
+// ArrayBuffers, which d8 passes without going through the ValueSerializer.
+
+const kLargeSize = 256 * 1024;
+
+function Echo() {
+  onmessage = function(message) {
+    postMessage(message);
+  };
+}
+
+function Measure(name, message, iterations, check) {
+  const worker = new Worker(Echo, {type: 'function'});
+  // Warm up the worker.
+  worker.postMessage(message);
+  check(worker.getMessage());
+
+  const start = performance.now();
+  for (let i = 0; i < iterations; ++i) {
+    worker.postMessage(message);
+    check(worker.getMessage());
+  }
+  const elapsed = performance.now() - start;
+  worker.terminate();
+
+  const bytes = typeof message == 'string' ? message.length :
+      message.byteLength;
+  let result = `${name}: ${(iterations * 1000 / elapsed).toFixed(0)} msg/s`;
+  if (bytes !== undefined) {
+    const megabytes = 2 * iterations * bytes / (1024 * 1024);
+    result += `, ${(megabytes * 1000 / elapsed).toFixed(1)} MB/s`;
+  }
+  print(result);
+}
+
+function CheckEqual(expected) {
+  return function(actual) {
+    if (actual !== expected) throw new Error(`Unexpected message ${actual}`);
+  };
+}
+
+function CheckByteLength(expected) {
+  return function(actual) {
+    if (!(actual instanceof ArrayBuffer) || actual.byteLength != expected) {
+      throw new Error(`Unexpected message ${actual}`);
+    }
+  };
+}
+
+Measure('Smi', 42, 10000, CheckEqual(42));
+
+const kObject = {x: 1, y: 'two', z: [3, 4, 5]};
+Measure('Object', kObject, 10000, function(actual) {
+  if (actual.y !== kObject.y || actual.z.length != kObject.z.length) {
+    throw new Error(`Unexpected message ${actual}`);
+  }
+});
+
+const kOneByteString = 'x'.repeat(kLargeSize);
+Measure('OneByteString', kOneByteString, 500, CheckEqual(kOneByteString));
+
+const kTwoByteString = '☃'.repeat(kLargeSize / 2);
+Measure('TwoByteString', kTwoByteString, 500, CheckEqual(kTwoByteString));
+
+const kArrayBuffer = new ArrayBuffer(kLargeSize);
+new Uint8Array(kArrayBuffer).fill(7);
+Measure('ArrayBuffer', kArrayBuffer, 500, CheckByteLength(kLargeSize));
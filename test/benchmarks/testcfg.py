@@ -37,6 +37,8 @@ from testrunner.objects import testcase
 class TestLoader(testsuite.TestLoader):
   def _list_test_filenames(self):
     return [
+        "d8/worker-messages",
+
         "kraken/ai-astar",
         "kraken/audio-beat-detection",
         "kraken/audio-dft",
@@ -114,7 +116,9 @@ class TestCase(testcase.D8TestCase):
     path = self.path
     testroot = self.suite.testroot
     files = []
-    if path.startswith("kraken"):
+    if path.startswith("d8"):
+      files.append(os.path.join(self.suite.root, "%s.js" % path))
+    elif path.startswith("kraken"):
       files.append(os.path.join(testroot, "%s-data.js" % path))
       files.append(os.path.join(testroot, "%s.js" % path))
     elif path.startswith("octane"):
@@ -134,6 +138,8 @@ class TestCase(testcase.D8TestCase):
     return files
 
   def _get_source_path(self):
+    if self.path.startswith("d8"):
+      return os.path.join(self.suite.root, self.path + self._get_suffix())
     return os.path.join(self.suite.testroot, self.path + self._get_suffix())
 
 
@@ -18,6 +18,7 @@
   V(CompactionPartiallyAbortedPageIntraAbortedPointers)     \
   V(CompactionPartiallyAbortedPageWithInvalidatedSlots)     \
   V(CompactionPartiallyAbortedPageWithRememberedSetEntries) \
+  V(CompactionPauseBudget)                                  \
   V(CompactionSpaceDivideMultiplePages)                     \
   V(CompactionSpaceDivideSinglePage)                        \
   V(InvalidatedSlotsAfterTrimming)                          \
@@ -39,6 +40,7 @@
   V(MarkCompactCollector)                                   \
   V(MarkCompactEpochCounter)                                \
   V(MemoryReducerActivationForSmallHeaps)                   \
+  V(MinorMCPagePromotions)                                  \
   V(NoPromotion)                                            \
   V(NumberStringCacheSize)                                  \
   V(ObjectGroups)                                           \
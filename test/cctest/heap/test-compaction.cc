@@ -103,8 +103,94 @@ int GetObjectSize(int objects_per_page) {
   return std::min(kMaxRegularHeapObjectSize, object_size);
 }
 
+// Fills a new old space page for each element of {survivors} with ten
+// objects and keeps only the first one alive, in {survivors}.
+void CreateFragmentedPages(Isolate* isolate, Handle<FixedArray> survivors) {
+  Heap* heap = isolate->heap();
+  const int objects_per_page = 10;
+  const int object_size = GetObjectSize(objects_per_page);
+  for (int i = 0; i < survivors->length(); i++) {
+    HandleScope scope(isolate);
+    CHECK(heap->old_space()->Expand());
+    std::vector<Handle<FixedArray>> page_handles = heap::CreatePadding(
+        heap, object_size * objects_per_page, AllocationType::kOld,
+        object_size);
+    CheckAllObjectsOnPage(page_handles,
+                          Page::FromHeapObject(*page_handles.front()));
+    survivors->set(i, *page_handles.front());
+  }
+}
+
+int CountMovedObjects(Handle<FixedArray> objects,
+                      const std::vector<Page*>& pages) {
+  int moved = 0;
+  for (int i = 0; i < objects->length(); i++) {
+    HeapObject object = HeapObject::cast(objects->get(i));
+    if (Page::FromHeapObject(object) != pages[i]) moved++;
+  }
+  return moved;
+}
+
+std::vector<Page*> PagesOf(Handle<FixedArray> objects) {
+  std::vector<Page*> pages;
+  for (int i = 0; i < objects->length(); i++) {
+    pages.push_back(Page::FromHeapObject(HeapObject::cast(objects->get(i))));
+  }
+  return pages;
+}
+
 }  // namespace
 
+HEAP_TEST(CompactionPauseBudget) {
+  if (FLAG_never_compact || FLAG_always_compact || FLAG_stress_compaction ||
+      FLAG_stress_compaction_random) {
+    return;
+  }
+  // The budget is too small for any real compaction, so each GC evacuates
+  // only a page worth of live objects.
+  ManualGCScope manual_gc_scope;
+  FLAG_compaction_pause_budget_ms = 0.001;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+
+  const int kPages = 24;
+  Handle<FixedArray> survivors =
+      isolate->factory()->NewFixedArray(kPages, AllocationType::kOld);
+  Handle<FixedArray> more_survivors =
+      isolate->factory()->NewFixedArray(kPages, AllocationType::kOld);
+  heap::SealCurrentObjects(heap);
+  CreateFragmentedPages(isolate, survivors);
+  std::vector<Page*> pages = PagesOf(survivors);
+
+  // The first GC only compacts some of the fragmented pages...
+  CcTest::CollectAllGarbage();
+  heap->mark_compact_collector()->EnsureSweepingCompleted();
+  int moved = CountMovedObjects(survivors, pages);
+  CHECK_LT(0, moved);
+  CHECK_GT(kPages, moved);
+
+  // ...and the following ones pick up the rest. A page that holds the linear
+  // allocation area, and a single page whose compaction would not release any
+  // memory, may be left alone.
+  for (int i = 0; i < kPages && moved < kPages - 2; i++) {
+    CcTest::CollectAllGarbage();
+    heap->mark_compact_collector()->EnsureSweepingCompleted();
+    moved = CountMovedObjects(survivors, pages);
+  }
+  CHECK_LE(kPages - 2, moved);
+
+  // Memory reducing GCs are not limited by the budget.
+  heap::SealCurrentObjects(heap);
+  CreateFragmentedPages(isolate, more_survivors);
+  std::vector<Page*> more_pages = PagesOf(more_survivors);
+  heap->CollectAllGarbage(Heap::kReduceMemoryFootprintMask,
+                          GarbageCollectionReason::kTesting);
+  heap->mark_compact_collector()->EnsureSweepingCompleted();
+  CHECK_LE(kPages - 2, CountMovedObjects(more_survivors, more_pages));
+}
+
 HEAP_TEST(CompactionPartiallyAbortedPage) {
   if (FLAG_never_compact || FLAG_crash_on_aborted_evacuation) return;
   // Test the scenario where we reach OOM during compaction and parts of the
@@ -2079,6 +2079,36 @@ TEST(CollectingAllAvailableGarbageShrinksNewSpace) {
   CHECK_EQ(old_capacity, new_capacity);
 }
 
+TEST(AdaptiveSemiSpaceSizing) {
+  if (FLAG_single_generation) return;
+  FLAG_adaptive_semi_space_sizing = true;
+  FLAG_stress_concurrent_allocation = false;  // For SimulateFullSpace.
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  if (heap->MaxSemiSpaceSize() == heap->InitialSemiSpaceSize()) {
+    return;
+  }
+
+  v8::HandleScope scope(CcTest::isolate());
+  NewSpace* new_space = heap->new_space();
+  CcTest::CollectAllAvailableGarbage();
+  const size_t initial_capacity = new_space->TotalCapacity();
+  CHECK_EQ(new_space->InitialTotalCapacity(), initial_capacity);
+
+  {
+    // A full new space that survives the scavenge needs room for twice the
+    // survivors, so the controller grows the semi-spaces.
+    v8::HandleScope temporary_scope(CcTest::isolate());
+    heap::SimulateFullSpace(new_space);
+    CcTest::CollectGarbage(NEW_SPACE);
+    CHECK_LT(initial_capacity, new_space->TotalCapacity());
+  }
+
+  // Memory reducing GCs shrink them back.
+  CcTest::CollectAllAvailableGarbage();
+  CHECK_EQ(initial_capacity, new_space->TotalCapacity());
+}
+
 static int NumberOfGlobalObjects() {
   int count = 0;
   HeapObjectIterator iterator(CcTest::heap());
@@ -241,7 +241,7 @@ TEST(PartiallyInitializedJSFunction) {
   isolate->RegisterDeserializerStarted();
   // 2. Set the context field to the uninitialized sentintel.
   TaggedField<Object, JSFunction::kContextOffset>::store(
-      *js_function, Deserializer::uninitialized_field_value());
+      *js_function, Smi::uninitialized_deserialization_value());
   // 3. Request memory meaurement and run all tasks. GC that runs as part
   // of the measurement should not crash.
   CcTest::isolate()->MeasureMemory(
@@ -271,7 +271,7 @@ TEST(PartiallyInitializedContext) {
   isolate->RegisterDeserializerStarted();
   // 2. Set the native context field to the uninitialized sentintel.
   TaggedField<Object, Map::kConstructorOrBackPointerOrNativeContextOffset>::
-      store(*map, Deserializer::uninitialized_field_value());
+      store(*map, Smi::uninitialized_deserialization_value());
   // 3. Request memory meaurement and run all tasks. GC that runs as part
   // of the measurement should not crash.
   CcTest::isolate()->MeasureMemory(
@@ -286,6 +286,68 @@ TEST(PartiallyInitializedContext) {
   isolate->RegisterDeserializerFinished();
 }
 
+namespace {
+
+struct ContextLimitResult {
+  v8::Local<v8::Context> expected_context;
+  int calls = 0;
+  size_t live_bytes = 0;
+};
+
+void ContextMemoryLimitCallback(v8::Local<v8::Context> context,
+                                size_t live_bytes, void* data) {
+  ContextLimitResult* result = reinterpret_cast<ContextLimitResult*>(data);
+  CHECK(context == result->expected_context);
+  result->calls++;
+  result->live_bytes = live_bytes;
+}
+
+}  // anonymous namespace
+
+TEST(TrackedContextLiveBytes) {
+  ManualGCScope manual_gc_scope;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::Context> small_context = v8::Context::New(isolate);
+  v8::Local<v8::Context> large_context = v8::Context::New(isolate);
+  isolate->TrackContextMemory(small_context);
+  isolate->TrackContextMemory(large_context, MB);
+  ContextLimitResult result;
+  result.expected_context = large_context;
+  isolate->SetContextMemoryLimitCallback(ContextMemoryLimitCallback, &result);
+  {
+    v8::Context::Scope context_scope(large_context);
+    CompileRun(
+        "var data = [];"
+        "for (let i = 0; i < 200000; i++) data.push({i});");
+  }
+
+  CcTest::CollectAllGarbage();
+  size_t small_size = isolate->GetContextLiveBytes(small_context);
+  size_t large_size = isolate->GetContextLiveBytes(large_context);
+  CHECK_LT(0, small_size);
+  CHECK_LT(small_size + 2 * MB, large_size);
+
+  // The limit callback runs in a task after the GC.
+  while (v8::platform::PumpMessageLoop(v8::internal::V8::GetCurrentPlatform(),
+                                       isolate)) {
+  }
+  CHECK_EQ(1, result.calls);
+  CHECK_EQ(large_size, result.live_bytes);
+
+  isolate->UntrackContextMemory(large_context);
+  CHECK_EQ(0, isolate->GetContextLiveBytes(large_context));
+  CcTest::CollectAllGarbage();
+  while (v8::platform::PumpMessageLoop(v8::internal::V8::GetCurrentPlatform(),
+                                       isolate)) {
+  }
+  CHECK_EQ(1, result.calls);
+  CHECK_LT(0, isolate->GetContextLiveBytes(small_context));
+  isolate->UntrackContextMemory(small_context);
+  isolate->SetContextMemoryLimitCallback(nullptr, nullptr);
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
@@ -4,6 +4,7 @@
 
 #include "src/execution/isolate.h"
 #include "src/heap/factory.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/spaces-inl.h"
 #include "src/objects/objects-inl.h"
 #include "test/cctest/cctest.h"
@@ -166,6 +167,50 @@ UNINITIALIZED_HEAP_TEST(Regress658718) {
   isolate->Dispose();
 }
 
+#ifdef ENABLE_MINOR_MC
+UNINITIALIZED_HEAP_TEST(MinorMCPagePromotions) {
+  if (!i::FLAG_page_promotion) return;
+  FLAG_minor_mc = true;
+  // Also runs the formatting of the "mmc" line.
+  FLAG_trace_gc_nvp = true;
+
+  v8::Isolate* isolate = NewIsolateForPagePromotion();
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    Heap* heap = i_isolate->heap();
+    GCTracer* tracer = heap->tracer();
+
+    for (bool parallel_marking : {true, false}) {
+      FLAG_minor_mc_parallel_marking = parallel_marking;
+      // Ensure that the new space is empty so that the page to be moved does
+      // not contain the age mark.
+      heap->CollectGarbage(NEW_SPACE, i::GarbageCollectionReason::kTesting);
+      heap->CollectGarbage(NEW_SPACE, i::GarbageCollectionReason::kTesting);
+
+      v8::HandleScope inner_handle_scope(isolate);
+      std::vector<Handle<FixedArray>> handles;
+      heap::SimulateFullSpace(heap->new_space(), &handles);
+      CHECK_GT(handles.size(), 0u);
+      // The last page is fully live and does not contain the age mark, so the
+      // minor mark-compactor moves it within the young generation.
+      Handle<FixedArray> last_object = handles.back();
+      Page* to_be_promoted_page = Page::FromHeapObject(*last_object);
+      CHECK(!to_be_promoted_page->Contains(heap->new_space()->age_mark()));
+      heap->CollectGarbage(NEW_SPACE, i::GarbageCollectionReason::kTesting);
+      CHECK_EQ(GCTracer::Event::MINOR_MARK_COMPACTOR, tracer->current_.type);
+      CHECK(heap->new_space()->ToSpaceContainsSlow(last_object->address()));
+      CHECK(to_be_promoted_page->Contains(last_object->address()));
+      CHECK_LT(0u, tracer->current_.new_to_new_pages);
+      CHECK_EQ(0u, tracer->current_.new_to_old_pages);
+    }
+  }
+  isolate->Dispose();
+}
+#endif  // ENABLE_MINOR_MC
+
 #endif  // V8_LITE_MODE
 
 }  // namespace heap
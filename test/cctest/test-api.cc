@@ -21130,6 +21130,52 @@ THREADED_TEST(JSONParseArray) {
                      i::PACKED_ELEMENTS);
 }
 
+THREADED_TEST(JSONStreamingParse) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  HandleScope scope(isolate);
+
+  // Split the text into chunks of every size, including in the middle of
+  // the multi-byte characters.
+  const char* text =
+      "[{\"a\": [1, 2]}, \"\xE2\x98\x83\", 3.5, [\"]\", \"\\\"\"]]";
+  size_t length = strlen(text);
+  for (size_t chunk_size = 1; chunk_size <= length; chunk_size++) {
+    v8::JSON::StreamingParser parser(isolate,
+                                     v8::JSON::StreamingParser::UTF8);
+    for (size_t i = 0; i < length; i += chunk_size) {
+      const uint8_t* chunk = reinterpret_cast<const uint8_t*>(text + i);
+      CHECK(parser
+                .AppendChunk(context.local(), chunk,
+                             std::min(chunk_size, length - i))
+                .FromJust());
+    }
+    Local<Value> result = parser.Finish(context.local()).ToLocalChecked();
+    context->Global()->Set(context.local(), v8_str("obj"), result).FromJust();
+    ExpectString("JSON.stringify(obj)",
+                 "[{\"a\":[1,2]},\"\xE2\x98\x83\",3.5,[\"]\",\"\\\"\"]]");
+  }
+}
+
+THREADED_TEST(JSONStreamingParseError) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  HandleScope scope(isolate);
+
+  v8::JSON::StreamingParser parser(isolate,
+                                   v8::JSON::StreamingParser::ONE_BYTE);
+  const uint8_t first[] = "[1, 2";
+  const uint8_t second[] = ", ,3]";
+  CHECK(parser.AppendChunk(context.local(), first, 5).FromJust());
+  v8::TryCatch try_catch(isolate);
+  CHECK(parser.AppendChunk(context.local(), second, 5).IsNothing());
+  CHECK(try_catch.HasCaught());
+  String::Utf8Value message(isolate, try_catch.Message()->Get());
+  CHECK_EQ(0, strcmp(*message,
+                     "Uncaught SyntaxError: Unexpected token , in JSON at "
+                     "position 7"));
+}
+
 THREADED_TEST(JSONStringifyObject) {
   LocalContext context;
   HandleScope scope(context->GetIsolate());
@@ -21158,6 +21204,68 @@ THREADED_TEST(JSONStringifyObjectWithGap) {
   ExpectString("JSON.stringify(obj, null,  '*')", *utf8);
 }
 
+namespace {
+
+class StringUtf8Sink : public v8::JSON::Utf8Sink {
+ public:
+  void Append(const char* data, size_t length) override {
+    CHECK_GT(length, 0);
+    output.append(data, length);
+    chunks++;
+  }
+
+  std::string output;
+  int chunks = 0;
+};
+
+}  // namespace
+
+THREADED_TEST(JSONStringifyToUtf8) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  HandleScope scope(isolate);
+  // Large enough to be written in several parts, some of which end between
+  // the two halves of a surrogate pair.
+  const char* sources[] = {
+      "({x: 42, y: [1.5, 'a\\\\\\u00e9\\"\\n\\u0001']})",
+      "Array.from({length: 10000}, (_, i) => ({id: i, s: 'v' + i}))",
+      "Array.from({length: 10000}, (_, i) => '\\u2603\\ud83d\\ude00' + i)",
+      "({a: '\\u00ff'.repeat(50000), b: '\\ud83d\\ude00'.repeat(50000)})"};
+  for (const char* source : sources) {
+    Local<Value> value = CompileRun(source);
+    context->Global()->Set(context.local(), v8_str("obj"), value).FromJust();
+    for (Local<String> gap : {Local<String>(), v8_str("  ")}) {
+      StringUtf8Sink sink;
+      CHECK(v8::JSON::StringifyToUtf8(context.local(), value, &sink, gap)
+                .FromJust());
+      Local<String> expected =
+          v8::JSON::Stringify(context.local(), value, gap).ToLocalChecked();
+      v8::String::Utf8Value utf8(isolate, expected);
+      CHECK_EQ(std::string(*utf8, utf8.length()), sink.output);
+    }
+  }
+  StringUtf8Sink sink;
+  CHECK(v8::JSON::StringifyToUtf8(context.local(), CompileRun("obj"), &sink)
+            .FromJust());
+  CHECK_GT(sink.chunks, 1);
+}
+
+THREADED_TEST(JSONStringifyToUtf8NoResult) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  HandleScope scope(isolate);
+  StringUtf8Sink sink;
+  CHECK(!v8::JSON::StringifyToUtf8(context.local(), v8::Undefined(isolate),
+                                   &sink)
+             .FromJust());
+  CHECK_EQ(0, sink.chunks);
+
+  v8::TryCatch try_catch(isolate);
+  Local<Value> value = CompileRun("({toJSON() { throw 1; }})");
+  CHECK(v8::JSON::StringifyToUtf8(context.local(), value, &sink).IsNothing());
+  CHECK(try_catch.HasCaught());
+}
+
 #if V8_OS_POSIX
 class ThreadInterruptTest {
  public:
@@ -867,6 +867,73 @@ TEST(HeapSnapshotEphemeron) {
   CHECK(success);
 }
 
+static void CheckSameChildren(v8::Isolate* isolate,
+                              const v8::HeapGraphNode* expected,
+                              const v8::HeapGraphNode* actual) {
+  CHECK(expected);
+  CHECK(actual);
+  CHECK_EQ(expected->GetId(), actual->GetId());
+  CHECK_EQ(0, strcmp(GetName(expected), GetName(actual)));
+  CHECK_EQ(expected->GetChildrenCount(), actual->GetChildrenCount());
+  for (int i = 0, count = expected->GetChildrenCount(); i < count; ++i) {
+    const v8::HeapGraphEdge* expected_edge = expected->GetChild(i);
+    const v8::HeapGraphEdge* actual_edge = actual->GetChild(i);
+    CHECK_EQ(expected_edge->GetType(), actual_edge->GetType());
+    v8::String::Utf8Value expected_name(isolate, expected_edge->GetName());
+    v8::String::Utf8Value actual_name(isolate, actual_edge->GetName());
+    CHECK_EQ(0, strcmp(*expected_name, *actual_name));
+    CHECK_EQ(expected_edge->GetToNode()->GetId(),
+             actual_edge->GetToNode()->GetId());
+  }
+}
+
+TEST(HeapSnapshotParallelExtraction) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::HeapProfiler* heap_profiler = isolate->GetHeapProfiler();
+
+  CompileRun(
+      "class KeyClass{};\n"
+      "class ValueClass{};\n"
+      "function Point(x, y) { this.x = x; this.y = y; }\n"
+      "var points = [];\n"
+      "for (var i = 0; i < 10000; i++) points.push(new Point(i, {i}));\n"
+      "var key = new KeyClass();\n"
+      "var wm = new WeakMap();\n"
+      "wm.set(key, new ValueClass());\n"
+      "var buffer = new ArrayBuffer(16);\n");
+  i::FLAG_heap_snapshot_parallel_extraction = false;
+  const v8::HeapSnapshot* serial = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(serial));
+  i::FLAG_heap_snapshot_parallel_extraction = true;
+  const v8::HeapSnapshot* parallel = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(parallel));
+
+  // The references of the objects must be the same and in the same order,
+  // including the ones that ephemerons add to their keys.
+  const v8::HeapGraphNode* global = GetGlobalObject(serial);
+  for (const char* name : {"points", "key", "wm", "buffer"}) {
+    const v8::HeapGraphNode* node =
+        GetProperty(isolate, global, v8::HeapGraphEdge::kProperty, name);
+    CHECK(node);
+    CheckSameChildren(isolate, node, parallel->GetNodeById(node->GetId()));
+    for (int i = 0, count = node->GetChildrenCount(); i < count; ++i) {
+      const v8::HeapGraphNode* child = node->GetChild(i)->GetToNode();
+      CheckSameChildren(isolate, child, parallel->GetNodeById(child->GetId()));
+    }
+  }
+  const v8::HeapGraphNode* points = GetProperty(
+      isolate, global, v8::HeapGraphEdge::kProperty, "points");
+  const v8::HeapGraphNode* elements =
+      GetProperty(isolate, points, v8::HeapGraphEdge::kInternal, "elements");
+  CHECK(elements);
+  for (int i = 0, count = elements->GetChildrenCount(); i < count; ++i) {
+    const v8::HeapGraphNode* point = elements->GetChild(i)->GetToNode();
+    CheckSameChildren(isolate, point, parallel->GetNodeById(point->GetId()));
+  }
+}
+
 TEST(HeapSnapshotAddressReuse) {
   LocalContext env;
   v8::HandleScope scope(env->GetIsolate());
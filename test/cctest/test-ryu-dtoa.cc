@@ -0,0 +1,93 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdlib.h>
+
+#include "src/base/utils/random-number-generator.h"
+#include "src/init/v8.h"
+#include "src/numbers/bignum-dtoa.h"
+#include "src/numbers/double.h"
+#include "src/numbers/ryu-dtoa.h"
+#include "test/cctest/cctest.h"
+#include "test/cctest/gay-shortest.h"
+
+namespace v8 {
+namespace internal {
+namespace test_ryu_dtoa {
+
+static const int kBufferSize = 100;
+
+static void CheckShortest(double v, const char* representation,
+                          int decimal_point) {
+  char buffer_container[kBufferSize];
+  Vector<char> buffer(buffer_container, kBufferSize);
+  int length;
+  int point;
+  RyuDtoa(v, buffer, &length, &point);
+  CHECK_EQ(0, strcmp(representation, buffer.begin()));
+  CHECK_EQ(static_cast<int>(strlen(representation)), length);
+  CHECK_EQ(decimal_point, point);
+}
+
+TEST(RyuDtoaShortestVariousDoubles) {
+  CheckShortest(1.0, "1", 1);
+  CheckShortest(1.5, "15", 1);
+  CheckShortest(0.1, "1", 0);
+  CheckShortest(1.23e-18, "123", -17);
+  CheckShortest(1e21, "1", 22);
+  CheckShortest(1e23, "1", 24);
+  CheckShortest(5e-324, "5", -323);
+  CheckShortest(1.7976931348623157e308, "17976931348623157", 309);
+  CheckShortest(4294967272.0, "4294967272", 10);
+  CheckShortest(2147483648.0, "2147483648", 10);
+  CheckShortest(9007199254740991.0, "9007199254740991", 16);
+  CheckShortest(4.1855804968213567e298, "4185580496821357", 299);
+  CheckShortest(5.5626846462680035e-309, "5562684646268003", -308);
+  // FastDtoa can't compute this one, and needs the bignum fallback.
+  CheckShortest(3.5844466002796428e+298, "35844466002796428", 299);
+
+  uint64_t smallest_normal64 = 0x0010'0000'0000'0000;
+  CheckShortest(Double(smallest_normal64).value(), "22250738585072014", -307);
+  uint64_t largest_denormal64 = 0x000F'FFFF'FFFF'FFFF;
+  CheckShortest(Double(largest_denormal64).value(), "2225073858507201", -307);
+}
+
+TEST(RyuDtoaShortestHalfwayCases) {
+  // These are exactly halfway between the two closest 17 digit
+  // representations, and are rounded to the even one.
+  CheckShortest(1125899906842624.25, "11258999068426242", 16);
+  CheckShortest(1125899906842624.75, "11258999068426248", 16);
+  CheckShortest(125942.58911132812, "12594258911132812", 6);
+}
+
+TEST(RyuDtoaGayShortest) {
+  Vector<const PrecomputedShortest> precomputed =
+      PrecomputedShortestRepresentations();
+  for (int i = 0; i < precomputed.length(); ++i) {
+    const PrecomputedShortest current_test = precomputed[i];
+    CheckShortest(current_test.v, current_test.representation,
+                  current_test.decimal_point);
+  }
+}
+
+TEST(RyuDtoaMatchesBignumDtoa) {
+  base::RandomNumberGenerator rng(0x5EED);
+  char buffer_container[kBufferSize];
+  Vector<char> buffer(buffer_container, kBufferSize);
+  for (int i = 0; i < 100000; ++i) {
+    uint64_t bits;
+    rng.NextBytes(&bits, sizeof(bits));
+    Double d(bits & ~Double::kSignMask);
+    if (d.IsSpecial() || d.value() == 0) continue;
+    int length;
+    int point;
+    BignumDtoa(d.value(), BIGNUM_DTOA_SHORTEST, 0, buffer, &length, &point);
+    buffer[length] = '\0';
+    CheckShortest(d.value(), buffer.begin(), point);
+  }
+}
+
+}  // namespace test_ryu_dtoa
+}  // namespace internal
+}  // namespace v8
@@ -36,6 +36,7 @@
 #include "src/common/assert-scope.h"
 #include "src/debug/debug.h"
 #include "src/heap/heap-inl.h"
+#include "src/heap/parked-scope.h"
 #include "src/heap/read-only-heap.h"
 #include "src/heap/safepoint.h"
 #include "src/heap/spaces.h"
@@ -47,10 +48,12 @@
 #include "src/objects/js-array-inl.h"
 #include "src/objects/js-regexp-inl.h"
 #include "src/objects/objects-inl.h"
+#include "src/objects/string-table.h"
 #include "src/runtime/runtime.h"
 #include "src/snapshot/code-serializer.h"
 #include "src/snapshot/context-deserializer.h"
 #include "src/snapshot/context-serializer.h"
+#include "src/snapshot/persistent-code-cache.h"
 #include "src/snapshot/read-only-deserializer.h"
 #include "src/snapshot/read-only-serializer.h"
 #include "src/snapshot/snapshot-compression.h"
@@ -61,6 +64,11 @@
 #include "test/cctest/heap/heap-utils.h"
 #include "test/cctest/setup-isolate-for-tests.h"
 
+#if V8_OS_POSIX
+#include <dirent.h>
+#include <unistd.h>
+#endif  // V8_OS_POSIX
+
 namespace v8 {
 namespace internal {
 
@@ -744,6 +752,130 @@ UNINITIALIZED_TEST(CustomSnapshotDataBlobStringNotInternalized) {
 
 namespace {
 
+// Returns the number of read-only strings in the string table of {isolate}.
+int CountReadOnlyStringsInStringTable(Isolate* isolate) {
+  class CountingVisitor : public RootVisitor {
+   public:
+    explicit CountingVisitor(Isolate* isolate) : isolate_(isolate) {}
+
+    void VisitRootPointers(Root root, const char* description,
+                           FullObjectSlot start, FullObjectSlot end) override {
+      UNREACHABLE();
+    }
+
+    void VisitRootPointers(Root root, const char* description,
+                           OffHeapObjectSlot start,
+                           OffHeapObjectSlot end) override {
+      for (OffHeapObjectSlot current = start; current < end; ++current) {
+        Object obj = current.load(isolate_);
+        if (obj.IsHeapObject() &&
+            ReadOnlyHeap::Contains(HeapObject::cast(obj))) {
+          count_++;
+        }
+      }
+    }
+
+    int count() const { return count_; }
+
+   private:
+    Isolate* isolate_;
+    int count_ = 0;
+  };
+
+  CountingVisitor visitor(isolate);
+  SafepointScope safepoint_scope(isolate->heap());
+  isolate->string_table()->IterateElements(&visitor);
+  return visitor.count();
+}
+
+}  // namespace
+
+UNINITIALIZED_TEST(SharedStringTableIsolates) {
+  FLAG_shared_string_table = true;
+  // The shared string table belongs to the shared read-only heap.
+  if (!ReadOnlyHeap::IsReadOnlySpaceShared()) return;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  Isolate* i_isolate1 = reinterpret_cast<Isolate*>(isolate1);
+  Isolate* i_isolate2 = reinterpret_cast<Isolate*>(isolate2);
+
+  const SharedStringTable* shared_table =
+      i_isolate1->string_table()->shared_table();
+  CHECK_NOT_NULL(shared_table);
+  CHECK_EQ(shared_table, i_isolate2->string_table()->shared_table());
+
+  for (Isolate* isolate : {i_isolate1, i_isolate2}) {
+    v8::Isolate::Scope isolate_scope(reinterpret_cast<v8::Isolate*>(isolate));
+    HandleScope scope(isolate);
+
+    // A read-only string internalizes to the read-only object.
+    Handle<String> internalized =
+        isolate->factory()->InternalizeUtf8String("length");
+    CHECK_EQ(ReadOnlyRoots(isolate).length_string(), *internalized);
+
+    // The lookup without insertion finds it in the shared table.
+    Handle<String> string =
+        isolate->factory()->NewStringFromAsciiChecked("length");
+    CHECK(!string->IsInternalizedString());
+    CHECK_EQ(internalized->ptr(), StringTable::TryStringToIndexOrLookupExisting(
+                                      isolate, string->ptr()));
+
+    // None of the read-only strings were added to the isolate's own table.
+    CHECK_EQ(0, CountReadOnlyStringsInStringTable(isolate));
+  }
+#ifndef V8_COMPRESS_POINTERS
+  // Without pointer compression, the isolates share the read-only heap
+  // itself, so it is the very same object.
+  CHECK_EQ(ReadOnlyRoots(i_isolate1).length_string(),
+           ReadOnlyRoots(i_isolate2).length_string());
+#endif
+
+  isolate1->Dispose();
+  isolate2->Dispose();
+}
+
+UNINITIALIZED_TEST(SharedStringTableSnapshotWithoutFlag) {
+  DisableAlwaysOpt();
+  const char* source = "var s = 'length';";
+
+  FLAG_shared_string_table = true;
+  DisableEmbeddedBlobRefcounting();
+  v8::StartupData data = CreateSnapshotDataBlob(source);
+  FLAG_shared_string_table = false;
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &data;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+
+  // Test-appropriate equivalent of v8::Isolate::New.
+  v8::Isolate* isolate = TestSerializer::NewIsolate(params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  CHECK_NULL(i_isolate->string_table()->shared_table());
+  {
+    v8::Isolate::Scope i_scope(isolate);
+    v8::HandleScope h_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope c_scope(context);
+
+    // The snapshot also contains the strings of the shared table, so without
+    // the flag they are in the isolate's own table and internalize to the
+    // read-only objects instead of new copies.
+    Handle<String> internalized =
+        i_isolate->factory()->InternalizeUtf8String("length");
+    CHECK_EQ(ReadOnlyRoots(i_isolate).length_string(), *internalized);
+    CHECK_LT(0, CountReadOnlyStringsInStringTable(i_isolate));
+    CHECK(CompileRun("s === 'length'")->IsTrue());
+  }
+  isolate->Dispose();
+  delete[] data.data;  // We can dispose of the snapshot blob now.
+  FreeCurrentEmbeddedBlob();
+}
+
+namespace {
+
 void TestCustomSnapshotDataBlobWithIrregexpCode(
     v8::SnapshotCreator::FunctionCodeHandling function_code_handling) {
   DisableAlwaysOpt();
@@ -2435,6 +2567,258 @@ TEST(CodeSerializerIsolatesEager) {
   isolate2->Dispose();
 }
 
+namespace {
+
+class ConsumeCodeCacheThread final : public v8::base::Thread {
+ public:
+  explicit ConsumeCodeCacheThread(
+      v8::ScriptCompiler::ConsumeCodeCacheTask* task)
+      : Thread(base::Thread::Options("ConsumeCodeCacheThread")), task_(task) {}
+
+  void Run() override { task_->Run(); }
+
+ private:
+  v8::ScriptCompiler::ConsumeCodeCacheTask* task_;
+};
+
+void TestCodeSerializerOffThreadDeserialize(const char* compile_source,
+                                            bool expect_rejection) {
+  const char* source = "function f() { return 'abc'; }; f() + 'def'";
+  v8::ScriptCompiler::CachedData* cache = CompileRunAndProduceCache(source);
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptCompiler::ConsumeCodeCacheTask* task =
+        v8::ScriptCompiler::StartConsumingCodeCache(
+            isolate2, std::unique_ptr<v8::ScriptCompiler::CachedData>(cache));
+    ConsumeCodeCacheThread thread(task);
+    CHECK(thread.Start());
+    {
+      // The background thread may have to wait for a GC.
+      Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate2);
+      ParkedScope parked_scope(i_isolate->main_thread_local_isolate());
+      thread.Join();
+    }
+
+    v8::Local<v8::String> source_str = v8_str(compile_source);
+    v8::ScriptOrigin origin(isolate2, v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, nullptr, task);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    CHECK_EQ(expect_rejection, cache->rejected);
+
+    Handle<SharedFunctionInfo> sfi = v8::Utils::OpenHandle(*script);
+    Handle<Script> i_script(Script::cast(sfi->script()), sfi->GetIsolate());
+    CHECK(i_script->source().IsString());
+    CHECK(String::cast(i_script->source())
+              .IsEqualTo(CStrVector(compile_source)));
+
+    v8::Local<v8::Value> result = script->BindToCurrentContext()
+                                      ->Run(isolate2->GetCurrentContext())
+                                      .ToLocalChecked();
+    CHECK(result->ToString(isolate2->GetCurrentContext())
+              .ToLocalChecked()
+              ->Equals(isolate2->GetCurrentContext(),
+                       v8_str(expect_rejection ? "ABCdef" : "abcdef"))
+              .FromJust());
+  }
+  isolate2->Dispose();
+}
+
+}  // namespace
+
+TEST(CodeSerializerOffThreadDeserialize) {
+  TestCodeSerializerOffThreadDeserialize(
+      "function f() { return 'abc'; }; f() + 'def'", false);
+}
+
+TEST(CodeSerializerOffThreadDeserializeSourceMismatch) {
+  // The source hash covers the length only, so the code cache is rejected on
+  // the main thread for a source of a different length.
+  TestCodeSerializerOffThreadDeserialize(
+      "function f() { return 'ABC'; };  f() + 'def'", true);
+}
+
+#if V8_OS_POSIX
+namespace {
+
+int CountCompiledFunctions(Isolate* isolate,
+                           v8::Local<v8::UnboundScript> script) {
+  Handle<SharedFunctionInfo> toplevel =
+      Handle<SharedFunctionInfo>::cast(v8::Utils::OpenHandle(*script));
+  SharedFunctionInfo::ScriptIterator iterator(
+      isolate, Script::cast(toplevel->script()));
+  int count = 0;
+  for (SharedFunctionInfo info = iterator.Next(); !info.is_null();
+       info = iterator.Next()) {
+    if (info.is_compiled()) count++;
+  }
+  return count;
+}
+
+void RemoveDirectory(const char* directory) {
+  DIR* dir = opendir(directory);
+  CHECK_NOT_NULL(dir);
+  while (struct dirent* entry = readdir(dir)) {
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+      continue;
+    }
+    std::string path = std::string(directory) + "/" + entry->d_name;
+    CHECK(base::OS::Remove(path.c_str()));
+  }
+  closedir(dir);
+  CHECK_EQ(0, rmdir(directory));
+}
+
+int CountCacheEntries(const char* directory) {
+  DIR* dir = opendir(directory);
+  CHECK_NOT_NULL(dir);
+  int count = 0;
+  while (struct dirent* entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name.size() == strlen("0123456789abcdef.v8cc") &&
+        name.compare(16, std::string::npos, ".v8cc") == 0) {
+      count++;
+    }
+  }
+  closedir(dir);
+  return count;
+}
+
+}  // namespace
+
+TEST(PersistentCodeCacheIsolates) {
+  DisableAlwaysOpt();
+  char directory[] = "/tmp/v8-code-cache-XXXXXX";
+  CHECK_NOT_NULL(mkdtemp(directory));
+  const char* source =
+      "function f() { return 'abc'; };"
+      "function g() { return 'ghi'; };"
+      "(this.call_g ? g() : f()) + 'def'";
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  create_params.code_cache_directory = directory;
+
+  for (int run = 0; run < 3; run++) {
+    v8::Isolate* isolate = v8::Isolate::New(create_params);
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    {
+      v8::Isolate::Scope iscope(isolate);
+      v8::HandleScope scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+
+      // Later runs load the same source under a different name and position.
+      v8::ScriptOrigin origin(isolate, v8_str(run == 0 ? "test" : "other"),
+                              run * 10, run * 2);
+      v8::ScriptCompiler::Source script_source(v8_str(source), origin);
+      v8::Local<v8::UnboundScript> script;
+      if (run == 0) {
+        script = v8::ScriptCompiler::CompileUnboundScript(isolate,
+                                                          &script_source)
+                     .ToLocalChecked();
+        // Only the toplevel function was compiled, and it is not stored
+        // before it ran.
+        CHECK_EQ(1, CountCompiledFunctions(i_isolate, script));
+        CHECK_EQ(0, i_isolate->persistent_code_cache()->total_size());
+      } else {
+        // Later isolates find the script in the on-disk cache.
+        DisallowCompilation no_compile(i_isolate);
+        script = v8::ScriptCompiler::CompileUnboundScript(isolate,
+                                                          &script_source)
+                     .ToLocalChecked();
+        // The first run stored the lazily compiled {f} when its isolate was
+        // disposed, and the second run refreshed the entry with {g}.
+        CHECK_EQ(run + 1, CountCompiledFunctions(i_isolate, script));
+        // The cached script takes the details of this one.
+        Handle<SharedFunctionInfo> toplevel =
+            Handle<SharedFunctionInfo>::cast(v8::Utils::OpenHandle(*script));
+        Script cached_script = Script::cast(toplevel->script());
+        CHECK(String::cast(cached_script.name())
+                  .IsOneByteEqualTo(CStrVector("other")));
+        CHECK_EQ(run * 10, cached_script.line_offset());
+        CHECK_EQ(run * 2, cached_script.column_offset());
+        CHECK_LT(0, i_isolate->persistent_code_cache()->total_size());
+      }
+
+      if (run > 0) {
+        CHECK(context->Global()
+                  ->Set(context, v8_str("call_g"), v8::True(isolate))
+                  .FromJust());
+      }
+      v8::Local<v8::Value> result =
+          script->BindToCurrentContext()->Run(context).ToLocalChecked();
+      CHECK(result->ToString(context)
+                .ToLocalChecked()
+                ->Equals(context, v8_str(run == 0 ? "abcdef" : "ghidef"))
+                .FromJust());
+    }
+    isolate->Dispose();
+  }
+  RemoveDirectory(directory);
+}
+
+TEST(PersistentCodeCacheSharedDirectory) {
+  // Two caches on the same directory stand in for two processes. The maximum
+  // size holds for the directory as a whole.
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  HandleScope scope(isolate);
+  char directory[] = "/tmp/v8-code-cache-XXXXXX";
+  CHECK_NOT_NULL(mkdtemp(directory));
+
+  const int kPayloadLength = 100;
+  byte payload[kPayloadLength] = {};
+  Handle<String> probe_source =
+      isolate->factory()->NewStringFromAsciiChecked("'probe'");
+  size_t entry_size;
+  {
+    PersistentCodeCache probe(directory, PersistentCodeCache::kDefaultMaxSize);
+    CHECK(probe.Store(isolate, probe_source, ScriptOriginOptions(), payload,
+                      kPayloadLength));
+    probe.FlushPendingWrites();
+    entry_size = probe.total_size();
+    probe.Remove(isolate, probe_source, ScriptOriginOptions());
+  }
+  CHECK_EQ(0, CountCacheEntries(directory));
+
+  {
+    PersistentCodeCache cache1(directory, 3 * entry_size);
+    PersistentCodeCache cache2(directory, 3 * entry_size);
+    auto store = [&](PersistentCodeCache* cache, int i) {
+      std::string source = "'" + std::to_string(i) + "'";
+      CHECK(cache->Store(isolate,
+                         isolate->factory()->NewStringFromAsciiChecked(
+                             source.c_str()),
+                         ScriptOriginOptions(), payload, kPayloadLength));
+      cache->FlushPendingWrites();
+    };
+    store(&cache1, 0);
+    store(&cache1, 1);
+    store(&cache2, 2);
+    store(&cache2, 3);
+    // {cache2} sees the entries of {cache1} and evicts the oldest one.
+    CHECK_EQ(3, CountCacheEntries(directory));
+    CHECK_EQ(3 * entry_size, cache2.total_size());
+    store(&cache1, 4);
+    CHECK_EQ(3, CountCacheEntries(directory));
+    CHECK_EQ(3 * entry_size, cache1.total_size());
+  }
+
+  RemoveDirectory(directory);
+}
+#endif  // V8_OS_POSIX
+
 TEST(CodeSerializerAfterExecute) {
   // We test that no compilations happen when running this code. Forcing
   // to always optimize breaks this test.
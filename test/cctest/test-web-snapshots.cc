@@ -127,5 +127,206 @@ TEST(InnerFunctionWithContextAndParentContext) {
                   kMapCount, kContextCount, kFunctionCount, kObjectCount);
 }
 
+TEST(Arrays) {
+  const char* snapshot_source =
+      "var foo = {'smis': [1, -2, 3], 'doubles': [1.5, -2.5],\n"
+      "           'mixed': [1, 'lol', true, null, {'key': false}]};";
+  const char* test_source =
+      "foo.smis.concat(foo.doubles).join() + ',' + foo.mixed.length + "
+      "foo.mixed[1] + foo.mixed[4].key";
+  const char* expected_result = "1,-2,3,1.5,-2.5,5lolfalse";
+  // Strings: 'foo', 'smis', 'doubles', 'mixed', 'lol', 'key'
+  uint32_t kStringCount = 6;
+  uint32_t kMapCount = 2;
+  uint32_t kContextCount = 0;
+  uint32_t kFunctionCount = 0;
+  uint32_t kObjectCount = 5;
+  TestWebSnapshot(snapshot_source, test_source, expected_result, kStringCount,
+                  kMapCount, kContextCount, kFunctionCount, kObjectCount);
+}
+
+TEST(TypedArrays) {
+  const char* snapshot_source =
+      "var foo = {'bytes': new Uint8Array([1, 2, 3]),\n"
+      "           'doubles': new Float64Array([1.5, 2.5])};";
+  const char* test_source =
+      "'' + foo.bytes.length + foo.bytes[2] + (foo.doubles[0] + "
+      "foo.doubles[1]) + foo.doubles.buffer.byteLength";
+  const char* expected_result = "33416";
+  uint32_t kStringCount = 3;  // 'foo', 'bytes', 'doubles'
+  uint32_t kMapCount = 1;
+  uint32_t kContextCount = 0;
+  uint32_t kFunctionCount = 0;
+  uint32_t kObjectCount = 3;
+  TestWebSnapshot(snapshot_source, test_source, expected_result, kStringCount,
+                  kMapCount, kContextCount, kFunctionCount, kObjectCount);
+}
+
+TEST(MapsAndSets) {
+  const char* snapshot_source =
+      "var foo = {'map': new Map([['a', 1], ['b', {'key': 'lol'}]]),\n"
+      "           'set': new Set(['c', 2])};";
+  const char* test_source =
+      "foo.map.get('a') + foo.map.get('b').key + [...foo.set].join()";
+  const char* expected_result = "1lolc,2";
+  // Strings: 'foo', 'map', 'set', 'a', 'b', 'key', 'lol', 'c'
+  uint32_t kStringCount = 8;
+  uint32_t kMapCount = 2;
+  uint32_t kContextCount = 0;
+  uint32_t kFunctionCount = 0;
+  uint32_t kObjectCount = 4;
+  TestWebSnapshot(snapshot_source, test_source, expected_result, kStringCount,
+                  kMapCount, kContextCount, kFunctionCount, kObjectCount);
+}
+
+TEST(ClassInstance) {
+  const char* snapshot_source =
+      "class Point {\n"
+      "  constructor(x) { this.x = x; }\n"
+      "  twice() { return '' + this.x * 2; }\n"
+      "}\n"
+      "var foo = {'key': new Point(21)};";
+  const char* test_source = "foo.key.twice()";
+  const char* expected_result = "42";
+  // Strings: 'foo', 'key', class source code, 'x'
+  uint32_t kStringCount = 4;
+  uint32_t kMapCount = 2;
+  uint32_t kContextCount = 0;
+  uint32_t kFunctionCount = 1;
+  uint32_t kObjectCount = 2;
+  TestWebSnapshot(snapshot_source, test_source, expected_result, kStringCount,
+                  kMapCount, kContextCount, kFunctionCount, kObjectCount);
+}
+
+TEST(Cycle) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+  CompileRun("var foo = {'key': {}}; foo.key.parent = foo;");
+  v8::TryCatch try_catch(isolate);
+  WebSnapshotData snapshot_data;
+  std::vector<std::string> exports;
+  exports.push_back("foo");
+  WebSnapshotSerializer serializer(isolate);
+  CHECK(!serializer.TakeSnapshot(context, exports, snapshot_data));
+  CHECK(serializer.has_error());
+  CHECK(try_catch.HasCaught());
+}
+
+namespace {
+
+void TakeSnapshot(const char* snapshot_source, WebSnapshotData& snapshot_data) {
+  v8::Isolate* isolate = CcTest::isolate();
+  CompileRun(snapshot_source);
+  std::vector<std::string> exports;
+  exports.push_back("foo");
+  WebSnapshotSerializer serializer(isolate);
+  CHECK(serializer.TakeSnapshot(isolate->GetCurrentContext(), exports,
+                                snapshot_data));
+  CHECK(!serializer.has_error());
+  CHECK_NOT_NULL(snapshot_data.buffer);
+}
+
+}  // namespace
+
+TEST(Streaming) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  WebSnapshotData snapshot_data;
+  TakeSnapshot("var foo = {'key': (function() { return 'lol'; })};",
+               snapshot_data);
+
+  // Sections are deserialized as soon as they have been received completely,
+  // no matter how the snapshot is split into chunks.
+  for (size_t chunk_size : {size_t{1}, size_t{7}, snapshot_data.buffer_size}) {
+    v8::Local<v8::Context> new_context = CcTest::NewContext();
+    v8::Context::Scope context_scope(new_context);
+    WebSnapshotDeserializer deserializer(isolate);
+    for (size_t ix = 0; ix < snapshot_data.buffer_size; ix += chunk_size) {
+      size_t size = std::min(chunk_size, snapshot_data.buffer_size - ix);
+      CHECK(deserializer.AppendChunk(snapshot_data.buffer + ix, size));
+    }
+    CHECK(deserializer.FinishStreaming());
+    CHECK(!deserializer.has_error());
+    v8::Local<v8::String> result = CompileRun("foo.key()").As<v8::String>();
+    CHECK(result->Equals(new_context, v8_str("lol")).FromJust());
+    CHECK_EQ(1, deserializer.function_count());
+    CHECK_EQ(1, deserializer.object_count());
+  }
+}
+
+TEST(StreamingIncomplete) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  WebSnapshotData snapshot_data;
+  TakeSnapshot("var foo = {'key': 'lol'};", snapshot_data);
+
+  v8::Local<v8::Context> new_context = CcTest::NewContext();
+  v8::Context::Scope context_scope(new_context);
+  v8::TryCatch try_catch(isolate);
+  WebSnapshotDeserializer deserializer(isolate);
+  CHECK(deserializer.AppendChunk(snapshot_data.buffer,
+                                 snapshot_data.buffer_size - 1));
+  CHECK(!deserializer.FinishStreaming());
+  CHECK(deserializer.has_error());
+  CHECK(try_catch.HasCaught());
+}
+
+TEST(Lazy) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  WebSnapshotData snapshot_data;
+  TakeSnapshot("var foo = {'key': (function() { return 'lol'; })};",
+               snapshot_data);
+
+  v8::Local<v8::Context> new_context = CcTest::NewContext();
+  v8::Context::Scope context_scope(new_context);
+  WebSnapshotDeserializer deserializer(
+      isolate, WebSnapshotDeserializer::Mode::kLazy);
+  CHECK(deserializer.UseWebSnapshot(snapshot_data.buffer,
+                                    snapshot_data.buffer_size));
+  CHECK(!deserializer.has_error());
+  CHECK_EQ(1, deserializer.function_count());
+  CHECK_EQ(1, deserializer.object_count());
+  CHECK_EQ(0, deserializer.materialized_function_count());
+  CHECK_EQ(0, deserializer.materialized_object_count());
+
+  // Reading the export materializes the object and everything it refers to.
+  v8::Local<v8::String> result = CompileRun("foo.key()").As<v8::String>();
+  CHECK(result->Equals(new_context, v8_str("lol")).FromJust());
+  CHECK_EQ(1, deserializer.materialized_function_count());
+  CHECK_EQ(1, deserializer.materialized_object_count());
+  CHECK(CompileRun("foo === foo")->IsTrue());
+}
+
+TEST(LazyTypedArray) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  WebSnapshotData snapshot_data;
+  TakeSnapshot("var foo = {'key': new Float64Array([1.5, 2.5])};",
+               snapshot_data);
+
+  v8::Local<v8::Context> new_context = CcTest::NewContext();
+  v8::Context::Scope context_scope(new_context);
+  WebSnapshotDeserializer deserializer(
+      isolate, WebSnapshotDeserializer::Mode::kLazy);
+  CHECK(deserializer.UseWebSnapshot(snapshot_data.buffer,
+                                    snapshot_data.buffer_size));
+  CHECK_EQ(0, deserializer.materialized_object_count());
+
+  // The contents are used in place, and can still be written to.
+  v8::Local<v8::String> result =
+      CompileRun("foo.key[0] = 7; '' + (foo.key[0] + foo.key[1])")
+          .As<v8::String>();
+  CHECK(result->Equals(new_context, v8_str("9.5")).FromJust());
+  CHECK_EQ(2, deserializer.materialized_object_count());
+}
+
 }  // namespace internal
 }  // namespace v8
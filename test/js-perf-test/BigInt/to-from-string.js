@@ -0,0 +1,92 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+"use strict";
+
+load('bigint-util.js');
+
+let input_bigints = [];
+let input_strings = [];
+let iterations = 0;
+
+// Decimal string lengths. The large cases exercise the divide-and-conquer
+// conversion algorithms.
+const DIGITS_CASES = [100, 1000, 10000, 100000];
+
+
+// This dummy ensures that the feedback for benchmark.run() in the Measure
+// function from base.js is not monomorphic, thereby preventing the benchmarks
+// below from being inlined. This ensures consistent behavior and comparable
+// results.
+new BenchmarkSuite('Prevent-Inline-Dummy', [10000], [
+  new Benchmark('Prevent-Inline-Dummy', true, false, 0, () => {})
+]);
+
+
+DIGITS_CASES.forEach((d) => {
+  new BenchmarkSuite(`ToString-Decimal-${d}`, [1000], [
+    new Benchmark(`ToString-Decimal-${d}`, true, false, 0, TestToString,
+      () => SetUpTestToString(d))
+  ]);
+});
+
+
+DIGITS_CASES.forEach((d) => {
+  new BenchmarkSuite(`FromString-Decimal-${d}`, [1000], [
+    new Benchmark(`FromString-Decimal-${d}`, true, false, 0, TestFromString,
+      () => SetUpTestFromString(d))
+  ]);
+});
+
+
+function RandomDecimalString(digits) {
+  let s = String(1 + Math.floor(Math.random() * 9));
+  for (let i = 1; i < digits; i++) {
+    s += String(Math.floor(Math.random() * 10));
+  }
+  return s;
+}
+
+
+function SetIterations(digits) {
+  iterations = digits >= 10000 ? 1 : SLOW_TEST_ITERATIONS;
+}
+
+
+function SetUpTestToString(digits) {
+  SetIterations(digits);
+  input_bigints = [];
+  for (let i = 0; i < 4; i++) {
+    input_bigints.push(BigInt(RandomDecimalString(digits)));
+  }
+}
+
+
+function TestToString() {
+  let result = "";
+  for (let i = 0; i < iterations; ++i) {
+    result = input_bigints[i % 4].toString();
+  }
+
+  return result;
+}
+
+
+function SetUpTestFromString(digits) {
+  SetIterations(digits);
+  input_strings = [];
+  for (let i = 0; i < 4; i++) {
+    input_strings.push(RandomDecimalString(digits));
+  }
+}
+
+
+function TestFromString() {
+  let result = 0n;
+  for (let i = 0; i < iterations; ++i) {
+    result = BigInt(input_strings[i % 4]);
+  }
+
+  return result;
+}
@@ -0,0 +1,68 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+function MakeRecords(count, text) {
+  const records = [];
+  for (let i = 0; i < count; ++i) {
+    records.push({
+      id: i,
+      name: `record ${i}`,
+      active: i % 2 == 0,
+      score: i * 1.5,
+      tags: ['alpha', 'beta', 'gamma'],
+      text: text,
+    });
+  }
+  return records;
+}
+
+const kMinified = JSON.stringify(MakeRecords(100, 'short'));
+const kPretty = JSON.stringify(MakeRecords(100, 'short'), null, 8);
+const kLongStrings =
+    JSON.stringify(MakeRecords(100, 'lorem ipsum '.repeat(20)));
+const kEscapedStrings =
+    JSON.stringify(MakeRecords(100, 'line\n"quoted"\t'.repeat(10)));
+const kTwoByteStrings =
+    JSON.stringify(MakeRecords(100, 'lorem ipsum ☃ '.repeat(20)));
+const kNestedRecords = JSON.stringify(MakeRecords(100, 'short').map(
+    record => ({id: record.id, user: {name: record.name, meta: record}})));
+
+let result;
+
+function ParseMinified() {
+  result = JSON.parse(kMinified);
+}
+
+function ParsePretty() {
+  result = JSON.parse(kPretty);
+}
+
+function ParseLongStrings() {
+  result = JSON.parse(kLongStrings);
+}
+
+function ParseEscapedStrings() {
+  result = JSON.parse(kEscapedStrings);
+}
+
+function ParseTwoByteStrings() {
+  result = JSON.parse(kTwoByteStrings);
+}
+
+function ParseNestedRecords() {
+  result = JSON.parse(kNestedRecords);
+}
+
+function Verify() {
+  if (result.length != 100 || result[99].id != 99) {
+    throw new Error('Unexpected result');
+  }
+}
+
+createSuite('ParseMinified', 1000, ParseMinified, () => {}, Verify);
+createSuite('ParsePretty', 1000, ParsePretty, () => {}, Verify);
+createSuite('ParseLongStrings', 1000, ParseLongStrings, () => {}, Verify);
+createSuite('ParseEscapedStrings', 1000, ParseEscapedStrings, () => {}, Verify);
+createSuite('ParseTwoByteStrings', 1000, ParseTwoByteStrings, () => {}, Verify);
+createSuite('ParseNestedRecords', 1000, ParseNestedRecords, () => {}, Verify);
@@ -0,0 +1,61 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --sparkplug --no-always-sparkplug
+// Flags: --baseline-batch-compilation
+// Flags: --baseline-batch-compilation-threshold=1000000
+// Flags: --scale-factor-for-feedback-allocation=1 --expose-gc
+
+// Creates {count} distinct functions, so that each of them is enqueued for
+// batch compilation on its own.
+function MakeFunctions(count) {
+  let fns = [];
+  for (let i = 0; i < count; i++) {
+    fns.push(new Function("a", "b",
+        `let r = 0;
+         for (let j = 0; j < a; j++) { r += j * b + ${i}; }
+         return r;`));
+  }
+  return fns;
+}
+
+function Expected(a, b, i) {
+  let r = 0;
+  for (let j = 0; j < a; j++) { r += j * b + i; }
+  return r;
+}
+
+function Enqueue(fns) {
+  for (let i = 0; i < fns.length; i++) {
+    // Compile the bytecode first.
+    fns[i](1, 1);
+    %EnqueueForBaselineBatchCompilation(fns[i]);
+  }
+}
+
+// Enqueued functions are not compiled until the batch is.
+let fns = MakeFunctions(20);
+Enqueue(fns);
+for (let i = 0; i < fns.length; i++) {
+  assertTrue(isInterpreted(fns[i]));
+}
+%CompileBaselineBatch();
+for (let i = 0; i < fns.length; i++) {
+  assertTrue(isBaseline(fns[i]));
+  assertEquals(Expected(10, 2, i), fns[i](10, 2));
+}
+
+// Functions that die while enqueued must be skipped when the batch is
+// compiled.
+(function() {
+  Enqueue(MakeFunctions(10));
+})();
+let more = MakeFunctions(20);
+Enqueue(more);
+gc();
+%CompileBaselineBatch();
+for (let i = 0; i < more.length; i++) {
+  assertTrue(isBaseline(more[i]));
+  assertEquals(Expected(20, 3, i), more[i](20, 3));
+}
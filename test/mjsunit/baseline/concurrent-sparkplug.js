@@ -0,0 +1,54 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --sparkplug --no-always-sparkplug
+// Flags: --concurrent-sparkplug
+// Flags: --baseline-batch-compilation-threshold=1000000 --expose-gc
+
+function MakeFunctions(count) {
+  let fns = [];
+  for (let i = 0; i < count; i++) {
+    fns.push(new Function("o", `return o.x + o.y * ${i};`));
+  }
+  return fns;
+}
+
+function Enqueue(fns) {
+  for (let i = 0; i < fns.length; i++) {
+    // Compile the bytecode first.
+    fns[i]({x: 0, y: 0});
+    %EnqueueForBaselineBatchCompilation(fns[i]);
+  }
+}
+
+// Hand several batches to the background thread, and keep running the
+// functions while they are compiled. Installing the code happens on the main
+// thread only, either from the INSTALL_BASELINE_CODE interrupt or when
+// finalizing.
+let fns = MakeFunctions(50);
+for (let batch = 0; batch < 5; batch++) {
+  Enqueue(fns.slice(batch * 10, (batch + 1) * 10));
+  %CompileBaselineBatch();
+}
+for (let round = 0; round < 20; round++) {
+  let o = {x: round, y: 2};
+  for (let i = 0; i < fns.length; i++) {
+    assertEquals(round + 2 * i, fns[i](o));
+  }
+  // A GC while batches are in flight must keep their functions alive.
+  if (round % 5 == 0) gc();
+}
+%FinalizeBaselineBatchCompilation();
+for (let i = 0; i < fns.length; i++) {
+  assertTrue(isBaseline(fns[i]));
+  assertEquals(7 + 2 * i, fns[i]({x: 7, y: 2}));
+}
+
+// Finalizing must cope with batches whose functions died in the meantime.
+(function() {
+  Enqueue(MakeFunctions(10));
+  %CompileBaselineBatch();
+})();
+gc();
+%FinalizeBaselineBatchCompilation();
@@ -0,0 +1,162 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+function EncodeLatin1(text) {
+  return Uint8Array.from(text, c => c.charCodeAt(0));
+}
+
+function EncodeUtf16(text) {
+  const units = new Uint16Array(text.length);
+  for (let i = 0; i < text.length; ++i) units[i] = text.charCodeAt(i);
+  return new Uint8Array(units.buffer);
+}
+
+function EncodeUtf8(text) {
+  const bytes = [];
+  for (const c of text) {
+    const code = c.codePointAt(0);
+    if (code < 0x80) {
+      bytes.push(code);
+    } else if (code < 0x800) {
+      bytes.push(0xc0 | (code >> 6), 0x80 | (code & 0x3f));
+    } else if (code < 0x10000) {
+      bytes.push(0xe0 | (code >> 12), 0x80 | ((code >> 6) & 0x3f),
+                 0x80 | (code & 0x3f));
+    } else {
+      bytes.push(0xf0 | (code >> 18), 0x80 | ((code >> 12) & 0x3f),
+                 0x80 | ((code >> 6) & 0x3f), 0x80 | (code & 0x3f));
+    }
+  }
+  return new Uint8Array(bytes);
+}
+
+const kEncoders = {latin1: EncodeLatin1, utf8: EncodeUtf8, utf16: EncodeUtf16};
+
+// Splits the bytes into chunks of the given size. The chunks may end in the
+// middle of a character.
+function Split(bytes, chunk_size) {
+  const chunks = [];
+  for (let i = 0; i < bytes.length; i += chunk_size) {
+    chunks.push(bytes.subarray(i, i + chunk_size));
+  }
+  return chunks;
+}
+
+function Check(text, encodings = ['latin1', 'utf8', 'utf16'],
+               chunk_sizes = [1, 2, 3, 7, 64]) {
+  let expected_value, expected_error;
+  try {
+    expected_value = JSON.parse(text);
+  } catch (e) {
+    expected_error = e;
+  }
+  for (const encoding of encodings) {
+    const bytes = kEncoders[encoding](text);
+    for (const chunk_size of [...chunk_sizes, bytes.length || 1]) {
+      const chunks = Split(bytes, chunk_size);
+      if (expected_error) {
+        AssertSameError(() => d8.json.parseStreaming(chunks, encoding),
+                        expected_error);
+      } else {
+        assertEquals(expected_value,
+                     d8.json.parseStreaming(chunks, encoding));
+      }
+    }
+  }
+}
+
+function AssertSameError(fun, expected) {
+  try {
+    fun();
+  } catch (e) {
+    assertInstanceof(e, SyntaxError);
+    assertEquals(expected.message, e.message);
+    return;
+  }
+  assertUnreachable();
+}
+
+(function TestValues() {
+  Check('42');
+  Check(' "a string" ');
+  Check('{"a": [1, 2, {"b": null}], "c": true}');
+  Check('[]');
+  Check(' [ ] ');
+  Check('[1, 2.5, -3, "four", [5], {"six": 6}, null, true, false]');
+  Check('[{"a": "]", "b": "}"}, ["[", "{"], "\\"]", "\\\\", ","]');
+  Check('\n[\n  1,\n  2\n]\n');
+})();
+
+(function TestErrors() {
+  Check('');
+  Check('   ');
+  Check('[');
+  Check('[1, 2');
+  Check('[1, {');
+  Check('[,1]');
+  Check('[1,,2]');
+  Check('[1, ]');
+  Check('[1}');
+  Check('[}');
+  Check('[1 2]');
+  Check('[{"a": 1}}, 2]');
+  Check('[tru]');
+  Check('[1] x');
+  Check('[1] 2');
+  Check('[1] "');
+  Check('[1]]');
+  Check('{"a": 1');
+  Check('{"a": 1}}');
+})();
+
+(function TestNonLatin1() {
+  Check('["☃", "😀", "\xff"]', ['utf8', 'utf16']);
+  Check('{"☃": "😀"}', ['utf8', 'utf16']);
+  Check('["☃", 1, ]', ['utf8', 'utf16']);
+  Check('["a", "\xe9", "b"]', ['latin1', 'utf8', 'utf16']);
+})();
+
+(function TestInvalidUtf8() {
+  // Invalid and incomplete sequences are decoded as U+FFFD.
+  const bytes = new Uint8Array([0x5b, 0x22, 0xff, 0x22, 0x2c, 0x22, 0xe2,
+                                0x98, 0x22, 0x5d]);
+  assertEquals(['\ufffd', '\ufffd'],
+               d8.json.parseStreaming(Split(bytes, 1), 'utf8'));
+  assertEquals('\ufffd', d8.json.parseStreaming(
+      [new Uint8Array([0x22, 0xe2, 0x22])], 'utf8'));
+})();
+
+(function TestLargeArrays() {
+  // Enough elements to be parsed in several batches, some of which only
+  // contain objects, doubles or small integers.
+  const elements = [];
+  for (let i = 0; i < 5000; ++i) {
+    elements.push({id: i, name: `n${i}`, tags: ['a', 'b']}, `s${i}`);
+  }
+  for (let i = 0; i < 10000; ++i) elements.push(i + 0.5);
+  for (let i = 0; i < 10000; ++i) elements.push(i);
+  const text = JSON.stringify(elements);
+  const bytes = EncodeUtf8(text);
+  assertEquals(elements, d8.json.parseStreaming(Split(bytes, 4096)));
+  assertEquals(elements, d8.json.parseStreaming(Split(bytes, 1000000)));
+
+  // Arrays of numbers get the same elements kind as with JSON.parse.
+  const smis = Array.from({length: 20000}, (_, i) => i);
+  const smi_result = d8.json.parseStreaming(
+      Split(EncodeLatin1(JSON.stringify(smis)), 1000), 'latin1');
+  assertTrue(%HasSmiElements(smi_result));
+  assertEquals(smis, smi_result);
+  const doubles = smis.concat(smis.map(i => i + 0.5));
+  const double_result = d8.json.parseStreaming(
+      Split(EncodeLatin1(JSON.stringify(doubles)), 1000), 'latin1');
+  assertTrue(%HasDoubleElements(double_result));
+  assertEquals(doubles, double_result);
+
+  // Errors after the first batch report positions in the whole text.
+  Check(text.slice(0, -1) + ',]', ['utf8'], [4096]);
+  Check(text.slice(0, -1) + '}', ['utf8'], [4096]);
+  Check(text + ' x', ['utf8'], [4096]);
+})();
@@ -0,0 +1,56 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Exercises the subquadratic multiplication and division algorithms
+// (Karatsuba, Toom-Cook, FFT, Burnikel-Ziegler, Barrett) by checking
+// arithmetic identities on inputs of sizes around the algorithm thresholds.
+
+var seed = 12345;
+function RandomHexDigit() {
+  seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF;
+  return "0123456789abcdef"[(seed >> 16) & 0xF];
+}
+
+// Returns a random positive BigInt with the given number of bits.
+function RandomBigInt(bits) {
+  var chars = Math.ceil(bits / 4);
+  var hex = "1";
+  for (var i = 1; i < chars; i++) hex += RandomHexDigit();
+  return BigInt("0x" + hex);
+}
+
+function Check(a_bits, b_bits) {
+  var a = RandomBigInt(a_bits);
+  var b = RandomBigInt(b_bits);
+  var c = RandomBigInt(b_bits - 2);  // c < b.
+  var product = a * b;
+  assertEquals(product, b * a);
+  assertEquals(a, product / b);
+  assertEquals(b, product / a);
+  assertEquals(0n, product % a);
+  var n = product + c;
+  assertEquals(a, n / b);
+  assertEquals(c, n % b);
+  assertEquals(-a, -n / b);
+  assertEquals(-c, -n % b);
+  // Distributivity mixes operands of different sizes.
+  var d = RandomBigInt(a_bits >> 1);
+  assertEquals(a * b + d * b, (a + d) * b);
+}
+
+// Sizes in bits; 64 bits are one digit on 64-bit platforms.
+var sizes = [64, 2000, 2200, 12000, 13000, 95000, 100000, 200000];
+for (var i = 0; i < sizes.length; i++) {
+  for (var j = 0; j <= i; j++) {
+    Check(sizes[i], sizes[j] + 100);
+  }
+}
+
+// Large enough to take the Barrett division path.
+Check(2000000, 900000);
+
+// Squaring.
+var x = RandomBigInt(150000);
+assertEquals(x * x, x ** 2n);
+assertEquals(x, (x * x) / x);
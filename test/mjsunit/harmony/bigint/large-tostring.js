@@ -0,0 +1,58 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Exercises the divide-and-conquer toString and parsing algorithms by
+// round-tripping large values through strings of various radixes.
+
+var seed = 4711;
+function RandomChar(radix) {
+  seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF;
+  return ((seed >> 8) % radix).toString(radix);
+}
+
+function RandomString(radix, length) {
+  var s = (1 + (seed % (radix - 1))).toString(radix);
+  for (var i = 1; i < length; i++) s += RandomChar(radix);
+  return s;
+}
+
+function Check(radix, length) {
+  var str = RandomString(radix, length);
+  var prefix = {2: "0b", 8: "0o", 10: "", 16: "0x"}[radix];
+  var x = BigInt(prefix + str);
+  assertEquals(str, x.toString(radix));
+  assertEquals("-" + str, (-x).toString(radix));
+  // Cross-check the decimal conversions against the power-of-two ones.
+  var dec = x.toString();
+  assertEquals(x, BigInt(dec));
+  assertEquals(x.toString(16), BigInt(dec).toString(16));
+}
+
+var lengths = [1, 19, 20, 21, 500, 1000, 5000, 20000, 100000];
+var radixes = [2, 8, 10, 16];
+for (var r = 0; r < radixes.length; r++) {
+  for (var l = 0; l < lengths.length; l++) {
+    Check(radixes[r], lengths[l]);
+  }
+}
+
+// Values with long runs of zero chunks must keep their inner zeros.
+var p = 10n ** 5000n;
+assertEquals("1" + "0".repeat(5000), p.toString());
+assertEquals("1" + "0".repeat(2499) + "1" + "0".repeat(2500),
+             (p + 10n ** 2500n).toString());
+assertEquals("9".repeat(5000), (p - 1n).toString());
+assertEquals(p - 1n, BigInt("9".repeat(5000)));
+
+// Other radixes via toString only (BigInt() only parses 2, 8, 10, 16).
+var y = BigInt(RandomString(10, 3000));
+for (var radix = 3; radix <= 36; radix += 11) {
+  var s = y.toString(radix);
+  var back = 0n;
+  var R = BigInt(radix);
+  for (var i = 0; i < s.length; i++) {
+    back = back * R + BigInt(parseInt(s[i], radix));
+  }
+  assertEquals(y, back);
+}
@@ -0,0 +1,59 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// The JSON parser scans strings and whitespace in blocks of characters. Check
+// that special characters are found at every position within a block.
+
+const kLengths = [0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 64, 100];
+
+for (const length of kLengths) {
+  const plain = 'a'.repeat(length);
+  assertEquals(plain, JSON.parse(`"${plain}"`));
+
+  for (let i = 0; i <= length; ++i) {
+    const before = 'a'.repeat(i);
+    const after = 'b'.repeat(length - i);
+
+    // Escapes.
+    assertEquals(`${before}"${after}`, JSON.parse(`"${before}\\"${after}"`));
+    assertEquals(`${before}\n${after}`, JSON.parse(`"${before}\\n${after}"`));
+    assertEquals(`${before}☃${after}`,
+                 JSON.parse(`"${before}\\u2603${after}"`));
+
+    // Unescaped control characters and unterminated strings.
+    assertThrows(() => JSON.parse(`"${before}\n${after}"`), SyntaxError);
+    assertThrows(() => JSON.parse(`"${before}\x1f${after}"`), SyntaxError);
+    assertThrows(() => JSON.parse(`"${before}`), SyntaxError);
+
+    // Characters which don't terminate a string.
+    assertEquals(`${before}\x20${after}`,
+                 JSON.parse(`"${before}\x20${after}"`));
+    assertEquals(`${before}\x7f${after}`,
+                 JSON.parse(`"${before}\x7f${after}"`));
+    assertEquals(`${before}\xff${after}`,
+                 JSON.parse(`"${before}\xff${after}"`));
+
+    // Two-byte sources, with and without characters outside of Latin1.
+    const two_byte = `${before}☃${after}`;
+    assertEquals(two_byte, JSON.parse(`"${two_byte}"`));
+    assertEquals([two_byte, plain], JSON.parse(`["${two_byte}", "${plain}"]`));
+    assertEquals(`${before}"${after}`,
+                 JSON.parse(`["${before}\\"${after}", "☃"]`)[0]);
+    assertThrows(() => JSON.parse(`"${before}\n${after}☃"`), SyntaxError);
+    assertThrows(() => JSON.parse(`"☃${before}`), SyntaxError);
+  }
+
+  // Whitespace.
+  for (const space of [' ', '\t', '\n', '\r']) {
+    const whitespace = space.repeat(length);
+    assertEquals({a: [1, 2]},
+                 JSON.parse(`${whitespace}{${whitespace}"a"${whitespace}:` +
+                            `${whitespace}[1,${whitespace}2]}${whitespace}`));
+    assertEquals('☃', JSON.parse(`${whitespace}"☃"${whitespace}`));
+    assertThrows(() => JSON.parse(`${whitespace}\x0b1`), SyntaxError);
+    assertThrows(() => JSON.parse(`${whitespace}`), SyntaxError);
+  }
+  const mixed = ' \t\n\r'.repeat(length);
+  assertEquals(42, JSON.parse(`${mixed}42${mixed}`));
+}
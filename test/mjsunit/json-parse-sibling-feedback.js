@@ -0,0 +1,73 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Objects nested in array elements are built using the map of the object at
+// the same position in the previous element.
+
+(function TestNestedSameShape() {
+  const result = JSON.parse(
+      '[{"id": 1, "user": {"name": "a", "address": {"zip": 1}}},' +
+      ' {"id": 2, "user": {"name": "b", "address": {"zip": 2}}},' +
+      ' {"id": 3, "user": {"name": "c", "address": {"zip": 3}}}]');
+  assertEquals(3, result.length);
+  for (let i = 0; i < 3; ++i) {
+    assertEquals(i + 1, result[i].id);
+    assertEquals('abc'[i], result[i].user.name);
+    assertEquals(i + 1, result[i].user.address.zip);
+  }
+  assertTrue(%HaveSameMap(result[0].user, result[2].user));
+  assertTrue(%HaveSameMap(result[0].user.address, result[2].user.address));
+})();
+
+(function TestNestedDifferentShapes() {
+  const result = JSON.parse(
+      '[{"user": {"name": "a", "age": 1}},' +
+      ' {"user": {"age": 2, "name": "b"}},' +
+      ' {"user": {"name": "c"}},' +
+      ' {"user": {"name": "d", "age": 4, "extra": true}},' +
+      ' {"other": {"name": "e", "age": 5}},' +
+      ' {"user": 6},' +
+      ' {"user": {"name": "g", "age": 7}}]');
+  assertEquals({name: 'a', age: 1}, result[0].user);
+  assertEquals({age: 2, name: 'b'}, result[1].user);
+  assertEquals(['age', 'name'], Object.keys(result[1].user));
+  assertEquals({name: 'c'}, result[2].user);
+  assertEquals({name: 'd', age: 4, extra: true}, result[3].user);
+  assertEquals({name: 'e', age: 5}, result[4].other);
+  assertEquals(6, result[5].user);
+  assertEquals({name: 'g', age: 7}, result[6].user);
+})();
+
+(function TestNestedRepresentations() {
+  const result = JSON.parse(
+      '[{"p": {"v": 1}}, {"p": {"v": 1.5}}, {"p": {"v": "s"}},' +
+      ' {"p": {"v": null}}, {"p": {"v": {"w": 1}}}, {"p": {"v": 2}}]');
+  assertEquals([1, 1.5, 's', null, {w: 1}, 2], result.map(e => e.p.v));
+})();
+
+(function TestNestedIndexAndEscapedKeys() {
+  const result = JSON.parse(
+      '[{"0": {"a": 1}, "b": {"c": 1}, "\\u0064": {"e": 1}},' +
+      ' {"0": {"a": 2}, "b": {"c": 2}, "\\u0064": {"e": 2}}]');
+  assertEquals(2, result[1][0].a);
+  assertEquals(2, result[1].b.c);
+  assertEquals(2, result[1].d.e);
+})();
+
+(function TestNestedArrays() {
+  const result = JSON.parse(
+      '[{"a": [{"b": {"c": 1}}, {"b": {"c": 2}}]},' +
+      ' {"a": [{"b": {"c": 3}}, {"b": {"c": 4}}]}]');
+  assertEquals([1, 2, 3, 4], result.flatMap(e => e.a.map(f => f.b.c)));
+})();
+
+(function TestNestedDoubleFieldInSibling() {
+  const result = JSON.parse(
+      '[{"a": 1.5, "b": {"c": 1}}, {"a": {"x": 1}, "b": {"c": 2}}]');
+  assertEquals(1.5, result[0].a);
+  assertEquals({x: 1}, result[1].a);
+  assertEquals(2, result[1].b.c);
+})();
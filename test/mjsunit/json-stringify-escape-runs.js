@@ -0,0 +1,68 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Strings are copied to the JSON output in runs of characters which don't need
+// to be escaped. Put the escaped characters at every position of and around a
+// vector block.
+
+function Expected(s) {
+  let result = '"';
+  for (let i = 0; i < s.length; ++i) {
+    const c = s.charCodeAt(i);
+    if (c == 0x22) {
+      result += '\\"';
+    } else if (c == 0x5c) {
+      result += '\\\\';
+    } else if (c == 0x0a) {
+      result += '\\n';
+    } else if (c < 0x20) {
+      result += '\\u' + c.toString(16).padStart(4, '0');
+    } else if (c >= 0xd800 && c <= 0xdbff && i + 1 < s.length &&
+               s.charCodeAt(i + 1) >= 0xdc00 && s.charCodeAt(i + 1) <= 0xdfff) {
+      result += s[i] + s[i + 1];
+      ++i;
+    } else if (c >= 0xd800 && c <= 0xdfff) {
+      result += '\\u' + c.toString(16);
+    } else {
+      result += s[i];
+    }
+  }
+  return result + '"';
+}
+
+const kSpecials = ['"', '\\', '\n', '\x01', '\x1f', '\ud800', '\udfff',
+                   '😀', '\x7f', '\xff', ' '];
+
+for (const filler of ['a', '\xe9', 'Ā']) {
+  for (let length = 0; length < 40; ++length) {
+    const plain = filler.repeat(length);
+    assertEquals(Expected(plain), JSON.stringify(plain));
+    for (const special of kSpecials) {
+      for (let i = 0; i <= length; ++i) {
+        const s = plain.slice(0, i) + special + plain.slice(i);
+        assertEquals(Expected(s), JSON.stringify(s));
+      }
+    }
+  }
+}
+
+// Strings whose escaped form might not fit into the current part of the
+// result are appended in runs that are split at part boundaries. Put the
+// escaped characters at irregular distances, so that they fall on and around
+// the boundaries of parts.
+for (const filler of ['a', '\xe9', 'Ā']) {
+  for (const length of [3000, 20000, 100000]) {
+    const plain = filler.repeat(length);
+    assertEquals(Expected(plain), JSON.stringify(plain));
+    assertEquals('[' + Expected(plain) + ']', JSON.stringify([plain]));
+    for (const special of kSpecials) {
+      let s = '';
+      for (let i = 0, step = 1; i < length; i += step, step = step * 3 % 997) {
+        s += plain.slice(0, step) + special;
+      }
+      assertEquals(Expected(s), JSON.stringify(s));
+      assertEquals('{"a":' + Expected(s) + '}', JSON.stringify({a: s}));
+    }
+  }
+}
@@ -0,0 +1,195 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/bounded-page-allocator.h"
+
+#include <map>
+
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace base {
+
+using Address = BoundedPageAllocator::Address;
+using v8::internal::KB;
+using v8::internal::MB;
+
+namespace {
+
+constexpr size_t kPageSize = 256 * KB;
+constexpr size_t kHugePageSize = 2 * MB;
+constexpr Address kBegin = static_cast<Address>(64 * MB);
+
+// Records the permissions the bounded page allocator sets, without touching
+// any memory.
+class RecordingPageAllocator : public v8::PageAllocator {
+ public:
+  struct PageState {
+    Permission permission;
+    bool discarded;
+  };
+
+  size_t AllocatePageSize() override { return kPageSize; }
+  size_t CommitPageSize() override { return kPageSize; }
+  void SetRandomMmapSeed(int64_t seed) override {}
+  void* GetRandomMmapAddr() override { return nullptr; }
+
+  void* AllocatePages(void* address, size_t size, size_t alignment,
+                      Permission access) override {
+    UNREACHABLE();
+  }
+  bool FreePages(void* address, size_t size) override { UNREACHABLE(); }
+  bool ReleasePages(void* address, size_t size, size_t new_size) override {
+    UNREACHABLE();
+  }
+
+  bool SetPermissions(void* address, size_t size, Permission access) override {
+    Record(address, size, {access, access == kNoAccess});
+    return true;
+  }
+
+  bool SetNoAccessWithoutDiscarding(void* address, size_t size) override {
+    Record(address, size, {kNoAccess, false});
+    return true;
+  }
+
+  bool IsReadWrite(Address page) const {
+    auto it = pages_.find(page);
+    return it != pages_.end() && it->second.permission == kReadWrite;
+  }
+
+  // Returns true if the page is inaccessible but keeps its memory.
+  bool IsProtected(Address page) const {
+    auto it = pages_.find(page);
+    return it != pages_.end() && it->second.permission == kNoAccess &&
+           !it->second.discarded;
+  }
+
+  bool IsDecommitted(Address page) const {
+    auto it = pages_.find(page);
+    return it != pages_.end() && it->second.permission == kNoAccess &&
+           it->second.discarded;
+  }
+
+  bool IsUntouched(Address page) const { return pages_.count(page) == 0; }
+
+ private:
+  void Record(void* address, size_t size, PageState state) {
+    Address begin = reinterpret_cast<Address>(address);
+    CHECK(IsAligned(begin, kPageSize));
+    CHECK(IsAligned(size, kPageSize));
+    for (Address page = begin; page < begin + size; page += kPageSize) {
+      pages_[page] = state;
+    }
+  }
+
+  std::map<Address, PageState> pages_;
+};
+
+}  // namespace
+
+TEST(BoundedPageAllocatorTest, FreedPagesAreDecommitted) {
+  RecordingPageAllocator recorder;
+  BoundedPageAllocator allocator(&recorder, kBegin, kHugePageSize, kPageSize);
+
+  CHECK(allocator.AllocatePagesAt(kBegin, kPageSize,
+                                  PageAllocator::kReadWrite));
+  CHECK(allocator.AllocatePagesAt(kBegin + kPageSize, kPageSize,
+                                  PageAllocator::kReadWrite));
+  CHECK(allocator.FreePages(reinterpret_cast<void*>(kBegin), kPageSize));
+  CHECK(recorder.IsDecommitted(kBegin));
+  CHECK(recorder.IsReadWrite(kBegin + kPageSize));
+}
+
+TEST(BoundedPageAllocatorTest, SetNoAccessWithoutDiscarding) {
+  RecordingPageAllocator recorder;
+  BoundedPageAllocator allocator(&recorder, kBegin, kHugePageSize, kPageSize);
+
+  CHECK(allocator.AllocatePagesAt(kBegin, 2 * kPageSize,
+                                  PageAllocator::kReadWrite));
+  CHECK(allocator.SetNoAccessWithoutDiscarding(reinterpret_cast<void*>(kBegin),
+                                               kPageSize));
+  CHECK(recorder.IsProtected(kBegin));
+  CHECK(recorder.IsReadWrite(kBegin + kPageSize));
+}
+
+TEST(BoundedPageAllocatorTest, HugePageGroupIsDecommittedOnceFree) {
+  RecordingPageAllocator recorder;
+  BoundedPageAllocator allocator(&recorder, kBegin, 2 * kHugePageSize,
+                                 kPageSize, kHugePageSize);
+
+  CHECK(allocator.AllocatePagesAt(kBegin, kPageSize,
+                                  PageAllocator::kReadWrite));
+  CHECK(allocator.AllocatePagesAt(kBegin + kPageSize, kPageSize,
+                                  PageAllocator::kReadWrite));
+
+  // The other page keeps the group alive, so the freed page only traps.
+  CHECK(allocator.FreePages(reinterpret_cast<void*>(kBegin), kPageSize));
+  CHECK(recorder.IsProtected(kBegin));
+  CHECK(recorder.IsReadWrite(kBegin + kPageSize));
+  CHECK(recorder.IsUntouched(kBegin + 2 * kPageSize));
+
+  // Freeing the last page decommits the whole group, including pages that
+  // were never allocated, but not the neighbouring group.
+  CHECK(allocator.FreePages(reinterpret_cast<void*>(kBegin + kPageSize),
+                            kPageSize));
+  for (Address page = kBegin; page < kBegin + kHugePageSize;
+       page += kPageSize) {
+    CHECK(recorder.IsDecommitted(page));
+  }
+  CHECK(recorder.IsUntouched(kBegin + kHugePageSize));
+}
+
+TEST(BoundedPageAllocatorTest, RegionSpanningHugePageGroups) {
+  RecordingPageAllocator recorder;
+  BoundedPageAllocator allocator(&recorder, kBegin, 2 * kHugePageSize,
+                                 kPageSize, kHugePageSize);
+  const Address kSpanning = kBegin + kHugePageSize - kPageSize;
+  const Address kSecondGroupPage = kBegin + kHugePageSize + 2 * kPageSize;
+
+  CHECK(allocator.AllocatePagesAt(kBegin, kPageSize,
+                                  PageAllocator::kReadWrite));
+  CHECK(allocator.AllocatePagesAt(kSpanning, 2 * kPageSize,
+                                  PageAllocator::kReadWrite));
+  CHECK(allocator.AllocatePagesAt(kSecondGroupPage, kPageSize,
+                                  PageAllocator::kReadWrite));
+
+  // Both groups still have allocated pages.
+  CHECK(allocator.FreePages(reinterpret_cast<void*>(kSpanning),
+                            2 * kPageSize));
+  CHECK(recorder.IsProtected(kSpanning));
+  CHECK(recorder.IsProtected(kSpanning + kPageSize));
+
+  CHECK(allocator.FreePages(reinterpret_cast<void*>(kBegin), kPageSize));
+  CHECK(recorder.IsDecommitted(kBegin));
+  CHECK(recorder.IsDecommitted(kSpanning));
+  CHECK(recorder.IsProtected(kSpanning + kPageSize));
+  CHECK(recorder.IsReadWrite(kSecondGroupPage));
+
+  CHECK(allocator.FreePages(reinterpret_cast<void*>(kSecondGroupPage),
+                            kPageSize));
+  CHECK(recorder.IsDecommitted(kSpanning + kPageSize));
+  CHECK(recorder.IsDecommitted(kSecondGroupPage));
+}
+
+TEST(BoundedPageAllocatorTest, PartialHugePageGroupAtEnd) {
+  RecordingPageAllocator recorder;
+  const size_t kSize = kHugePageSize + 4 * kPageSize;
+  BoundedPageAllocator allocator(&recorder, kBegin, kSize, kPageSize,
+                                 kHugePageSize);
+  const Address kLastGroup = kBegin + kHugePageSize;
+
+  CHECK(allocator.AllocatePagesAt(kLastGroup, kPageSize,
+                                  PageAllocator::kReadWrite));
+  CHECK(allocator.FreePages(reinterpret_cast<void*>(kLastGroup), kPageSize));
+  // The group is clipped to the end of the allocator's region.
+  for (Address page = kLastGroup; page < kBegin + kSize; page += kPageSize) {
+    CHECK(recorder.IsDecommitted(page));
+  }
+  CHECK(recorder.IsUntouched(kBegin + kSize));
+}
+
+}  // namespace base
+}  // namespace v8
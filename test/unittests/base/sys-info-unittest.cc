@@ -3,6 +3,19 @@
 // found in the LICENSE file.
 
 #include "src/base/sys-info.h"
+
+#if V8_OS_LINUX
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#endif
+
+#include "src/base/logging.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace v8 {
@@ -21,5 +34,172 @@ TEST(SysInfoTest, AmountOfVirtualMemory) {
   EXPECT_LE(0, SysInfo::AmountOfVirtualMemory());
 }
 
+#if V8_OS_LINUX
+namespace {
+
+// A temporary directory that stands in for the file system root, with fake
+// /proc/self and cgroup files.
+class CgroupFixture {
+ public:
+  CgroupFixture() { CHECK_NOT_NULL(mkdtemp(root_)); }
+  ~CgroupFixture() {
+    for (auto it = paths_.rbegin(); it != paths_.rend(); ++it) {
+      CHECK_EQ(0, remove(it->c_str()));
+    }
+    CHECK_EQ(0, rmdir(root_));
+  }
+
+  const char* root() const { return root_; }
+
+  // Creates or overwrites the file at the absolute |path| below the root, and
+  // creates the directories leading to it.
+  void WriteFile(const std::string& path, const char* contents) {
+    for (size_t slash = path.find('/', 1); slash != std::string::npos;
+         slash = path.find('/', slash + 1)) {
+      std::string directory = root_ + path.substr(0, slash);
+      if (mkdir(directory.c_str(), 0700) == 0) paths_.push_back(directory);
+    }
+    std::string file_path = root_ + path;
+    FILE* file = fopen(file_path.c_str(), "w");
+    CHECK_NOT_NULL(file);
+    fputs(contents, file);
+    fclose(file);
+    if (std::find(paths_.begin(), paths_.end(), file_path) == paths_.end()) {
+      paths_.push_back(file_path);
+    }
+  }
+
+ private:
+  char root_[32] = "/tmp/v8-sys-info-XXXXXX";
+  std::vector<std::string> paths_;
+};
+
+const char kCgroupV2MountInfo[] =
+    "22 27 0:21 / /proc rw,nosuid,nodev,noexec,relatime shared:12 - proc proc "
+    "rw\n"
+    "26 22 0:23 / /sys/fs/cgroup rw,nosuid,nodev,noexec,relatime shared:4 - "
+    "cgroup2 cgroup2 rw,nsdelegate,memory_recursiveprot\n";
+
+const char kHostPressure[] =
+    "some avg10=90.00 avg60=80.00 avg300=70.00 total=1000000\n"
+    "full avg10=50.00 avg60=40.00 avg300=30.00 total=500000\n";
+
+}  // namespace
+
+TEST(SysInfoTest, CgroupV2WithoutNamespace) {
+  // A systemd service sees the whole cgroup hierarchy.
+  CgroupFixture fixture;
+  fixture.WriteFile("/proc/self/cgroup", "0::/system.slice/app.service\n");
+  fixture.WriteFile("/proc/self/mountinfo", kCgroupV2MountInfo);
+  fixture.WriteFile("/sys/fs/cgroup/memory.pressure", kHostPressure);
+  fixture.WriteFile("/sys/fs/cgroup/system.slice/app.service/memory.max",
+                    "67108864\n");
+  fixture.WriteFile("/sys/fs/cgroup/system.slice/app.service/memory.current",
+                    "33554432\n");
+  fixture.WriteFile("/sys/fs/cgroup/system.slice/app.service/memory.stat",
+                    "anon 29360128\nfile 4194304\ninactive_file 1048576\n");
+  fixture.WriteFile(
+      "/sys/fs/cgroup/system.slice/app.service/memory.pressure",
+      "some avg10=12.50 avg60=2.00 avg300=0.50 total=12345\n"
+      "full avg10=1.00 avg60=0.00 avg300=0.00 total=123\n");
+
+  EXPECT_EQ(64 * 1024 * 1024, SysInfo::AmountOfCgroupMemory(fixture.root()));
+  EXPECT_EQ(31 * 1024 * 1024,
+            SysInfo::CgroupMemoryWorkingSet(fixture.root()));
+  EXPECT_EQ(12.5, SysInfo::MemoryPressureStallPercentage(fixture.root()));
+}
+
+TEST(SysInfoTest, CgroupMemoryFindsCgroupOnce) {
+  CgroupFixture fixture;
+  fixture.WriteFile("/proc/self/cgroup", "0::/app.slice\n");
+  fixture.WriteFile("/proc/self/mountinfo", kCgroupV2MountInfo);
+  fixture.WriteFile("/sys/fs/cgroup/app.slice/memory.max", "67108864\n");
+  fixture.WriteFile("/sys/fs/cgroup/app.slice/memory.current", "33554432\n");
+
+  CgroupMemory cgroup_memory(fixture.root());
+  EXPECT_TRUE(cgroup_memory.IsAvailable());
+  EXPECT_EQ(32 * 1024 * 1024, cgroup_memory.WorkingSet());
+
+  // Later samples only read the files of the cgroup that was found first.
+  fixture.WriteFile("/proc/self/cgroup", "0::/other.slice\n");
+  fixture.WriteFile("/sys/fs/cgroup/app.slice/memory.current", "16777216\n");
+  EXPECT_EQ(64 * 1024 * 1024, cgroup_memory.Limit());
+  EXPECT_EQ(16 * 1024 * 1024, cgroup_memory.WorkingSet());
+}
+
+TEST(SysInfoTest, CgroupV2Unlimited) {
+  CgroupFixture fixture;
+  fixture.WriteFile("/proc/self/cgroup", "0::/\n");
+  fixture.WriteFile("/proc/self/mountinfo", kCgroupV2MountInfo);
+  fixture.WriteFile("/sys/fs/cgroup/memory.max", "max\n");
+  fixture.WriteFile("/sys/fs/cgroup/memory.current", "8388608\n");
+  fixture.WriteFile("/sys/fs/cgroup/memory.pressure",
+                    "some avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+
+  EXPECT_EQ(0, SysInfo::AmountOfCgroupMemory(fixture.root()));
+  EXPECT_EQ(8 * 1024 * 1024, SysInfo::CgroupMemoryWorkingSet(fixture.root()));
+  EXPECT_EQ(0, SysInfo::MemoryPressureStallPercentage(fixture.root()));
+}
+
+TEST(SysInfoTest, CgroupV2RootCgroup) {
+  // Without a cgroup namespace, a process in the root cgroup must not pick up
+  // the system-wide pressure.
+  CgroupFixture fixture;
+  fixture.WriteFile("/proc/self/cgroup", "0::/\n");
+  fixture.WriteFile("/proc/self/mountinfo", kCgroupV2MountInfo);
+  fixture.WriteFile("/sys/fs/cgroup/memory.pressure", kHostPressure);
+
+  EXPECT_EQ(0, SysInfo::AmountOfCgroupMemory(fixture.root()));
+  EXPECT_GT(0, SysInfo::MemoryPressureStallPercentage(fixture.root()));
+}
+
+TEST(SysInfoTest, CgroupV1BindMount) {
+  // A container without a cgroup namespace on a hybrid hierarchy, which has
+  // its cgroup bind-mounted at /sys/fs/cgroup/memory.
+  CgroupFixture fixture;
+  fixture.WriteFile("/proc/self/cgroup",
+                    "12:cpu,cpuacct:/docker/0123abcd\n"
+                    "11:memory:/docker/0123abcd\n"
+                    "0::/docker/0123abcd\n");
+  fixture.WriteFile(
+      "/proc/self/mountinfo",
+      "600 598 0:55 /docker/0123abcd /sys/fs/cgroup/cpu,cpuacct "
+      "ro,nosuid,nodev,noexec,relatime master:10 - cgroup cgroup "
+      "rw,cpu,cpuacct\n"
+      "601 598 0:56 /docker/0123abcd /sys/fs/cgroup/memory "
+      "ro,nosuid,nodev,noexec,relatime master:11 - cgroup cgroup rw,memory\n"
+      "602 598 0:28 / /sys/fs/cgroup/unified "
+      "rw,nosuid,nodev,noexec,relatime - cgroup2 cgroup2 rw\n");
+  fixture.WriteFile("/sys/fs/cgroup/memory/memory.limit_in_bytes",
+                    "134217728\n");
+  fixture.WriteFile("/sys/fs/cgroup/memory/memory.usage_in_bytes",
+                    "67108864\n");
+  fixture.WriteFile("/sys/fs/cgroup/memory/memory.stat",
+                    "cache 8388608\nrss 58720256\n"
+                    "total_inactive_file 4194304\n");
+  fixture.WriteFile("/sys/fs/cgroup/unified/docker/0123abcd/memory.pressure",
+                    kHostPressure);
+
+  EXPECT_EQ(128 * 1024 * 1024, SysInfo::AmountOfCgroupMemory(fixture.root()));
+  EXPECT_EQ(60 * 1024 * 1024,
+            SysInfo::CgroupMemoryWorkingSet(fixture.root()));
+  // cgroup v1 has no per-cgroup PSI.
+  EXPECT_GT(0, SysInfo::MemoryPressureStallPercentage(fixture.root()));
+}
+
+TEST(SysInfoTest, CgroupNotMounted) {
+  CgroupFixture fixture;
+  fixture.WriteFile("/proc/self/cgroup", "0::/user.slice\n");
+  fixture.WriteFile(
+      "/proc/self/mountinfo",
+      "22 27 0:21 / /proc rw,nosuid,nodev,noexec,relatime - proc proc rw\n");
+
+  EXPECT_FALSE(CgroupMemory(fixture.root()).IsAvailable());
+  EXPECT_EQ(0, SysInfo::AmountOfCgroupMemory(fixture.root()));
+  EXPECT_EQ(0, SysInfo::CgroupMemoryWorkingSet(fixture.root()));
+  EXPECT_GT(0, SysInfo::MemoryPressureStallPercentage(fixture.root()));
+}
+#endif  // V8_OS_LINUX
+
 }  // namespace base
 }  // namespace v8
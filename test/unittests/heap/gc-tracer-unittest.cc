@@ -530,6 +530,58 @@ TEST_F(GCTracerTest, RecordScavengerHistograms) {
   GcHistogram::CleanUp();
 }
 
+TEST_F(GCTracerTest, RecordMinorMCHistograms) {
+  if (FLAG_stress_incremental_marking) return;
+  isolate()->SetCreateHistogramFunction(&GcHistogram::CreateHistogram);
+  isolate()->SetAddHistogramSampleFunction(&GcHistogram::AddHistogramSample);
+  GCTracer* tracer = i_isolate()->heap()->tracer();
+  tracer->ResetForTesting();
+  tracer->current_.scopes[GCTracer::Scope::MINOR_MC_MARK] = 1;
+  tracer->current_.scopes[GCTracer::Scope::MINOR_MC_EVACUATE] = 2;
+  tracer->current_.scopes[GCTracer::Scope::MINOR_MC_CLEAR] = 3;
+  tracer->RecordGCPhasesHistograms(i_isolate()->counters()->gc_minor_mc());
+  EXPECT_EQ(1, GcHistogram::Get("V8.GCMinorMC.Mark")->Total());
+  EXPECT_EQ(2, GcHistogram::Get("V8.GCMinorMC.Evacuate")->Total());
+  EXPECT_EQ(3, GcHistogram::Get("V8.GCMinorMC.Clear")->Total());
+  GcHistogram::CleanUp();
+}
+
+TEST_F(GCTracerTest, MinorMCPagePromotions) {
+  GCTracer* tracer = i_isolate()->heap()->tracer();
+  tracer->ResetForTesting();
+  tracer->Start(MINOR_MARK_COMPACTOR, GarbageCollectionReason::kTesting,
+                "collector unittest");
+  tracer->AddPagePromotions(2, 1);
+  tracer->AddPagePromotions(1, 0);
+  tracer->Stop(MINOR_MARK_COMPACTOR);
+  EXPECT_EQ(3u, tracer->current_.new_to_old_pages);
+  EXPECT_EQ(1u, tracer->current_.new_to_new_pages);
+  // The counts are per garbage collection.
+  tracer->Start(MINOR_MARK_COMPACTOR, GarbageCollectionReason::kTesting,
+                "collector unittest");
+  tracer->Stop(MINOR_MARK_COMPACTOR);
+  EXPECT_EQ(0u, tracer->current_.new_to_old_pages);
+  EXPECT_EQ(0u, tracer->current_.new_to_new_pages);
+}
+
+TEST_F(GCTracerTest, MinorMCSpeed) {
+  GCTracer* tracer = i_isolate()->heap()->tracer();
+  tracer->ResetForTesting();
+  // Scavenges only count towards the speed of both young generation
+  // collectors.
+  tracer->Start(SCAVENGER, GarbageCollectionReason::kTesting,
+                "collector unittest");
+  tracer->Stop(SCAVENGER);
+  EXPECT_EQ(1, tracer->recorded_minor_gcs_total_.Count());
+  EXPECT_EQ(0, tracer->recorded_minor_mcs_.Count());
+  EXPECT_EQ(0.0, tracer->MinorMCSpeedInBytesPerMillisecond());
+  tracer->Start(MINOR_MARK_COMPACTOR, GarbageCollectionReason::kTesting,
+                "collector unittest");
+  tracer->Stop(MINOR_MARK_COMPACTOR);
+  EXPECT_EQ(2, tracer->recorded_minor_gcs_total_.Count());
+  EXPECT_EQ(1, tracer->recorded_minor_mcs_.Count());
+}
+
 TEST_F(GCTracerTest, RecordGCSumHistograms) {
   if (FLAG_stress_incremental_marking) return;
   isolate()->SetCreateHistogramFunction(&GcHistogram::CreateHistogram);
@@ -108,5 +108,71 @@ TEST_F(MemoryControllerTest, OldGenerationAllocationLimit) {
           new_space_capacity, factor, Heap::HeapGrowingMode::kMinimal));
 }
 
+TEST_F(MemoryControllerTest, NewSpaceTargetCapacity) {
+  const size_t min_capacity = 1 * MB;
+  const size_t max_capacity = 16 * MB;
+  const size_t current_capacity = 4 * MB;
+  // Without allocation or GC samples the capacity does not change.
+  EXPECT_EQ(current_capacity,
+            NewSpaceController::TargetCapacity(0, 0, 0, current_capacity,
+                                               min_capacity, max_capacity));
+  EXPECT_EQ(current_capacity,
+            NewSpaceController::TargetCapacity(100, 0, 0, current_capacity,
+                                               min_capacity, max_capacity));
+
+  // A young generation GC takes 1 ms, so the mutator has to run for
+  // 0.97 / 0.03 ms between GCs.
+  const size_t survived = 100 * KB;
+  const double gc_speed = 100 * KB;
+  const double mu = NewSpaceController::kTargetMutatorUtilization;
+  const double mutator_time = mu / (1 - mu);
+  const double throughput = 200 * KB;
+  EXPECT_NEAR(throughput * mutator_time,
+              NewSpaceController::TargetCapacity(throughput, gc_speed, survived,
+                                                 current_capacity, min_capacity,
+                                                 max_capacity),
+              1);
+
+  // Idle mutators shrink the capacity, bursty ones grow it.
+  EXPECT_EQ(min_capacity, NewSpaceController::TargetCapacity(
+                              1, gc_speed, survived, current_capacity,
+                              min_capacity, max_capacity));
+  EXPECT_EQ(max_capacity, NewSpaceController::TargetCapacity(
+                              100 * MB, gc_speed, survived, current_capacity,
+                              min_capacity, max_capacity));
+
+  // There is always room for twice the survivors.
+  EXPECT_EQ(6 * MB, NewSpaceController::TargetCapacity(
+                        1, gc_speed, 3 * MB, current_capacity, min_capacity,
+                        max_capacity));
+  EXPECT_EQ(max_capacity, NewSpaceController::TargetCapacity(
+                              1, gc_speed, 9 * MB, current_capacity,
+                              min_capacity, max_capacity));
+}
+
+TEST_F(MemoryControllerTest, ContainerMemoryPressureLevel) {
+  const size_t limit = 1000 * MB;
+  const double no_psi = -1;
+
+  // Without a limit or PSI there is never pressure.
+  EXPECT_EQ(MemoryPressureLevel::kNone,
+            ContainerMemoryController::PressureLevel(0, 4000 * MB, no_psi));
+
+  EXPECT_EQ(MemoryPressureLevel::kNone,
+            ContainerMemoryController::PressureLevel(limit, 500 * MB, no_psi));
+  EXPECT_EQ(MemoryPressureLevel::kModerate,
+            ContainerMemoryController::PressureLevel(limit, 850 * MB, no_psi));
+  EXPECT_EQ(MemoryPressureLevel::kCritical,
+            ContainerMemoryController::PressureLevel(limit, 950 * MB, no_psi));
+
+  // Stalls raise the pressure even if the cgroup is far from its limit.
+  EXPECT_EQ(MemoryPressureLevel::kNone,
+            ContainerMemoryController::PressureLevel(limit, 500 * MB, 1));
+  EXPECT_EQ(MemoryPressureLevel::kModerate,
+            ContainerMemoryController::PressureLevel(limit, 500 * MB, 20));
+  EXPECT_EQ(MemoryPressureLevel::kCritical,
+            ContainerMemoryController::PressureLevel(0, 0, 50));
+}
+
 }  // namespace internal
 }  // namespace v8
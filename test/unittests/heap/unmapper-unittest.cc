@@ -327,5 +327,50 @@ TEST_F(SequentialUnmapperTest, UnmapOnTeardown) {
 #endif  // V8_COMPRESS_POINTERS
 }
 
+TEST_F(SequentialUnmapperTest, ReleasePooledChunks) {
+  Page* page = allocator()->AllocatePage(
+      MemoryChunkLayout::AllocatableMemoryInDataPage(),
+      static_cast<PagedSpace*>(heap()->old_space()),
+      Executability::NOT_EXECUTABLE);
+  EXPECT_NE(nullptr, page);
+  const size_t page_size = tracking_page_allocator()->AllocatePageSize();
+  allocator()->Free<MemoryAllocator::kPooledAndQueue>(page);
+  unmapper()->FreeQueuedChunks();
+  EXPECT_EQ(static_cast<size_t>(MemoryChunk::kPageSize),
+            unmapper()->PooledMemory());
+  unmapper()->ReleasePooledChunks();
+  EXPECT_EQ(0u, unmapper()->PooledMemory());
+#ifdef V8_COMPRESS_POINTERS
+  tracking_page_allocator()->CheckPagePermissions(page->address(), page_size,
+                                                  PageAllocator::kNoAccess);
+#else
+  tracking_page_allocator()->CheckIsFree(page->address(), page_size);
+#endif  // V8_COMPRESS_POINTERS
+  unmapper()->TearDown();
+}
+
+TEST_F(SequentialUnmapperTest, PoolIsBounded) {
+  const size_t old_pool_size = i::FLAG_memory_chunk_pool_size;
+  i::FLAG_memory_chunk_pool_size = 0;
+  Page* page = allocator()->AllocatePage(
+      MemoryChunkLayout::AllocatableMemoryInDataPage(),
+      static_cast<PagedSpace*>(heap()->old_space()),
+      Executability::NOT_EXECUTABLE);
+  EXPECT_NE(nullptr, page);
+  const size_t page_size = tracking_page_allocator()->AllocatePageSize();
+  allocator()->Free<MemoryAllocator::kPooledAndQueue>(page);
+  unmapper()->FreeQueuedChunks();
+  // The pool is full, so the page is unmapped right away.
+  EXPECT_EQ(0u, unmapper()->PooledMemory());
+#ifdef V8_COMPRESS_POINTERS
+  tracking_page_allocator()->CheckPagePermissions(page->address(), page_size,
+                                                  PageAllocator::kNoAccess);
+#else
+  tracking_page_allocator()->CheckIsFree(page->address(), page_size);
+#endif  // V8_COMPRESS_POINTERS
+  unmapper()->TearDown();
+  i::FLAG_memory_chunk_pool_size = old_pool_size;
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,112 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/base/platform/platform.h"
+#include "src/execution/isolate.h"
+#include "src/execution/local-isolate.h"
+#include "src/handles/local-handles-inl.h"
+#include "src/handles/persistent-handles.h"
+#include "src/heap/local-factory-inl.h"
+#include "src/heap/local-heap-inl.h"
+#include "src/heap/parked-scope.h"
+#include "src/init/v8.h"
+#include "src/objects/string-table.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+constexpr int kThreads = 4;
+// Enough strings to resize the string table several times while the threads
+// are inserting.
+constexpr int kStrings = 20000;
+// Coprime with kStrings, so that each thread visits every string once.
+constexpr int kStride = 7919;
+
+std::string StringForIndex(int index) {
+  return "string-table-stress-" + std::to_string(index);
+}
+
+class InternalizeThread final : public v8::base::Thread {
+ public:
+  InternalizeThread(Isolate* isolate, int offset)
+      : v8::base::Thread(base::Thread::Options("InternalizeThread")),
+        isolate_(isolate),
+        offset_(offset),
+        results_(kStrings) {}
+
+  void Run() override {
+    LocalIsolate local_isolate(isolate_, ThreadKind::kBackground);
+    UnparkedScope unparked_scope(local_isolate.heap());
+    // Each thread internalizes the strings in a different order, so that the
+    // threads race both for the same keys and for the table resizes.
+    for (int n = 0; n < kStrings; ++n) {
+      int index = (n * kStride + offset_) % kStrings;
+      std::string string = StringForIndex(index);
+      LocalHandleScope scope(&local_isolate);
+      Handle<String> result = local_isolate.factory()->InternalizeString(
+          OneByteVector(string.c_str()));
+      results_[index] = local_isolate.heap()->NewPersistentHandle(result);
+    }
+    persistent_handles_ = local_isolate.heap()->DetachPersistentHandles();
+  }
+
+  Handle<String> result(int index) const { return results_[index]; }
+
+ private:
+  Isolate* isolate_;
+  int offset_;
+  std::vector<Handle<String>> results_;
+  std::unique_ptr<PersistentHandles> persistent_handles_;
+};
+
+}  // namespace
+
+using StringTableTest = TestWithIsolate;
+
+TEST_F(StringTableTest, ConcurrentInternalization) {
+  const int elements_before = isolate()->string_table()->NumberOfElements();
+
+  std::vector<std::unique_ptr<InternalizeThread>> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    auto thread = std::make_unique<InternalizeThread>(
+        isolate(), i * (kStrings / kThreads));
+    CHECK(thread->Start());
+    threads.push_back(std::move(thread));
+  }
+
+  {
+    // The background threads may need a GC, which requires the main thread
+    // to reach a safepoint.
+    ParkedScope parked(i_isolate()->main_thread_local_isolate());
+    for (auto& thread : threads) thread->Join();
+  }
+
+  // All threads must have ended up with the same internalized string for each
+  // key, and it must be the one the main thread finds.
+  HandleScope scope(isolate());
+  for (int index = 0; index < kStrings; ++index) {
+    std::string string = StringForIndex(index);
+    Handle<String> expected =
+        factory()->InternalizeString(OneByteVector(string.c_str()));
+    for (auto& thread : threads) {
+      EXPECT_EQ(*expected, *thread->result(index));
+    }
+  }
+  // Strings from before the test may have died, but no key may have been
+  // added twice.
+  EXPECT_LE(kStrings, isolate()->string_table()->NumberOfElements());
+  EXPECT_GE(elements_before + kStrings,
+            isolate()->string_table()->NumberOfElements());
+}
+
+}  // namespace internal
+}  // namespace v8
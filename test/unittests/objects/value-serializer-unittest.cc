@@ -1061,6 +1061,59 @@ TEST_F(ValueSerializerTest, DecodeArray) {
   ExpectScriptTrue("result.hasOwnProperty(1)");
 }
 
+TEST_F(ValueSerializerTest, RoundTripPackedArrays) {
+  // Arrays with Smi elements, with varints of different lengths.
+  Local<Value> value = RoundTripTest("[0, -1, 63, -64, 1 << 29, -(1 << 29)]");
+  ASSERT_TRUE(value->IsArray());
+  EXPECT_EQ(6u, Array::Cast(*value)->Length());
+  ExpectScriptTrue("result.toString() === '0,-1,63,-64,536870912,-536870912'");
+  ExpectScriptTrue("result.push(0.5) === 7 && result[6] === 0.5");
+
+  // Arrays with double elements.
+  value = RoundTripTest("[0.5, -0, NaN, Infinity, 1e300]");
+  ASSERT_TRUE(value->IsArray());
+  EXPECT_EQ(5u, Array::Cast(*value)->Length());
+  ExpectScriptTrue("result[0] === 0.5 && Object.is(result[1], -0)");
+  ExpectScriptTrue("Number.isNaN(result[2]) && result[3] === Infinity");
+  ExpectScriptTrue("result[4] === 1e300");
+  ExpectScriptTrue("result.push('x') === 6 && result[5] === 'x'");
+
+  // Integers which are only Smis on some platforms.
+  value = RoundTripTest("[1 << 30, -(1 << 31), 2 ** 31 - 1]");
+  ASSERT_TRUE(value->IsArray());
+  ExpectScriptTrue("result.toString() === '1073741824,-2147483648,2147483647'");
+
+  // Elements which only start out like a packed array.
+  value = RoundTripTest("[1, 2, 'three']");
+  ExpectScriptTrue("result.toString() === '1,2,three'");
+  value = RoundTripTest("[0.5, {}]");
+  ExpectScriptTrue("result[0] === 0.5 && typeof result[1] === 'object'");
+
+  // Packed arrays with additional properties.
+  value = RoundTripTest("var y = [1.5, 2.5]; y.foo = 'bar'; y;");
+  ExpectScriptTrue("result.toString() === '1.5,2.5' && result.foo === 'bar'");
+}
+
+TEST_F(ValueSerializerTest, DecodePackedArrays) {
+  // Int32 elements, one of which is not a Smi on any platform.
+  Local<Value> value =
+      DecodeTest({0xFF, 0x0D, 0x41, 0x03, 0x49, 0x02, 0x49, 0x03, 0x49, 0xFE,
+                  0xFF, 0xFF, 0xFF, 0x0F, 0x24, 0x00, 0x03});
+  ASSERT_TRUE(value->IsArray());
+  EXPECT_EQ(3u, Array::Cast(*value)->Length());
+  ExpectScriptTrue("result.toString() === '1,-2,2147483647'");
+
+  // Double elements, and a truncated one.
+  value = DecodeTest({0xFF, 0x0D, 0x41, 0x02, 0x4E, 0x00, 0x00, 0x00, 0x00,
+                      0x00, 0x00, 0xE0, 0x3F, 0x4E, 0x00, 0x00, 0x00, 0x00,
+                      0x00, 0x00, 0xF0, 0xBF, 0x24, 0x00, 0x02});
+  ASSERT_TRUE(value->IsArray());
+  EXPECT_EQ(2u, Array::Cast(*value)->Length());
+  ExpectScriptTrue("result[0] === 0.5 && result[1] === -1");
+  InvalidDecodeTest({0xFF, 0x0D, 0x41, 0x02, 0x4E, 0x00, 0x00, 0x00, 0x00,
+                     0x00, 0x00, 0xE0, 0x3F, 0x4E, 0x00, 0x00});
+}
+
 TEST_F(ValueSerializerTest, DecodeInvalidOverLargeArray) {
   // So large it couldn't exist in the V8 heap, and its size couldn't fit in a
   // SMI on 32-bit systems (2^30).
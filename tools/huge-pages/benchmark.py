@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+# Copyright 2021 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+'''
+Compares d8 with and without --transparent-huge-pages on a heap-heavy
+workload (workload.js by default). For each configuration, it reports the
+median over all runs of:
+  - the wall time that the workload prints,
+  - the peak resident set size,
+  - the peak amount of memory backed by transparent huge pages,
+  - the dTLB load and store misses counted by "perf stat".
+
+Linux only. TLB misses are only reported if "perf" is on the PATH and the
+kernel lets the user count events of its own processes (see
+/proc/sys/kernel/perf_event_paranoid). Transparent huge pages must be enabled
+in "madvise" or "always" mode in /sys/kernel/mm/transparent_hugepage/enabled.
+
+Examples:
+  tools/huge-pages/benchmark.py out/x64.release/d8
+  tools/huge-pages/benchmark.py --runs 10 out/x64.release/d8 -- 512
+'''
+
+import argparse
+import os
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+WORKLOAD = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                        'workload.js')
+CONFIGURATIONS = [
+    ('4K pages', []),
+    ('huge pages', ['--transparent-huge-pages']),
+]
+PERF_EVENTS = ['dTLB-load-misses', 'dTLB-store-misses']
+POLL_INTERVAL_S = 0.05
+
+
+def ReadKilobytes(path, fields):
+  '''Sums the given "<field>: <n> kB" lines of a /proc file.'''
+  result = dict((field, 0) for field in fields)
+  try:
+    with open(path) as f:
+      for line in f:
+        name, _, value = line.partition(':')
+        if name in result:
+          result[name] += int(value.split()[0])
+  except (IOError, OSError, ValueError):
+    return None
+  return result
+
+
+def Run(d8, flags, workload, workload_args, use_perf):
+  command = [d8] + flags + [workload]
+  if workload_args:
+    command += ['--'] + workload_args
+  process = subprocess.Popen(command, stdout=subprocess.PIPE,
+                             universal_newlines=True)
+  perf = None
+  perf_output = None
+  if use_perf:
+    perf_output = tempfile.NamedTemporaryFile(suffix='.csv', delete=False)
+    perf_output.close()
+    perf = subprocess.Popen([
+        'perf', 'stat', '-x,', '-e', ','.join(PERF_EVENTS), '-o',
+        perf_output.name, '-p', str(process.pid)
+    ], stderr=subprocess.DEVNULL)
+
+  # smaps_rollup only exists while the process runs, so sample it until the
+  # process exits. wait4 returns the peak RSS of this process alone.
+  peak_huge_kb = 0
+  smaps = '/proc/%d/smaps_rollup' % process.pid
+  while True:
+    pid, status, rusage = os.wait4(process.pid, os.WNOHANG)
+    if pid != 0:
+      break
+    sample = ReadKilobytes(smaps, ['AnonHugePages'])
+    if sample:
+      peak_huge_kb = max(peak_huge_kb, sample['AnonHugePages'])
+    time.sleep(POLL_INTERVAL_S)
+  process.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+  stdout = process.stdout.read()
+  if process.returncode != 0:
+    sys.exit('%s failed with exit status %d' % (' '.join(command),
+                                                 process.returncode))
+
+  result = {
+      'time_ms': None,
+      'peak_rss_kb': rusage.ru_maxrss,
+      'peak_huge_kb': peak_huge_kb,
+  }
+  match = re.search(r'^time_ms=([0-9.]+)$', stdout, re.MULTILINE)
+  if match:
+    result['time_ms'] = float(match.group(1))
+
+  if perf:
+    perf.wait()
+    with open(perf_output.name) as f:
+      for line in f:
+        fields = line.strip().split(',')
+        if len(fields) > 2 and fields[2] in PERF_EVENTS:
+          try:
+            result[fields[2]] = int(fields[0])
+          except ValueError:
+            # "<not supported>" or "<not counted>".
+            pass
+    os.remove(perf_output.name)
+  return result
+
+
+def Median(runs, key):
+  values = [run[key] for run in runs if run.get(key) is not None]
+  if not values:
+    return None
+  return statistics.median(values)
+
+
+def Format(value, unit):
+  if value is None:
+    return 'n/a'
+  if unit == 'MB':
+    return '%.1f MB' % (value / 1024.0)
+  if unit == 'ms':
+    return '%.1f ms' % value
+  return '{:,}'.format(int(value))
+
+
+def Main():
+  parser = argparse.ArgumentParser(
+      description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument('d8', help='path to d8')
+  parser.add_argument('--runs', type=int, default=5,
+                      help='runs per configuration (default: 5)')
+  parser.add_argument('--workload', default=WORKLOAD,
+                      help='script to run (default: workload.js)')
+  parser.add_argument('--d8-flags', default='',
+                      help='extra flags for d8, separated by spaces')
+  parser.add_argument('workload_args', nargs='*',
+                      help='arguments for the workload, after "--"')
+  options = parser.parse_args()
+
+  if not sys.platform.startswith('linux'):
+    sys.exit('Transparent huge pages are only supported on Linux.')
+  use_perf = shutil.which('perf') is not None
+  if not use_perf:
+    print('perf not found, TLB misses are not reported.')
+
+  extra_flags = options.d8_flags.split()
+  results = []
+  for name, flags in CONFIGURATIONS:
+    runs = []
+    for i in range(options.runs):
+      runs.append(Run(options.d8, extra_flags + flags, options.workload,
+                      options.workload_args, use_perf))
+      print('[%s %d/%d]' % (name, i + 1, options.runs), file=sys.stderr)
+    results.append((name, runs))
+
+  rows = [
+      ('time', 'time_ms', 'ms'),
+      ('peak RSS', 'peak_rss_kb', 'MB'),
+      ('peak huge pages', 'peak_huge_kb', 'MB'),
+  ] + [(event, event, '') for event in PERF_EVENTS]
+  print('%-20s' % 'median' + ''.join('%20s' % name for name, _ in results))
+  for label, key, unit in rows:
+    print('%-20s' % label + ''.join(
+        '%20s' % Format(Median(runs, key), unit) for _, runs in results))
+
+
+if __name__ == '__main__':
+  Main()
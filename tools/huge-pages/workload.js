@@ -0,0 +1,60 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A heap-heavy workload for benchmark.py. It keeps a large object graph alive
+// and walks it in a random order, so that most accesses miss the TLB. It also
+// keeps replacing part of the graph, so that pages are freed and reused.
+//
+// Usage: d8 workload.js -- [megabytes of live objects]
+
+const kMegabytes = arguments.length > 0 ? Number(arguments[0]) : 256;
+// A node with three fields takes about 24 bytes on a 64-bit build with
+// pointer compression, and the array holds another 4 bytes per node.
+const kNodes = Math.floor(kMegabytes * 1024 * 1024 / 28);
+const kWalks = 8;
+const kChurnFraction = 0.1;
+
+// Nodes refer to each other by index, so that a node dies as soon as it is
+// replaced in the array.
+function Node(value, next) {
+  this.value = value;
+  this.next = next;
+  this.payload = null;
+}
+
+let seed = 0x2545f491;
+function Random(limit) {
+  seed ^= seed << 13;
+  seed ^= seed >>> 17;
+  seed ^= seed << 5;
+  return (seed >>> 0) % limit;
+}
+
+const start = performance.now();
+
+// Link the nodes in a random order, so that following the links jumps
+// between pages.
+const nodes = new Array(kNodes);
+for (let i = 0; i < kNodes; i++) nodes[i] = new Node(i, Random(kNodes));
+
+let checksum = 0;
+for (let walk = 0; walk < kWalks; walk++) {
+  let node = nodes[Random(kNodes)];
+  for (let i = 0; i < kNodes; i++) {
+    checksum = (checksum + node.value) | 0;
+    node = nodes[node.next];
+  }
+  // Replace some of the nodes. The old ones die and their pages are freed
+  // once the old generation is collected.
+  const churn = Math.floor(kNodes * kChurnFraction);
+  for (let i = 0; i < churn; i++) {
+    const index = Random(kNodes);
+    const replacement = new Node(nodes[index].value, Random(kNodes));
+    replacement.payload = [index, walk];
+    nodes[index] = replacement;
+  }
+}
+
+print(`checksum=${checksum}`);
+print(`time_ms=${(performance.now() - start).toFixed(1)}`);